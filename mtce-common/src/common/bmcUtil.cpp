@@ -19,6 +19,7 @@ using namespace std;
 #include "bmcUtil.h"     /* for ... mtce-common bmc utility header   */
 #include "nodeUtil.h"    /* for ... tolowercase                      */
 #include "jsonUtil.h"    /* for ... jsonUtil_get_key_value_string    */
+#include "redfishClient.h" /* for ... redfishClient_close            */
 
 /**********************************************************************
  *
@@ -401,6 +402,9 @@ int bmcUtil_is_power_on ( string   hostname,
  *              Function detects which process is calling it and removes
  *              only the temp files that daemon created for a specific host.
  *
+ *              For redfish this also closes the host's in-process redfish
+ *              client session and connection, if there is one.
+ *
  * Assumptions: Keeps the temp dirs clean and current.
  *
  ****************************************************************************/
@@ -413,6 +417,9 @@ void bmcUtil_remove_files ( string hostname, bmc_protocol_enum protocol )
     std::list<string> filelist ;
     std::list<string>::iterator file_ptr ;
 
+    if ( protocol == BMC_PROTOCOL__REDFISHTOOL )
+        redfishClient_close ( hostname );
+
     string dir = BMC_OUTPUT_DIR ;
     dir.append(bmcUtil_getProtocol_str(protocol));
 
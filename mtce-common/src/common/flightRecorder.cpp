@@ -0,0 +1,301 @@
+/*
+ * Copyright (c) 2026 Wind River Systems, Inc.
+*
+* SPDX-License-Identifier: Apache-2.0
+*
+ */
+
+ /**
+  * @file
+  * Starling-X Common Binary Flight Recorder Implementation
+  *
+  * See flightRecorder.h for a description of the recorder.
+  *
+  * Writers claim a record by atomically incrementing the header's
+  * head count. The record's seq is zeroed, its payload written and
+  * then seq is released with the claim number. Readers only accept
+  * a record whose seq matches the claim number of its slot both
+  * before and after the copy.
+  *
+  * This module has no logging or daemon library dependencies so
+  * it can also be linked into the offline decoder.
+  */
+
+#include <stdio.h>
+#include <string.h>
+#include <time.h>
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/mman.h>
+#include <sys/syscall.h>
+
+#include "returnCodes.h"    /* for ... PASS, FAIL_xxxx                  */
+#include "flightRecorder.h" /* for ... this module header               */
+
+static_assert ( sizeof(flight_record_type) == 64, "flight record size" );
+static_assert ( sizeof(flight_header_type) == 128, "flight header size" );
+static_assert ( (FLIGHT_RECORDER_RECORDS & (FLIGHT_RECORDER_RECORDS-1)) == 0,
+                "flight recorder records must be a power of 2" );
+
+typedef struct
+{
+    flight_header_type header ;
+    flight_record_type records [FLIGHT_RECORDER_RECORDS] ;
+} flight_recorder_type ;
+
+/* Used when the /dev/shm file cannot be mapped */
+static flight_recorder_type _fallback ;
+
+static flight_recorder_type * _recorder = NULL ;
+static char _filename [FLIGHT_RECORDER_NAME_LEN+64] = { "" } ;
+
+/* cached writer thread id */
+static thread_local uint32_t _tid = 0 ;
+
+/* Event names and the labels of the arguments each one records.
+ * Indexed by flight_event_enum. A NULL label is not displayed. */
+typedef struct
+{
+    const char * name ;
+    const char * args [FLIGHT_RECORDER_ARGS] ;
+} flight_event_info_type ;
+
+static const flight_event_info_type _event_info [FLIGHT_EVENT__LAST] =
+{
+    { "none"         , { NULL     , NULL     , NULL      , NULL    }},
+    { "start"        , { "pid"    , NULL     , NULL      , NULL    }},
+    { "pulse_req"    , { "iface"  , "seq"    , "bytes"   , "rri"   }},
+    { "pulse_rsp"    , { "iface"  , "seq"    , "flags"   , "bytes" }},
+    { "pulse_miss"   , { "iface"  , "misses" , "max"     , NULL    }},
+    { "admin_action" , { "from"   , "to"     , NULL      , NULL    }},
+    { "state_change" , { "admin"  , "oper"   , "avail"   , NULL    }},
+    { "thread_launch", { "command", "rc"     , NULL      , NULL    }},
+    { "thread_done"  , { "command", "status" , NULL      , NULL    }},
+    { "bmc_call"     , { "rc"     , "msecs"  , NULL      , NULL    }},
+    { "bmc_redfish"  , { "rc"     , "msecs"  , NULL      , NULL    }},
+};
+
+/*****************************************************************************
+ *
+ * Name       : flightRecorder_init
+ *
+ * Description: Create and map /dev/shm/<name>.flight, keeping the previous
+ *              run's recording as <name>.flight.prev, and start recording.
+ *
+ ****************************************************************************/
+
+int flightRecorder_init ( const char * name )
+{
+    int rc = PASS ;
+    flight_recorder_type * recorder_ptr = NULL ;
+
+    if ( __atomic_load_n ( &_recorder, __ATOMIC_ACQUIRE ) != NULL )
+        return (PASS);
+
+    if (( name == NULL ) || ( name[0] == '\0' ))
+        return (FAIL_BAD_PARM);
+
+    snprintf ( &_filename[0], sizeof(_filename), "%s/%s%s",
+               FLIGHT_RECORDER_DIR, name, FLIGHT_RECORDER_SUFFIX );
+
+    /* preserve the last run's recording for post-mortem */
+    char prev [sizeof(_filename)+8] ;
+    snprintf ( &prev[0], sizeof(prev), "%s%s", _filename, FLIGHT_RECORDER_PREV );
+    rename ( _filename, prev );
+
+    int fd = open ( _filename, O_RDWR | O_CREAT | O_TRUNC | O_CLOEXEC, 0600 );
+    if ( fd >= 0 )
+    {
+        if ( ftruncate ( fd, sizeof(flight_recorder_type)) == 0 )
+        {
+            void * base = mmap ( NULL, sizeof(flight_recorder_type),
+                                 PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0 );
+            if ( base != MAP_FAILED )
+                recorder_ptr = (flight_recorder_type*)base ;
+        }
+        close ( fd );
+    }
+    if ( recorder_ptr == NULL )
+    {
+        unlink ( _filename );
+        _filename[0] = '\0' ;
+        recorder_ptr = &_fallback ;
+        rc = FAIL_FILE_CREATE ;
+    }
+
+    struct timespec ts ;
+    clock_gettime ( CLOCK_REALTIME, &ts );
+
+    recorder_ptr->header.magic    = FLIGHT_RECORDER_MAGIC ;
+    recorder_ptr->header.version  = FLIGHT_RECORDER_VERSION ;
+    recorder_ptr->header.records  = FLIGHT_RECORDER_RECORDS ;
+    recorder_ptr->header.rec_size = sizeof(flight_record_type);
+    recorder_ptr->header.pid      = getpid();
+    recorder_ptr->header.head     = 0 ;
+    recorder_ptr->header.start    = ((uint64_t)ts.tv_sec*1000000000)+ts.tv_nsec ;
+    snprintf ( &recorder_ptr->header.name[0], FLIGHT_RECORDER_NAME_LEN, "%s", name );
+
+    __atomic_store_n ( &_recorder, recorder_ptr, __ATOMIC_RELEASE );
+
+    flightRecorder_log ( FLIGHT_EVENT__START, name, getpid() );
+    return (rc);
+}
+
+const char * flightRecorder_file ( void )
+{
+    return (&_filename[0]);
+}
+
+/*****************************************************************************
+ *
+ * Name       : flightRecorder_log
+ *
+ * Description: Add a record. Lock free ; safe from any thread.
+ *
+ ****************************************************************************/
+
+void flightRecorder_log ( flight_event_enum event,
+                          const char * tag,
+                          int a0, int a1, int a2, int a3 )
+{
+    flight_recorder_type * recorder_ptr =
+        __atomic_load_n ( &_recorder, __ATOMIC_ACQUIRE );
+    if ( recorder_ptr == NULL )
+        return ;
+
+    uint64_t seq = __atomic_add_fetch ( &recorder_ptr->header.head, 1, __ATOMIC_RELAXED );
+    flight_record_type * rec_ptr =
+        &recorder_ptr->records[(seq-1) & (FLIGHT_RECORDER_RECORDS-1)] ;
+
+    /* invalidate the slot while it is being written */
+    __atomic_store_n ( &rec_ptr->seq, 0, __ATOMIC_RELAXED );
+    __atomic_thread_fence ( __ATOMIC_RELEASE );
+
+    if ( _tid == 0 )
+        _tid = (uint32_t)syscall ( SYS_gettid );
+
+    struct timespec ts ;
+    clock_gettime ( CLOCK_REALTIME, &ts );
+
+    rec_ptr->nsec    = ((uint64_t)ts.tv_sec*1000000000)+ts.tv_nsec ;
+    rec_ptr->event   = event ;
+    rec_ptr->tid     = _tid ;
+    rec_ptr->args[0] = a0 ;
+    rec_ptr->args[1] = a1 ;
+    rec_ptr->args[2] = a2 ;
+    rec_ptr->args[3] = a3 ;
+
+    int i = 0 ;
+    if ( tag )
+    {
+        for ( ; ( i < FLIGHT_RECORDER_TAG_LEN-1 ) && tag[i] ; i++ )
+            rec_ptr->tag[i] = tag[i] ;
+    }
+    rec_ptr->tag[i] = '\0' ;
+
+    __atomic_store_n ( &rec_ptr->seq, seq, __ATOMIC_RELEASE );
+}
+
+const char * flightRecorder_event_str ( uint32_t event )
+{
+    if ( event >= FLIGHT_EVENT__LAST )
+        return ("unknown");
+    return ( _event_info[event].name );
+}
+
+/*****************************************************************************
+ *
+ * Name       : flightRecorder_load
+ *
+ * Description: Validate the recording at 'base' and copy its consistent
+ *              records into 'records', oldest first.
+ *
+ * Returns    : PASS or FAIL_INVALID_DATA if this is not a recording
+ *              this version of the decoder understands.
+ *
+ ****************************************************************************/
+
+int flightRecorder_load ( const void * base, size_t size,
+                          flight_header_type & header,
+                          vector<flight_record_type> & records )
+{
+    records.clear();
+    if (( base == NULL ) || ( size < sizeof(flight_header_type) ))
+        return (FAIL_INVALID_DATA);
+
+    const flight_header_type * header_ptr = (const flight_header_type*)base ;
+    memcpy ( &header, header_ptr, sizeof(header));
+    if (( header.magic    != FLIGHT_RECORDER_MAGIC ) ||
+        ( header.version  != FLIGHT_RECORDER_VERSION ) ||
+        ( header.rec_size != sizeof(flight_record_type)) ||
+        ( header.records  == 0 ) ||
+        ( header.records & (header.records-1)) ||
+        ( size < sizeof(flight_header_type) +
+                 ((size_t)header.records*sizeof(flight_record_type))))
+    {
+        return (FAIL_INVALID_DATA);
+    }
+    header.name[FLIGHT_RECORDER_NAME_LEN-1] = '\0' ;
+
+    const flight_record_type * ring =
+        (const flight_record_type*)((const char*)base + sizeof(flight_header_type));
+
+    uint64_t head  = __atomic_load_n ( &header_ptr->head, __ATOMIC_ACQUIRE );
+    uint64_t first = ( head > header.records ) ? head - header.records + 1 : 1 ;
+    records.reserve ( head - first + 1 );
+    for ( uint64_t seq = first ; seq <= head ; seq++ )
+    {
+        const flight_record_type * rec_ptr = &ring[(seq-1) & (header.records-1)] ;
+        if ( __atomic_load_n ( &rec_ptr->seq, __ATOMIC_ACQUIRE ) != seq )
+            continue ; /* never completed or already overwritten */
+
+        flight_record_type record ;
+        memcpy ( &record, rec_ptr, sizeof(record));
+        __atomic_thread_fence ( __ATOMIC_ACQUIRE );
+        if ( __atomic_load_n ( &rec_ptr->seq, __ATOMIC_RELAXED ) != seq )
+            continue ; /* overwritten while being copied */
+
+        record.seq = seq ;
+        record.tag[FLIGHT_RECORDER_TAG_LEN-1] = '\0' ;
+        records.push_back ( record );
+    }
+    return (PASS);
+}
+
+/*****************************************************************************
+ *
+ * Name       : flightRecorder_format
+ *
+ * Description: Format a record as
+ *
+ *   <local time> <seq> <tid> <event> <tag> <label>:<arg> ...
+ *
+ ****************************************************************************/
+
+void flightRecorder_format ( const flight_record_type & record,
+                             char * buf, size_t len )
+{
+    struct tm tm ;
+    time_t secs = (time_t)(record.nsec / 1000000000) ;
+    localtime_r ( &secs, &tm );
+
+    size_t n = strftime ( buf, len, "%Y-%m-%dT%H:%M:%S", &tm );
+    n += snprintf ( &buf[n], len-n, ".%06u %8llu %6u %-13s %-20s",
+                    (unsigned)((record.nsec % 1000000000)/1000),
+                    (unsigned long long)record.seq,
+                    record.tid,
+                    flightRecorder_event_str ( record.event ),
+                    record.tag );
+
+    const char * const * labels_ptr = NULL ;
+    if ( record.event < FLIGHT_EVENT__LAST )
+        labels_ptr = &_event_info[record.event].args[0] ;
+
+    for ( int i = 0 ; ( i < FLIGHT_RECORDER_ARGS ) && ( n < len ) ; i++ )
+    {
+        if ( labels_ptr == NULL )
+            n += snprintf ( &buf[n], len-n, " %d", record.args[i] );
+        else if ( labels_ptr[i] )
+            n += snprintf ( &buf[n], len-n, " %s:%d", labels_ptr[i], record.args[i] );
+    }
+}
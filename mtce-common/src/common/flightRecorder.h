@@ -0,0 +1,122 @@
+#ifndef __INCLUDE_FLIGHTRECORDER_H__
+#define __INCLUDE_FLIGHTRECORDER_H__
+
+/*
+ * Copyright (c) 2026 Wind River Systems, Inc.
+*
+* SPDX-License-Identifier: Apache-2.0
+*
+ */
+
+ /**
+  * @file
+  * Starling-X Common Binary Flight Recorder Header
+  *
+  * A fixed size, preallocated ring of small binary event records that
+  * is cheap enough to leave enabled in the daemon hot paths.
+  *
+  * Each record holds a timestamp, an event id, up to four integer
+  * arguments and a short string id ; typically the hostname. Nothing
+  * is formatted at record time. Records are claimed with a single
+  * atomic increment so the recorder may be used from the main loop
+  * and the bmc threads at the same time without a lock.
+  *
+  * The ring is mapped from /dev/shm/<daemon>.flight so its content
+  * survives a daemon crash. The previous run's file is kept as
+  * /dev/shm/<daemon>.flight.prev and both can be decoded offline
+  * with the mtcFlight tool.
+  */
+
+#include <stdio.h>
+#include <stdint.h>
+#include <vector>
+
+using namespace std;
+
+#define FLIGHT_RECORDER_DIR       ((const char *)("/dev/shm"))
+#define FLIGHT_RECORDER_SUFFIX    ((const char *)(".flight"))
+#define FLIGHT_RECORDER_PREV      ((const char *)(".prev"))
+
+#define FLIGHT_RECORDER_MAGIC     (0x544c4643) /* "CFLT" */
+#define FLIGHT_RECORDER_VERSION   (1)
+#define FLIGHT_RECORDER_RECORDS   (4096)       /* must be a power of 2 */
+#define FLIGHT_RECORDER_ARGS      (4)
+#define FLIGHT_RECORDER_TAG_LEN   (24)
+#define FLIGHT_RECORDER_NAME_LEN  (32)
+
+/* Event ids are stored in the file ; only ever append to this list
+ * and add the matching entry to the event table in flightRecorder.cpp */
+typedef enum
+{
+    FLIGHT_EVENT__NONE          = 0,
+    FLIGHT_EVENT__START         = 1,
+    FLIGHT_EVENT__PULSE_REQ     = 2,
+    FLIGHT_EVENT__PULSE_RSP     = 3,
+    FLIGHT_EVENT__PULSE_MISS    = 4,
+    FLIGHT_EVENT__ADMIN_ACTION  = 5,
+    FLIGHT_EVENT__STATE_CHANGE  = 6,
+    FLIGHT_EVENT__THREAD_LAUNCH = 7,
+    FLIGHT_EVENT__THREAD_DONE   = 8,
+    FLIGHT_EVENT__BMC_CALL      = 9,
+    FLIGHT_EVENT__BMC_REDFISH   = 10,
+    FLIGHT_EVENT__LAST          = 11,
+} flight_event_enum ;
+
+/* One 64 byte record.
+ *
+ * seq is the 1 based claim order. It is zeroed while the record is
+ * being written and set last, so a reader skips any record whose seq
+ * is zero or does not match its slot. */
+typedef struct
+{
+    uint64_t seq   ;                               /**< claim order       */
+    uint64_t nsec  ;                               /**< CLOCK_REALTIME    */
+    uint32_t event ;                               /**< flight_event_enum */
+    uint32_t tid   ;                               /**< writer thread id  */
+    int32_t  args [FLIGHT_RECORDER_ARGS] ;         /**< event arguments   */
+    char     tag  [FLIGHT_RECORDER_TAG_LEN] ;      /**< short string id   */
+} flight_record_type ;
+
+/* File header ; the records follow it. */
+typedef struct
+{
+    uint32_t magic    ;
+    uint32_t version  ;
+    uint32_t records  ;                            /**< ring size         */
+    uint32_t rec_size ;                            /**< sizeof record     */
+    int32_t  pid      ;                            /**< writer process    */
+    uint32_t spare    ;
+    uint64_t head     ;                            /**< records claimed   */
+    uint64_t start    ;                            /**< CLOCK_REALTIME    */
+    char     name [FLIGHT_RECORDER_NAME_LEN] ;     /**< daemon name       */
+    char     pad  [56] ;                           /**< 128 byte header   */
+} flight_header_type ;
+
+/* Map /dev/shm/<name>.flight and start recording to it.
+ * Falls back to an in memory ring if the file cannot be mapped,
+ * in which case FAIL_FILE_CREATE is returned. */
+int  flightRecorder_init ( const char * name );
+
+/* Full path of the recording file ; empty if not mapped */
+const char * flightRecorder_file ( void );
+
+/* Add a record. Lock free and safe from any thread.
+ * A no-op before flightRecorder_init. */
+void flightRecorder_log ( flight_event_enum event,
+                          const char * tag,
+                          int a0 = 0, int a1 = 0, int a2 = 0, int a3 = 0 );
+
+/* Event and argument names used when decoding */
+const char * flightRecorder_event_str ( uint32_t event );
+
+/* Validate a mapped recording and copy its consistent records
+ * out in claim order. Usable on a live or a dead recording. */
+int  flightRecorder_load ( const void * base, size_t size,
+                           flight_header_type & header,
+                           vector<flight_record_type> & records );
+
+/* Format one record as a single line of text */
+void flightRecorder_format ( const flight_record_type & record,
+                             char * buf, size_t len );
+
+#endif // __INCLUDE_FLIGHTRECORDER_H__
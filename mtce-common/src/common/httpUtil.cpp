@@ -12,6 +12,8 @@
   */
 
 #include <stdlib.h>
+#include <sys/socket.h>     /* for ... recv                 */
+#include <event2/bufferevent.h> /* for ... bufferevent_getfd */
 
 using namespace std;
 
@@ -27,6 +29,28 @@ static char rest_api_filename[MAX_FILENAME_LEN];
 static char rest_api_log_str [MAX_API_LOG_LEN];
 static libEvent nullEvent ;
 
+/* An idle keep-alive connection */
+typedef struct
+{
+    string                     ip ;
+    int                      port ;
+    struct evhttp_connection *conn ;
+} http_pool_conn_type ;
+
+/* The keep-alive connection pool */
+static struct
+{
+    struct event_base * base ; /* the long lived shared event base */
+    list<http_pool_conn_type> idle ;
+
+    unsigned long long hits   ; /* acquired an idle connection      */
+    unsigned long long misses ; /* had to create a new connection   */
+    unsigned long long drops  ; /* freed rather than kept on release*/
+    unsigned long long done   ; /* completed requests               */
+    unsigned long long msecs  ; /* total completed request time     */
+    unsigned long long max_msecs ;
+} http_pool = { NULL, list<http_pool_conn_type>(), 0, 0, 0, 0, 0, 0 } ;
+
 #define HTTP_GET_STR "GET"
 #define HTTP_PUT_STR "PUT"
 #define HTTP_PATCH_STR "PATCH"
@@ -137,6 +161,7 @@ int httpUtil_event_init ( libEvent * ptr ,
     /* Result Info */
     ptr->callback    = nullptr ;
     ptr->done        = false ;
+    ptr->keep_alive  = false ;
     ptr->status      = FAIL;
     ptr->http_status = 0   ;
     ptr->low_wm = ptr->med_wm = ptr->high_wm = false ;
@@ -171,6 +196,11 @@ void httpUtil_init ( void )
 
 void httpUtil_free_conn ( libEvent & event )
 {
+    if ( httpUtil_pool_owns ( event ) )
+    {
+        httpUtil_pool_release ( event );
+        return ;
+    }
     if ( event.conn )
     {
         hlog3 ("%s Free Connection (%p)\n", event.log_prefix.c_str(), event.conn );
@@ -193,6 +223,14 @@ void httpUtil_free_conn ( libEvent & event )
 
 void httpUtil_free_base ( libEvent & event )
 {
+    /* The shared base is never freed */
+    if ( httpUtil_pool_owns ( event ) )
+    {
+        httpUtil_pool_release ( event );
+        event.base = NULL ;
+        return ;
+    }
+
     /* Free the base */
     if ( event.base )
     {
@@ -215,6 +253,225 @@ void httpUtil_free_base ( libEvent & event )
     }
 }
 
+/* ***********************************************************************
+ *
+ * Name       : httpUtil_pool_owns
+ *
+ * Description: Returns true if the event's base is the shared pool base.
+ *
+ * ************************************************************************/
+
+bool httpUtil_pool_owns ( libEvent & event )
+{
+    return (( event.base != NULL ) && ( event.base == http_pool.base ));
+}
+
+/* ***********************************************************************
+ *
+ * Name       : httpUtil_pool_acquire
+ *
+ * Description: Load the event with the shared event base and a
+ *              connection to its ip:port ; an idle one if there
+ *              is one or a new one otherwise.
+ *
+ * ************************************************************************/
+
+int httpUtil_pool_acquire ( libEvent & event )
+{
+    if ( http_pool.base == NULL )
+    {
+        http_pool.base = event_base_new();
+        if ( http_pool.base == NULL )
+        {
+            elog ("%s No Memory for shared event base\n", event.log_prefix.c_str());
+            return (FAIL_EVENT_BASE);
+        }
+    }
+
+    event.base = http_pool.base ;
+    event.conn = NULL ;
+
+    list<http_pool_conn_type>::iterator it = http_pool.idle.begin() ;
+    while ( it != http_pool.idle.end() )
+    {
+        if (( it->port != event.port ) || ( it->ip != event.ip ))
+        {
+            ++it ;
+            continue ;
+        }
+
+        struct evhttp_connection * conn = it->conn ;
+        it = http_pool.idle.erase ( it );
+
+        /* The server may have closed the connection while it was idle
+         * and the shared base is not looped between requests so
+         * libevent may not know yet. Peek at the socket rather than
+         * fail the request on a dead connection. */
+        char c ;
+        int fd = bufferevent_getfd ( evhttp_connection_get_bufferevent ( conn ));
+        if (( fd >= 0 ) &&
+            (( recv ( fd, &c, 1, MSG_PEEK | MSG_DONTWAIT ) >= 0 ) ||
+             (( errno != EAGAIN ) && ( errno != EWOULDBLOCK ))))
+        {
+            hlog3 ("%s closed idle connection (%p)\n", event.log_prefix.c_str(), conn );
+            http_pool.drops++ ;
+            evhttp_connection_free ( conn );
+            continue ;
+        }
+
+        event.conn = conn ;
+        http_pool.hits++ ;
+        hlog3 ("%s reusing connection (%p)\n", event.log_prefix.c_str(), event.conn );
+        return (PASS);
+    }
+
+    http_pool.misses++ ;
+    return ( httpUtil_connect ( event ));
+}
+
+/* ***********************************************************************
+ *
+ * Name       : httpUtil_pool_release
+ *
+ * Description: Return the event's connection to the idle list.
+ *
+ * A connection is only kept if the request on it completed successfully
+ * and there is room for it. Otherwise, like after a timeout or a failed
+ * or abandoned request, it is freed.
+ *
+ * ************************************************************************/
+
+void httpUtil_pool_release ( libEvent & event )
+{
+    if ( event.conn == NULL )
+        return ;
+
+    /* account for requests whose handler has run */
+    if (( event.active == false ) &&
+        (( event.done_time.ts.tv_sec  != event.send_time.ts.tv_sec ) ||
+         ( event.done_time.ts.tv_nsec != event.send_time.ts.tv_nsec )))
+    {
+        unsigned long long msecs = (event.diff_time.secs*1000) + event.diff_time.msecs ;
+        http_pool.done++ ;
+        http_pool.msecs += msecs ;
+        if ( msecs > http_pool.max_msecs )
+            http_pool.max_msecs = msecs ;
+    }
+
+    if (( event.active == false ) && ( event.status == PASS ) && ( event.keep_alive ))
+    {
+        int count = 0 ;
+        list<http_pool_conn_type>::iterator it ;
+        for ( it = http_pool.idle.begin() ; it != http_pool.idle.end() ; ++it )
+            if (( it->port == event.port ) && ( it->ip == event.ip ))
+                count++ ;
+
+        if ( count < HTTP_POOL_MAX_IDLE )
+        {
+            http_pool_conn_type entry ;
+            entry.ip   = event.ip   ;
+            entry.port = event.port ;
+            entry.conn = event.conn ;
+            http_pool.idle.push_back ( entry );
+            hlog3 ("%s keeping connection (%p)\n", event.log_prefix.c_str(), event.conn );
+            event.conn = NULL ;
+            return ;
+        }
+    }
+
+    hlog3 ("%s Free Connection (%p)\n", event.log_prefix.c_str(), event.conn );
+    http_pool.drops++ ;
+    evhttp_connection_free ( event.conn );
+    event.conn = NULL ;
+}
+
+/* ***********************************************************************
+ *
+ * Name       : httpUtil_keep_alive
+ *
+ * Description: Returns true if the server did not say it would close
+ *              the connection after this response.
+ *
+ * ************************************************************************/
+
+bool httpUtil_keep_alive ( struct evhttp_request * req )
+{
+    if ( req == NULL )
+        return (false);
+
+    const char * conn_hdr = evhttp_find_header ( req->input_headers, "Connection" );
+    if (( req->major == 1 ) && ( req->minor == 0 ))
+    {
+        /* HTTP/1.0 closes unless told otherwise */
+        return (( conn_hdr != NULL ) && ( strcasecmp ( conn_hdr, "keep-alive" ) == 0 ));
+    }
+    return (( conn_hdr == NULL ) || ( strcasecmp ( conn_hdr, "close" ) != 0 ));
+}
+
+/* no-op timer callback ; only there to wake up httpUtil_pool_wait */
+static void httpUtil_pool_wakeup ( evutil_socket_t fd, short what, void * arg )
+{
+    UNUSED(fd);
+    UNUSED(what);
+    UNUSED(arg);
+}
+
+/* ***********************************************************************
+ *
+ * Name       : httpUtil_pool_wait
+ *
+ * Description: Blocking wait for a pooled request.
+ *
+ * event_base_dispatch can't be used on the shared base since the idle
+ * connections keep it busy. Instead loop over it until the request
+ * handler clears event.active. The connection timeout guarantees the
+ * handler is called but still give up a couple of seconds after that.
+ *
+ * ************************************************************************/
+
+int httpUtil_pool_wait ( libEvent & event )
+{
+    struct timeval tv = { event.timeout+1, 0 } ;
+    unsigned long long deadline = gettime_monotonic_nsec () +
+                                  ((unsigned long long)(event.timeout+2)*NSEC_TO_SEC) ;
+
+    event_base_once ( event.base, -1, EV_TIMEOUT, httpUtil_pool_wakeup, NULL, &tv );
+    while ( event.active == true )
+    {
+        if ( event_base_loop ( event.base, EVLOOP_ONCE ) < 0 )
+            break ;
+        if ( gettime_monotonic_nsec () > deadline )
+        {
+            wlog ("%s no response after %d secs\n", event.log_prefix.c_str(), event.timeout );
+            break ;
+        }
+    }
+    if ( event.active == true )
+    {
+        event.active = false ;
+        event.status = FAIL_TIMEOUT ;
+    }
+    return (event.status);
+}
+
+/* ***********************************************************************
+ *
+ * Name       : httpUtil_pool_stats_log
+ *
+ * Description: Log the pool's connection reuse and request latency stats.
+ *
+ * ************************************************************************/
+
+void httpUtil_pool_stats_log ( void )
+{
+    llog ("http pool: hits:%llu misses:%llu drops:%llu idle:%lu ; requests:%llu avg:%llu max:%llu msec\n",
+           http_pool.hits, http_pool.misses, http_pool.drops,
+           (unsigned long)http_pool.idle.size(),
+           http_pool.done,
+           http_pool.done ? http_pool.msecs/http_pool.done : 0,
+           http_pool.max_msecs );
+}
+
 /* ***********************************************************************
  *
  * Name       : httpUtil_connect
@@ -266,9 +523,10 @@ int httpUtil_request ( libEvent & event,
     int rc = PASS ;
 
     /* Make a new request and bind the event handler to it.
-     * The handler will be called with arg* pointing to the event.base
-     * that needs to be freed at the end of the handler execution */
-    event.req = evhttp_request_new( hdlr , event.base );
+     * The handler will be called with arg* pointing to the event.
+     * The base can't be used to find the event since pooled
+     * requests all share the same base. */
+    event.req = evhttp_request_new( hdlr , &event );
     if ( ! event.req )
     {
         elog ("%s evhttp_request_new returned NULL\n", event.log_prefix.c_str() );
@@ -481,6 +739,7 @@ int httpUtil_status ( libEvent & event )
         return (FAIL_UNKNOWN_HOSTNAME);
     }
     event.status = event.http_status = evhttp_request_get_response_code (event.req);
+    event.keep_alive = httpUtil_keep_alive ( event.req );
     switch (event.status)
     {
         case HTTP_OK:
@@ -531,21 +790,21 @@ void httpUtil_handler ( struct evhttp_request *req, void *arg )
 
     if ( arg == NULL )
     {
-        elog ("null base pointer\n");
+        elog ("null event pointer\n");
         return ;
     }
 
-    /* find the event for this base */
+    /* make sure the event is still registered */
     if ( keyValObject.get_key ((unsigned long)arg, temp ) != PASS )
     {
-        wlog ("get_key value 'event' lookup from base (%p) key failed\n", arg );
+        wlog ("get_key value 'event' lookup from event (%p) key failed\n", arg );
         return ;
     }
 
     event_ptr = (libEvent*)temp;
     if (( event_ptr->request >= SERVICE_LAST ) || ( event_ptr->request == SERVICE_NONE ))
     {
-        slog ("HTTP Event Lookup Failed for http base (%p) <------\n", arg);
+        slog ("HTTP Event Lookup Failed for http event (%p) <------\n", arg);
         return ;
     }
 
@@ -691,6 +950,9 @@ void httpUtil_latency_log ( libEvent & event, const char * label_ptr, int line ,
                  ((event.this_time-event.prev_time) > NSEC_TO_MSEC) ? ((event.this_time-event.prev_time)/NSEC_TO_MSEC) : 0,
                  ((event.this_time-event.prev_time) > NSEC_TO_MSEC) ? ((event.this_time-event.prev_time)%NSEC_TO_MSEC) : 0,
                  label_ptr, line );
+
+            /* show whether connection reuse is working when things are slow */
+            httpUtil_pool_stats_log ();
         }
     }
     /* reset to be equal for next round */
@@ -731,34 +993,37 @@ int httpUtil_api_request ( libEvent & event )
                   event.log_prefix.c_str(), event.base );
 
         // Be sure to free the key
-        keyValObject.del_key ((unsigned long)event.base );
+        keyValObject.del_key ((unsigned long)&event );
+        if ( httpUtil_pool_owns ( event ) )
+        {
+            /* abandoned request ; don't keep its connection */
+            event.active = false ;
+            event.status = FAIL ;
+            httpUtil_free_conn ( event );
+        }
        // event_base_free(event.base);
     }
 
-    /* Allocate the base */
-    event.base = event_base_new();
-    if ( event.base == NULL )
+    /* Use the shared event base and a pooled connection */
+    if ( httpUtil_pool_acquire ( event ) != PASS )
     {
-        elog ("%s No Memory for Request\n", event.log_prefix.c_str());
-        event.status = FAIL_EVENT_BASE ;
-        return (event.status) ;
+        event.status = FAIL_CONNECT ;
+        goto httpUtil_api_request_done ;
     }
-    else
+
+    if ( keyValObject.add_key ((unsigned long)&event, (unsigned long)&event) != PASS )
     {
-        if ( keyValObject.add_key ((unsigned long)event.base, (unsigned long)&event) != PASS )
-        {
-            slog ("%s failed to store base:event as key (%p) value pair\n", 
-                      event.log_prefix.c_str(), event.base );
+        slog ("%s failed to store event:event as key (%p) value pair\n",
+                  event.log_prefix.c_str(), &event );
 
-            /* lets try and recover from this */
-            keyValObject.del_key ((unsigned long)event.base);
-            if ( keyValObject.add_key ((unsigned long)event.base, (unsigned long)&event) != PASS )
-            {
-                slog ("%s still cannot store base:event after key_del\n", event.log_prefix.c_str());
+        /* lets try and recover from this */
+        keyValObject.del_key ((unsigned long)&event);
+        if ( keyValObject.add_key ((unsigned long)&event, (unsigned long)&event) != PASS )
+        {
+            slog ("%s still cannot store event:event after key_del\n", event.log_prefix.c_str());
 
-                event.status = FAIL_LOCATE_KEY_VALUE ;
-                goto httpUtil_api_request_done ;
-            }
+            event.status = FAIL_LOCATE_KEY_VALUE ;
+            goto httpUtil_api_request_done ;
         }
     }
 
@@ -806,13 +1071,6 @@ int httpUtil_api_request ( libEvent & event )
         goto httpUtil_api_request_done ;
     }
 
-    /* Establish connection */
-    if ( httpUtil_connect ( event ))
-    {
-        event.status = FAIL_CONNECT ;
-        goto httpUtil_api_request_done ;
-    }
-
     if ( httpUtil_request ( event, &httpUtil_handler ))
     {
         event.status = FAIL_REQUEST_NEW ;
@@ -895,8 +1153,9 @@ int httpUtil_api_request ( libEvent & event )
         hdr_entry++;
     }
 
+    /* pooled connections are kept open for the next request */
     hdrs.entry[hdr_entry].key   = "Connection" ;
-    hdrs.entry[hdr_entry].value = "close" ;
+    hdrs.entry[hdr_entry].value = "keep-alive" ;
     hdr_entry++;
     hdrs.entries = hdr_entry ;
 
@@ -921,6 +1180,7 @@ int httpUtil_api_request ( libEvent & event )
 
     gettime   ( event.send_time );
     gettime   ( event.done_time ); /* create a valid done value */
+    event.keep_alive = false ;
 
     if ( event.request == KEYSTONE_GET_TOKEN )
     {
@@ -957,7 +1217,8 @@ int httpUtil_api_request ( libEvent & event )
             hlog ("%s Requested (blocking) (timeout:%d secs)\n", event.log_prefix.c_str(), event.timeout);
 
             /* Send the message with timeout */
-            event_base_dispatch(event.base);
+            event.active = true ;
+            httpUtil_pool_wait ( event );
             httpUtil_latency_log ( event, label.c_str(), __LINE__, MAX_DELAY_B4_LATENCY_LOG );
             goto httpUtil_api_request_done ;
         }
@@ -974,7 +1235,8 @@ int httpUtil_api_request ( libEvent & event )
         else
         {
             hlog ("%s Requested (blocking) (timeout:%d secs)\n", event.log_prefix.c_str(), event.timeout );
-            event_base_dispatch(event.base);
+            event.active = true ;
+            httpUtil_pool_wait ( event );
             httpUtil_latency_log ( event, label.c_str(), __LINE__, MAX_DELAY_B4_LATENCY_LOG ) ;
             goto httpUtil_api_request_done ;
         }
@@ -993,7 +1255,7 @@ httpUtil_api_request_done:
     /* If the request fails then delete the key here */
     if ( free_key )
     {
-        keyValObject.del_key ((unsigned long)event.base) ;
+        keyValObject.del_key ((unsigned long)&event) ;
     }
 
     return (event.status);
@@ -252,6 +252,7 @@ struct libEvent
 
     /** Result Info */
     bool   done                   ; /**< true when request is done   */
+    bool   keep_alive             ; /**< server will keep conn open  */
     int    status                 ; /**< Execution Status            */
     int    http_status            ; /**< raw http returned status    */
     int    exec_time_msec         ; /**< execution time in msec      */
@@ -358,6 +359,43 @@ void httpUtil_free_base ( libEvent & event );
 /** Free the event lib connection */
 void httpUtil_free_conn ( libEvent & event );
 
+/** Keep-alive connection pool
+ *
+ *  Requests made through the pool share one long lived event base
+ *  and reuse idle connections to the same ip:port rather than paying
+ *  connection setup and teardown on every request.
+ *
+ *  The pool owns event.base and event.conn of a pooled event.
+ *  httpUtil_free_conn and httpUtil_free_base return them to the pool,
+ *  keeping the connection only if its last request completed cleanly.
+ *
+ *  Since the base is shared ; handlers of pooled requests must find
+ *  their event through the request callback arg rather than the base.
+ */
+#define HTTP_POOL_MAX_IDLE (8) /**< max idle connections per ip:port  */
+
+/** Get the shared base and an idle or new connection for this event */
+int  httpUtil_pool_acquire ( libEvent & event );
+
+/** Return the event's connection to the pool or free it */
+void httpUtil_pool_release ( libEvent & event );
+
+/** Returns true if the server will keep the response's connection open */
+bool httpUtil_keep_alive   ( struct evhttp_request * req );
+
+/** Returns true if the event's base and connection belong to the pool */
+bool httpUtil_pool_owns    ( libEvent & event );
+
+/** Run the shared base until this event's request completes
+ *  or its timeout has passed ; replaces event_base_dispatch */
+int  httpUtil_pool_wait    ( libEvent & event );
+
+/** Log the pool hit/miss and request latency stats */
+void httpUtil_pool_stats_log ( void );
+
+/** Latency log of the time since the previous call for this event */
+void httpUtil_latency_log ( libEvent & event, const char * label_ptr, int line , int msecs );
+
 /** TODO: FIXME: Get the payload string length. */
 string httpUtil_payload_len ( libEvent * ptr );
 
@@ -14,6 +14,7 @@
 #include <stdlib.h>
 #include <iostream>
 #include <list>
+#include <vector>
 #include <json-c/json.h>      /* for ... json-c json string parsing */
 #include <sstream>
 
@@ -219,6 +220,79 @@ string jsonUtil_get_key_value_string ( struct json_object * obj, const char * ke
     return (_json_get_key_value_string ( obj, key ));
 }
 
+/***********************************************************************
+ *
+ * Parse-once document handle ; see jsonUtil.h
+ *
+ ***********************************************************************/
+jsonUtil_doc_struct::~jsonUtil_doc_struct ( void )
+{
+    jsonUtil_doc_free ( *this );
+}
+
+void jsonUtil_doc_free ( jsonUtil_doc_type & doc )
+{
+    if ( doc.root )
+    {
+        json_object_put ( doc.root );
+        doc.root = (struct json_object *)(NULL);
+    }
+}
+
+int jsonUtil_doc_parse ( jsonUtil_doc_type & doc, const char * json_str_ptr )
+{
+    jsonUtil_doc_free ( doc );
+
+    if (( json_str_ptr == NULL ) || ( *json_str_ptr == '\0' ) ||
+        ( ! strncmp ( json_str_ptr, "(null)" , 6 )))
+    {
+        elog ("Cannot tokenize a null json string\n");
+        return (FAIL_NULL_POINTER);
+    }
+
+    doc.root = json_tokener_parse ( json_str_ptr );
+    if ( !doc.root )
+    {
+        jlog ("No or invalid json string (%s)\n", json_str_ptr );
+        return (FAIL_JSON_PARSE);
+    }
+    return (PASS);
+}
+
+struct json_object * jsonUtil_get_key_object ( struct json_object * obj, const char * key )
+{
+    struct json_object * key_obj = (struct json_object *)(NULL);
+    if (( obj ) && ( json_object_object_get_ex ( obj, key, &key_obj ) == true ))
+    {
+        return ( key_obj );
+    }
+    return ((struct json_object *)(NULL)) ;
+}
+
+struct json_object * jsonUtil_get_array ( struct json_object * obj,
+                                          const char * label,
+                                          int & elements )
+{
+    elements = 0 ;
+    struct json_object * array_obj = jsonUtil_get_key_object ( obj, label );
+    if (( array_obj ) && ( json_object_is_type ( array_obj, json_type_array )))
+    {
+        elements = (int)json_object_array_length ( array_obj );
+        return ( array_obj );
+    }
+    return ((struct json_object *)(NULL)) ;
+}
+
+struct json_object * jsonUtil_get_array_obj ( struct json_object * array_obj, int idx )
+{
+    if (( array_obj ) && ( idx >= 0 ) &&
+        ( idx < (int)json_object_array_length ( array_obj )))
+    {
+        return ( json_object_array_get_idx ( array_obj, idx ));
+    }
+    return ((struct json_object *)(NULL)) ;
+}
+
 int jsonUtil_get_key_value_int ( struct json_object * obj, const char * key )
 {
     int value = 0 ;
@@ -501,6 +575,107 @@ int jsonUtil_patch_load ( char * json_str_ptr,
     return (PASS);
 }
 
+/* Return the path of a json-patch 'replace' operation or an
+ * empty string if the object is some other kind of operation */
+static string _json_patch_replace_path ( struct json_object * op_obj )
+{
+    string path = "" ;
+    if ( op_obj && json_object_is_type ( op_obj, json_type_object ))
+    {
+        if ( _json_get_key_value_string ( op_obj, "op" ) == "replace" )
+        {
+            path = _json_get_key_value_string ( op_obj, "path" );
+            if ( path == "none" )
+                path.clear();
+        }
+    }
+    return (path);
+}
+
+/***************************************************************************
+ *
+ * Name       : jsonUtil_patch_merge
+ *
+ * Description: Merge the 'update' json-patch array into the 'payload'
+ *              json-patch array. Both must be lists of 'replace' ops.
+ *
+ *              A path already present in the payload has its value
+ *              replaced in place ; last writer wins. New paths are
+ *              appended in the order they appear in the update.
+ *
+ * Returns    : PASS with the payload updated to the merged document.
+ *              FAIL if either document is not a list of replace ops.
+ *                   The payload is left untouched in that case.
+ *
+ ***************************************************************************/
+int jsonUtil_patch_merge ( string & payload, const string & update )
+{
+    int rc = FAIL ;
+    struct json_object * dest_obj = (struct json_object *)(NULL);
+    struct json_object * from_obj = (struct json_object *)(NULL);
+
+    dest_obj = json_tokener_parse ( payload.data() );
+    from_obj = json_tokener_parse ( update.data()  );
+    if (( dest_obj && json_object_is_type ( dest_obj, json_type_array )) &&
+        ( from_obj && json_object_is_type ( from_obj, json_type_array )))
+    {
+        int dest_ops = (int)json_object_array_length ( dest_obj );
+        int from_ops = (int)json_object_array_length ( from_obj );
+        vector<string> dest_paths ;
+
+        rc = PASS ;
+        for ( int i = 0 ; i < dest_ops ; i++ )
+        {
+            string path = _json_patch_replace_path ( json_object_array_get_idx ( dest_obj, i ));
+            if ( path.empty() )
+            {
+                rc = FAIL ;
+                break ;
+            }
+            dest_paths.push_back ( path );
+        }
+        for ( int i = 0 ; ( rc == PASS ) && ( i < from_ops ) ; i++ )
+        {
+            if ( _json_patch_replace_path ( json_object_array_get_idx ( from_obj, i )).empty() )
+                rc = FAIL ;
+        }
+
+        for ( int i = 0 ; ( rc == PASS ) && ( i < from_ops ) ; i++ )
+        {
+            struct json_object * op_obj = json_object_array_get_idx ( from_obj, i );
+            string path = _json_patch_replace_path ( op_obj );
+            size_t d ;
+            for ( d = 0 ; d < dest_paths.size() ; d++ )
+                if ( dest_paths[d] == path )
+                    break ;
+
+            /* the dest array takes its own reference on the op */
+            json_object_get ( op_obj );
+            if ( d < dest_paths.size() )
+            {
+                json_object_array_put_idx ( dest_obj, d, op_obj );
+            }
+            else
+            {
+                json_object_array_add ( dest_obj, op_obj );
+                dest_paths.push_back ( path );
+            }
+        }
+        if ( rc == PASS )
+        {
+            int flags = JSON_C_TO_STRING_PLAIN ;
+#ifdef JSON_C_TO_STRING_NOSLASHESCAPE
+            flags |= JSON_C_TO_STRING_NOSLASHESCAPE ;
+#endif
+            payload = json_object_to_json_string_ext ( dest_obj, flags );
+        }
+    }
+    if (dest_obj) json_object_put(dest_obj);
+    if (from_obj) json_object_put(from_obj);
+
+    return (rc);
+}
+
 
 
 /* Load up json_info with the contents of the json_str */
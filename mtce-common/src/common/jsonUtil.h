@@ -130,6 +130,10 @@ int jsonUtil_hwmon_info ( char * json_str_ptr, node_inv_type & info );
 /** Handle the patch request response and verify execution status */
 int jsonUtil_patch_load ( char * json_str_ptr, node_inv_type & info );
 
+/** Merge the replace ops of one json-patch array into another ;
+  * last writer wins per path, new paths are appended in order */
+int jsonUtil_patch_merge ( string & payload, const string & update );
+
 /** Tokenizes the json string and loads 'info' with the received token
   *
   * @param json_str_ptr
@@ -188,6 +192,48 @@ int    jsonUtil_get_key_value_int    ( struct json_object * obj, const char * ke
 bool   jsonUtil_get_key_value_bool   ( struct json_object * obj, const char * key );
 string jsonUtil_get_key_value_string ( struct json_object * obj, const char * key );
 
+/***********************************************************************
+ * Parse-once json document handle.
+ *
+ * The string based utilities above tokenize their whole input string
+ * on every call, so a caller that extracts N values from a response
+ * pays for N parses. Instead, tokenize the response once with
+ * jsonUtil_doc_parse and then walk the same object tree with the
+ * typed getters above and the object and array accessors below.
+ *
+ * Objects returned by the accessors are borrowed from the document
+ * and are only valid until it is freed. The document frees itself
+ * when it goes out of scope.
+ ***********************************************************************/
+typedef struct jsonUtil_doc_struct
+{
+    struct json_object * root ; /**< parsed document or NULL */
+
+    jsonUtil_doc_struct  ( void ) { root = (struct json_object *)(NULL) ; }
+    ~jsonUtil_doc_struct ( void ) ;
+
+    jsonUtil_doc_struct ( const jsonUtil_doc_struct & ) = delete ;
+    jsonUtil_doc_struct & operator= ( const jsonUtil_doc_struct & ) = delete ;
+} jsonUtil_doc_type ;
+
+/** Tokenize json_str_ptr into doc ; frees any previous document.
+  * Returns PASS, FAIL_NULL_POINTER or FAIL_JSON_PARSE */
+int  jsonUtil_doc_parse ( jsonUtil_doc_type & doc, const char * json_str_ptr );
+void jsonUtil_doc_free  ( jsonUtil_doc_type & doc );
+
+/** Get the object value of 'key' or NULL if not present */
+struct json_object * jsonUtil_get_key_object ( struct json_object * obj, const char * key );
+
+/** Get the array value of 'label' along with its number of elements.
+  * Returns NULL, with elements set to 0, if the label is missing or
+  * is not an array. */
+struct json_object * jsonUtil_get_array ( struct json_object * obj,
+                                          const char * label,
+                                          int & elements );
+
+/** Get element 'idx' of an array object or NULL if out of range */
+struct json_object * jsonUtil_get_array_obj ( struct json_object * array_obj, int idx );
+
 /***********************************************************************
  * Get JSON Integer Value from Key
  * return 0 if success, -1 if fail.
@@ -62,6 +62,7 @@ int msgClassAddr::initAddr(const char* address, int port, int proto)
     this->port = port;
     this->address_str = new char[strlen(address)+1];
     this->address_numeric_string = new char[INET6_ADDRSTRLEN];
+    this->numeric_stale = false;
     snprintf(this->address_str, strlen(address)+1, "%s", address);
     this->addr_any = false;
 
@@ -162,6 +163,9 @@ const char* msgClassAddr::toString() const
 
 
 /**
+ * The string is only regenerated if the sockaddr may have changed
+ * since the last call ; i.e. a message was received into it.
+ *
  * @return IP address or resolved hostname this instance was created with
  */
 const char* msgClassAddr::toNumericString() const
@@ -174,6 +178,11 @@ const char* msgClassAddr::toNumericString() const
     {
         return NULL;
     }
+    if(this->numeric_stale == false)
+    {
+        return this->address_numeric_string;
+    }
+    this->numeric_stale = false;
     switch(this->getIPVersion())
     {
     case AF_INET:
@@ -234,7 +243,8 @@ const struct sockaddr* msgClassAddr::getSockAddr() const
 
 /**
  * Non-constant accessor for sockaddr.
- * Intended to be used internally by msgClassSock
+ * Intended to be used internally by msgClassSock.
+ * The caller may change the address so the numeric string is marked stale.
  */
 struct sockaddr* msgClassAddr::getSockAddr()
 {
@@ -242,6 +252,7 @@ struct sockaddr* msgClassAddr::getSockAddr()
     {
         return NULL;
     }
+    this->numeric_stale = true;
     return this->address_info->ai_addr;
 }
 
@@ -453,6 +464,30 @@ const msgClassAddr* msgClassSock::get_dst_addr()
 
 
 /**
+ * @return binary key of the source address of the last received message
+ */
+const msgClassAddrKey& msgClassSock::get_src_key() const
+{
+    return this->src_key;
+}
+
+
+/**
+ * Loads src_key from the src_addr sockaddr ; called once per received message
+ */
+void msgClassSock::setSrcKey()
+{
+    const msgClassAddr* addr_ptr = this->src_addr ;
+    if ( addr_ptr == NULL )
+        return ;
+    msgClassAddrKey_set ( this->src_key, addr_ptr->getSockAddr());
+}
+
+
+/**
+ * The string is converted from the received address only when called ;
+ * i.e. when it is logged.
+ *
  * @return character array representation of source IP address
  */
 const char* msgClassSock::get_src_str() const
@@ -624,6 +659,10 @@ msgClassSock::~msgClassSock()
     {
         delete[] this->interface;
     }
+    delete[] this->batch_hdr;
+    delete[] this->batch_iov;
+    delete[] this->batch_src;
+    delete[] this->batch_buf;
 }
 
 
@@ -636,6 +675,16 @@ msgClassSock::msgClassSock()
     this->sock = 0;
     this->return_status = RETRY;
     this->ok = false ;
+    this->batch_hdr = NULL;
+    this->batch_iov = NULL;
+    this->batch_src = NULL;
+    this->batch_buf = NULL;
+    this->batch_len = 0;
+    this->batch_max = 0;
+    this->batch_cnt = 0;
+    this->batch_reads = 0;
+    this->batch_msgs  = 0;
+    memset(&this->src_key, 0, sizeof(this->src_key));
 }
 
 
@@ -652,9 +701,126 @@ msgClassSock::msgClassSock()
 int msgClassSock::read(char* data, int len)
 {
     socklen_t socklen = this->src_addr->getSockLen();
-    return recvfrom(this->sock, data, len, 0, this->src_addr->getSockAddr(), &socklen);
+    int bytes = recvfrom(this->sock, data, len, 0, this->src_addr->getSockAddr(), &socklen);
+    if ( bytes >= 0 )
+        setSrcKey();
+    return bytes;
 }
 
+/**
+ * Reads up to max_msgs pending messages of up to len bytes each into
+ * the socket's batch ring with a single non-blocking recvmmsg call.
+ * The ring is allocated on first use and kept for the life of the socket.
+ * Any part of a buffer beyond the received message is zeroed so a short
+ * message never carries over data from a previous one.
+ *
+ * Messages are then accessed with getBatchMsg.
+ *
+ * @param maximum size of each message
+ * @param maximum number of messages to read
+ * @return number of messages read, 0 if none are pending or -1 on error
+ */
+int msgClassSock::readBatch(int len, int max_msgs)
+{
+    int rc ;
+
+    this->batch_cnt = 0 ;
+    if (( len <= 0 ) || ( max_msgs <= 0 ))
+        return -1 ;
+
+    if ( max_msgs > MSGCLASS_BATCH_MAX )
+        max_msgs = MSGCLASS_BATCH_MAX ;
+
+    if (( this->batch_buf == NULL ) || ( len > this->batch_len ))
+    {
+        delete[] this->batch_hdr;
+        delete[] this->batch_iov;
+        delete[] this->batch_src;
+        delete[] this->batch_buf;
+
+        this->batch_max = MSGCLASS_BATCH_MAX ;
+        this->batch_len = len ;
+        this->batch_hdr = new struct mmsghdr[this->batch_max];
+        this->batch_iov = new struct iovec[this->batch_max];
+        this->batch_src = new struct sockaddr_storage[this->batch_max];
+        this->batch_buf = new char[this->batch_max*this->batch_len];
+        memset ( this->batch_buf, 0, this->batch_max*this->batch_len );
+    }
+
+    for ( int i = 0 ; i < max_msgs ; i++ )
+    {
+        this->batch_iov[i].iov_base = &this->batch_buf[i*this->batch_len] ;
+        this->batch_iov[i].iov_len  = len ;
+
+        memset ( &this->batch_hdr[i], 0, sizeof(struct mmsghdr));
+        this->batch_hdr[i].msg_hdr.msg_iov     = &this->batch_iov[i] ;
+        this->batch_hdr[i].msg_hdr.msg_iovlen  = 1 ;
+        this->batch_hdr[i].msg_hdr.msg_name    = &this->batch_src[i] ;
+        this->batch_hdr[i].msg_hdr.msg_namelen = sizeof(struct sockaddr_storage) ;
+    }
+
+    rc = recvmmsg ( this->sock, this->batch_hdr, max_msgs, MSG_DONTWAIT, NULL );
+    if ( rc < 0 )
+    {
+        if (( errno == EAGAIN ) || ( errno == EWOULDBLOCK ))
+            return 0 ;
+        return -1 ;
+    }
+
+    this->batch_reads++ ;
+    this->batch_msgs += rc ;
+    this->batch_cnt = rc ;
+
+    for ( int i = 0 ; i < rc ; i++ )
+    {
+        int bytes = this->batch_hdr[i].msg_len ;
+        if ( bytes < len )
+            memset ( &this->batch_buf[(i*this->batch_len)+bytes], 0, len-bytes );
+    }
+    return rc ;
+}
+
+
+/**
+ * Accessor for a message received by the last readBatch call.
+ * Also loads the instance's src_addr with that message's source
+ * address so get_src_addr, get_src_key and get_src_str refer to it.
+ *
+ * @param index of the message in the batch
+ * @param returns the number of bytes in the message
+ * @return pointer to the message or NULL for an invalid index
+ */
+char* msgClassSock::getBatchMsg(int index, int* len)
+{
+    if (( index < 0 ) || ( index >= this->batch_cnt ))
+    {
+        return NULL ;
+    }
+    if ( this->src_addr && this->src_addr->getSockAddr() )
+    {
+        socklen_t socklen = this->src_addr->getSockLen();
+        if ( socklen > this->batch_hdr[index].msg_hdr.msg_namelen )
+            socklen = this->batch_hdr[index].msg_hdr.msg_namelen ;
+        memcpy ( this->src_addr->getSockAddr(), &this->batch_src[index], socklen );
+        setSrcKey();
+    }
+    if ( len )
+        *len = this->batch_hdr[index].msg_len ;
+    return &this->batch_buf[index*this->batch_len] ;
+}
+
+
+/**
+ * @param returns the number of recvmmsg calls that returned messages
+ * @param returns the number of messages those calls received
+ */
+void msgClassSock::getBatchStats(unsigned long long& reads, unsigned long long& msgs) const
+{
+    reads = this->batch_reads ;
+    msgs  = this->batch_msgs  ;
+}
+
+
 /**
  * Reads a reply from the specified socket into buffer ignoring the address
  * of where it came from.
@@ -673,17 +839,16 @@ int msgClassSock::readReply(char* data, int len)
  *  the existing sockaddr.  While that would ideally always be the case,
  *  in order to preserve the existing structure, there are some cases
  *  where the port and/or address are only specified when the data is
- *  being sent.  In these cases, a new sockaddr is allocated to be
- *  used for the call to sendto.  If src_addr is set, then the source
- *  address will be that address.
+ *  being sent.  In these cases, a new sockaddr is built on the stack
+ *  to be used for the call to sendto.
  *
  *  @param data to be sent
  *  @param size of data
- *  @param destination IP address.  If none is specified, uses instance's dst_addr
+ *  @param destination address key.  If NULL, uses instance's dst_addr
  *  @param destination port.  If none is specified, uses instance's stored port
  *  @return number of bytes sent
  */
-int msgClassSock::write(const char* data, int len, const char* dst, int port)
+int msgClassSock::sendTo(const char* data, int len, const msgClassAddrKey* dst, int port)
 {
     int ret = 0 ;
     sockaddr* dst_sock_addr = this->dst_addr->getSockAddr();
@@ -693,8 +858,15 @@ int msgClassSock::write(const char* data, int len, const char* dst, int port)
 
     if((port!=0) || (dst!=NULL))
     {
-        ret = 1 ;
-        switch(this->dst_addr->getIPVersion())
+        int family = this->dst_addr->getIPVersion();
+        if (( dst != NULL ) && ( dst->family != family ))
+        {
+            char buf[INET6_ADDRSTRLEN] ;
+            wlog ("write requires address resolution; ip '%s' is not AF network family %d\n",
+                   msgClassAddrKey_str ( *dst, buf, sizeof(buf)), family );
+            return (-1);
+        }
+        switch(family)
         {
         case AF_INET:
             dst_sock_addr = (sockaddr*) &dst_addr_in;
@@ -705,7 +877,7 @@ int msgClassSock::write(const char* data, int len, const char* dst, int port)
             }
             if(dst!=NULL)
             {
-                ret = inet_pton(AF_INET, dst, &(((sockaddr_in*)dst_sock_addr)->sin_addr));
+                memcpy(&((sockaddr_in*)dst_sock_addr)->sin_addr, &dst->addr[0], sizeof(struct in_addr));
             }
             break;
         case AF_INET6:
@@ -717,16 +889,11 @@ int msgClassSock::write(const char* data, int len, const char* dst, int port)
             }
             if(dst!=NULL)
             {
-                ret = inet_pton(AF_INET6, dst, &(((sockaddr_in6*)dst_sock_addr)->sin6_addr));
+                memcpy(&((sockaddr_in6*)dst_sock_addr)->sin6_addr, &dst->addr[0], sizeof(struct in6_addr));
             }
             break;
         default:
-            slog ("invalid AF network family (%d)\n", this->dst_addr->getIPVersion());
-            return (-1);
-        }
-        if ( ret != 1 )
-        {
-            wlog ("write requires address resolution; inet_pton returned %d for ip '%s'\n", ret, dst );
+            slog ("invalid AF network family (%d)\n", family);
             return (-1);
         }
     }
@@ -740,7 +907,9 @@ int msgClassSock::write(const char* data, int len, const char* dst, int port)
 }
 
 /**
- * Given an Rx socket, send a message to the last address that a messaged has received from.
+ * Send to the instance's dst_addr or to the specified address and/or port.
+ *  A destination address string is converted to binary once and cached
+ *  for the life of the socket.
  *
  *  @param data to be sent
  *  @param size of data
@@ -748,9 +917,59 @@ int msgClassSock::write(const char* data, int len, const char* dst, int port)
  *  @param destination port.  If none is specified, uses instance's stored port
  *  @return number of bytes sent
  */
+int msgClassSock::write(const char* data, int len, const char* dst, int port)
+{
+    if ( dst == NULL )
+    {
+        return sendTo(data, len, NULL, port);
+    }
+
+    std::unordered_map<std::string, msgClassAddrKey>::iterator it =
+        this->dst_cache.find(dst);
+    if ( it != this->dst_cache.end() )
+    {
+        return sendTo(data, len, &it->second, port);
+    }
+
+    msgClassAddrKey key ;
+    if ( msgClassAddrKey_set ( key, dst ) != PASS )
+    {
+        wlog ("write requires address resolution; inet_pton failed for ip '%s'\n", dst );
+        return (-1);
+    }
+    if ( this->dst_cache.size() >= MSGCLASS_DST_CACHE_MAX )
+    {
+        this->dst_cache.clear();
+    }
+    this->dst_cache[dst] = key ;
+    return sendTo(data, len, &key, port);
+}
+
+/**
+ * Send to a destination given as a binary address key ; no string conversion.
+ *
+ *  @param data to be sent
+ *  @param size of data
+ *  @param destination address key
+ *  @param destination port.  If none is specified, uses instance's stored port
+ *  @return number of bytes sent
+ */
+int msgClassSock::write(const char* data, int len, const msgClassAddrKey& dst, int port)
+{
+    return sendTo(data, len, &dst, port);
+}
+
+/**
+ * Given an Rx socket, send a message to the last address that a messaged has received from.
+ *
+ *  @param Rx socket the message was received on
+ *  @param data to be sent
+ *  @param size of data
+ *  @return number of bytes sent
+ */
 int msgClassSock::reply(const msgClassSock* source, const char* data, int len)
 {
-    return write(data, len, source->get_src_str());
+    return sendTo(data, len, &source->get_src_key(), 0);
 }
 
 
@@ -1177,3 +1396,78 @@ int get_address_ai_family ( const char * addr_ptr )
     }
     return (ai_family) ;
 }
+
+/* FNV-1a hash over the address family and address bytes */
+static size_t _addr_key_hash ( const msgClassAddrKey & key )
+{
+    size_t hash = 2166136261u ;
+    hash = ( hash ^ key.family ) * 16777619u ;
+    for ( unsigned int i = 0 ; i < sizeof(key.addr) ; i++ )
+    {
+        hash = ( hash ^ key.addr[i] ) * 16777619u ;
+    }
+    return (hash);
+}
+
+int msgClassAddrKey_set ( msgClassAddrKey & key, const char * address )
+{
+    MEMSET_ZERO ( key );
+    if (( address == NULL ) || ( address[0] == '\0' ))
+        return ( FAIL_INVALID_IP );
+
+    if ( inet_pton ( AF_INET, address, &key.addr[0] ) == 1 )
+    {
+        key.family = AF_INET ;
+        key.hash = _addr_key_hash ( key );
+        return (PASS);
+    }
+    if ( inet_pton ( AF_INET6, address, &key.addr[0] ) == 1 )
+    {
+        key.family = AF_INET6 ;
+        key.hash = _addr_key_hash ( key );
+        return (PASS);
+    }
+    MEMSET_ZERO ( key );
+    return ( FAIL_INVALID_IP );
+}
+
+int msgClassAddrKey_set ( msgClassAddrKey & key, const struct sockaddr * sa )
+{
+    MEMSET_ZERO ( key );
+    if ( sa == NULL )
+        return ( FAIL_NO_IP_SUPPORT );
+
+    switch ( sa->sa_family )
+    {
+        case AF_INET:
+        {
+            key.family = AF_INET ;
+            memcpy ( &key.addr[0], &((const sockaddr_in*)sa)->sin_addr, sizeof(struct in_addr));
+            key.hash = _addr_key_hash ( key );
+            return (PASS);
+        }
+        case AF_INET6:
+        {
+            key.family = AF_INET6 ;
+            memcpy ( &key.addr[0], &((const sockaddr_in6*)sa)->sin6_addr, sizeof(struct in6_addr));
+            key.hash = _addr_key_hash ( key );
+            return (PASS);
+        }
+        default:
+            return ( FAIL_NO_IP_SUPPORT );
+    }
+}
+
+const char * msgClassAddrKey_str ( const msgClassAddrKey & key, char * buf, socklen_t len )
+{
+    if (( buf == NULL ) || ( len == 0 ))
+        return ("");
+
+    buf[0] = '\0' ;
+    if (( key.family != AF_INET ) && ( key.family != AF_INET6 ))
+        return (buf);
+
+    if ( inet_ntop ( key.family, &key.addr[0], buf, len ) == NULL )
+        buf[0] = '\0' ;
+    return (buf);
+}
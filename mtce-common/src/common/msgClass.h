@@ -23,6 +23,50 @@
 #include "returnCodes.h"
 #include "nodeUtil.h"
 
+#include <string>
+#include <unordered_map>
+
+
+/*
+ * The msgClassAddrKey is a compact binary representation of an IPv4 or
+ * IPv6 address that can be used as a hash table key. It allows the source
+ * address of a received message to be matched against known host addresses
+ * without converting it to, and comparing, presentation format strings.
+ */
+struct msgClassAddrKey
+{
+    sa_family_t   family ;
+    unsigned char addr[sizeof(struct in6_addr)] ;
+    size_t        hash   ; /* precomputed by msgClassAddrKey_set */
+
+    bool operator== ( const msgClassAddrKey & rhs ) const
+    {
+        return (( this->hash == rhs.hash ) &&
+                ( this->family == rhs.family ) &&
+                ( memcmp ( this->addr, rhs.addr, sizeof(this->addr)) == 0 ));
+    }
+};
+
+/* Hash functor so a msgClassAddrKey can key a std::unordered_map */
+struct msgClassAddrKeyHash
+{
+    size_t operator() ( const msgClassAddrKey & key ) const
+    {
+        return ( key.hash );
+    }
+};
+
+/* Load a msgClassAddrKey from a numeric IPv4/IPv6 address string.
+ * Returns PASS or FAIL_INVALID_IP */
+int msgClassAddrKey_set ( msgClassAddrKey & key, const char * address );
+
+/* Load a msgClassAddrKey from an AF_INET or AF_INET6 sockaddr.
+ * Returns PASS or FAIL_NO_IP_SUPPORT */
+int msgClassAddrKey_set ( msgClassAddrKey & key, const struct sockaddr * sa );
+
+/* Format a msgClassAddrKey as a numeric address string into buf.
+ * Returns buf ; empty if the key is not set */
+const char * msgClassAddrKey_str ( const msgClassAddrKey & key, char * buf, socklen_t len );
 
 /*
  * The msgClassAddr class is a version-independent representation
@@ -92,6 +136,13 @@ protected:
      */
     char* address_numeric_string;
 
+    /**
+     * Set when the sockaddr may have been changed through the non-const
+     * getSockAddr accessor ; i.e. by a receive. The numeric string is
+     * only regenerated by toNumericString when this is set.
+     */
+    mutable bool numeric_stale;
+
     /**
      * Stores the addrinfo struct created by getaddrinfo.  This contains
      * both the IP version and the sockaddr.
@@ -103,6 +154,12 @@ private:
 
 };
 
+/* Maximum number of messages received by one msgClassSock::readBatch call */
+#define MSGCLASS_BATCH_MAX (64)
+
+/* Maximum number of destination addresses cached per msgClassSock */
+#define MSGCLASS_DST_CACHE_MAX (1024)
+
 /*
  * The msgClassSock class is an abstraction of the inet sockets used
  *  by maintenance,which are not dependent on the socket protocol. This is needed
@@ -114,8 +171,12 @@ public:
     ~msgClassSock();
     int read(char* data, int len);
     int write(const char* data, int len, const char* dest=NULL, int port=0);
+    int write(const char* data, int len, const msgClassAddrKey& dest, int port=0);
     int reply(const msgClassSock* source, const char* data, int len);
     int readReply(char* data, int len);
+    int readBatch(int len, int max_msgs=MSGCLASS_BATCH_MAX);
+    char* getBatchMsg(int index, int* len);
+    void getBatchStats(unsigned long long& reads, unsigned long long& msgs) const;
     int getFD();
     int interfaceBind();
     int setPriortyMessaging( const char * iface );
@@ -124,6 +185,7 @@ public:
 
     const msgClassAddr* get_src_addr();
     const msgClassAddr* get_dst_addr();
+    const msgClassAddrKey& get_src_key() const;
     const char* get_src_str() const;
     const char* get_dst_str() const;
 
@@ -178,6 +240,37 @@ protected:
      */
     bool  ok ;
 
+    /**
+     * Batched receive ring used by readBatch. Allocated on first use
+     * and sized for batch_max messages of batch_len bytes each.
+     */
+    struct mmsghdr*          batch_hdr ;
+    struct iovec*            batch_iov ;
+    struct sockaddr_storage* batch_src ;
+    char*                    batch_buf ;
+    int                      batch_len ;
+    int                      batch_max ;
+    int                      batch_cnt ; /* messages from last readBatch */
+
+    /* readBatch syscall and message counters */
+    unsigned long long       batch_reads ;
+    unsigned long long       batch_msgs  ;
+
+    /**
+     * Binary key of the source address of the last received message.
+     * Set once per message so lookups need no string conversion.
+     */
+    msgClassAddrKey          src_key ;
+
+    /**
+     * Destination address strings given to write, already converted
+     * to binary keys, so repeat sends skip the conversion.
+     */
+    std::unordered_map<std::string, msgClassAddrKey> dst_cache ;
+
+    void setSrcKey();
+    int  sendTo(const char* data, int len, const msgClassAddrKey* dest, int port);
+
 private:
     bool createSocketUDP4();
     bool createSocketUDP6();
@@ -448,6 +448,10 @@ typedef enum
 /* dedicate more idle time in AIO ; there is less maintenance to do */
 #define MTCAGENT_AIO_SELECT_TIMEOUT (10000)
 
+/* hosts that are not runnable are still run through the fsm this
+ * often as a safety net against a missed wake-up */
+#define MTC_FSM_SWEEP_MSECS (1000)
+
 /** Number of retries maintenance will do when it experiences
  *  a REST API call failure ; any failure */
 #define REST_API_RETRY_COUNT (3)
@@ -19,6 +19,9 @@
  *
  */
 
+#include <sys/timerfd.h>     /* for ... timerfd_create, timerfd_settime */
+#include <fcntl.h>
+
 #include "daemon_common.h"
 #include "nodeBase.h"
 #include "nodeTimers.h"
@@ -35,6 +38,316 @@ static int timer_count = 0 ;
 #define MTC_TIMER_SIGNAL (SIGRTMIN + 2)
 #endif
 
+#ifdef DEBIAN_BULLSEYE
+#define MTC_TIMER_SIGNO (SIGRTMIN)
+#else
+#define MTC_TIMER_SIGNO (MTC_TIMER_SIGNAL)
+#endif
+
+/***************************************************************************
+ *
+ *                       Timer Wheel Backend
+ *
+ * A hierarchical timing wheel of MTC_TIMER_WHEEL_LEVELS levels, each with
+ * MTC_TIMER_WHEEL_SLOTS slots. A timer is filed in the lowest level that
+ * can hold its remaining ticks. Each tick processes one level 0 slot and,
+ * whenever a level wraps, cascades the next slot of the level above down.
+ *
+ * The tick is driven by a single periodic timerfd that the owning daemon
+ * services at base level through mtcTimer_wheel_service.
+ *
+ ***************************************************************************/
+
+static int                wheel_fd        = -1 ;
+static unsigned long long wheel_now       =  0 ; /* current tick count  */
+static unsigned long long wheel_pending   =  0 ; /* elapsed, not ticked */
+static bool               wheel_servicing = false ;
+static struct mtc_timer_link wheel_slot[MTC_TIMER_WHEEL_LEVELS][MTC_TIMER_WHEEL_SLOTS] ;
+
+static void _wheel_list_init ( struct mtc_timer_link * head_ptr )
+{
+    head_ptr->next  = head_ptr ;
+    head_ptr->prev  = head_ptr ;
+    head_ptr->timer = NULL ;
+}
+
+static void _wheel_unlink ( struct mtc_timer * mtcTimer_ptr )
+{
+    struct mtc_timer_link * link_ptr = &mtcTimer_ptr->link ;
+    if ( link_ptr->next )
+    {
+        link_ptr->prev->next = link_ptr->next ;
+        link_ptr->next->prev = link_ptr->prev ;
+        link_ptr->next = NULL ;
+        link_ptr->prev = NULL ;
+    }
+}
+
+static void _wheel_append ( struct mtc_timer_link * head_ptr,
+                            struct mtc_timer      * mtcTimer_ptr )
+{
+    struct mtc_timer_link * link_ptr = &mtcTimer_ptr->link ;
+    link_ptr->timer = mtcTimer_ptr ;
+    link_ptr->next  = head_ptr ;
+    link_ptr->prev  = head_ptr->prev ;
+    head_ptr->prev->next = link_ptr ;
+    head_ptr->prev = link_ptr ;
+}
+
+/* File a timer in the wheel slot for its expiry tick */
+static void _wheel_insert ( struct mtc_timer * mtcTimer_ptr )
+{
+    unsigned long long max_ticks =
+        (1ULL << (MTC_TIMER_WHEEL_SLOT_BITS*MTC_TIMER_WHEEL_LEVELS)) - 1 ;
+
+    if ( mtcTimer_ptr->expiry < wheel_now )
+        mtcTimer_ptr->expiry = wheel_now ;
+    else if ( mtcTimer_ptr->expiry - wheel_now > max_ticks )
+        mtcTimer_ptr->expiry = wheel_now + max_ticks ;
+
+    unsigned long long delta = mtcTimer_ptr->expiry - wheel_now ;
+    int level = 0 ;
+    while (( level < (MTC_TIMER_WHEEL_LEVELS-1) ) &&
+           ( delta >= (1ULL << (MTC_TIMER_WHEEL_SLOT_BITS*(level+1)))))
+    {
+        level++ ;
+    }
+    int slot = (mtcTimer_ptr->expiry >> (MTC_TIMER_WHEEL_SLOT_BITS*level)) &
+                                        (MTC_TIMER_WHEEL_SLOTS-1) ;
+
+    _wheel_append ( &wheel_slot[level][slot], mtcTimer_ptr );
+}
+
+/* Move a slot's list onto a local list head */
+static void _wheel_detach ( struct mtc_timer_link * slot_ptr,
+                            struct mtc_timer_link * list_ptr )
+{
+    _wheel_list_init ( list_ptr );
+    if ( slot_ptr->next != slot_ptr )
+    {
+        list_ptr->next = slot_ptr->next ;
+        list_ptr->prev = slot_ptr->prev ;
+        list_ptr->next->prev = list_ptr ;
+        list_ptr->prev->next = list_ptr ;
+        _wheel_list_init ( slot_ptr );
+    }
+}
+
+/* Refile all the timers of a higher level slot into lower levels */
+static void _wheel_cascade ( int level, int slot )
+{
+    struct mtc_timer_link list ;
+    _wheel_detach ( &wheel_slot[level][slot], &list );
+    while ( list.next != &list )
+    {
+        struct mtc_timer * mtcTimer_ptr = list.next->timer ;
+        _wheel_unlink ( mtcTimer_ptr );
+        _wheel_insert ( mtcTimer_ptr );
+    }
+    /* list head goes out of scope empty */
+    list.next = NULL ;
+}
+
+/* The tick the wheel would be at if every elapsed tick had been serviced.
+ *
+ * wheel_now only advances as mtcTimer_wheel_service works through the
+ * timerfd expirations so, after a long main loop pass, it lags real time.
+ * Collect any expirations the kernel has counted since the last read so
+ * that new expiry times are filed against the real current tick rather
+ * than a stale one. Those ticks are worked off by the next service call. */
+static unsigned long long _wheel_current ( void )
+{
+    uint64_t ticks = 0 ;
+    if (( wheel_fd >= 0 ) && ( read ( wheel_fd, &ticks, sizeof(ticks)) == sizeof(ticks) ))
+        wheel_pending += ticks ;
+    return ( wheel_now + wheel_pending );
+}
+
+/* Advance the wheel by one tick and dispatch what expired on it */
+static int _wheel_tick ( void )
+{
+    int expired = 0 ;
+
+    wheel_now++ ;
+
+    /* cascade down each level that wrapped */
+    unsigned long long index = wheel_now ;
+    for ( int level = 1 ; level < MTC_TIMER_WHEEL_LEVELS ; level++ )
+    {
+        if ( index & (MTC_TIMER_WHEEL_SLOTS-1) )
+            break ;
+        index >>= MTC_TIMER_WHEEL_SLOT_BITS ;
+        _wheel_cascade ( level, index & (MTC_TIMER_WHEEL_SLOTS-1));
+    }
+
+    struct mtc_timer_link list ;
+    _wheel_detach ( &wheel_slot[0][wheel_now & (MTC_TIMER_WHEEL_SLOTS-1)], &list );
+
+    /* A handler may stop or restart any timer, including ones still
+     * on this local list, so always take the next one off the head. */
+    while ( list.next != &list )
+    {
+        struct mtc_timer * mtcTimer_ptr = list.next->timer ;
+        _wheel_unlink ( mtcTimer_ptr );
+
+        /* Like the posix timer it replaces, the wheel timer is periodic
+         * until stopped ; refile it before the handler gets a chance to.
+         * Period from real time, not from this possibly catch-up tick */
+        mtcTimer_ptr->expiry = wheel_now + wheel_pending + mtcTimer_ptr->period ;
+        _wheel_insert ( mtcTimer_ptr );
+
+        siginfo_t si ;
+        memset ( &si, 0, sizeof(si));
+        si.si_signo = MTC_TIMER_SIGNO ;
+        si.si_value.sival_ptr = mtcTimer_ptr ;
+        mtcTimer_ptr->handler ( si.si_signo, &si, NULL );
+        expired++ ;
+    }
+    list.next = NULL ;
+    return (expired);
+}
+
+/* Put a validated timer request on the wheel */
+static int _wheel_start ( struct mtc_timer * mtcTimer_ptr,
+                          void (*handler)(int, siginfo_t*, void*),
+                          int secs, int msec )
+{
+    unsigned long long ticks =
+        ((((unsigned long long)secs*1000) + msec) + (MTC_TIMER_WHEEL_TICK_MSEC-1)) /
+                                                    MTC_TIMER_WHEEL_TICK_MSEC ;
+    if ( ticks == 0 )
+        ticks = 1 ;
+
+    mtcTimer_ptr->handler = handler ;
+    mtcTimer_ptr->period  = ticks ;
+    mtcTimer_ptr->expiry  = _wheel_current () + ticks ;
+    mtcTimer_ptr->secs    = secs ;
+    mtcTimer_ptr->msec    = msec ;
+    mtcTimer_ptr->wheel   = true ;
+
+    /* the tid is not a kernel timer here, just a non-null
+     * token for code that checks tid to see if it is running */
+    mtcTimer_ptr->tid     = (timer_t)mtcTimer_ptr ;
+
+    mtcTimer_ptr->_guard = 0x12345678 ;
+    mtcTimer_ptr->guard_ = 0x77654321 ;
+    mtcTimer_ptr->ring   = false ;
+    mtcTimer_ptr->active = true ;
+
+    _wheel_insert ( mtcTimer_ptr );
+    timer_count++ ;
+
+    tlog ("%s (%s) wheel timer with %d.%03d second timeout (count:%d)\n",
+              mtcTimer_ptr->hostname.c_str(),
+              mtcTimer_ptr->service.c_str(),
+              mtcTimer_ptr->secs,
+              mtcTimer_ptr->msec,
+              timer_count );
+    return (PASS);
+}
+
+static void _wheel_stop ( struct mtc_timer * mtcTimer_ptr )
+{
+    _wheel_unlink ( mtcTimer_ptr );
+    mtcTimer_ptr->wheel = false ;
+    mtcTimer_ptr->tid   = NULL  ;
+    if ( timer_count )
+        timer_count-- ;
+}
+
+int mtcTimer_wheel_init ( void )
+{
+    if ( wheel_fd >= 0 )
+        return (PASS);
+
+    for ( int level = 0 ; level < MTC_TIMER_WHEEL_LEVELS ; level++ )
+        for ( int slot = 0 ; slot < MTC_TIMER_WHEEL_SLOTS ; slot++ )
+            _wheel_list_init ( &wheel_slot[level][slot] );
+
+    int fd = timerfd_create ( CLOCK_MONOTONIC, TFD_NONBLOCK | TFD_CLOEXEC );
+    if ( fd < 0 )
+    {
+        elog ("timer wheel timerfd_create failed (%d:%s) ; using posix timers\n",
+                  errno, strerror(errno));
+        return (FAIL_TIMER_CREATE);
+    }
+
+    struct itimerspec tick ;
+    memset ( &tick, 0, sizeof(tick));
+    tick.it_value.tv_nsec    = MTC_TIMER_WHEEL_TICK_MSEC*1000000 ;
+    tick.it_interval.tv_nsec = MTC_TIMER_WHEEL_TICK_MSEC*1000000 ;
+    if ( timerfd_settime ( fd, 0, &tick, NULL ) < 0 )
+    {
+        elog ("timer wheel timerfd_settime failed (%d:%s) ; using posix timers\n",
+                  errno, strerror(errno));
+        close ( fd );
+        return (FAIL_TIMER_SET);
+    }
+    wheel_fd = fd ;
+    ilog ("timer wheel enabled ; %d msec tick (fd:%d)\n",
+              MTC_TIMER_WHEEL_TICK_MSEC, wheel_fd );
+    return (PASS);
+}
+
+/* Stop all wheel timers and release the timerfd */
+void mtcTimer_wheel_fini ( void )
+{
+    if ( wheel_fd < 0 )
+        return ;
+
+    for ( int level = 0 ; level < MTC_TIMER_WHEEL_LEVELS ; level++ )
+    {
+        for ( int slot = 0 ; slot < MTC_TIMER_WHEEL_SLOTS ; slot++ )
+        {
+            struct mtc_timer_link * head_ptr = &wheel_slot[level][slot] ;
+            while ( head_ptr->next != head_ptr )
+            {
+                struct mtc_timer * mtcTimer_ptr = head_ptr->next->timer ;
+                _wheel_stop ( mtcTimer_ptr );
+                mtcTimer_ptr->active = false ;
+            }
+        }
+    }
+    close ( wheel_fd );
+    wheel_fd = -1 ;
+    wheel_pending = 0 ;
+}
+
+int mtcTimer_wheel_fd ( void )
+{
+    return ( wheel_fd );
+}
+
+bool mtcTimer_wheel_enabled ( void )
+{
+    return ( wheel_fd >= 0 );
+}
+
+/* Advance the wheel by however many ticks elapsed since the last call.
+ * Safe to call at any time ; returns the number of timers dispatched */
+int mtcTimer_wheel_service ( void )
+{
+    int expired = 0 ;
+
+    if (( wheel_fd < 0 ) || ( wheel_servicing == true ))
+        return (0);
+
+    /* includes ticks already collected by timer starts since the last
+     * call ; the timerfd may no longer be readable for those */
+    _wheel_current ();
+
+    wheel_servicing = true ;
+    while ( wheel_pending )
+    {
+        wheel_pending-- ;
+        expired += _wheel_tick ();
+    }
+    wheel_servicing = false ;
+
+    return (expired);
+}
+
+/***************************************************************************/
 
 int _timer_start ( struct mtc_timer * mtcTimer_ptr,
                    void (*handler)(int, siginfo_t*, void*),
@@ -81,6 +394,12 @@ int _timer_start ( struct mtc_timer * mtcTimer_ptr,
         goto _timer_start_out ;
     }
 
+    if ( wheel_fd >= 0 )
+    {
+        rc = _wheel_start ( mtcTimer_ptr, handler, secs, msec );
+        goto _timer_start_out ;
+    }
+
     /* Clean the timer struct */
     memset ( &mtcTimer_ptr->sev,   0, sizeof(struct sigevent));
     memset ( &mtcTimer_ptr->value, 0, sizeof(struct itimerspec));
@@ -216,6 +535,12 @@ int _timer_stop ( struct mtc_timer * mtcTimer_ptr , bool int_safe)
         return (FAIL_NULL_POINTER);
     }
 
+    if ( mtcTimer_ptr->wheel == true )
+    {
+        _wheel_stop ( mtcTimer_ptr );
+        goto _timer_stop_out ;
+    }
+
     if ( timer_count == 0 )
     {
         if ( int_safe == false )
@@ -447,6 +772,20 @@ int _timer_stop_tid ( timer_t * tid_ptr , bool int_safe )
         stale_tid_count = timer_count ;
     }
 
+    /* A wheel timer's tid is a token pointing back at its own timer.
+     * That is safe to recognize and stop since, unlike a kernel timer,
+     * an unclaimed wheel timer would otherwise keep firing. */
+    if (( tid_ptr ) && ( *tid_ptr ))
+    {
+        struct mtc_timer * mtcTimer_ptr = (struct mtc_timer *)*tid_ptr ;
+        if (( &mtcTimer_ptr->tid == tid_ptr ) && ( mtcTimer_ptr->wheel == true ))
+        {
+            _wheel_stop ( mtcTimer_ptr );
+            mtcTimer_ptr->active = false ;
+            return (PASS);
+        }
+    }
+
 /* This defined out due to potential for segfault */
 #ifdef WANT_TIMER_STOP_BY_ID
 
@@ -536,6 +875,9 @@ void _timer_init ( struct mtc_timer * mtcTimer_ptr , string hostname, string ser
                mtcTimer_ptr->service.c_str(),
                mtcTimer_ptr->tid) ;
 
+    if ( mtcTimer_ptr->wheel == true )
+        _wheel_stop ( mtcTimer_ptr );
+
     mtcTimer_ptr->init = TIMER_INIT_SIGNATURE ;
     mtcTimer_ptr->tid  = NULL ;
     mtcTimer_ptr->secs = 0 ;
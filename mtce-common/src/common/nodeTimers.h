@@ -125,6 +125,40 @@
 
 #define TIMER_INIT_SIGNATURE (0x86752413)
 
+/** Timer wheel tick resolution and geometry ; see mtcTimer_wheel_init.
+ *  4 levels of 64 slots at a 10 msec tick span ~46 hours which covers
+ *  MAX_TIMER_DURATION. */
+#define MTC_TIMER_WHEEL_TICK_MSEC   (10)
+#define MTC_TIMER_WHEEL_LEVELS       (4)
+#define MTC_TIMER_WHEEL_SLOT_BITS    (6)
+#define MTC_TIMER_WHEEL_SLOTS        (1<<MTC_TIMER_WHEEL_SLOT_BITS)
+
+struct mtc_timer ;
+
+/** Timer wheel slot list linkage */
+struct mtc_timer_link
+{
+    struct mtc_timer_link * next  ;
+    struct mtc_timer_link * prev  ;
+    struct mtc_timer      * timer ; /**< NULL for slot list heads */
+
+    mtc_timer_link() : next(NULL), prev(NULL), timer(NULL) {}
+
+    /* a copy is never on the wheel ; only the original is linked */
+    mtc_timer_link( const mtc_timer_link & ) : next(NULL), prev(NULL), timer(NULL) {}
+    mtc_timer_link & operator= ( const mtc_timer_link & ) { return *this ; }
+
+    /* a timer freed while running unlinks itself from the wheel */
+    ~mtc_timer_link()
+    {
+        if ( next )
+        {
+            prev->next = next ;
+            next->prev = prev ;
+        }
+    }
+} ;
+
 struct mtc_timer
 {
                                 /** linux timer structs                  */
@@ -145,6 +179,13 @@ struct mtc_timer
           int        msec     ; /**< set by create parm - sub second not supported */
           string     hostname ; /**< name of the host using the timer    */
           string     service  ; /**< name of the service using the timer */
+
+                                /** timer wheel members                  */
+          bool       wheel  = false ; /**< true if running on the wheel  */
+          unsigned   period = 0     ; /**< period in wheel ticks         */
+    unsigned long long expiry = 0   ; /**< wheel tick it expires on      */
+    struct mtc_timer_link link      ; /**< wheel slot list linkage       */
+    void (*handler)(int, siginfo_t*, void*) = NULL ; /**< expiry handler */
 } ;
 
 void mtcTimer_mem_log ( void );
@@ -198,6 +239,30 @@ void mtcTimer_reset ( struct mtc_timer * mtcTimer_ptr );
 void mtcTimer_fini ( struct mtc_timer & mtcTimer );
 void mtcTimer_fini ( struct mtc_timer * mtcTimer_ptr );
 
+/***************************************************************************
+ *
+ * Timer Wheel Backend
+ *
+ * Once enabled with mtcTimer_wheel_init all subsequent timer starts are
+ * placed on a hierarchical timing wheel driven by a single timerfd rather
+ * than each creating its own signal based posix timer. Starting and
+ * stopping a timer becomes an O(1) list operation with no system calls.
+ *
+ * Expired timers are dispatched, at base level, to the handler they were
+ * started with, with si_value.sival_ptr pointing at the mtc_timer just as
+ * the posix timer signal would. The mtc_timer API is unchanged.
+ *
+ * The wheel is serviced by mtcTimer_wheel_service which is called from
+ * daemon_signal_hdlr. Daemons should also add mtcTimer_wheel_fd to their
+ * select list so timer expiry wakes the main loop.
+ *
+ ***************************************************************************/
+int  mtcTimer_wheel_init    ( void );
+void mtcTimer_wheel_fini    ( void );
+int  mtcTimer_wheel_fd      ( void );
+bool mtcTimer_wheel_enabled ( void );
+int  mtcTimer_wheel_service ( void );
+
 void mtcWait_msecs ( int millisecs );
 void mtcWait_secs  ( int secs );
 
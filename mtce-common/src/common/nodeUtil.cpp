@@ -33,7 +33,9 @@
 #include <fstream>
 #include <stdlib.h>
 #include <stdio.h>
-#include <regex>
+#include <spawn.h>          /* for ... posix_spawn                */
+#include <poll.h>           /* for ... poll                       */
+#include <signal.h>
 #include <openssl/opensslv.h>
 
 #if OPENSSL_VERSION_NUMBER >= 0x30000000L
@@ -1228,10 +1230,16 @@ bool string_contains ( string buffer, string sequence )
 static int health = NODE_HEALTH_UNKNOWN ;
 int get_node_health ( string hostname )
 {
-    struct stat p ;
-    memset ( &p, 0 , sizeof(struct stat));
-    stat ( CONFIG_PASS_FILE, &p ) ;
-    if ((p.st_ino != 0 ) && (p.st_dev != 0))
+    return ( set_node_health ( hostname,
+                               daemon_is_file_present ( CONFIG_PASS_FILE ),
+                               daemon_is_file_present ( CONFIG_FAIL_FILE )));
+}
+
+/* Update the node health from the presence of the config pass and
+ * fail files, as already known by the caller */
+int set_node_health ( string hostname, bool config_pass, bool config_fail )
+{
+    if ( config_pass )
     {
         if ( health != NODE_HEALTHY )
         {
@@ -1241,9 +1249,7 @@ int get_node_health ( string hostname )
     }
     else
     {
-       memset ( &p, 0 , sizeof(struct stat));
-       stat ( CONFIG_FAIL_FILE, &p ) ;
-       if ((p.st_ino != 0 ) && (p.st_dev != 0))
+       if ( config_fail )
        {
            if ( health != NODE_UNHEALTHY )
            {
@@ -2243,12 +2249,34 @@ void update_config_option ( const char ** config_ptr_ptr, string str2dup )
 
 static const char bar [] = { "-----------------------------------------------------------------------------------------\n"} ;
 static const char ban [] = { "Service State and Traceback -------------------------------------------------------------\n"} ;
-std::list<string>           mem_log_list ;
-std::list<string>::iterator mem_log_iter ;
+/* In-memory trace buffer ; a preallocated ring of MAX_MEM_LIST_SIZE
+ * fixed length text slots. When full the oldest entry is overwritten.
+ * Entries longer than a slot are truncated. */
+static char mem_log_ring [MAX_MEM_LIST_SIZE][MAX_MEM_LOG_LEN] ;
+static int  mem_log_head  = 0 ; /* index of the oldest entry */
+static int  mem_log_count = 0 ; /* number of entries         */
 
 void mem_log_list_init ( void )
 {
-    mem_log_list.clear();
+    mem_log_head  = 0 ;
+    mem_log_count = 0 ;
+}
+
+/* Copy 'len' bytes of 'log' into the next ring slot */
+static void _mem_log_add ( const char * log, size_t len )
+{
+    int slot = (mem_log_head + mem_log_count) % MAX_MEM_LIST_SIZE ;
+
+    if ( len > MAX_MEM_LOG_LEN-1 )
+         len = MAX_MEM_LOG_LEN-1 ;
+    memcpy ( &mem_log_ring[slot][0], log, len );
+    mem_log_ring[slot][len] = '\0' ;
+
+    /* Don't allow the in-memory list to exceed MAX_MEM_LIST_SIZE */
+    if ( mem_log_count < MAX_MEM_LIST_SIZE )
+        mem_log_count++ ;
+    else
+        mem_log_head = (mem_log_head + 1) % MAX_MEM_LIST_SIZE ;
 }
 
 /* Log a label int value and string of other data */
@@ -2276,41 +2304,19 @@ void mem_log ( string one, string two, string three )
 /* log a character string */
 void mem_log ( char * log )
 {
-    // string full_log = pt() ;
-    // full_log.append(": ");
-    string full_log = log ;
-
-    mem_log_list.push_back ( full_log ) ;
-
-    /* Don't allow the in-memory list to exceed MAX_MEM_LIST_SIZE */
-    if ( mem_log_list.size() > MAX_MEM_LIST_SIZE )
-    {
-        mem_log_list.pop_front();
-    }
+    _mem_log_add ( log, strlen(log) );
 }
 
 /* Log a single character ; typically used to add a linefeed to the trace log */
 void mem_log ( char char_log )
 {
-    string tmp = "";
-    tmp.insert(tmp.begin(),char_log) ;
-    mem_log ( tmp ); /* Call string proto */
+    _mem_log_add ( &char_log, 1 );
 }
 
 /* log a string */
 void mem_log ( string log )
 {
-    // string full_log = pt() ;
-    // full_log.append(": ");
-    string full_log = log ;
-
-    mem_log_list.push_back ( full_log ) ;
-
-    /* Don't allow the in-memory list to exceed MAX_MEM_LIST_SIZE */
-    if ( mem_log_list.size() >= MAX_MEM_LIST_SIZE )
-    {
-        mem_log_list.pop_front();
-    }
+    _mem_log_add ( log.data(), log.length() );
 }
 
 void daemon_dump_membuf_banner ( void )
@@ -2326,28 +2332,26 @@ void daemon_dump_membuf ( void )
     int i = 0 ;
     int usec_delay = 1 ;
 
-    if ( mem_log_list.empty () )
+    if ( mem_log_count == 0 )
         return ;
 
     /* as the data grows so do we have to accept loosing data over stalling process */
-    if ( mem_log_list.size() < 200 )
+    if ( mem_log_count < 200 )
         usec_delay = 99 ;
-    else if ( mem_log_list.size() < 1000 )
+    else if ( mem_log_count < 1000 )
         usec_delay = 10 ;
 
     /* Run Maintenance on Inventory */
-    for ( mem_log_iter  = mem_log_list.begin () ;
-          mem_log_iter != mem_log_list.end   () ;
-          mem_log_iter++ )
+    for ( int n = 0 ; n < mem_log_count ; n++ )
     {
         /* sleep for usec_delay every 10 logs so we don't overload syslog */
         if (( ++i % 10 ) == 0 )
         {
             usleep (usec_delay);
         }
-        syslog ( LOG_INFO, "%3d| %s", i, mem_log_iter->c_str() );
+        syslog ( LOG_INFO, "%3d| %s", i, &mem_log_ring[(mem_log_head + n) % MAX_MEM_LIST_SIZE][0] );
     }
-    mem_log_list.clear();
+    mem_log_list_init ();
 }
 
 /*****************************************************************************
@@ -2507,163 +2511,299 @@ system_state_enum get_system_state ( bool verbose )
     return system_state ;
 }
 
-/**
- * @brief Restore the stdout and stderr from copies
+/***************************************************************************
  *
- * @param stdout_copy   copy of stdout file description
- * @param stderr_copy   copy of stderr file description
- */
-static void restore_stdout_stderr(int& stdout_copy, int& stderr_copy)
+ * Name       : spawn_split_argv
+ *
+ * Description: Split a command string into its whitespace separated
+ *              arguments. Done in the parent so that the spawned child
+ *              does nothing but exec.
+ *
+ ***************************************************************************/
+
+void spawn_split_argv ( const string & cmd, vector<string> & args )
 {
-    if(stdout_copy > 0)
+    args.clear();
+    size_t i = 0 ;
+    while ( i < cmd.length() )
     {
-        dup2(stdout_copy, STDOUT_FILENO);
-        close(stdout_copy);
-    }
-    if(stderr_copy > 0)
-    {
-        dup2(stderr_copy, STDERR_FILENO);
-        close(stderr_copy);
+        while (( i < cmd.length() ) && ( isspace((unsigned char)cmd[i]) ))
+            i++ ;
+        size_t j = i ;
+        while (( j < cmd.length() ) && ( !isspace((unsigned char)cmd[j]) ))
+            j++ ;
+        if ( j > i )
+            args.push_back ( cmd.substr ( i, j-i ));
+        i = j ;
     }
 }
 
-/**
- * @brief Redirect the stdout and stderr to the
- *        output filename. store a copy of current
- *        stdout & stderr file descriptions
+/* remaining msecs before 'deadline' or -1 if there is no deadline */
+static int _spawn_remaining_msecs ( unsigned long long deadline )
+{
+    if ( deadline == 0 )
+        return (-1);
+
+    unsigned long long now = gettime_monotonic_nsec ();
+    if ( now >= deadline )
+        return (0);
+
+    return ((int)((deadline - now + 999999)/1000000));
+}
+
+/* Don't let the child inherit the calling thread's blocked signals
+ * or the daemon's ignored SIGPIPE */
+static void _spawn_attr_init ( posix_spawnattr_t & attr )
+{
+    sigset_t mask ;
+    posix_spawnattr_init ( &attr );
+    sigemptyset ( &mask );
+    posix_spawnattr_setsigmask ( &attr, &mask );
+    sigaddset ( &mask, SIGPIPE );
+    posix_spawnattr_setsigdefault ( &attr, &mask );
+    posix_spawnattr_setflags ( &attr, POSIX_SPAWN_SETSIGMASK | POSIX_SPAWN_SETSIGDEF );
+}
+
+/***************************************************************************
  *
- * @param hostname          The hostname
- * @param output_filename   out filename for stdout/stderr redirection
- * @param stdout_copy       copy of stdout file description
- * @param stderr_copy       copy of stderr file description
- */
-static void redirect_stdout_stderr(const string& hostname,
-                                   const string& output_filename,
-                                   int& stdout_copy,
-                                   int& stderr_copy)
-{
-    // default output values
-    stdout_copy = -1;
-    stderr_copy = -1;
-
-    // Open file with explicit permissions: rw-r--r-- (0644)
-    int redirect_fd = open(output_filename.c_str(),
-                           O_CREAT | O_WRONLY | O_TRUNC,
-                           S_IRUSR | S_IWUSR | S_IRGRP | S_IROTH);  // 0644
-    if ( redirect_fd < 0 )
-    {
-        elog ("%s failed to open output filename: [%s] - error code = %d (%s)",
-               hostname.c_str(),
-               output_filename.c_str(),
-               errno,
-               strerror(errno));
-        return;
-    }
+ * Name       : spawn_execv
+ *
+ * Description: Execute 'cmd' with posix_spawn and wait for it to complete.
+ *
+ * The child's stdout and stderr go to output_filename when one is given,
+ * otherwise they are captured through a pipe into 'output' when an output
+ * pointer is given, otherwise they go to /dev/null.
+ *
+ * The child is reaped without blocking so that a command that outlives
+ * timeout_secs can be killed.
+ *
+ * Returns    : PASS              - command exited with status 0
+ *              FAIL_SYSTEM_CALL  - command failed or exited non-zero
+ *              FAIL_FORK_HANDLING- command could not be spawned
+ *              FAIL_TIMEOUT      - command was killed at timeout_secs
+ *
+ *              errno is set to the spawn error on FAIL_FORK_HANDLING.
+ *
+ ***************************************************************************/
 
-    stdout_copy = dup(STDOUT_FILENO);
-    if( stdout_copy < 0 )
+int spawn_execv ( const string & hostname,
+                  const string & cmd,
+                  const string & output_filename,
+                        string * output_ptr,
+                        int      timeout_secs )
+{
+    vector<string> args ;
+    spawn_split_argv ( cmd, args );
+    if ( args.empty() )
     {
-        elog ("%s could not copy STDOUT file descriptor - error code = %d (%s)",
-               hostname.c_str(),
-               errno,
-               strerror(errno));
-        return;
+        elog ("%s cannot execute empty command", hostname.c_str());
+        return (FAIL_STRING_EMPTY);
     }
 
-    stderr_copy = dup(STDERR_FILENO);
-    if( stderr_copy < 0 )
+    vector<char*> argv ;
+    for ( size_t i = 0 ; i < args.size() ; i++ )
+        argv.push_back(const_cast<char*>(args[i].c_str()));
+    argv.push_back(NULL); // end of argument list
+
+    bool capture = ( output_filename.empty() && ( output_ptr != NULL ));
+    int  pipe_fd[2] = { -1, -1 };
+    if ( output_ptr )
+        output_ptr->clear();
+
+    if ( capture && ( pipe2 ( pipe_fd, O_CLOEXEC ) != 0 ))
     {
-        elog ("%s could not copy STDERR file descriptor - error code = %d (%s)",
-               hostname.c_str(),
-               errno,
-               strerror(errno));
-        return;
+        elog ("%s could not create output pipe (%d:%m)", hostname.c_str(), errno);
+        return (FAIL_FORK_HANDLING);
     }
 
-    if(dup2(redirect_fd, STDOUT_FILENO) < 0 )
+    /* Child file actions ; dup2 clears the close on exec flag */
+    posix_spawn_file_actions_t actions ;
+    posix_spawn_file_actions_init ( &actions );
+    if ( capture )
     {
-        elog ("%s could not redirect STDOUT file descriptor - error code = %d (%s)",
-               hostname.c_str(),
-               errno,
-               strerror(errno));
-        return;
+        posix_spawn_file_actions_adddup2 ( &actions, pipe_fd[1], STDOUT_FILENO );
+    }
+    else
+    {
+        posix_spawn_file_actions_addopen ( &actions, STDOUT_FILENO,
+            output_filename.empty() ? "/dev/null" : output_filename.c_str(),
+            O_CREAT | O_WRONLY | O_TRUNC,
+            S_IRUSR | S_IWUSR | S_IRGRP | S_IROTH);  // 0644
     }
+    posix_spawn_file_actions_adddup2 ( &actions, STDOUT_FILENO, STDERR_FILENO );
+
+    posix_spawnattr_t attr ;
+    _spawn_attr_init ( attr );
 
-    if (dup2(redirect_fd, STDERR_FILENO) < 0 )
+    pid_t child_pid = 0 ;
+    int spawn_rc = posix_spawn ( &child_pid, argv[0], &actions, &attr, &argv[0], environ );
+
+    posix_spawnattr_destroy ( &attr );
+    posix_spawn_file_actions_destroy ( &actions );
+    if ( capture )
+        close ( pipe_fd[1] );
+
+    if ( spawn_rc != 0 )
     {
-        elog ("%s could not redirect STDERR file descriptor - error code = %d (%s)",
+        if ( capture )
+            close ( pipe_fd[0] );
+        elog ("%s could not execute command '%s' - error code = %d (%s)",
                hostname.c_str(),
-               errno,
-               strerror(errno));
-        return;
+               argv[0],
+               spawn_rc,
+               strerror(spawn_rc));
+        errno = spawn_rc ;
+        return (FAIL_FORK_HANDLING);
     }
 
-    close(redirect_fd);
-}
-
-int fork_execv (const string& hostname,
-                const string& cmd,
-                const string& output_filename)
-{
-    int rc = FAIL_SYSTEM_CALL;
+    unsigned long long deadline = 0 ;
+    if ( timeout_secs > 0 )
+        deadline = gettime_monotonic_nsec () +
+                   ((unsigned long long)timeout_secs * 1000000000ULL);
 
-    pid_t child_pid = fork(); // fork child process in order to run cmd
-    switch(child_pid)
+    bool timedout = false ;
+    if ( capture )
     {
-        case -1:
-        {
-            // fork failed
-            rc = FAIL_FORK_HANDLING;
-            elog ("%s could not execute command - fork failed  - error code = %d (%s)",
-                   hostname.c_str(),
-                    errno,
-                    strerror(errno));
-            break;
-        }
-        case 0:
+        /* Drain the pipe until the child and anything it
+         * started has closed it, or until the deadline. */
+        char buffer[4096] ;
+        for ( ; ; )
         {
-            // child process
-            std::vector<char*> argv;
-            std::regex ws_re("[^\\s]+"); // whitespace
-            std::sregex_token_iterator first{cmd.begin(),
-                                             cmd.end(),
-                                             ws_re,
-                                             0};
-            std::sregex_token_iterator last;
-            std::vector<std::string> v(first,last);
-            for (const std::string& arg : v)
+            struct pollfd pfd ;
+            pfd.fd = pipe_fd[0] ;
+            pfd.events = POLLIN ;
+            pfd.revents = 0 ;
+            int msecs = _spawn_remaining_msecs ( deadline );
+            if ( msecs == 0 )
             {
-                argv.push_back(const_cast<char*>(arg.c_str()));
+                timedout = true ;
+                break ;
             }
-            argv.push_back(NULL); // end of argument list
+            int n = poll ( &pfd, 1, msecs );
+            if ( n < 0 )
             {
-                int stdout_copy = -1, stderr_copy = -1;
-                redirect_stdout_stderr(hostname,
-                                       output_filename,
-                                       stdout_copy,
-                                       stderr_copy);
-                execv(argv[0], &argv[0]);
-                restore_stdout_stderr(stdout_copy, stderr_copy);
+                if ( errno == EINTR )
+                    continue ;
+                elog ("%s output pipe poll failed (%d:%m)", hostname.c_str(), errno);
+                break ;
             }
-            /* execv returns -1 on error, and does not return on success */
-            elog ("%s could not execute command '%s' - error code = %d (%s)",
-                   hostname.c_str(),
-                   argv[0],
-                   errno,
-                   strerror(errno));
-            exit(FAIL_SYSTEM_CALL);
-        }
-        default:
-        {
-            // parent process
-            int status = 0;
-            waitpid(child_pid , &status, 0 );
-            if( WIFEXITED(status) && WEXITSTATUS(status) == PASS )
+            if ( n == 0 )
+                continue ;
+
+            ssize_t bytes = read ( pipe_fd[0], buffer, sizeof(buffer));
+            if ( bytes < 0 )
             {
-                rc = PASS;
+                if ( errno == EINTR )
+                    continue ;
+                break ;
             }
-            break;
+            if ( bytes == 0 )
+                break ; /* EOF */
+
+            if ( output_ptr->length() < SPAWN_OUTPUT_MAX_BYTES )
+                output_ptr->append ( buffer, bytes );
         }
+        close ( pipe_fd[0] );
     }
-    return (rc);
+
+    /* Reap without blocking, backing off from 1 to 50 msecs per check */
+    int status = 0 ;
+    int delay_msecs = 1 ;
+    for ( ; ; )
+    {
+        pid_t pid = waitpid ( child_pid, &status, WNOHANG );
+        if ( pid == child_pid )
+            break ;
+        if (( pid < 0 ) && ( errno != EINTR ))
+        {
+            elog ("%s waitpid for '%s' (%d) failed (%d:%m)",
+                   hostname.c_str(), argv[0], child_pid, errno );
+            return (FAIL_SYSTEM_CALL);
+        }
+        int msecs = _spawn_remaining_msecs ( deadline );
+        if (( timedout ) || ( msecs == 0 ))
+        {
+            wlog ("%s '%s' (%d) timeout after %d secs ; killing",
+                   hostname.c_str(), argv[0], child_pid, timeout_secs );
+            kill ( child_pid, SIGKILL );
+            while (( waitpid ( child_pid, &status, 0 ) < 0 ) && ( errno == EINTR )) ;
+            return (FAIL_TIMEOUT);
+        }
+        if (( msecs > 0 ) && ( delay_msecs > msecs ))
+            delay_msecs = msecs ;
+        usleep ( delay_msecs*1000 );
+        if ( delay_msecs < 50 )
+            delay_msecs *= 2 ;
+    }
+
+    if ( WIFEXITED(status) && WEXITSTATUS(status) == PASS )
+        return (PASS);
+
+    return (FAIL_SYSTEM_CALL);
+}
+
+int fork_execv (const string& hostname,
+                const string& cmd,
+                const string& output_filename)
+{
+    return ( spawn_execv ( hostname, cmd, output_filename, NULL, 0 ));
+}
+
+/***************************************************************************
+ *
+ * Name       : spawn_nowait
+ *
+ * Description: Start 'cmd' with posix_spawn, its stdout and stderr going
+ *              to /dev/null, and return without waiting for it.
+ *
+ *              The caller owns the child and must reap it with waitpid.
+ *
+ * Returns    : PASS with 'pid' set, FAIL_STRING_EMPTY or FAIL_FORK_HANDLING
+ *              with errno set to the spawn error.
+ *
+ ***************************************************************************/
+
+int spawn_nowait ( const string & hostname,
+                   const string & cmd,
+                         pid_t  & pid )
+{
+    pid = 0 ;
+    vector<string> args ;
+    spawn_split_argv ( cmd, args );
+    if ( args.empty() )
+    {
+        elog ("%s cannot execute empty command", hostname.c_str());
+        return (FAIL_STRING_EMPTY);
+    }
+
+    vector<char*> argv ;
+    for ( size_t i = 0 ; i < args.size() ; i++ )
+        argv.push_back(const_cast<char*>(args[i].c_str()));
+    argv.push_back(NULL); // end of argument list
+
+    posix_spawn_file_actions_t actions ;
+    posix_spawn_file_actions_init ( &actions );
+    posix_spawn_file_actions_addopen ( &actions, STDOUT_FILENO, "/dev/null", O_WRONLY, 0 );
+    posix_spawn_file_actions_adddup2 ( &actions, STDOUT_FILENO, STDERR_FILENO );
+
+    posix_spawnattr_t attr ;
+    _spawn_attr_init ( attr );
+
+    int spawn_rc = posix_spawn ( &pid, argv[0], &actions, &attr, &argv[0], environ );
+
+    posix_spawnattr_destroy ( &attr );
+    posix_spawn_file_actions_destroy ( &actions );
+
+    if ( spawn_rc != 0 )
+    {
+        elog ("%s could not execute command '%s' - error code = %d (%s)",
+               hostname.c_str(),
+               argv[0],
+               spawn_rc,
+               strerror(spawn_rc));
+        pid = 0 ;
+        errno = spawn_rc ;
+        return (FAIL_FORK_HANDLING);
+    }
+    return (PASS);
 }
@@ -13,6 +13,7 @@
 #include <stdio.h>
 #include <stdlib.h>
 #include <list>
+#include <vector>
 #include <evhttp.h>          /* for ... HTTP_ status definitions */
 
 using namespace std;
@@ -154,6 +155,7 @@ int  launch_force_pod_drain ( string hostname, int timeout_in_secs, char * done_
 void fork_graceful_reboot ( int delay_in_secs );
 
 int  get_node_health         ( string hostname );
+int  set_node_health         ( string hostname, bool config_pass, bool config_fail );
 int  clean_bm_response_files ( string hostname );
 int  get_pid_by_name_proc    ( string procname );
 int  get_pid_by_name_pipe    ( string procname );
@@ -195,10 +197,10 @@ system_state_enum get_system_state ( bool verbose=true );
 const char * get_system_state_str ( system_state_enum system_state );
 
 /**
- * @brief                   execute command string using fork execv
+ * @brief                   execute command string using posix_spawn
  *
  * @param hostname          The hostname
- * @param cmd               command string
+ * @param cmd               command string ; argv[0] is the full path
  * @param output_filename   output redirection file
  *                          stdout and stderr will be redirected to
  *                          this file
@@ -209,4 +211,41 @@ int fork_execv (const string& hostname,
                 const string& cmd,
                 const string& output_filename);
 
+/* cap on the command output captured by spawn_execv */
+#define SPAWN_OUTPUT_MAX_BYTES (4*1024*1024)
+
+/**
+ * @brief                   execute command string using posix_spawn
+ *                          with optional output capture and timeout
+ *
+ * @param hostname          The hostname
+ * @param cmd               command string ; split on whitespace in the
+ *                          caller, argv[0] is the full path
+ * @param output_filename   if not empty, stdout and stderr are
+ *                          redirected to this file
+ * @param output_ptr        otherwise, if not NULL, stdout and stderr
+ *                          are captured into this buffer
+ * @param timeout_secs      kill the command if it has not exited
+ *                          within this many seconds ; 0 for no timeout
+ *
+ * @return int              PASS on zero exit status,
+ *                          FAIL_TIMEOUT if killed at timeout,
+ *                          FAIL_FORK_HANDLING if it could not be spawned,
+ *                          FAIL_SYSTEM_CALL otherwise
+ */
+int spawn_execv ( const string & hostname,
+                  const string & cmd,
+                  const string & output_filename,
+                        string * output_ptr,
+                        int      timeout_secs );
+
+/* split a command string into its whitespace separated arguments */
+void spawn_split_argv ( const string & cmd, vector<string> & args );
+
+/* start cmd with its output discarded and return without waiting ;
+ * the caller reaps the returned pid */
+int spawn_nowait ( const string & hostname,
+                   const string & cmd,
+                         pid_t  & pid );
+
 #endif
@@ -1,5 +1,5 @@
 /*
- * Copyright (c) 2015-2017,2020 Wind River Systems, Inc.
+ * Copyright (c) 2015-2017,2020,2026 Wind River Systems, Inc.
 *
 * SPDX-License-Identifier: Apache-2.0
 *
@@ -8,8 +8,28 @@
  /**
   * @file
   * Wind River Titanium Cloud Maintenance Ping Utility Implementation
+  *
+  * One ICMP engine per daemon.
+  *
+  * The engine lazily opens one raw socket per address family, filtered
+  * to echo replies only. pingUtil_send queues a host's echo request and
+  * the engine sends all queued requests with one sendmmsg call when it
+  * is next serviced. The daemon services it once per main loop pass
+  * through pingUtil_service, so the requests queued by that pass of host
+  * FSMs go out together. Each pingUtil_acc_monitor or pingUtil_recv call
+  * also services the engine, which drains the reply sockets and routes
+  * each reply to its host by identity and source address, marking it
+  * received if its sequence matches the host's outstanding request.
+  *
+  * Monitor FSM waits are monotonic deadlines rounded up to a shared
+  * schedule tick, so hosts that come due together are sent together,
+  * rather than a posix timer per host.
   */
 
+#include <map>
+#include <vector>
+#include <net/if.h>          /* for ... if_nametoindex                      */
+
 #include "daemon_common.h"   /* for ... MEMSET_ZERO                         */
 #include "nodeBase.h"
 #include "nodeUtil.h"
@@ -21,19 +41,17 @@
 #endif
 #define __AREA__ "acc"
 
+/* from linux/icmp.h which conflicts with netinet/ip_icmp.h */
+#ifndef ICMP_FILTER
+#define ICMP_FILTER (1)
+#endif
+
 typedef struct
 {
     struct icmphdr hdr;
     char msg[PING_MESSAGE_LEN];
 } ping4_tx_message_type ;
 
-typedef struct
-{
-    struct iphdr ip_hdr ;
-    struct icmphdr  hdr ;
-    char msg[PING_MESSAGE_LEN];
-} ping4_rx_message_type ;
-
 typedef struct
 {
 //  struct ip6_hdr iphdr;
@@ -41,34 +59,459 @@ typedef struct
     char msg[PING_MESSAGE_LEN] ; // MSG_HEADER_SIZE];
 } ping6_tx_message_type ;
 
+/* handle a reasonable ping flood per drain */
+#define MAX_PING_FLUSH (512)
 
+/* The per daemon ICMP engine */
 typedef struct
 {
-    // struct ip6_hdr ip_hdr;
-    struct icmp6_hdr  hdr;
-    char msg[PING_MESSAGE_LEN];
-} ping6_rx_message_type ;
+    msgClassSock * sock4 ; /* shared raw sockets ; opened on first use */
+    msgClassSock * sock6 ;
+
+    /* hosts in the engine and their identity */
+    std::map<ping_info_type*, unsigned short> members ;
+
+    /* reply routing ; identity to hosts */
+    std::multimap<unsigned short, ping_info_type*> routes ;
+
+    /* hosts with a request waiting for the next batch send */
+    std::vector<ping_info_type*> send_queue ;
 
+    unsigned long long drained ; /* monotonic nsec of the last drain */
+
+    unsigned long long sent    ; /* echo requests sent               */
+    unsigned long long batches ; /* sendmmsg calls                   */
+    unsigned long long replies ; /* replies routed to a request      */
+    unsigned long long stale   ; /* replies routed with an old seq   */
+} ping_engine_type ;
+
+static ping_engine_type _engine = { NULL, NULL,
+                                    std::map<ping_info_type*, unsigned short>(),
+                                    std::multimap<unsigned short, ping_info_type*>(),
+                                    std::vector<ping_info_type*>(),
+                                    0, 0, 0, 0, 0 };
 
 /*******************************************************************************
  *
- * Name    : pingUtil_init
+ * Name    : _ping_deadline
+ *
+ * Purpose : Return the monotonic time msecs from now rounded up to the next
+ *           shared schedule tick.
+ *
+ ******************************************************************************/
+static unsigned long long _ping_deadline ( int msecs )
+{
+    const unsigned long long tick = (unsigned long long)PING_SCHEDULE_TICK_MSEC*1000000 ;
+    unsigned long long deadline = gettime_monotonic_nsec() + ((unsigned long long)msecs*1000000) ;
+    return (((deadline + tick - 1) / tick ) * tick );
+}
+
+static bool _ping_expired ( ping_info_type & ping_info )
+{
+    return ( gettime_monotonic_nsec() >= ping_info.deadline );
+}
+
+/*******************************************************************************
+ *
+ * Name    : _ping_engine_sock
+ *
+ * Purpose : Get the engine's raw socket for an address family ;
+ *           opening it on first use.
+ *
+ * Returns : the socket or NULL if it could not be opened
+ *
+ ******************************************************************************/
+static msgClassSock * _ping_engine_sock ( bool ipv6 )
+{
+    msgClassSock * & sock_ptr = ipv6 ? _engine.sock6 : _engine.sock4 ;
+    if ( sock_ptr )
+        return ( sock_ptr );
+
+    msgClassSock * new_ptr = new msgClassTx( ipv6 ? "::1" : "127.0.0.1", 0, IPPROTO_RAW, NULL, true);
+    if ( new_ptr->return_status != PASS )
+    {
+        elog ("failed to create ipv%d ping socket ; error status:%d\n",
+                  ipv6 ? 6 : 4, new_ptr->return_status );
+        delete ( new_ptr );
+        return ( NULL );
+    }
+    if ( new_ptr->setSocketNonBlocking () != PASS )
+    {
+        elog ("failed to set ipv%d ping socket to non-blocking\n", ipv6 ? 6 : 4 );
+        delete ( new_ptr );
+        return ( NULL );
+    }
+
+    /* only wake up for echo replies */
+    int rc ;
+    if ( ipv6 )
+    {
+        struct icmp6_filter filter ;
+        ICMP6_FILTER_SETBLOCKALL ( &filter );
+        ICMP6_FILTER_SETPASS ( ICMP6_ECHO_REPLY, &filter );
+        rc = setsockopt ( new_ptr->getFD(), IPPROTO_ICMPV6, ICMP6_FILTER, &filter, sizeof(filter));
+    }
+    else
+    {
+        uint32_t filter = ~(1U << ICMP_ECHOREPLY) ;
+        rc = setsockopt ( new_ptr->getFD(), SOL_RAW, ICMP_FILTER, &filter, sizeof(filter));
+    }
+    if ( rc )
+    {
+        wlog ("failed to set ipv%d ping socket echo reply filter (%d:%m)\n", ipv6 ? 6 : 4, errno );
+    }
+
+    ilog ("ipv%d ping engine socket open (fd:%d)\n", ipv6 ? 6 : 4, new_ptr->getFD());
+    sock_ptr = new_ptr ;
+    return ( sock_ptr );
+}
+
+static bool _ping_engine_member ( ping_info_type & ping_info )
+{
+    return ( _engine.members.find ( &ping_info ) != _engine.members.end() );
+}
+
+static void _ping_engine_remove ( ping_info_type & ping_info )
+{
+    std::map<ping_info_type*, unsigned short>::iterator it =
+        _engine.members.find ( &ping_info );
+    if ( it == _engine.members.end() )
+        return ;
+
+    std::pair<std::multimap<unsigned short, ping_info_type*>::iterator,
+              std::multimap<unsigned short, ping_info_type*>::iterator> range =
+        _engine.routes.equal_range ( it->second );
+    for ( std::multimap<unsigned short, ping_info_type*>::iterator route = range.first ;
+          route != range.second ; ++route )
+    {
+        if ( route->second == &ping_info )
+        {
+            _engine.routes.erase ( route );
+            break ;
+        }
+    }
+    _engine.members.erase ( it );
+
+    for ( unsigned int i = 0 ; i < _engine.send_queue.size() ; )
+    {
+        if ( _engine.send_queue[i] == &ping_info )
+            _engine.send_queue.erase ( _engine.send_queue.begin() + i );
+        else
+            i++ ;
+    }
+}
+
+static void _ping_engine_add ( ping_info_type & ping_info )
+{
+    _ping_engine_remove ( ping_info );
+    _engine.members[&ping_info] = ping_info.identity ;
+    _engine.routes.insert ( std::make_pair ( ping_info.identity, &ping_info ));
+}
+
+/*******************************************************************************
+ *
+ * Name    : _ping_engine_send_failed
+ *
+ * Purpose : Handle a queued request that could not be sent. The FSM fails
+ *           the host just as if the send had been done inline.
+ *
+ ******************************************************************************/
+static void _ping_engine_send_failed ( ping_info_type * ping_info_ptr, int error )
+{
+    wlog ("%s ping %s send failed (%d:%s)\n",
+              ping_info_ptr->hostname.c_str(),
+              ping_info_ptr->ip.c_str(),
+              error, strerror(error));
+
+    ping_info_ptr->requested = false ;
+    if ( ping_info_ptr->stage == PINGUTIL_MONITOR_STAGE__RECV )
+        ping_info_ptr->stage = PINGUTIL_MONITOR_STAGE__FAIL ;
+}
+
+/*******************************************************************************
+ *
+ * Name    : _ping_engine_flush
+ *
+ * Purpose : Send all queued echo requests ; one sendmmsg per address family
+ *           per PING_BATCH_MAX requests.
+ *
+ ******************************************************************************/
+static void _ping_engine_flush ( void )
+{
+    static ping4_tx_message_type   ping4_tx [PING_BATCH_MAX] ;
+    static ping6_tx_message_type   ping6_tx [PING_BATCH_MAX] ;
+    static struct sockaddr_storage dest     [PING_BATCH_MAX] ;
+    static struct iovec            iov      [PING_BATCH_MAX] ;
+    static struct mmsghdr          hdr      [PING_BATCH_MAX] ;
+    ping_info_type * batch [PING_BATCH_MAX] ;
+
+    for ( int family = 0 ; ( family < 2 ) && ( ! _engine.send_queue.empty()) ; family++ )
+    {
+        bool ipv6 = ( family == 1 ) ;
+        unsigned int i = 0 ;
+        while ( i < _engine.send_queue.size() )
+        {
+            /* build a batch of this family's requests */
+            int count = 0 ;
+            for ( ; ( i < _engine.send_queue.size() ) && ( count < PING_BATCH_MAX ) ; )
+            {
+                ping_info_type * ping_info_ptr = _engine.send_queue[i] ;
+                if ( ping_info_ptr->ipv6_mode != ipv6 )
+                {
+                    i++ ;
+                    continue ;
+                }
+                _engine.send_queue.erase ( _engine.send_queue.begin() + i );
+
+                MEMSET_ZERO ( dest[count] );
+                MEMSET_ZERO ( hdr[count] );
+                if ( ipv6 )
+                {
+                    ping6_tx_message_type * tx_ptr = &ping6_tx[count] ;
+                    MEMSET_ZERO (*tx_ptr);
+                    tx_ptr->icmphdr.icmp6_type = ICMP6_ECHO_REQUEST;
+                    tx_ptr->icmphdr.icmp6_code = 0;
+                    tx_ptr->icmphdr.icmp6_id   = htons(ping_info_ptr->identity) ;
+                    tx_ptr->icmphdr.icmp6_seq  = htons(ping_info_ptr->sequence) ;
+                    snprintf ( &tx_ptr->msg[0], PING_MESSAGE_LEN, "%s", ping_info_ptr->message );
+                    tx_ptr->icmphdr.icmp6_cksum = htons(checksum(tx_ptr, sizeof(*tx_ptr)));
+
+                    struct sockaddr_in6 * sa_ptr = (struct sockaddr_in6*)&dest[count] ;
+                    sa_ptr->sin6_family = AF_INET6 ;
+                    sa_ptr->sin6_scope_id = ping_info_ptr->scope_id ;
+                    memcpy ( &sa_ptr->sin6_addr, &ping_info_ptr->addr.addr[0], sizeof(struct in6_addr));
+                    hdr[count].msg_hdr.msg_namelen = sizeof(struct sockaddr_in6);
+                    iov[count].iov_base = tx_ptr ;
+                    iov[count].iov_len  = sizeof(*tx_ptr);
+                }
+                else
+                {
+                    ping4_tx_message_type * tx_ptr = &ping4_tx[count] ;
+                    MEMSET_ZERO (*tx_ptr);
+                    tx_ptr->hdr.type = ICMP_ECHO;
+                    tx_ptr->hdr.un.echo.id       = htons(ping_info_ptr->identity) ;
+                    tx_ptr->hdr.un.echo.sequence = htons(ping_info_ptr->sequence) ;
+                    snprintf ( &tx_ptr->msg[0], PING_MESSAGE_LEN, "%s", ping_info_ptr->message );
+
+                    /* checksum should not be converted to htons
+                     * - will get (wrong icmp cksum ) */
+                    tx_ptr->hdr.checksum = checksum(tx_ptr, sizeof(*tx_ptr));
+
+                    struct sockaddr_in * sa_ptr = (struct sockaddr_in*)&dest[count] ;
+                    sa_ptr->sin_family = AF_INET ;
+                    memcpy ( &sa_ptr->sin_addr, &ping_info_ptr->addr.addr[0], sizeof(struct in_addr));
+                    hdr[count].msg_hdr.msg_namelen = sizeof(struct sockaddr_in);
+                    iov[count].iov_base = tx_ptr ;
+                    iov[count].iov_len  = sizeof(*tx_ptr);
+                }
+                hdr[count].msg_hdr.msg_name   = &dest[count] ;
+                hdr[count].msg_hdr.msg_iov    = &iov[count] ;
+                hdr[count].msg_hdr.msg_iovlen = 1 ;
+                batch[count++] = ping_info_ptr ;
+            }
+            if ( count == 0 )
+                break ;
+
+            msgClassSock * sock_ptr = _ping_engine_sock ( ipv6 );
+            for ( int sent = 0 ; sent < count ; )
+            {
+                int rc = -1 ;
+                if ( sock_ptr )
+                {
+                    rc = sendmmsg ( sock_ptr->getFD(), &hdr[sent], count-sent, 0 );
+                    _engine.batches++ ;
+                }
+                if ( rc > 0 )
+                {
+                    _engine.sent += rc ;
+                    sent += rc ;
+                }
+                else
+                {
+                    /* the first request in the remaining batch failed */
+                    _ping_engine_send_failed ( batch[sent], sock_ptr ? errno : ENOTSOCK );
+                    sent++ ;
+                }
+            }
+            dlog3 ("sent %d ipv%d ping requests\n", count, ipv6 ? 6 : 4 );
+
+            /* the requests taken from the queue shifted the rest down */
+            i = 0 ;
+        }
+    }
+}
+
+/*******************************************************************************
+ *
+ * Name    : _ping_engine_route
+ *
+ * Purpose : Route an echo reply to the host it was sent to
+ *
+ ******************************************************************************/
+static void _ping_engine_route ( struct sockaddr_storage & from,
+                                 unsigned short id,
+                                 unsigned short seq )
+{
+    msgClassAddrKey key ;
+    if ( msgClassAddrKey_set ( key, (struct sockaddr*)&from ) != PASS )
+        return ;
+
+    std::pair<std::multimap<unsigned short, ping_info_type*>::iterator,
+              std::multimap<unsigned short, ping_info_type*>::iterator> range =
+        _engine.routes.equal_range ( id );
+    for ( std::multimap<unsigned short, ping_info_type*>::iterator route = range.first ;
+          route != range.second ; ++route )
+    {
+        ping_info_type * ping_info_ptr = route->second ;
+        if ( !( ping_info_ptr->addr == key ))
+            continue ;
+
+        if (( ping_info_ptr->requested == true ) && ( seq == ping_info_ptr->sequence ))
+        {
+            ping_info_ptr->received = true ;
+            _engine.replies++ ;
+        }
+        else
+        {
+            _engine.stale++ ;
+            dlog ("%s received-out-of-sequence ping response for this identity:%04x ; sequence:%04x\n",
+                      ping_info_ptr->hostname.c_str(), id, seq );
+        }
+        return ;
+    }
+    /* identity does not match a host of this daemon */
+}
+
+/*******************************************************************************
+ *
+ * Name    : _ping_engine_drain
+ *
+ * Purpose : Read and route all pending replies on the engine sockets
+ *
+ ******************************************************************************/
+static void _ping_engine_drain ( void )
+{
+    char buf [sizeof(struct iphdr)+60+sizeof(struct icmphdr)+PING_MESSAGE_LEN] ;
+    struct sockaddr_storage from ;
+
+    _engine.drained = gettime_monotonic_nsec();
+    if ( _engine.sock4 )
+    {
+        for ( int i = 0 ; i < MAX_PING_FLUSH ; i++ )
+        {
+            socklen_t len = sizeof(from);
+            int bytes = recvfrom ( _engine.sock4->getFD(), buf, sizeof(buf), 0, (struct sockaddr*)&from, &len );
+            if ( bytes <= 0 )
+                break ;
+
+            /* ipv4 raw sockets receive the ip header */
+            struct iphdr * ip_ptr = (struct iphdr*)&buf[0] ;
+            int ip_len = ip_ptr->ihl*4 ;
+            if ( bytes < ip_len + (int)sizeof(struct icmphdr))
+                continue ;
+            struct icmphdr * icmp_ptr = (struct icmphdr*)&buf[ip_len] ;
+            if ( icmp_ptr->type != ICMP_ECHOREPLY )
+                continue ;
+            _ping_engine_route ( from, ntohs(icmp_ptr->un.echo.id), ntohs(icmp_ptr->un.echo.sequence));
+        }
+    }
+    if ( _engine.sock6 )
+    {
+        for ( int i = 0 ; i < MAX_PING_FLUSH ; i++ )
+        {
+            socklen_t len = sizeof(from);
+            int bytes = recvfrom ( _engine.sock6->getFD(), buf, sizeof(buf), 0, (struct sockaddr*)&from, &len );
+            if ( bytes <= 0 )
+                break ;
+            if ( bytes < (int)sizeof(struct icmp6_hdr))
+                continue ;
+            struct icmp6_hdr * icmp_ptr = (struct icmp6_hdr*)&buf[0] ;
+            if ( icmp_ptr->icmp6_type != ICMP6_ECHO_REPLY )
+                continue ;
+            _ping_engine_route ( from, ntohs(icmp_ptr->icmp6_id), ntohs(icmp_ptr->icmp6_seq));
+        }
+    }
+}
+
+/*******************************************************************************
+ *
+ * Name    : _ping_engine_service
+ *
+ * Purpose : Send queued requests and, unless recently done, drain replies.
+ *
+ ******************************************************************************/
+static void _ping_engine_service ( bool force_drain )
+{
+    if ( ! _engine.send_queue.empty() )
+        _ping_engine_flush ();
+
+    if (( force_drain == true ) ||
+        ( gettime_monotonic_nsec() - _engine.drained >=
+          (unsigned long long)PING_DRAIN_HOLDOFF_MSEC*1000000 ))
+    {
+        _ping_engine_drain ();
+    }
+}
+
+/*******************************************************************************
+ *
+ * Name    : _ping_scope_id
+ *
+ * Purpose : Get the interface index an ipv6 address must be sent out of.
+ *
+ * Description: Only link-local addresses need one. It is taken from an
+ *              explicit '%<interface>' suffix, as getaddrinfo would, or
+ *              else is the management interface that BMCs are reached on.
+ *              The suffix is removed from 'address'.
+ *
+ ******************************************************************************/
+static unsigned int _ping_scope_id ( string & address )
+{
+    unsigned int scope_id = 0 ;
+    size_t pos = address.find('%');
+    if ( pos != string::npos )
+    {
+        string scope = address.substr ( pos+1 );
+        address.erase ( pos );
+        if (( scope_id = if_nametoindex ( scope.c_str())) == 0 )
+            scope_id = (unsigned int)atoi ( scope.c_str());
+        return (scope_id);
+    }
+
+    struct in6_addr addr6 ;
+    if (( inet_pton ( AF_INET6, address.c_str(), &addr6 ) != 1 ) ||
+        ( !IN6_IS_ADDR_LINKLOCAL ( &addr6 )))
+    {
+        return (0);
+    }
+
+    /* looked up once ; the management interface does not change */
+    static unsigned int mgmnt_scope_id = 0 ;
+    if ( mgmnt_scope_id == 0 )
+    {
+        string iface = daemon_mgmnt_iface ();
+        iface = daemon_get_iface_master ( (char*)iface.data());
+        mgmnt_scope_id = if_nametoindex ( iface.c_str());
+        ilog ("link-local ping scope is %s (index:%u)\n", iface.c_str(), mgmnt_scope_id );
+    }
+    return ( mgmnt_scope_id );
+}
+
+/*******************************************************************************
  *
- * Purpose : Setup a ping socket
+ * Name    : pingUtil_init
  *
- * Assumptions: caller initializes and installs timer handler outside of init
- *              before the monitor is called.
+ * Purpose : Add a host to the ping engine
  *
- * Returns : PASS      : non-blocking ping socket towards specified ip address setup ok
+ * Returns : PASS      : host added ; engine socket for its address family open
  *           FAIL__xxx : init failed
  *
  ******************************************************************************/
 int pingUtil_init ( string hostname, ping_info_type & ping_info, const char * ip_address )
 {
-    int rc = PASS ;
     if ( hostUtil_is_valid_ip_addr ( ip_address ) == false )
     {
-        wlog ("%s refusing to setup ping socket for invalid IP address\n", hostname.c_str());
+        wlog ("%s refusing to setup ping for invalid IP address\n", hostname.c_str());
         return (FAIL_NULL_POINTER);
     }
 
@@ -92,157 +535,73 @@ int pingUtil_init ( string hostname, ping_info_type & ping_info, const char * ip
     ping_info.fail_debounce = 0     ;
     ping_info.requested= false      ;
     ping_info.received = false      ;
-    ping_info.recv_flush_highwater=2;
     /* added for ping monitor */
     ping_info.ok       = false      ;
     ping_info.monitoring = false    ;
+    ping_info.deadline = 0          ;
     ping_info.stage = PINGUTIL_MONITOR_STAGE__OPEN ;
 
-    ping_info.sock = new msgClassTx(ip_address, 0, IPPROTO_RAW, NULL, true);
-
-    /* Validate the socket setup */
-    if ( ping_info.sock == NULL )
+    string address = ip_address ;
+    ping_info.scope_id = _ping_scope_id ( address );
+    if ( msgClassAddrKey_set ( ping_info.addr, address.c_str() ) != PASS )
     {
-        rc = FAIL_SOCKET_CREATE ;
-        elog ("%s failed to create ping socket ; null socket\n",
-                  ping_info.hostname.c_str());
+        elog ("%s failed to convert ping address '%s'\n", hostname.c_str(), ip_address );
+        return (FAIL_INVALID_IP);
     }
-    else
+    ping_info.ipv6_mode = ( ping_info.addr.family == AF_INET6 ) ;
+
+    if ( _ping_engine_sock ( ping_info.ipv6_mode ) == NULL )
     {
-        rc = ping_info.sock->return_status;
-        if ( rc != PASS )
-        {
-            elog ("%s failed to create ping socket ; error status:%d\n",
-                     ping_info.hostname.c_str(), rc );
-            rc = FAIL_SOCKET_CREATE ;
-            delete (ping_info.sock );
-            return rc;
-        }
-        else
-        {
-            if ( ( rc = ping_info.sock->setSocketNonBlocking () ) == PASS )
-            {
-                MEMSET_ZERO(ping_info.message);
-                switch ( ping_info.sock->get_dst_addr()->getIPVersion() )
-                {
-                    case AF_INET:
-                    {
-                        ping_info.ipv6_mode = false ;
-                        snprintf (&ping_info.message[0], PING_MESSAGE_LEN,
-                                  "%s ipv4 ping message from %s daemon",
-                                      ping_info.hostname.data(),
-                                      program_invocation_short_name);
-                        break ;
-                    }
-                    case AF_INET6:
-                    {
-                        ping_info.ipv6_mode = true ;
-                        snprintf (&ping_info.message[0], PING_MESSAGE_LEN,
-                                  "%s ipv6 ping message from %s daemon",
-                                      ping_info.hostname.data(),
-                                      program_invocation_short_name);
-                        break ;
-                    }
-                    default:
-                    {
-                        elog ("Unsupported IP protocol version\n");
-                        return (FAIL);
-                    }
-                }
-                dlog3 ("%s (fd:%d)\n",
-                          ping_info.message,
-                          ping_info.sock->getFD());
-            }
-            else
-            {
-                elog ("%s failed to set ping socket to non-blocking:%d\n",
-                          ping_info.hostname.c_str(), rc );
-            }
-        }
+        elog ("%s failed to create ping socket\n", ping_info.hostname.c_str());
+        return (FAIL_SOCKET_CREATE);
     }
 
-    return rc ;
-}
+    MEMSET_ZERO(ping_info.message);
+    snprintf (&ping_info.message[0], PING_MESSAGE_LEN,
+              "%s ipv%d ping message from %s daemon",
+                  ping_info.hostname.data(),
+                  ping_info.ipv6_mode ? 6 : 4,
+                  program_invocation_short_name);
 
-int pingUtil_recv_flush ( ping_info_type & ping_info, bool loud );
+    _ping_engine_add ( ping_info );
+    dlog3 ("%s (hosts:%ld)\n", ping_info.message, _engine.members.size());
+    return (PASS);
+}
 
 /*******************************************************************************
  *
  * Name    : pingUtil_send
  *
- * Purpose : Send an ICMP ECHO ping request to the specified socket
+ * Purpose : Queue an ICMP ECHO ping request for the next engine batch send
  *
- * Returns : PASS : send was ok
- *           FAIL : send failed
+ * Returns : PASS : request queued
+ *           FAIL : host is not in the engine
  *
  ******************************************************************************/
 int pingUtil_send ( ping_info_type & ping_info )
 {
-    ping4_tx_message_type ping4_tx;
-    ping6_tx_message_type ping6_tx;
-    int bytes = 0 ;
-
-
-    pingUtil_recv_flush ( ping_info, false );
-
-    if (( ping_info.sock == NULL ) || ( ping_info.sock->return_status != PASS ))
+    if ( _ping_engine_member ( ping_info ) == false )
     {
-        wlog ("%s refusing to send ping on %s socket\n",
-                  ping_info.hostname.c_str(),
-                  ping_info.sock ? "faulty" : "null" );
+        wlog ("%s refusing to send ping ; not initialized\n",
+                  ping_info.hostname.c_str());
 
         return (FAIL_NULL_POINTER);
     }
 
     ping_info.sequence++ ;
 
-    if ( ping_info.ipv6_mode == false )
-    {
-        MEMSET_ZERO (ping4_tx);
-
-        ping4_tx.hdr.type = ICMP_ECHO;
-
-        ping4_tx.hdr.un.echo.id       = htons(ping_info.identity) ;
-        ping4_tx.hdr.un.echo.sequence = htons(ping_info.sequence) ;
-
-        snprintf ( &ping4_tx.msg[0], PING_MESSAGE_LEN, "%s", ping_info.message );
-
-        /* checksum should not be converted to htons
-         * - will get (wrong icmp cksum ) */
-        ping4_tx.hdr.checksum = checksum(&ping4_tx, sizeof(ping4_tx));
-
-        dlog3 ("%s ping4 checksum: %04x\n",
-                  ping_info.hostname.c_str(),
-                  ping4_tx.hdr.checksum );
-
-        bytes = ping_info.sock->write((const char*)&ping4_tx, sizeof(ping4_tx));
-    }
-    else
+    bool queued = false ;
+    for ( unsigned int i = 0 ; i < _engine.send_queue.size() ; i++ )
     {
-        MEMSET_ZERO (ping6_tx);
-
-        ping6_tx.icmphdr.icmp6_type = ICMP6_ECHO_REQUEST;
-        ping6_tx.icmphdr.icmp6_code = 0;
-
-        ping6_tx.icmphdr.icmp6_id = htons(ping_info.identity) ;
-        ping6_tx.icmphdr.icmp6_seq = htons(ping_info.sequence) ;
-
-        snprintf ( &ping6_tx.msg[0], PING_MESSAGE_LEN, "%s", ping_info.message );
-
-        ping6_tx.icmphdr.icmp6_cksum = htons(checksum(&ping6_tx, sizeof(ping6_tx)));
-
-        dlog3 ("%s ping6 checksum: %04x\n",
-                  ping_info.hostname.c_str(),
-                  ping6_tx.icmphdr.icmp6_cksum );
-
-        bytes = ping_info.sock->write( (const char*)&ping6_tx, sizeof(ping6_tx_message_type));
+        if ( _engine.send_queue[i] == &ping_info )
+        {
+            queued = true ;
+            break ;
+        }
     }
+    if ( queued == false )
+        _engine.send_queue.push_back ( &ping_info );
 
-    if ( bytes <= 0 )
-    {
-        wlog ("%s ping %s send failed (rc:%d) (%d:%m)\n", ping_info.hostname.c_str(), ping_info.ip.c_str(), bytes, errno );
-        return FAIL ;
-    }
     if (( ping_info.monitoring == false ) &&
         ( ping_info.send_retries >= PING_MAX_SEND_RETRIES ))
     {
@@ -267,317 +626,95 @@ int pingUtil_send ( ping_info_type & ping_info )
     ping_info.received = false ;
     ping_info.requested = true ;
 
-    return PASS ;
-}
-
-/*******************************************************************************
- *
- * Name    : pingUtil_recv_flush
- *
- * Purpose : Empty the ping receiver in preparation for a fresh ping request.
- *
- * Returns : PASS : empty
- *           RETRY: not empty
- *
- ******************************************************************************/
-
-int pingUtil_recv_flush ( ping_info_type & ping_info, bool loud )
-{
-    int empty_count = 0 ;
-    int flush_count = 0 ;
-    bool exit_pass  = false ;
-
-    if ( ping_info.sock == NULL )
-        return (FAIL_NULL_POINTER);
-
-    for ( int i = 0 , bytes = 0 ; i < PING_MAX_FLUSH_RETRIES ; i++ )
-    {
-        if (  ping_info.ipv6_mode == true )
-        {
-            ping6_rx_message_type ping6_rx ;
-            MEMSET_ZERO(ping6_rx);
-            bytes = ping_info.sock->readReply( (char *)&ping6_rx, sizeof(ping6_rx_message_type));
-            if ( bytes > 0 )
-            {
-                unsigned short  id = htons(ping6_rx.hdr.icmp6_id)  ;
-                unsigned short seq = htons(ping6_rx.hdr.icmp6_seq) ;
-                flush_count++   ;
-                empty_count = 0 ;
-
-                if ( id == ping_info.identity )
-                {
-                    wlog ("%s flushed out-of-sequence ping response for my identity:%04x ; sequence:%04x (%d)\n",
-                              ping_info.hostname.c_str(), ping_info.identity, seq, flush_count );
-                }
-                else if ( loud == true )
-                {
-                    wlog ("%s flushed %d byte message identity:%04x sequence:%04x\n",
-                              ping_info.hostname.c_str(), bytes, id , seq );
-                }
-            }
-        }
-        else
-        {
-            ping4_rx_message_type  ping4_rx ;
-            MEMSET_ZERO(ping4_rx);
-            bytes = ping_info.sock->readReply( (char *)&ping4_rx, sizeof(ping4_rx_message_type));
-            if (( bytes > 0 ) && ( ping4_rx.hdr.un.echo.id != 0 ))
-            {
-                flush_count++   ;
-                empty_count = 0 ;
-                unsigned short  id = htons(ping4_rx.hdr.un.echo.id);
-                unsigned short seq = htons(ping4_rx.hdr.un.echo.sequence);
-                if ( id == ping_info.identity )
-                {
-                    wlog ("%s flushed out-of-sequence ping response for my identity:%04x ; sequence:%04x (%d)\n",
-                              ping_info.hostname.c_str(),
-                              ping_info.identity,
-                              seq,
-                              flush_count );
-                }
-                else if ( loud == true )
-                {
-                    wlog ("%s flushed %d byte message identity:%04x sequence:%04x\n",
-                              ping_info.hostname.c_str(), bytes, id, seq );
-                }
-            }
-        }
-
-        if ( bytes <= 0 )
-        {
-            if ( empty_count++ == 3 )
-            {
-                exit_pass = true ;
-                break ;
-            }
-        }
-    }
+    if ( _engine.send_queue.size() >= PING_BATCH_MAX )
+        _ping_engine_flush ();
 
-    if ( flush_count > ping_info.recv_flush_highwater )
-    {
-        ping_info.recv_flush_highwater = flush_count ;
-        dlog ("%s ping flush peak at %d\n",
-                  ping_info.hostname.c_str(),
-                  ping_info.recv_flush_highwater );
-    }
-    else if ( flush_count )
-    {
-        dlog2 ("%s ping flushed %d messages\n",
-                   ping_info.hostname.c_str(), flush_count );
-    }
-
-    if ( exit_pass == true )
-        return (PASS);
-
-    return (RETRY);
+    return PASS ;
 }
 
 /*******************************************************************************
  *
  * Name    : pingUtil_recv
  *
- * Purpose : Receive an ICMP ping response and compare the suggested sequence
- *           and identifier numbers.
+ * Purpose : Check whether the engine routed the response to the last
+ *           request to this host.
  *
  * Returns : PASS : got the response with the correct id and seq codes
- *           RETRY: got response but with one or mode bad codes
- *           FAIL : got no ping reply
+ *           RETRY: no response yet
+ *           FAIL_NULL_POINTER : host is not in the engine
  *
  ******************************************************************************/
 
-/* handle a reasonable ping flood without failing local pings */
-#define MAX_PING_FLUSH (512)
-
 int pingUtil_recv ( ping_info_type & ping_info,
                               bool   loud )  /* print log if no data received */
 {
-    int rc = FAIL ;
-    int bytes = 0 ;
-
-    if (( ping_info.requested == true ) && ( ping_info.received == true ))
-    {
-        ping_info.requested = false ;
-        return (PASS);
-    }
-
-    if ( ping_info.sock == NULL )
+    if ( _ping_engine_member ( ping_info ) == false )
         return (FAIL_NULL_POINTER);
 
-    for ( int i = 0 ; i < MAX_PING_FLUSH ; i++ )
+    _ping_engine_service ( true );
+
+    if (( ping_info.requested == true ) && ( ping_info.received == true ))
     {
-        if (  ping_info.ipv6_mode == true )
+        /* Don't print this log once we have established ping and
+         * are in monitoring mode. */
+        if ( ping_info.monitoring == false )
         {
-            ping6_rx_message_type  ping6_rx ;
-            MEMSET_ZERO(ping6_rx);
-            bytes = ping_info.sock->readReply( (char *)&ping6_rx, sizeof(ping6_rx_message_type));
-            if ( bytes > 0 )
+            /* ... only want the log when we are first connecting */
+            if ( ping_info.recv_retries )
             {
-                unsigned short  id = htons(ping6_rx.hdr.icmp6_id);
-                unsigned short seq = htons(ping6_rx.hdr.icmp6_seq);
-
-                if ( loud == true )
-                {
-                    ilog ("%s %s search ; bytes:%d ; identity:%04x (got %04x) sequence:%04x (got %04x)\n",
-                              ping_info.hostname.c_str(),
-                              ping_info.ip.c_str(), bytes,
-                              ping_info.identity, ping6_rx.hdr.icmp6_id,
-                              ping_info.sequence, ping6_rx.hdr.icmp6_seq );
-                }
-
-                if (( ping6_rx.hdr.icmp6_type == ICMP6_ECHO_REPLY ) &&
-                    ( id  == ping_info.identity ) &&
-                    ( seq == ping_info.sequence ))
-                {
-                    /* Don't print this log once we have established ping and
-                     * are in monitoring mode. */
-                    if ( ping_info.monitoring == false )
-                    {
-                        /* ... only want the log when we ar first connecting */
-                        ilog ("%s ping recv %s ok ; identity:%04x sequence:%04x (try %d) (%d)\n",
-                                  ping_info.hostname.c_str(),
-                                  ping_info.ip.c_str(),
-                                  ping_info.identity,
-                                  ping_info.sequence,
-                                  ping_info.recv_retries+1,
-                                  i);
-                    }
-                    else
-                    {
-                        /* ... only want the log when we ar first connecting */
-                        mlog ("%s ping recv %s ok ; identity:%04x sequence:%04x (try %d) (%d)\n",
-                                  ping_info.hostname.c_str(),
-                                  ping_info.ip.c_str(),
-                                  ping_info.identity,
-                                  ping_info.sequence,
-                                  ping_info.recv_retries+1,
-                                  i);
-                    }
-
-                    ping_info.requested = false ;
-                    ping_info.received  = true  ;
-                    rc = PASS ;
-                    break ;
-                }
-
-                else if ( ping6_rx.hdr.icmp6_id == ping_info.identity )
-                {
- 	 	            ilog ("%s received-out-of-sequence ping response for this identity:%04x ; sequence:%04x\n",
-                              ping_info.hostname.c_str(), id, seq);
-                     rc = RETRY ;
-                }
-                else
-                {
-                   ; /* identity is 0 or does not match this host */
-                }
+                ilog ("%s ping %s ok ; (try %d)",
+                          ping_info.hostname.c_str(),
+                          ping_info.ip.c_str(),
+                          ping_info.recv_retries+1);
             }
             else
             {
-                /* no data */
-                rc = RETRY ;
-                break ;
+                ilog ("%s ping %s ok",
+                      ping_info.hostname.c_str(),
+                      ping_info.ip.c_str());
             }
         }
         else
         {
-            ping4_rx_message_type  ping4_rx ;
-            MEMSET_ZERO(ping4_rx);
-            bytes = ping_info.sock->readReply ( (char*)&ping4_rx, sizeof(ping4_rx)) ;
-            if ( bytes > 0 )
-            {
-                unsigned short  id = htons(ping4_rx.hdr.un.echo.id);
-                unsigned short seq = htons(ping4_rx.hdr.un.echo.sequence);
-
-                // dump_memory ( &ping4_rx, 16, sizeof(ping4_rx_message_type));
-                if ( loud == true )
-                {
-                    ilog ("%s %s search ; bytes:%d ; identity:%04x (got %04x) sequence:%04x (got %04x)\n",
-                              ping_info.hostname.c_str(),
-                              ping_info.ip.c_str(), bytes,
-                              ping_info.identity, id,
-                              ping_info.sequence, seq );
-                }
-
-                if (( ping4_rx.hdr.type == ICMP_ECHOREPLY ) &&
-                    ( id  == ping_info.identity ) &&
-                    ( seq == ping_info.sequence ))
-                {
-                    /* Don't print this log once we have established ping and
-                     * are in monitoring mode. */
-                    if ( ping_info.monitoring == false )
-                    {
-                        /* ... only want the log when we are first connecting */
-                        if ( ping_info.recv_retries )
-                        {
-                            ilog ("%s ping %s ok ; (try %d)",
-                                      ping_info.hostname.c_str(),
-                                      ping_info.ip.c_str(),
-                                      ping_info.recv_retries+1);
-                        }
-                        else
-                        {
-                            ilog ("%s ping %s ok",
-                                  ping_info.hostname.c_str(),
-                                  ping_info.ip.c_str());
-                        }
-                    }
-                    else
-                    {
-                        /* ... only want the log when we ar first connecting */
-                        mlog ("%s ping recv %s ok ; identity:%04x sequence:%04x (try %d) (%d)\n",
-                                  ping_info.hostname.c_str(),
-                                  ping_info.ip.c_str(),
-                                  ping_info.identity,
-                                  ping_info.sequence,
-                                  ping_info.recv_retries+1,
-                                  i);
-                    }
-
-                    ping_info.requested = false ;
-                    ping_info.received  = true  ;
-
-                    rc = PASS ;
-                    break ;
-                }
-
-                else if ( id == ping_info.identity )
-                {
- 	 	            ilog ("%s received-out-of-sequence ping response for this identity:%04x ; sequence:%04x\n",
-                              ping_info.hostname.c_str(), id, seq );
-                    rc = RETRY ;
-                }
-                else
-                {
-                   ; /* identity is 0 or does not match this host */
-                }
-            }
-            else
-            {
-                /* no data */
-                rc = RETRY ;
-                break ;
-            }
+            mlog ("%s ping recv %s ok ; identity:%04x sequence:%04x (try %d)\n",
+                      ping_info.hostname.c_str(),
+                      ping_info.ip.c_str(),
+                      ping_info.identity,
+                      ping_info.sequence,
+                      ping_info.recv_retries+1);
         }
+        ping_info.requested = false ;
+        return (PASS);
+    }
+
+    if ( loud == true )
+    {
+        ilog ("%s %s no reply yet ; identity:%04x sequence:%04x (engine sent:%llu batches:%llu replies:%llu stale:%llu)\n",
+                  ping_info.hostname.c_str(),
+                  ping_info.ip.c_str(),
+                  ping_info.identity,
+                  ping_info.sequence,
+                  _engine.sent, _engine.batches,
+                  _engine.replies, _engine.stale );
     }
-    return rc ;
+    return (RETRY);
 }
 
 /*******************************************************************************
  *
  * Name    : pingUtil_fini
  *
- * Purpose : Close an ping socket
+ * Purpose : Remove a host from the ping engine
  *
  *******************************************************************************/
 void pingUtil_fini ( ping_info_type & ping_info )
 {
-    if ( ping_info.sock )
+    if ( _ping_engine_member ( ping_info ) )
     {
-        dlog1 ("%s ping socket close ok (fd:%d)\n",
+        _ping_engine_remove ( ping_info );
+        dlog1 ("%s ping removed from engine (hosts:%ld)\n",
                   ping_info.hostname.c_str(),
-                  ping_info.sock->getFD());
-
-        delete ( ping_info.sock );
-        ping_info.sock = NULL ;
+                  _engine.members.size());
     }
 
     ping_info.recv_retries = 0;
@@ -585,9 +722,11 @@ void pingUtil_fini ( ping_info_type & ping_info )
     ping_info.fail_debounce = 0;
     ping_info.sequence = 0;
     ping_info.identity = 0;
+    ping_info.requested = false;
+    ping_info.received = false;
 
     /* Support for ping monitor */
-    mtcTimer_reset ( ping_info.timer );
+    ping_info.deadline = 0 ;
     ping_info.stage = PINGUTIL_MONITOR_STAGE__IDLE ;
 }
 
@@ -597,11 +736,23 @@ void pingUtil_restart ( ping_info_type & ping_info )
     pingUtil_fini (ping_info);
     pingUtil_init (ping_info.hostname, ping_info, ping_info.ip.data());
 
-    mtcTimer_reset ( ping_info.timer );
-    mtcTimer_start ( ping_info.timer, ping_info.timer_handler, 1 );
+    ping_info.deadline = _ping_deadline ( 1000 );
     ping_info.stage = PINGUTIL_MONITOR_STAGE__WAIT;
 }
 
+/********************************************************************************
+ *
+ * Name    : pingUtil_service
+ *
+ * Purpose : Send queued requests and route pending replies ; see header.
+ *
+ *******************************************************************************/
+void pingUtil_service ( void )
+{
+    if ( ! _engine.members.empty() )
+        _ping_engine_service ( false );
+}
+
 /********************************************************************************
  *
  * Name    : pingUtil_acc_monitor
@@ -612,6 +763,8 @@ void pingUtil_restart ( ping_info_type & ping_info )
 
 int pingUtil_acc_monitor ( ping_info_type & ping_info )
 {
+    _ping_engine_service ( false );
+
     switch ( ping_info.stage )
     {
         /* do nothing stage */
@@ -621,14 +774,10 @@ int pingUtil_acc_monitor ( ping_info_type & ping_info )
         }
         case PINGUTIL_MONITOR_STAGE__WAIT:
         {
-            if ( mtcTimer_expired ( ping_info.timer ) )
+            if ( _ping_expired ( ping_info ) )
             {
                 ping_info.stage = PINGUTIL_MONITOR_STAGE__SEND ;
             }
-            /* Don't let the buffer fill up with pings ;
-             * keep the socket empty till we want to ping */
-            pingUtil_recv_flush ( ping_info , false );
-
             break ;
         }
         case PINGUTIL_MONITOR_STAGE__OPEN:
@@ -647,7 +796,7 @@ int pingUtil_acc_monitor ( ping_info_type & ping_info )
         }
         case PINGUTIL_MONITOR_STAGE__SEND:
         {
-            if ( ping_info.sock == NULL )
+            if ( _ping_engine_member ( ping_info ) == false )
             {
                 if (( ping_info.ip.empty()) || !ping_info.ip.compare(NONE))
                 {
@@ -688,31 +837,18 @@ int pingUtil_acc_monitor ( ping_info_type & ping_info )
             }
             else
             {
-                if ( ping_info.timer_handler == NULL )
-                {
-                    elog ("%s no timer handler installed\n", ping_info.hostname.c_str());
-                    ping_info.stage = PINGUTIL_MONITOR_STAGE__FAIL ;
-                }
-                else
-                {
-                    if ( ping_info.timer.tid )
-                    {
-                        ilog ("%s unexpected active timer\n", ping_info.hostname.c_str());
-                        mtcTimer_reset ( ping_info.timer );
-                    }
-                    mtcTimer_start_msec ( ping_info.timer, ping_info.timer_handler, PING_WAIT_TIMER_MSEC );
+                ping_info.deadline = _ping_deadline ( PING_WAIT_TIMER_MSEC );
 
-                    /* send was ok so clear its retry counter */
-                    ping_info.send_retries = 0 ;
+                /* send was queued so clear its retry counter */
+                ping_info.send_retries = 0 ;
 
-                    ping_info.stage = PINGUTIL_MONITOR_STAGE__RECV ;
-                }
+                ping_info.stage = PINGUTIL_MONITOR_STAGE__RECV ;
             }
             break ;
         }
         case PINGUTIL_MONITOR_STAGE__RECV:
         {
-            if ( mtcTimer_expired ( ping_info.timer ))
+            if ( _ping_expired ( ping_info ))
             {
                 bool loud = false ;
                 if ( daemon_get_cfg_ptr()->debug_bmgmt )
@@ -731,7 +867,7 @@ int pingUtil_acc_monitor ( ping_info_type & ping_info )
                     else
                     {
                         blog1 ("%s retrying ping\n", ping_info.hostname.c_str());
-                        mtcTimer_start_msec ( ping_info.timer, ping_info.timer_handler, PING_RETRY_DELAY_MSECS );
+                        ping_info.deadline = _ping_deadline ( PING_RETRY_DELAY_MSECS );
                     }
                 }
                 else
@@ -750,7 +886,7 @@ int pingUtil_acc_monitor ( ping_info_type & ping_info )
                     ping_info.send_retries = 0 ;
                     ping_info.recv_retries = 0 ;
                     ping_info.fail_debounce = 0 ;
-                    mtcTimer_start ( ping_info.timer, ping_info.timer_handler, interval );
+                    ping_info.deadline = _ping_deadline ( interval*1000 );
                     ping_info.stage = PINGUTIL_MONITOR_STAGE__WAIT ;
                 }
             }
@@ -785,8 +921,7 @@ int pingUtil_acc_monitor ( ping_info_type & ping_info )
                 pingUtil_fini (ping_info);
                 pingUtil_init (ping_info.hostname, ping_info, ping_info.ip.data());
             }
-            mtcTimer_reset ( ping_info.timer );
-            mtcTimer_start ( ping_info.timer, ping_info.timer_handler, PING_FAIL_RETRY_DELAY );
+            ping_info.deadline = _ping_deadline ( PING_FAIL_RETRY_DELAY*1000 );
             ping_info.stage = PINGUTIL_MONITOR_STAGE__WAIT;
             break ;
         }
@@ -796,7 +931,6 @@ int pingUtil_acc_monitor ( ping_info_type & ping_info )
 
             /* Default to check the connection.
              * Failure case is handled there */
-            mtcTimer_reset ( ping_info.timer );
 
             ping_info.stage = PINGUTIL_MONITOR_STAGE__FAIL ;
         }
@@ -807,6 +941,7 @@ int pingUtil_acc_monitor ( ping_info_type & ping_info )
 
 
 
+
 #ifdef WANT_MAIN
 /*--------------------------------------------------------------------*/
 /*--- main - look up host and start ping processes.                ---*/
@@ -11,6 +11,12 @@
  /**
   * @file
   * Wind River Titanium Cloud Maintenance Ping Utility Header
+  *
+  * All the hosts a daemon pings share one ICMP engine that owns a single
+  * raw socket per address family. Echo requests are queued and sent in
+  * batches ; replies are routed back to each host's ping_info by identity,
+  * source address and sequence. A host's ping_info is that host's entry
+  * in the engine along with its monitor FSM state.
   */
 
 #include <stdio.h>
@@ -51,6 +57,10 @@ using namespace std;
 #define PING_FAIL_DEBOUNCE_THLD   (3)
 #define PING_MESSAGE_LEN         (80)
 
+#define PING_BATCH_MAX           (64)   /* echo requests per sendmmsg     */
+#define PING_SCHEDULE_TICK_MSEC (100)   /* shared monitor schedule period */
+#define PING_DRAIN_HOLDOFF_MSEC  (10)   /* min time between reply drains  */
+
 typedef enum
 {
     PINGUTIL_MONITOR_STAGE__IDLE = 0,
@@ -67,7 +77,8 @@ typedef struct
 {
     string hostname         ;
     string ip               ;
-    msgClassSock * sock     ;
+    msgClassAddrKey addr    ; /* binary ip ; engine send and routing key */
+    unsigned int scope_id   ; /* ipv6 interface index for link-local addr */
 
     unsigned short identity ;
     unsigned short sequence ;
@@ -77,13 +88,11 @@ typedef struct
     bool   ipv6_mode        ;
     bool   received         ;
     bool   requested        ;
-    int recv_flush_highwater;
     /* for monitor FSM */
     bool                ok    ;
     bool           monitoring ;
     pingUtil_stage_type stage ;
-    struct mtc_timer    timer ;
-    void (*timer_handler) ( int, siginfo_t*, void* );
+    unsigned long long deadline ; /* monotonic nsec the stage wait ends */
     char message [PING_MESSAGE_LEN];
 } ping_info_type ;
 
@@ -91,10 +100,10 @@ typedef struct
  *
  * Name    : pingUtil_init
  *
- * Purpose : Setup a ping socket
+ * Purpose : Add a host to the ping engine
  *
- * Returns : PASS : non-blocking ping socket towards specified ip address setup ok
- *           FAIL : send failed
+ * Returns : PASS : host added ; the engine socket for its address family is open
+ *           FAIL : init failed
  *
  ******************************************************************************/
 int pingUtil_init ( string hostname, ping_info_type & ping_info, const char * ip_address );
@@ -103,9 +112,9 @@ int pingUtil_init ( string hostname, ping_info_type & ping_info, const char * ip
  *
  * Name    : pingUtil_send
  *
- * Purpose : Send an ICMP ECHO ping request to the specified socket
+ * Purpose : Queue an ICMP ECHO ping request for the next engine batch send
  *
- * Returns : PASS : send was ok
+ * Returns : PASS : request queued
  *           FAIL : send failed
  *
  ******************************************************************************/
@@ -116,12 +125,12 @@ int pingUtil_send ( ping_info_type & ping_info );
  *
  * Name    : pingUtil_recv
  *
- * Purpose : Receive an ICMP ping response and compare the suggested sequence
- *           and identifier numbers.
+ * Purpose : Check whether the engine routed the response to the last
+ *           request to this host.
  *
  * Returns : PASS : got the response with the correct id and seq codes
- *           RETRY: got response but with one or mode bad codes
- *           FAIL : got no ping reply
+ *           RETRY: no response yet
+ *           FAIL_NULL_POINTER : host is not in the engine
  *
  ********************************************************************************/
 
@@ -132,10 +141,11 @@ int pingUtil_recv ( ping_info_type & ping_info, /* sequence in the ping request
  *
  * Name    : pingUtil_fini
  *
- * Purpose : Close an ping socket
+ * Purpose : Remove a host from the ping engine. Must be called before
+ *           the ping_info is freed.
  *
  *******************************************************************************/
-void pingUtil_fini ( ping_info_type & ping_info ); /* the preopened ping socket */
+void pingUtil_fini ( ping_info_type & ping_info );
 
 /********************************************************************************
  *
@@ -147,6 +157,19 @@ void pingUtil_fini ( ping_info_type & ping_info ); /* the preopened ping socket
 
 int pingUtil_acc_monitor ( ping_info_type & ping_info );
 
+/********************************************************************************
+ *
+ * Name    : pingUtil_service
+ *
+ * Purpose : Send the echo requests queued by this pass of host FSMs and
+ *           route any pending replies. Called once per daemon main loop
+ *           pass so a queued request does not wait for its host's next
+ *           FSM run to go out.
+ *
+ *******************************************************************************/
+
+void pingUtil_service ( void );
+
 /********************************************************************************
  *
  * Name    : pingUtil_restart
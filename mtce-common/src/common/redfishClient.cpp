@@ -0,0 +1,1021 @@
+/*
+ * Copyright (c) 2026 Wind River Systems, Inc.
+*
+* SPDX-License-Identifier: Apache-2.0
+*
+ *
+ *
+ * @file
+ * Starling-X Common In-Process Redfish Client
+ *
+ * Replaces the fork/exec of redfishtool, and the password and output
+ * files that go with it, with a libevent http client that runs in the
+ * calling bmc thread and returns the response body in memory.
+ *
+ * Each host gets a cached session that carries
+ *
+ *  - a dedicated event base and keep-alive evhttp connection (https by
+ *    default, as redfishtool is run with '-S Always'),
+ *  - the X-Auth-Token of a Redfish session created on first use, with
+ *    a fallback to basic authentication for BMCs that refuse sessions,
+ *  - the Systems/Chassis resource paths learned on the first walk of
+ *    the service tree.
+ *
+ * A session is only ever used by the one bmc thread running for its
+ * host, so the mutex only protects the session map itself.
+ */
+
+#include <stdio.h>
+#include <string.h>
+#include <pthread.h>
+#include <sys/syscall.h>              /* for ... SYS_gettid                */
+#include <map>
+#include <openssl/ssl.h>              /* for ... SSL_CTX_new, SSL_new      */
+#include <openssl/evp.h>              /* for ... EVP_EncodeBlock           */
+#include <event2/event.h>             /* for ... event_base_new            */
+#include <event2/http.h>              /* for ... evhttp_connection ...     */
+#include <event2/buffer.h>            /* for ... evbuffer_copyout          */
+#include <event2/bufferevent.h>       /* for ... bufferevent_free          */
+#include <event2/bufferevent_ssl.h>   /* for ... bufferevent_openssl_...   */
+#include <event2/keyvalq_struct.h>    /* for ... evkeyvalq                 */
+
+using namespace std;
+
+#include "nodeBase.h"      /* for ... mtce node common definitions     */
+#include "nodeUtil.h"      /* for ... itos                             */
+#include "jsonUtil.h"      /* for ... jsonUtil_doc_parse               */
+#include "redfishUtil.h"   /* for ... REDFISHTOOL_xxx_CMD strings      */
+#include "redfishClient.h" /* for ... this module header               */
+#include "flightRecorder.h" /* for ... flightRecorder_log              */
+
+typedef struct
+{
+    string hostname ;
+
+    /* connection */
+    string bm_ip      ; /* provisioned address the session was built for */
+    string address    ; /* address portion of bm_ip                       */
+    string host_hdr   ; /* Host header value                              */
+    bool   https      ;
+    int    port       ;
+    struct event_base        * base ;
+    struct evhttp_connection * conn ;
+    bool   conn_closed ; /* set by the close callback ; rebuild on next use */
+    bool   conn_used   ; /* at least one response received on this conn     */
+
+    /* authentication */
+    string bm_un       ;
+    string bm_pw       ;
+    string token       ; /* X-Auth-Token of the current session            */
+    string session_uri ; /* Location of the current session ; for logout    */
+    bool   basic_auth  ; /* BMC refused a session ; use basic auth          */
+
+    /* learned resource paths */
+    string system_uri  ;
+    string reset_uri   ;
+    string power_uri   ;
+    string thermal_uri ;
+
+    /* ownership */
+    bool   busy    ; /* in use by a bmc thread                          */
+    bool   discard ; /* closed while busy ; free when the thread is done */
+
+    /* stats */
+    unsigned int requests ;
+    unsigned int connects ;
+    unsigned int logins   ;
+} redfishClient_session_type ;
+
+typedef struct
+{
+    struct event_base * base ;
+    bool   done     ;
+    int    status   ; /* http status code ; 0 = no response */
+    string body     ;
+    string token    ;
+    string location ;
+} redfishClient_response_type ;
+
+static pthread_mutex_t _sessions_mutex = PTHREAD_MUTEX_INITIALIZER ;
+static std::map<string, redfishClient_session_type *> _sessions ;
+static SSL_CTX * _ssl_ctx = (SSL_CTX *)(NULL) ;
+
+/*************************************************************************
+ *
+ * Name       : redfishClient_selected
+ *
+ * Description: Look for this host in the mtc.conf [agent]
+ *              redfish_native_hosts list ; 'none', 'all' or a comma
+ *              separated list of hostnames.
+ *
+ *************************************************************************/
+
+bool redfishClient_selected ( const string & hostname )
+{
+    const char * hosts = daemon_get_cfg_ptr()->redfish_native_hosts ;
+    if (( hosts == NULL ) || ( hosts[0] == '\0' ))
+        return (false);
+
+    string host_list = hosts ;
+    if ( host_list == REDFISH_CLIENT_HOSTS__NONE )
+        return (false);
+    if ( host_list == REDFISH_CLIENT_HOSTS__ALL )
+        return (true);
+
+    size_t start = host_list.find_first_not_of(", \t");
+    while ( start != string::npos )
+    {
+        size_t end = host_list.find_first_of(", \t", start);
+        if ( host_list.compare ( start,
+                                 (end == string::npos) ? string::npos : end-start,
+                                 hostname ) == 0 )
+        {
+            return (true);
+        }
+        start = host_list.find_first_not_of(", \t", end);
+    }
+    return (false);
+}
+
+/*************************************************************************
+ *
+ * Session map management
+ *
+ *************************************************************************/
+
+static void _session_disconnect ( redfishClient_session_type * session_ptr )
+{
+    if ( session_ptr->conn )
+    {
+        /* frees the bufferevent and with it the SSL object */
+        evhttp_connection_free ( session_ptr->conn );
+        session_ptr->conn = (struct evhttp_connection *)(NULL) ;
+    }
+    session_ptr->conn_closed = false ;
+    session_ptr->conn_used   = false ;
+}
+
+static void _session_free ( redfishClient_session_type * session_ptr )
+{
+    _session_disconnect ( session_ptr );
+    if ( session_ptr->base )
+    {
+        event_base_free ( session_ptr->base );
+    }
+    delete session_ptr ;
+}
+
+static redfishClient_session_type * _session_get ( const string & hostname )
+{
+    redfishClient_session_type * session_ptr = (redfishClient_session_type *)(NULL) ;
+
+    pthread_mutex_lock ( &_sessions_mutex );
+
+    if ( _ssl_ctx == NULL )
+    {
+        /* BMCs present self signed certificates ; like redfishtool
+         * the certificate is not verified */
+        _ssl_ctx = SSL_CTX_new ( TLS_client_method() );
+        if ( _ssl_ctx )
+            SSL_CTX_set_verify ( _ssl_ctx, SSL_VERIFY_NONE, NULL );
+    }
+
+    std::map<string, redfishClient_session_type *>::iterator it = _sessions.find(hostname);
+    if ( it != _sessions.end() )
+    {
+        if ( it->second->busy )
+        {
+            /* The last thread to use this session never returned it ;
+             * it was cancelled mid request. Its connection state can't
+             * be trusted so abandon it rather than reuse it. Like a
+             * close, the thread frees it if it ever completes. */
+            wlog_t ("%s abandoning redfish session held by a cancelled thread",
+                        hostname.c_str());
+            it->second->discard = true ;
+            _sessions.erase ( it );
+        }
+        else
+        {
+            session_ptr = it->second ;
+        }
+    }
+    if ( session_ptr == NULL )
+    {
+        session_ptr = new redfishClient_session_type ;
+        session_ptr->hostname    = hostname ;
+        session_ptr->https       = true ;
+        session_ptr->port        = REDFISH_CLIENT_HTTPS_PORT ;
+        session_ptr->base        = (struct event_base *)(NULL) ;
+        session_ptr->conn        = (struct evhttp_connection *)(NULL) ;
+        session_ptr->conn_closed = false ;
+        session_ptr->conn_used   = false ;
+        session_ptr->basic_auth  = false ;
+        session_ptr->busy        = false ;
+        session_ptr->discard     = false ;
+        session_ptr->requests    = 0 ;
+        session_ptr->connects    = 0 ;
+        session_ptr->logins      = 0 ;
+        _sessions[hostname] = session_ptr ;
+    }
+    session_ptr->busy = true ;
+
+    pthread_mutex_unlock ( &_sessions_mutex );
+    return (session_ptr);
+}
+
+static void _session_put ( redfishClient_session_type * session_ptr )
+{
+    pthread_mutex_lock ( &_sessions_mutex );
+    session_ptr->busy = false ;
+    bool discard = session_ptr->discard ;
+    pthread_mutex_unlock ( &_sessions_mutex );
+
+    if ( discard )
+    {
+        _session_free ( session_ptr );
+    }
+}
+
+void redfishClient_close ( const string & hostname )
+{
+    redfishClient_session_type * session_ptr = (redfishClient_session_type *)(NULL) ;
+
+    pthread_mutex_lock ( &_sessions_mutex );
+    std::map<string, redfishClient_session_type *>::iterator it = _sessions.find(hostname);
+    if ( it != _sessions.end() )
+    {
+        if ( it->second->busy )
+        {
+            /* the thread frees it when its request completes */
+            it->second->discard = true ;
+        }
+        else
+        {
+            session_ptr = it->second ;
+        }
+        _sessions.erase ( it );
+    }
+    pthread_mutex_unlock ( &_sessions_mutex );
+
+    if ( session_ptr )
+    {
+        dlog ("%s redfish session closed (requests:%u connects:%u logins:%u)",
+                  hostname.c_str(),
+                  session_ptr->requests,
+                  session_ptr->connects,
+                  session_ptr->logins);
+        _session_free ( session_ptr );
+    }
+}
+
+/*************************************************************************
+ *
+ * Name       : _session_address
+ *
+ * Description: Load the address, port and scheme from the provisioned
+ *              bm_ip ; a bare IPv4 or IPv6 address defaults to https.
+ *
+ *************************************************************************/
+
+static void _session_address ( redfishClient_session_type * session_ptr,
+                               const string & bm_ip )
+{
+    string addr = bm_ip ;
+
+    session_ptr->bm_ip = bm_ip ;
+    session_ptr->https = true ;
+    session_ptr->port  = REDFISH_CLIENT_HTTPS_PORT ;
+
+    if ( addr.compare ( 0, 8, "https://" ) == 0 )
+    {
+        addr.erase ( 0, 8 );
+    }
+    else if ( addr.compare ( 0, 7, "http://" ) == 0 )
+    {
+        addr.erase ( 0, 7 );
+        session_ptr->https = false ;
+        session_ptr->port  = REDFISH_CLIENT_HTTP_PORT ;
+    }
+
+    bool ipv6 = false ;
+    if (( !addr.empty() ) && ( addr[0] == '[' ))
+    {
+        /* bracketed ipv6 with an optional port */
+        size_t close = addr.find(']');
+        session_ptr->address = addr.substr ( 1, (close == string::npos) ? string::npos : close-1 );
+        if (( close != string::npos ) && ( addr.compare ( close+1, 1, ":" ) == 0 ))
+            session_ptr->port = atoi ( addr.substr(close+2).data() );
+        ipv6 = true ;
+    }
+    else if (( addr.find(':') != string::npos ) && ( addr.find(':') == addr.rfind(':')))
+    {
+        /* ipv4 or name with port */
+        session_ptr->address = addr.substr ( 0, addr.find(':') );
+        session_ptr->port    = atoi ( addr.substr(addr.find(':')+1).data() );
+    }
+    else
+    {
+        session_ptr->address = addr ;
+        ipv6 = ( addr.find(':') != string::npos ) ;
+    }
+
+    session_ptr->host_hdr = ipv6 ? "[" + session_ptr->address + "]" : session_ptr->address ;
+    if ((  session_ptr->https && ( session_ptr->port != REDFISH_CLIENT_HTTPS_PORT )) ||
+        ( !session_ptr->https && ( session_ptr->port != REDFISH_CLIENT_HTTP_PORT )))
+    {
+        session_ptr->host_hdr.append(":");
+        session_ptr->host_hdr.append(itos(session_ptr->port));
+    }
+}
+
+/*************************************************************************
+ *
+ * Connection management
+ *
+ *************************************************************************/
+
+static void _connection_closed ( struct evhttp_connection * conn, void * arg )
+{
+    UNUSED(conn);
+
+    /* evhttp would otherwise try to reconnect this connection with the
+     * spent SSL object ; flag it to be rebuilt before the next request */
+    ((redfishClient_session_type *)arg)->conn_closed = true ;
+}
+
+static int _session_connect ( redfishClient_session_type * session_ptr )
+{
+    struct bufferevent * bev = (struct bufferevent *)(NULL) ;
+
+    _session_disconnect ( session_ptr );
+
+    if ( session_ptr->base == NULL )
+    {
+        session_ptr->base = event_base_new();
+        if ( session_ptr->base == NULL )
+        {
+            elog_t ("%s failed to create redfish event base",
+                        session_ptr->hostname.c_str());
+            return (FAIL_EVENT_BASE);
+        }
+    }
+
+    if ( session_ptr->https )
+    {
+        SSL * ssl = _ssl_ctx ? SSL_new ( _ssl_ctx ) : (SSL *)(NULL) ;
+        if ( ssl == NULL )
+        {
+            elog_t ("%s failed to create redfish ssl object",
+                        session_ptr->hostname.c_str());
+            return (FAIL_CONNECT);
+        }
+        bev = bufferevent_openssl_socket_new ( session_ptr->base, -1, ssl,
+                                               BUFFEREVENT_SSL_CONNECTING,
+                                               BEV_OPT_CLOSE_ON_FREE |
+                                               BEV_OPT_DEFER_CALLBACKS );
+        if ( bev == NULL )
+        {
+            SSL_free ( ssl );
+            elog_t ("%s failed to create redfish ssl bufferevent",
+                        session_ptr->hostname.c_str());
+            return (FAIL_CONNECT);
+        }
+        /* many BMCs close without a TLS close_notify */
+        bufferevent_openssl_set_allow_dirty_shutdown ( bev, 1 );
+    }
+
+    /* a NULL bufferevent lets evhttp create a plain socket one */
+    session_ptr->conn =
+    evhttp_connection_base_bufferevent_new ( session_ptr->base, NULL, bev,
+                                             session_ptr->address.c_str(),
+                                             session_ptr->port );
+    if ( session_ptr->conn == NULL )
+    {
+        if ( bev )
+            bufferevent_free ( bev );
+        elog_t ("%s failed to create redfish connection to %s:%d",
+                    session_ptr->hostname.c_str(),
+                    session_ptr->address.c_str(),
+                    session_ptr->port);
+        return (FAIL_CONNECT);
+    }
+
+    evhttp_connection_set_timeout ( session_ptr->conn, REDFISH_CLIENT_TIMEOUT_SECS );
+    evhttp_connection_set_retries ( session_ptr->conn, 0 );
+    evhttp_connection_set_closecb ( session_ptr->conn, _connection_closed, session_ptr );
+
+    session_ptr->connects++ ;
+    blog1_t ("%s redfish %s connection to %s:%d (connects:%u)",
+                 session_ptr->hostname.c_str(),
+                 session_ptr->https ? "https" : "http",
+                 session_ptr->address.c_str(),
+                 session_ptr->port,
+                 session_ptr->connects);
+    return (PASS);
+}
+
+/*************************************************************************
+ *
+ * Request handling
+ *
+ *************************************************************************/
+
+static void _response_handler ( struct evhttp_request * req, void * arg )
+{
+    redfishClient_response_type * resp_ptr = (redfishClient_response_type *)arg ;
+
+    resp_ptr->done = true ;
+    if ( req )
+    {
+        resp_ptr->status = evhttp_request_get_response_code ( req );
+
+        struct evbuffer * buf = evhttp_request_get_input_buffer ( req );
+        size_t len = buf ? evbuffer_get_length ( buf ) : 0 ;
+        if ( len )
+        {
+            resp_ptr->body.resize ( len );
+            evbuffer_copyout ( buf, &resp_ptr->body[0], len );
+        }
+
+        struct evkeyvalq * hdrs = evhttp_request_get_input_headers ( req );
+        const char * value ;
+        if (( value = evhttp_find_header ( hdrs, REDFISH_HEADER__AUTH_TOKEN )) != NULL )
+            resp_ptr->token = value ;
+        if (( value = evhttp_find_header ( hdrs, "Location" )) != NULL )
+            resp_ptr->location = value ;
+    }
+    event_base_loopbreak ( resp_ptr->base );
+}
+
+static string _basic_auth ( redfishClient_session_type * session_ptr )
+{
+    string creds = session_ptr->bm_un + ":" + session_ptr->bm_pw ;
+    string encoded ;
+
+    encoded.resize ( 4*((creds.length()+2)/3) + 1 );
+    int len = EVP_EncodeBlock ( (unsigned char *)&encoded[0],
+                                (const unsigned char *)creds.data(),
+                                creds.length());
+    encoded.resize ( len > 0 ? len : 0 );
+    return ( "Basic " + encoded );
+}
+
+/*************************************************************************
+ *
+ * Name       : _session_send
+ *
+ * Description: Issue one request over the session's keep-alive
+ *              connection and run its event base until the response,
+ *              or a connection error or timeout, is delivered.
+ *
+ *              An idle keep-alive connection may have been closed by
+ *              the BMC since the last request. If a reused connection
+ *              produces no response then the request is retried once
+ *              over a new connection.
+ *
+ * Returns    : PASS if an http response was received ; resp.status
+ *              holds the http status.
+ *
+ *************************************************************************/
+
+static int _session_send ( redfishClient_session_type  * session_ptr,
+                           enum evhttp_cmd_type          type,
+                           const string                & path,
+                           const string                & payload,
+                           bool                          auth,
+                           redfishClient_response_type & resp )
+{
+    for ( int attempt = 0 ; attempt < 2 ; attempt++ )
+    {
+        /* deliver any pending close of the idle connection */
+        if (( session_ptr->base ) && ( session_ptr->conn ))
+            event_base_loop ( session_ptr->base, EVLOOP_NONBLOCK );
+
+        if (( session_ptr->conn == NULL ) || ( session_ptr->conn_closed ))
+        {
+            int rc = _session_connect ( session_ptr );
+            if ( rc != PASS )
+                return (rc);
+        }
+        bool reused = session_ptr->conn_used ;
+
+        resp.base     = session_ptr->base ;
+        resp.done     = false ;
+        resp.status   = 0 ;
+        resp.body.clear();
+        resp.token.clear();
+        resp.location.clear();
+
+        struct evhttp_request * req = evhttp_request_new ( _response_handler, &resp );
+        if ( req == NULL )
+        {
+            elog_t ("%s evhttp_request_new failed", session_ptr->hostname.c_str());
+            return (FAIL_REQUEST_NEW);
+        }
+
+        struct evkeyvalq * hdrs = evhttp_request_get_output_headers ( req );
+        evhttp_add_header ( hdrs, "Host", session_ptr->host_hdr.c_str());
+        evhttp_add_header ( hdrs, "Accept", "application/json" );
+        evhttp_add_header ( hdrs, "OData-Version", "4.0" );
+        if ( auth )
+        {
+            if ( ! session_ptr->token.empty() )
+                evhttp_add_header ( hdrs, REDFISH_HEADER__AUTH_TOKEN, session_ptr->token.c_str());
+            else if ( session_ptr->basic_auth )
+                evhttp_add_header ( hdrs, "Authorization", _basic_auth(session_ptr).c_str());
+        }
+        if ( ! payload.empty() )
+        {
+            /* evhttp only adds Content-Length to POST and PUT ; PATCH needs it too */
+            evhttp_add_header ( hdrs, "Content-Type", "application/json" );
+            evhttp_add_header ( hdrs, "Content-Length", itos(payload.length()).c_str());
+            evbuffer_add ( evhttp_request_get_output_buffer ( req ),
+                           payload.data(), payload.length());
+        }
+
+        /* evhttp owns, and on failure frees, the request */
+        if ( evhttp_make_request ( session_ptr->conn, req, type, path.c_str()) != 0 )
+        {
+            elog_t ("%s redfish request failed to start ; %s",
+                        session_ptr->hostname.c_str(), path.c_str());
+            session_ptr->conn_closed = true ;
+            return (FAIL_MAKE_REQUEST);
+        }
+
+        event_base_dispatch ( session_ptr->base );
+        session_ptr->requests++ ;
+
+        if (( resp.done ) && ( resp.status ))
+        {
+            session_ptr->conn_used = true ;
+            blog2_t ("%s redfish %s (http:%d) (%ld bytes)",
+                         session_ptr->hostname.c_str(),
+                         path.c_str(),
+                         resp.status,
+                         (long)resp.body.length());
+            return (PASS);
+        }
+
+        session_ptr->conn_closed = true ;
+        if ( ! reused )
+            break ;
+
+        blog_t ("%s redfish keep-alive connection dropped ; reconnecting",
+                    session_ptr->hostname.c_str());
+    }
+
+    wlog_t ("%s redfish request got no response from %s ; %s",
+                session_ptr->hostname.c_str(),
+                session_ptr->address.c_str(),
+                path.c_str());
+    return (FAIL_CONNECT);
+}
+
+/* Map the http status to a return code ; failures leave a redfishtool
+ * style error string in response for the callers that look for one */
+static int _status_rc ( int status, string & response )
+{
+    if (( status >= 200 ) && ( status < 300 ))
+        return (PASS);
+
+    response = REDFISHTOOL_RESPONSE_ERROR ;
+    response.append(": status_code: ");
+    response.append(itos(status));
+
+    if ( status == 401 )
+        return (FAIL_AUTHENTICATION);
+    if ( status == 404 )
+        return (FAIL_NOT_FOUND);
+    return (FAIL_REQUEST);
+}
+
+/*************************************************************************
+ *
+ * Authentication
+ *
+ *************************************************************************/
+
+static void _session_logout ( redfishClient_session_type * session_ptr )
+{
+    if (( ! session_ptr->token.empty() ) && ( ! session_ptr->session_uri.empty()))
+    {
+        redfishClient_response_type resp ;
+        _session_send ( session_ptr, EVHTTP_REQ_DELETE,
+                        session_ptr->session_uri, "", true, resp );
+    }
+    session_ptr->token.clear();
+    session_ptr->session_uri.clear();
+    session_ptr->basic_auth = false ;
+}
+
+/* Login statuses that mean this BMC does not do Redfish sessions, or
+ * not for this user, rather than that the login failed this time */
+static bool _session_refused ( int status )
+{
+    return (( status == 401 ) || ( status == 403 ) ||
+            ( status == 404 ) || ( status == 405 ));
+}
+
+/* Create a session. A BMC that has no session service, or refuses the
+ * user a session, is switched to basic auth for the life of the session.
+ * Any other failure ; a server error or timeout ; is returned so that
+ * the login is tried again on the next request. */
+static int _session_login ( redfishClient_session_type * session_ptr,
+                                   string               & response )
+{
+    redfishClient_response_type resp ;
+    string payload = "{\"UserName\":\"" ;
+    payload.append(jsonUtil_escapeSpecialChar(session_ptr->bm_un));
+    payload.append("\",\"Password\":\"");
+    payload.append(jsonUtil_escapeSpecialChar(session_ptr->bm_pw));
+    payload.append("\"}");
+
+    session_ptr->token.clear();
+    session_ptr->session_uri.clear();
+
+    int rc = _session_send ( session_ptr, EVHTTP_REQ_POST,
+                             REDFISH_PATH__SESSIONS, payload, false, resp );
+    if ( rc != PASS )
+        return (rc);
+
+    rc = _status_rc ( resp.status, resp.body );
+    if (( rc == PASS ) && ( ! resp.token.empty()))
+    {
+        session_ptr->token       = resp.token ;
+        session_ptr->session_uri = resp.location ;
+        session_ptr->basic_auth  = false ;
+        session_ptr->logins++ ;
+        blog_t ("%s redfish session created (logins:%u)",
+                    session_ptr->hostname.c_str(),
+                    session_ptr->logins);
+    }
+    else if (( rc == PASS ) || ( _session_refused ( resp.status )))
+    {
+        wlog_t ("%s redfish session login refused (http:%d) ; using basic auth",
+                    session_ptr->hostname.c_str(),
+                    resp.status);
+        session_ptr->basic_auth = true ;
+    }
+    else
+    {
+        wlog_t ("%s redfish session login failed (http:%d) ; will retry",
+                    session_ptr->hostname.c_str(),
+                    resp.status);
+        response = resp.body ;
+        return (rc);
+    }
+    return (PASS);
+}
+
+/*************************************************************************
+ *
+ * Name       : _session_request
+ *
+ * Description: Issue an authenticated request. A session is created if
+ *              there is none. If the BMC rejects the session token,
+ *              because it expired or was deleted, then log in again
+ *              and retry once.
+ *
+ *************************************************************************/
+
+static int _session_request ( redfishClient_session_type * session_ptr,
+                              enum evhttp_cmd_type         type,
+                              const string               & path,
+                              const string               & payload,
+                                    string               & response )
+{
+    redfishClient_response_type resp ;
+    int rc ;
+
+    if (( session_ptr->token.empty() ) && ( ! session_ptr->basic_auth ))
+    {
+        if (( rc = _session_login ( session_ptr, response )) != PASS )
+            return (rc);
+    }
+
+    rc = _session_send ( session_ptr, type, path, payload, true, resp );
+    if (( rc == PASS ) && ( resp.status == 401 ))
+    {
+        blog_t ("%s redfish session rejected ; logging in again",
+                    session_ptr->hostname.c_str());
+        session_ptr->basic_auth = false ;
+        if (( rc = _session_login ( session_ptr, response )) == PASS )
+        {
+            rc = _session_send ( session_ptr, type, path, payload, true, resp );
+        }
+    }
+    if ( rc != PASS )
+        return (rc);
+
+    response = resp.body ;
+    return ( _status_rc ( resp.status, response ));
+}
+
+/* GET 'path' and parse the response */
+static int _session_get_doc ( redfishClient_session_type * session_ptr,
+                              const string               & path,
+                                    string               & response,
+                                    jsonUtil_doc_type    & doc )
+{
+    int rc = _session_request ( session_ptr, EVHTTP_REQ_GET, path, "", response );
+    if ( rc == PASS )
+    {
+        if (( rc = jsonUtil_doc_parse ( doc, response.data())) != PASS )
+        {
+            wlog_t ("%s redfish %s response is not json",
+                        session_ptr->hostname.c_str(), path.c_str());
+        }
+    }
+    return (rc);
+}
+
+/*************************************************************************
+ *
+ * Service tree walk helpers
+ *
+ *************************************************************************/
+
+/* the @odata.id of 'obj' or of its 'label' member object */
+static string _odata_id ( struct json_object * obj, const char * label )
+{
+    if ( label )
+        obj = jsonUtil_get_key_object ( obj, label );
+
+    struct json_object * id_obj = jsonUtil_get_key_object ( obj, REDFISH_LABEL__ODATA_ID );
+    if ( id_obj )
+        return ( json_object_get_string ( id_obj ));
+    return ("");
+}
+
+/* GET a collection and return its first member's path */
+static int _first_member ( redfishClient_session_type * session_ptr,
+                           const char                 * collection,
+                                 string               & member,
+                                 string               & response )
+{
+    jsonUtil_doc_type doc ;
+    int rc = _session_get_doc ( session_ptr, collection, response, doc );
+    if ( rc == PASS )
+    {
+        int elements = 0 ;
+        struct json_object * array_obj =
+        jsonUtil_get_array ( doc.root, REDFISH_LABEL__MEMBERS, elements );
+        if ( elements > 0 )
+            member = _odata_id ( jsonUtil_get_array_obj ( array_obj, 0 ), NULL );
+        if ( member.empty() )
+        {
+            wlog_t ("%s redfish %s has no members",
+                        session_ptr->hostname.c_str(), collection);
+            rc = FAIL_NOT_FOUND ;
+        }
+    }
+    return (rc);
+}
+
+/*************************************************************************
+ *
+ * Name       : _get_system
+ *
+ * Description: GET the first Systems member ; the 'Systems get' command.
+ *              The system path and its reset action target are learned
+ *              on first use and the cached system path is re-learned if
+ *              the BMC no longer finds it.
+ *
+ *************************************************************************/
+
+static int _get_system ( redfishClient_session_type * session_ptr,
+                         string                     & response )
+{
+    int rc = FAIL_NOT_FOUND ;
+    for ( int pass = 0 ; pass < 2 ; pass++ )
+    {
+        bool cached = ! session_ptr->system_uri.empty() ;
+        if ( ! cached )
+        {
+            rc = _first_member ( session_ptr, REDFISH_PATH__SYSTEMS,
+                                 session_ptr->system_uri, response );
+            if ( rc != PASS )
+                return (rc);
+        }
+
+        jsonUtil_doc_type doc ;
+        rc = _session_get_doc ( session_ptr, session_ptr->system_uri, response, doc );
+        if ( rc == PASS )
+        {
+            struct json_object * action_obj =
+            jsonUtil_get_key_object (
+                jsonUtil_get_key_object ( doc.root, REDFISH_LABEL__ACTIONS ),
+                REDFISH_LABEL__ACTION_RESET );
+            struct json_object * target_obj =
+            jsonUtil_get_key_object ( action_obj, REDFISH_LABEL__TARGET );
+            if ( target_obj )
+                session_ptr->reset_uri = json_object_get_string ( target_obj );
+            break ;
+        }
+        if (( rc != FAIL_NOT_FOUND ) || ( ! cached ))
+            break ;
+
+        session_ptr->system_uri.clear();
+        session_ptr->reset_uri.clear();
+    }
+    return (rc);
+}
+
+/*************************************************************************
+ *
+ * Name       : _get_chassis_resource
+ *
+ * Description: GET the Power or Thermal resource of the first Chassis
+ *              member ; the 'Chassis Power' and 'Chassis Thermal'
+ *              commands. Both paths are learned from the one chassis
+ *              query and re-learned if the BMC no longer finds them.
+ *
+ *************************************************************************/
+
+static int _get_chassis_resource ( redfishClient_session_type * session_ptr,
+                                   bool                         power,
+                                   string                     & response )
+{
+    int rc = FAIL_NOT_FOUND ;
+    for ( int pass = 0 ; pass < 2 ; pass++ )
+    {
+        string & uri = power ? session_ptr->power_uri : session_ptr->thermal_uri ;
+        bool cached = ! uri.empty() ;
+        if ( ! cached )
+        {
+            string chassis_uri ;
+            rc = _first_member ( session_ptr, REDFISH_PATH__CHASSIS, chassis_uri, response );
+            if ( rc != PASS )
+                return (rc);
+
+            jsonUtil_doc_type doc ;
+            if (( rc = _session_get_doc ( session_ptr, chassis_uri, response, doc )) != PASS )
+                return (rc);
+
+            session_ptr->power_uri   = _odata_id ( doc.root, REDFISH_LABEL__POWER );
+            session_ptr->thermal_uri = _odata_id ( doc.root, REDFISH_LABEL__THERMAL );
+            if ( session_ptr->power_uri.empty() )
+                session_ptr->power_uri = chassis_uri + "/" + REDFISH_LABEL__POWER ;
+            if ( session_ptr->thermal_uri.empty() )
+                session_ptr->thermal_uri = chassis_uri + "/" + REDFISH_LABEL__THERMAL ;
+        }
+
+        rc = _session_request ( session_ptr, EVHTTP_REQ_GET, uri, "", response );
+        if (( rc != FAIL_NOT_FOUND ) || ( ! cached ))
+            break ;
+
+        session_ptr->power_uri.clear();
+        session_ptr->thermal_uri.clear();
+    }
+    return (rc);
+}
+
+/* POST a ComputerSystem.Reset of 'reset_type' */
+static int _system_reset ( redfishClient_session_type * session_ptr,
+                           const string               & reset_type,
+                                 string               & response )
+{
+    if ( session_ptr->reset_uri.empty() )
+    {
+        int rc = _get_system ( session_ptr, response );
+        if ( rc != PASS )
+            return (rc);
+        if ( session_ptr->reset_uri.empty() )
+            session_ptr->reset_uri = session_ptr->system_uri + "/Actions/ComputerSystem.Reset" ;
+    }
+
+    string payload = "{\"ResetType\":\"" ;
+    payload.append(jsonUtil_escapeSpecialChar(reset_type));
+    payload.append("\"}");
+
+    return ( _session_request ( session_ptr, EVHTTP_REQ_POST,
+                                session_ptr->reset_uri, payload, response ));
+}
+
+/* PATCH a one time network boot override */
+static int _system_bootdev_pxe ( redfishClient_session_type * session_ptr,
+                                 string                     & response )
+{
+    if ( session_ptr->system_uri.empty() )
+    {
+        int rc = _first_member ( session_ptr, REDFISH_PATH__SYSTEMS,
+                                 session_ptr->system_uri, response );
+        if ( rc != PASS )
+            return (rc);
+    }
+
+    string payload = "{\"Boot\":{\"BootSourceOverrideEnabled\":\"Once\","
+                     "\"BootSourceOverrideTarget\":\"Pxe\"}}" ;
+
+    return ( _session_request ( session_ptr, EVHTTP_REQ_PATCH,
+                                session_ptr->system_uri, payload, response ));
+}
+
+/*************************************************************************
+ *
+ * Name       : redfishClient_command
+ *
+ * Description: Execute a redfishtool command in process ; see header.
+ *
+ *************************************************************************/
+
+int redfishClient_command ( const string & hostname,
+                            const string & bm_ip,
+                            const string & bm_un,
+                            const string & bm_pw,
+                            const string & command,
+                                  string & response )
+{
+    int rc ;
+    unsigned long long before_time = gettime_monotonic_nsec ();
+    size_t raw_get_len = strlen(REDFISHTOOL_RAW_GET_CMD);
+    size_t reset_len   = strlen(REDFISHTOOL_POWER_RESET_CMD);
+
+    response.clear();
+
+    redfishClient_session_type * session_ptr = _session_get ( hostname );
+
+    /* provisioning changes invalidate the connection or the session */
+    if ( session_ptr->bm_ip != bm_ip )
+    {
+        _session_disconnect ( session_ptr );
+        session_ptr->token.clear();
+        session_ptr->session_uri.clear();
+        session_ptr->basic_auth = false ;
+        session_ptr->system_uri.clear();
+        session_ptr->reset_uri.clear();
+        session_ptr->power_uri.clear();
+        session_ptr->thermal_uri.clear();
+        _session_address ( session_ptr, bm_ip );
+        session_ptr->bm_un = bm_un ;
+        session_ptr->bm_pw = bm_pw ;
+    }
+    else if (( session_ptr->bm_un != bm_un ) || ( session_ptr->bm_pw != bm_pw ))
+    {
+        _session_logout ( session_ptr );
+        session_ptr->bm_un = bm_un ;
+        session_ptr->bm_pw = bm_pw ;
+    }
+
+    if ( command == REDFISHTOOL_ROOT_QUERY_CMD )
+    {
+        /* the service root does not require authentication */
+        redfishClient_response_type resp ;
+        rc = _session_send ( session_ptr, EVHTTP_REQ_GET, REDFISH_PATH__ROOT, "", false, resp );
+        if ( rc == PASS )
+        {
+            response = resp.body ;
+            rc = _status_rc ( resp.status, response );
+        }
+    }
+    else if ( command == REDFISHTOOL_BMC_INFO_CMD )
+    {
+        rc = _get_system ( session_ptr, response );
+    }
+    else if ( command == REDFISHTOOL_CHASSIS_POWER_CMD )
+    {
+        rc = _get_chassis_resource ( session_ptr, true, response );
+    }
+    else if ( command == REDFISHTOOL_CHASSIS_THERMAL_CMD )
+    {
+        rc = _get_chassis_resource ( session_ptr, false, response );
+    }
+    else if ( command.compare ( 0, raw_get_len, REDFISHTOOL_RAW_GET_CMD ) == 0 )
+    {
+        rc = _session_request ( session_ptr, EVHTTP_REQ_GET,
+                                command.substr(raw_get_len), "", response );
+    }
+    else if ( command.compare ( 0, reset_len, REDFISHTOOL_POWER_RESET_CMD ) == 0 )
+    {
+        rc = _system_reset ( session_ptr, command.substr(reset_len), response );
+    }
+    else if ( command == REDFISHTOOL_BOOTDEV_PXE_CMD )
+    {
+        rc = _system_bootdev_pxe ( session_ptr, response );
+    }
+    else
+    {
+        response = "unsupported redfish client command: " ;
+        response.append(command);
+        rc = FAIL_NOT_SUPPORTED ;
+    }
+
+    if ( rc != PASS )
+    {
+        if ( response.empty() )
+        {
+            response = REDFISHTOOL_RESPONSE_ERROR ;
+            response.append(": no response from ");
+            response.append(session_ptr->address);
+        }
+        blog_t ("%s redfish '%s' failed (rc:%d) %s",
+                    hostname.c_str(),
+                    command.c_str(),
+                    rc, response.c_str());
+    }
+
+    _session_put ( session_ptr );
+    flightRecorder_log ( FLIGHT_EVENT__BMC_REDFISH, hostname.c_str(), rc,
+               (int)((gettime_monotonic_nsec () - before_time)/1000000) );
+    return (rc);
+}
@@ -0,0 +1,98 @@
+#ifndef __INCLUDE_REDFISHCLIENT_H__
+#define __INCLUDE_REDFISHCLIENT_H__
+
+/*
+ * Copyright (c) 2026 Wind River Systems, Inc.
+*
+* SPDX-License-Identifier: Apache-2.0
+*
+ */
+
+ /**
+  * @file
+  * Starling-X Common In-Process Redfish Client Header
+  *
+  * Executes the subset of redfishtool commands used by maintenance and
+  * hardware monitor directly over HTTP(S) from the calling bmc thread.
+  *
+  * One session is cached per host. It holds a keep-alive connection to
+  * the BMC along with the X-Auth-Token of a Redfish session that is
+  * created on first use and reused until the BMC rejects it. The
+  * resource paths learned while walking the service tree are cached
+  * with the session so that subsequent requests go straight to the
+  * target resource.
+  *
+  * Response bodies are returned in memory ; no password or data files
+  * are created.
+  */
+
+#include <iostream>
+#include <string>
+
+using namespace std;
+
+#define REDFISH_CLIENT_TIMEOUT_SECS   (30)   /* matches redfishtool -T 30 */
+#define REDFISH_CLIENT_HTTPS_PORT     (443)
+#define REDFISH_CLIENT_HTTP_PORT      (80)
+
+/* mtc.conf [agent] redfish_native_hosts keywords */
+#define REDFISH_CLIENT_HOSTS__NONE    ((const char *)("none"))
+#define REDFISH_CLIENT_HOSTS__ALL     ((const char *)("all"))
+
+/* Redfish service paths */
+#define REDFISH_PATH__ROOT            ((const char *)("/redfish/v1"))
+#define REDFISH_PATH__SESSIONS        ((const char *)("/redfish/v1/SessionService/Sessions"))
+#define REDFISH_PATH__SYSTEMS         ((const char *)("/redfish/v1/Systems"))
+#define REDFISH_PATH__CHASSIS         ((const char *)("/redfish/v1/Chassis"))
+
+/* Redfish labels used to walk the service tree */
+#define REDFISH_LABEL__MEMBERS        ((const char *)("Members"))
+#define REDFISH_LABEL__ODATA_ID       ((const char *)("@odata.id"))
+#define REDFISH_LABEL__POWER          ((const char *)("Power"))
+#define REDFISH_LABEL__THERMAL        ((const char *)("Thermal"))
+#define REDFISH_LABEL__TARGET         ((const char *)("target"))
+#define REDFISH_HEADER__AUTH_TOKEN    ((const char *)("X-Auth-Token"))
+
+/* redfishtool chassis commands handled by the in-process client */
+#define REDFISHTOOL_CHASSIS_POWER_CMD   ((const char *)("Chassis Power"))
+#define REDFISHTOOL_CHASSIS_THERMAL_CMD ((const char *)("Chassis Thermal"))
+
+/* true if the mtc.conf redfish_native_hosts option selects the
+ * in-process client for this host rather than redfishtool */
+bool redfishClient_selected ( const string & hostname );
+
+/***************************************************************************
+ *
+ * Execute a redfishtool command in process.
+ *
+ * Supported commands are
+ *
+ *    REDFISHTOOL_ROOT_QUERY_CMD      - GET the service root
+ *    REDFISHTOOL_BMC_INFO_CMD        - GET the first Systems member
+ *    REDFISHTOOL_CHASSIS_POWER_CMD   - GET the first Chassis member's Power
+ *    REDFISHTOOL_CHASSIS_THERMAL_CMD - GET the first Chassis member's Thermal
+ *    REDFISHTOOL_RAW_GET_CMD <path>  - GET the specified path
+ *    REDFISHTOOL_POWER_RESET_CMD <t> - POST ComputerSystem.Reset of type <t>
+ *    REDFISHTOOL_BOOTDEV_PXE_CMD     - PATCH a one time Pxe boot override
+ *
+ * bm_ip is normally a bare IPv4/IPv6 address reached over https on 443.
+ * An explicit 'http[s]://address[:port]' form is also accepted.
+ *
+ * Returns PASS with the response body in 'response'. On failure the
+ * response holds a redfishtool style 'Response Error: status_code: <n>'
+ * string and the return code is one of FAIL_CONNECT, FAIL_AUTHENTICATION,
+ * FAIL_NOT_FOUND, FAIL_REQUEST, FAIL_JSON_PARSE or FAIL_NOT_SUPPORTED.
+ *
+ ***************************************************************************/
+int redfishClient_command ( const string & hostname,
+                            const string & bm_ip,
+                            const string & bm_un,
+                            const string & bm_pw,
+                            const string & command,
+                                  string & response );
+
+/* Drop the cached session and connection for this host.
+ * Deferred to the end of the request if a thread is using it. */
+void redfishClient_close ( const string & hostname );
+
+#endif // __INCLUDE_REDFISHCLIENT_H__
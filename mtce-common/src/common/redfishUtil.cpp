@@ -490,13 +490,15 @@ int redfishUtil_get_bmc_info ( string & hostname,
         return (FAIL_STRING_EMPTY) ;
     }
 
-    struct json_object *json_obj = json_tokener_parse((char*)json_bmc_info.data());
-    if ( !json_obj )
+    /* Parse the bmc info once ; the document is released on any return */
+    jsonUtil_doc_type doc ;
+    if ( jsonUtil_doc_parse ( doc, json_bmc_info.data() ) != PASS )
     {
         wlog ("%s bmc info data parse error", hostname.c_str());
         return (FAIL_JSON_PARSE) ;
 
     }
+    struct json_object *json_obj = doc.root ;
 
     /* load the power state */
     string power_state = tolowercase(jsonUtil_get_key_value_string( json_obj, REDFISH_LABEL__POWER_STATE));
@@ -538,15 +540,24 @@ int redfishUtil_get_bmc_info ( string & hostname,
     {
         std::list<string> action_list ;
 
-        /* get the first level reset action label content */
-        string json_actions = jsonUtil_get_key_value_string (json_obj_actions,
-                                             REDFISH_LABEL__ACTION_RESET);
-        if ( !json_actions.empty() && json_actions.compare("none") )
+        /* get the first level reset action label object */
+        struct json_object *json_actions_obj =
+        jsonUtil_get_key_object ( json_obj_actions, REDFISH_LABEL__ACTION_RESET );
+        if ( json_actions_obj )
         {
-            if ( jsonUtil_get_list ((char*)json_actions.data(),
-                                    REDFISH_LABEL__ACTION_RESET_ALLOWED,
-                                    action_list ) == PASS )
+            if ( jsonUtil_get_key_object ( json_actions_obj,
+                                           REDFISH_LABEL__ACTION_RESET_ALLOWED ))
             {
+                int actions = 0 ;
+                struct json_object * allowed_obj =
+                jsonUtil_get_array ( json_actions_obj,
+                                     REDFISH_LABEL__ACTION_RESET_ALLOWED,
+                                     actions );
+                for ( int i = 0 ; i < actions ; i++ )
+                {
+                    action_list.push_back ( json_object_get_string (
+                        jsonUtil_get_array_obj ( allowed_obj, i )));
+                }
                 redfishUtil_load_actions ( hostname, bmc_info, action_list);
             }
             else
@@ -562,9 +573,7 @@ int redfishUtil_get_bmc_info ( string & hostname,
                           hostname.c_str(),
                           REDFISH_LABEL__ACTION_RESET_ALLOWED );
 
-                struct json_object *json_actions_obj =
-                json_tokener_parse((char*)json_actions.data());
-                if ( json_actions_obj )
+                if ( json_object_is_type ( json_actions_obj, json_type_object ))
                 {
                     string json_actions_target =
                     jsonUtil_get_key_value_string(json_actions_obj,
@@ -592,7 +601,7 @@ int redfishUtil_get_bmc_info ( string & hostname,
                 {
                     wlog ("%s null json object from %s using label %s",
                               hostname.c_str(),
-                              json_actions.c_str(),
+                              json_object_get_string(json_actions_obj),
                               REDFISH_LABEL__ACTION_RESET_ALLOWED);
                     return ( FAIL_JSON_PARSE );
                 }
@@ -658,7 +667,5 @@ int redfishUtil_get_bmc_info ( string & hostname,
         wlog ("%s memory object not found", hostname.c_str());
     }
 
-    json_object_put(json_obj );
-
     return (PASS) ;
 }
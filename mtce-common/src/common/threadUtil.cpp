@@ -1,5 +1,5 @@
 /*
- * Copyright (c) 2016-2017, 2024 Wind River Systems, Inc.
+ * Copyright (c) 2016-2017, 2024, 2026 Wind River Systems, Inc.
 *
 * SPDX-License-Identifier: Apache-2.0
 *
@@ -25,11 +25,15 @@
  *
  ****************************************************************************/
 
+#include <algorithm>          /* for ... std::find                    */
+
 #include "daemon_common.h"   /* for ... daemon_health_test           */
 #include "nodeBase.h"        /* for ... mtce node common definitions */
 #include "hostUtil.h"        /* for ... mtce host common definitions */
 #include "threadUtil.h"      /* for ... this module header           */
-#include "nodeUtil.h"        /* for ... fork_execv                   */
+#include "nodeUtil.h"        /* for ... spawn_execv                  */
+#include "flightRecorder.h"  /* for ... flightRecorder_log           */
+#include "bmcUtil.h"         /* for ... BMC_THREAD_CMD__xxxx         */
 
 /* Stores the parent process's timer handler */
 static void (*thread_timer_handler)(int, siginfo_t*, void*) = NULL ;
@@ -122,12 +126,344 @@ void threadUtil_fini ( void )
     ; // ilog ("called\n");
 }
 
+/*****************************************************************************
+ *
+ * Name       : _thread_create
+ *
+ * Description: Create a detached pthread with all signals blocked so that
+ *              it does not inherit the parent's signal handling.
+ *
+ ****************************************************************************/
+
+static int _thread_create ( pthread_t & id, void* (*thread) (void*), void * arg )
+{
+    daemon_signal_hdlr ();
+
+    /* Block signals */
+    sigfillset(&__disabled_mask);
+
+    // sigemptyset(&__enabled_mask); /* maybe not needed */
+    pthread_sigmask(SIG_SETMASK, &__disabled_mask, NULL );
+    pthread_sigmask(SIG_BLOCK, &__disabled_mask, &__enabled_mask);
+
+    int rc = pthread_create(&id, &__attr, thread, arg);
+
+    if ( sigismember (&__enabled_mask, SIGINT ) == 0 )
+    {
+        slog ("SIGINT signal was not enabled ; enabling\n");
+        sigaddset(&__enabled_mask, SIGINT);
+    }
+    if ( sigismember (&__enabled_mask, SIGTERM ) == 0 )
+    {
+        slog ("SIGTERM signal was not enabled ; enabling\n");
+        sigaddset(&__enabled_mask, SIGTERM);
+    }
+    if ( sigismember (&__enabled_mask, SIGUSR1 ) == 0 )
+    {
+        slog ("SIGUSR1 signal was not enabled ; enabling\n");
+        sigaddset(&__enabled_mask, SIGUSR1);
+    }
+
+    /* restore signal mask */
+    pthread_sigmask(SIG_SETMASK, &__enabled_mask, NULL );
+    pthread_sigmask(SIG_UNBLOCK, &__enabled_mask, NULL );
+
+    /* The above disables signal handling for a short period while a
+     * thread is started. In the meantime the only signal that is
+     * crutial not to miss is USR1.
+     * Work Around: run the USR1 signal handler immediately following
+     * the launch just in case it was requested during the launch
+     * while the signals were masked. */
+    daemon_health_test ();
+
+    return (rc);
+}
+
+/*****************************************************************************
+ *
+ *                    Daemon Wide Thread Worker Pool
+ *
+ * The pool mutex protects the queues and counters. The parent queues
+ * and dequeues jobs and spawns workers. Workers only pop jobs.
+ *
+ * Workers are created on demand, up to the configured count, and then
+ * wait on the condition variable for the next job.
+ *
+ ****************************************************************************/
+
+typedef struct
+{
+    void* (*thread) (void*) ; /* the thread function to run        */
+    thread_info_type * info_ptr ; /* its arg ; also the job key    */
+} thread_job_type ;
+
+typedef struct
+{
+    pthread_mutex_t lock ;
+    pthread_cond_t  cond ;
+
+    int max     ; /* configured worker count ; 0 = pool disabled  */
+    int workers ; /* live workers                                 */
+    int busy    ; /* workers running a job                        */
+
+    std::list<thread_job_type> queue [THREAD_PRIORITY__LEVELS] ;
+
+    /* info of the jobs workers are running now */
+    std::list<thread_info_type*> running ;
+
+    /* stats */
+    unsigned long long queued     ; /* jobs queued                   */
+    unsigned long long dispatched ; /* jobs started by a worker      */
+    unsigned long long dequeued   ; /* jobs killed before they ran   */
+    unsigned long long spawned    ; /* workers created               */
+    unsigned long long exited     ; /* workers that exited in a job  */
+    int                peak_busy  ;
+    size_t             peak_queue ;
+} thread_pool_type ;
+
+static thread_pool_type _pool = { PTHREAD_MUTEX_INITIALIZER,
+                                  PTHREAD_COND_INITIALIZER,
+                                  0, 0, 0, {}, {}, 0, 0, 0, 0, 0, 0, 0 };
+
+/* Queue priority of a bmc command ; power and reset ahead of queries
+ * and sensor reads so that recovery actions are not held behind audits */
+static thread_priority_enum _thread_priority ( int command )
+{
+    switch ( command )
+    {
+        case BMC_THREAD_CMD__POWER_RESET:
+        case BMC_THREAD_CMD__POWER_ON:
+        case BMC_THREAD_CMD__POWER_OFF:
+        case BMC_THREAD_CMD__POWER_CYCLE:
+        case BMC_THREAD_CMD__BOOTDEV_PXE:
+            return (THREAD_PRIORITY__HIGH);
+        case BMC_THREAD_CMD__READ_SENSORS:
+            return (THREAD_PRIORITY__LOW);
+        default:
+            return (THREAD_PRIORITY__NORMAL);
+    }
+}
+
+static size_t _pool_queued_locked ( void )
+{
+    size_t queued = 0 ;
+    for ( int p = 0 ; p < THREAD_PRIORITY__LEVELS ; p++ )
+        queued += _pool.queue[p].size();
+    return (queued);
+}
+
+/* account for a worker that pthread_exit'ed from within its job */
+static void _pool_worker_exit ( void * arg )
+{
+    pthread_mutex_lock ( &_pool.lock );
+    _pool.running.remove ( (thread_info_type*)arg );
+    _pool.busy-- ;
+    _pool.workers-- ;
+    _pool.exited++ ;
+    pthread_mutex_unlock ( &_pool.lock );
+}
+
+static void * _pool_worker ( void * arg )
+{
+    UNUSED(arg);
+    pthread_mutex_lock ( &_pool.lock );
+    for ( ; ; )
+    {
+        int p = 0 ;
+        for ( ; p < THREAD_PRIORITY__LEVELS ; p++ )
+            if ( ! _pool.queue[p].empty() )
+                break ;
+
+        if ( p == THREAD_PRIORITY__LEVELS )
+        {
+            /* retire workers above a reduced pool size */
+            if ( _pool.workers > _pool.max )
+                break ;
+            pthread_cond_wait ( &_pool.cond, &_pool.lock );
+            continue ;
+        }
+
+        thread_job_type job = _pool.queue[p].front();
+        _pool.queue[p].pop_front();
+        _pool.running.push_back ( job.info_ptr );
+        _pool.dispatched++ ;
+        if ( ++_pool.busy > _pool.peak_busy )
+            _pool.peak_busy = _pool.busy ;
+        pthread_mutex_unlock ( &_pool.lock );
+
+        pthread_cleanup_push ( _pool_worker_exit, job.info_ptr );
+        job.thread ( job.info_ptr );
+        pthread_cleanup_pop ( 0 );
+
+        /* the job may have changed these for itself */
+        pthread_setcancelstate ( PTHREAD_CANCEL_ENABLE, NULL );
+        pthread_setcanceltype  ( PTHREAD_CANCEL_DEFERRED, NULL );
+
+        pthread_mutex_lock ( &_pool.lock );
+        _pool.running.remove ( job.info_ptr );
+        _pool.busy-- ;
+    }
+    _pool.workers-- ;
+    pthread_mutex_unlock ( &_pool.lock );
+    return NULL ;
+}
+
+void threadUtil_workers ( int workers )
+{
+    if ( workers < 0 )
+        workers = 0 ;
+    else if ( workers > THREAD_WORKERS_MAX )
+        workers = THREAD_WORKERS_MAX ;
+
+    pthread_mutex_lock ( &_pool.lock );
+    if ( _pool.max != workers )
+    {
+        ilog ("BMC Workers : %d%s", workers, workers ? "" : " ; thread per launch");
+        _pool.max = workers ;
+        pthread_cond_broadcast ( &_pool.cond );
+    }
+    pthread_mutex_unlock ( &_pool.lock );
+}
+
+/*****************************************************************************
+ *
+ * Name       : _pool_queue
+ *
+ * Description: Queue a job and create a worker for it if all workers are
+ *              busy and the pool is below its configured size.
+ *
+ * Returns    : PASS or the pthread_create error if there are no workers
+ *              left to run the job.
+ *
+ ****************************************************************************/
+
+static int _pool_queue ( thread_ctrl_type & ctrl, thread_info_type & info )
+{
+    int rc = PASS ;
+    thread_job_type job ;
+    job.thread   = ctrl.thread ;
+    job.info_ptr = &info ;
+
+    pthread_mutex_lock ( &_pool.lock );
+    _pool.queue[_thread_priority(info.command)].push_back ( job );
+    _pool.queued++ ;
+    size_t queued = _pool_queued_locked ();
+    if ( queued > _pool.peak_queue )
+        _pool.peak_queue = queued ;
+
+    bool spawn = (( _pool.workers < _pool.max ) &&
+                  ( _pool.workers - _pool.busy < (int)queued ));
+    if ( spawn )
+        _pool.workers++ ;
+    else
+        pthread_cond_signal ( &_pool.cond );
+    pthread_mutex_unlock ( &_pool.lock );
+
+    if ( spawn )
+    {
+        pthread_t id ;
+        rc = _thread_create ( id, _pool_worker, NULL );
+        pthread_mutex_lock ( &_pool.lock );
+        if ( rc == PASS )
+        {
+            _pool.spawned++ ;
+        }
+        else
+        {
+            _pool.workers-- ;
+            /* nothing will run the job if there are no other workers */
+            if ( _pool.workers )
+            {
+                rc = PASS ;
+            }
+            else
+            {
+                _pool.queue[_thread_priority(info.command)].pop_back();
+                _pool.queued-- ;
+            }
+        }
+        pthread_mutex_unlock ( &_pool.lock );
+    }
+    return (rc);
+}
+
+/* remove a job that has not started yet ; returns true if it was queued */
+static bool _pool_dequeue ( thread_info_type & info )
+{
+    bool found = false ;
+    pthread_mutex_lock ( &_pool.lock );
+    for ( int p = 0 ; ( p < THREAD_PRIORITY__LEVELS ) && ( found == false ) ; p++ )
+    {
+        for ( std::list<thread_job_type>::iterator it = _pool.queue[p].begin() ;
+              it != _pool.queue[p].end() ; ++it )
+        {
+            if ( it->info_ptr == &info )
+            {
+                _pool.queue[p].erase ( it );
+                _pool.dequeued++ ;
+                found = true ;
+                break ;
+            }
+        }
+    }
+    pthread_mutex_unlock ( &_pool.lock );
+    return (found);
+}
+
+static bool _pool_is_queued ( thread_info_type & info )
+{
+    bool found = false ;
+    pthread_mutex_lock ( &_pool.lock );
+    for ( int p = 0 ; ( p < THREAD_PRIORITY__LEVELS ) && ( found == false ) ; p++ )
+    {
+        for ( std::list<thread_job_type>::iterator it = _pool.queue[p].begin() ;
+              it != _pool.queue[p].end() ; ++it )
+        {
+            if ( it->info_ptr == &info )
+            {
+                found = true ;
+                break ;
+            }
+        }
+    }
+    pthread_mutex_unlock ( &_pool.lock );
+    return (found);
+}
+
+static bool _pool_is_running ( thread_info_type & info )
+{
+    pthread_mutex_lock ( &_pool.lock );
+    bool found = ( std::find ( _pool.running.begin(), _pool.running.end(), &info ) != _pool.running.end());
+    pthread_mutex_unlock ( &_pool.lock );
+    return (found);
+}
+
+void threadUtil_workers_dump ( void )
+{
+    pthread_mutex_lock ( &_pool.lock );
+    ilog ("BMC Workers : max:%d live:%d busy:%d (peak:%d) queued:%zu:%zu:%zu (peak:%zu)\n",
+              _pool.max, _pool.workers, _pool.busy, _pool.peak_busy,
+              _pool.queue[THREAD_PRIORITY__HIGH].size(),
+              _pool.queue[THREAD_PRIORITY__NORMAL].size(),
+              _pool.queue[THREAD_PRIORITY__LOW].size(),
+              _pool.peak_queue );
+    ilog ("BMC Jobs    : queued:%llu dispatched:%llu dequeued:%llu ; workers spawned:%llu exited:%llu\n",
+              _pool.queued, _pool.dispatched, _pool.dequeued,
+              _pool.spawned, _pool.exited );
+    pthread_mutex_unlock ( &_pool.lock );
+}
+
 /*****************************************************************************
   *
  * Name       : threadUtil_bmcSystemCall
  *
  * Description: Execute a bmc system call using the supplied request string.
  *
+ *              The request is spawned rather than forked and is killed if
+ *              it is still running after DEFAULT_SYSTEM_REQUEST_TIMEOUT_SECS
+ *              so that a hung tool cannot hold the thread past its own
+ *              timeout.
+ *
  *              If the call takes longer than the supplied latency threshold
  *              then print a log indicating how long it took.
  *
@@ -145,9 +481,12 @@ int threadUtil_bmcSystemCall (string hostname,
                               unsigned long long latency_threshold_secs)
 {
     unsigned long long before_time = gettime_monotonic_nsec () ;
-    int rc = fork_execv ( hostname, request , datafile ) ;
+    int rc = spawn_execv ( hostname, request, datafile, NULL,
+                           DEFAULT_SYSTEM_REQUEST_TIMEOUT_SECS ) ;
     unsigned long long after_time = gettime_monotonic_nsec () ;
     unsigned long long delta_time = after_time-before_time ;
+    flightRecorder_log ( FLIGHT_EVENT__BMC_CALL, hostname.c_str(),
+                         rc, (int)(delta_time/1000000) );
     if ( delta_time > (latency_threshold_secs*1000000000))
     {
         wlog ("%s bmc system call took %2llu.%-8llu sec", hostname.c_str(),
@@ -276,6 +615,36 @@ void thread_init ( thread_ctrl_type & thread_ctrl,
                thread_ctrl.hostname.data(), thread_ctrl.name.data());
 }
 
+/****************************************************************************
+ *
+ * Name       : thread_fini
+ *
+ * Description: Release the thread ctrl and info of a host that is being
+ *              freed. A launch still in the worker queue is removed so
+ *              that no worker can later run it against freed memory.
+ *
+ ****************************************************************************/
+
+void thread_fini ( thread_ctrl_type & ctrl, thread_info_type & info )
+{
+    info.signal = SIGKILL ;
+    if ( _pool_dequeue ( info ) == true )
+    {
+        wlog ("%s %s thread removed from worker queue\n",
+                  ctrl.hostname.c_str(),
+                  ctrl.name.c_str());
+    }
+    if ( _pool_is_running ( info ) == true )
+    {
+        elog ("%s %s thread still running at fini\n",
+                  ctrl.hostname.c_str(),
+                  ctrl.name.c_str());
+    }
+    mtcTimer_fini ( ctrl.timer );
+    ctrl.stage = THREAD_STAGE__IDLE ;
+    ctrl.id    = 0 ;
+}
+
 /****************************************************************************
  *
  * Name       : thread_done
@@ -398,6 +767,16 @@ int  thread_launch ( thread_ctrl_type & ctrl, thread_info_type & info )
         rc = FAIL_THREAD_RUNNING ;
     }
 
+    /* a killed job keeps its worker, and this info, until it reaches
+     * a cancellation point or returns ; don't start a second one on it */
+    else if (( _pool.max ) && ( _pool_is_running ( info ) == true ))
+    {
+        wlog ("%s %s previous thread still running on a worker\n",
+                  ctrl.hostname.c_str(),
+                  ctrl.name.c_str());
+        rc = FAIL_THREAD_RUNNING ;
+    }
+
     else
     {
         _stage_change ( ctrl, THREAD_STAGE__LAUNCH );
@@ -419,6 +798,15 @@ void thread_kill ( thread_ctrl_type & ctrl, thread_info_type & info )
 {
     info.signal = SIGKILL ;
 
+    /* A launch that no worker has started yet is dropped now rather
+     * than in the KILL stage ; its owner may be freed before then */
+    if ( _pool_dequeue ( info ) == true )
+    {
+        wlog ("%s %s thread removed from worker queue\n",
+                  ctrl.hostname.c_str(),
+                  ctrl.name.c_str());
+    }
+
     /* only go to kill if not already handling kill */
     if (( ctrl.stage != THREAD_STAGE__KILL ) &&
         ( ctrl.stage != THREAD_STAGE__WAIT ) &&
@@ -660,44 +1048,16 @@ int thread_handler ( thread_ctrl_type & ctrl, thread_info_type & info )
             ctrl.idle = false ; /* not idle - for idle log throttle */
             ctrl.done = false ; /* declare the thread as running    */
 
-            daemon_signal_hdlr ();
-
-            /* Block signals */
-            sigfillset(&__disabled_mask);
-
-            // sigemptyset(&__enabled_mask); /* maybe not needed */
-            pthread_sigmask(SIG_SETMASK, &__disabled_mask, NULL );
-            pthread_sigmask(SIG_BLOCK, &__disabled_mask, &__enabled_mask);
-
-            rc = pthread_create(&ctrl.id, &__attr, ctrl.thread, (void*)&info);
-
-            if ( sigismember (&__enabled_mask, SIGINT ) == 0 )
-            {
-                slog ("%s SIGINT signal was not enabled ; enabling\n", ctrl.hostname.c_str());
-                sigaddset(&__enabled_mask, SIGINT);
-            }
-            if ( sigismember (&__enabled_mask, SIGTERM ) == 0 )
-            {
-                slog ("%s SIGTERM signal was not enabled ; enabling\n", ctrl.hostname.c_str());
-                sigaddset(&__enabled_mask, SIGTERM);
-            }
-            if ( sigismember (&__enabled_mask, SIGUSR1 ) == 0 )
-            {
-                slog ("%s SIGUSR1 signal was not enabled ; enabling\n", ctrl.hostname.c_str());
-                sigaddset(&__enabled_mask, SIGUSR1);
-            }
-
-            /* restore signal mask */
-            pthread_sigmask(SIG_SETMASK, &__enabled_mask, NULL );
-            pthread_sigmask(SIG_UNBLOCK, &__enabled_mask, NULL );
-
-            /* The above disables signal handling for a short period while a
-             * thread is started. In the meantime the only signal that is
-             * crutial not to miss is USR1.
-             * Work Around: run the USR1 signal handler immediately following
-             * the launch just in case it was requested during the launch
-             * while the signals were masked. */
-            daemon_health_test ();
+            /* The pool worker that runs a queued thread reports its
+             * id through info.id once it starts ; see MONITOR */
+            bool pooled = ( _pool.max != 0 ) ;
+            if ( pooled )
+                rc = _pool_queue ( ctrl, info );
+            else
+                rc = _thread_create ( ctrl.id, ctrl.thread, (void*)&info );
+            flightRecorder_log ( FLIGHT_EVENT__THREAD_LAUNCH,
+                                 ctrl.hostname.c_str(),
+                                 info.command, rc );
 
             if (rc != PASS)
             {
@@ -709,7 +1069,7 @@ int thread_handler ( thread_ctrl_type & ctrl, thread_info_type & info )
                 ctrl.status = info.status = FAIL_THREAD_CREATE ;
                 _stage_change ( ctrl, THREAD_STAGE__DONE );
             }
-            else if ( ctrl.id == 0 )
+            else if (( ctrl.id == 0 ) && ( pooled == false ))
             {
                 elog ("%s %s thread id is null\n",
                           ctrl.hostname.c_str(),
@@ -720,9 +1080,10 @@ int thread_handler ( thread_ctrl_type & ctrl, thread_info_type & info )
             }
             else
             {
-                dlog ("%s %s thread launched with command:%d\n",
+                dlog ("%s %s thread %s with command:%d\n",
                           ctrl.hostname.c_str(),
                           ctrl.name.c_str(),
+                          pooled ? "queued" : "launched",
                           info.command );
                 ctrl.status = PASS ;
 
@@ -738,6 +1099,10 @@ int thread_handler ( thread_ctrl_type & ctrl, thread_info_type & info )
         }
         case THREAD_STAGE__MONITOR:
         {
+            /* learn the id of the pool worker running this thread */
+            if (( ctrl.id == 0 ) && ( info.id != 0 ))
+                ctrl.id = info.id ;
+
             /* provide subtle indication that the thread ids don't match */
             if (( ctrl.id != info.id ) && ( info.id != 0 ))
             {
@@ -757,13 +1122,26 @@ int thread_handler ( thread_ctrl_type & ctrl, thread_info_type & info )
                                 info.progress);
             }
 #endif
-            if (( ctrl.timeout ) && ( mtcTimer_expired ( ctrl.timer ) ))
+            if (( ctrl.timeout ) && ( mtcTimer_expired ( ctrl.timer ) ) &&
+                ( _pool.max ) && ( _pool_is_queued ( info ) == true ))
+            {
+                /* time waiting for a worker does not count */
+                wlog ("%s %s thread still waiting for a worker ; restarting timeout\n",
+                          ctrl.hostname.c_str(),
+                          ctrl.name.c_str());
+                mtcTimer_reset ( ctrl.timer );
+                mtcTimer_start ( ctrl.timer, thread_timer_handler, ctrl.timeout );
+            }
+            else if (( ctrl.timeout ) && ( mtcTimer_expired ( ctrl.timer ) ))
             {
                 elog ("%s %s thread timeout\n",
                           ctrl.hostname.c_str(),
                           ctrl.name.c_str());
 
                 ctrl.status = FAIL_TIMEOUT ;
+                flightRecorder_log ( FLIGHT_EVENT__THREAD_DONE,
+                                     ctrl.hostname.c_str(),
+                                     info.command, ctrl.status );
                 _stage_change ( ctrl, THREAD_STAGE__KILL );
             }
             else if ( info.runcount > ctrl.runcount )
@@ -789,6 +1167,9 @@ int thread_handler ( thread_ctrl_type & ctrl, thread_info_type & info )
                                   info.status);
                     }
                 }
+                flightRecorder_log ( FLIGHT_EVENT__THREAD_DONE,
+                                     ctrl.hostname.c_str(),
+                                     info.command, info.status );
                 ctrl.id = 0 ;
                 info.id = 0 ;
                 _stage_change ( ctrl, THREAD_STAGE__DONE );
@@ -798,6 +1179,12 @@ int thread_handler ( thread_ctrl_type & ctrl, thread_info_type & info )
         case THREAD_STAGE__KILL:
         {
             info.signal = SIGKILL ;
+            if ( _pool_dequeue ( info ) == true )
+            {
+                wlog ("%s %s thread removed from worker queue\n",
+                          ctrl.hostname.c_str(),
+                          ctrl.name.c_str());
+            }
             if ( info.id != 0 )
             {
                 wlog ("%s %s thread kill req  (rc:%u)\n",
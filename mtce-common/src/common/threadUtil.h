@@ -2,7 +2,7 @@
 #define __INCLUDE_THREADBASE_H__
 
 /*
- * Copyright (c) 2017, 2024 Wind River Systems, Inc.
+ * Copyright (c) 2017, 2024, 2026 Wind River Systems, Inc.
 *
 * SPDX-License-Identifier: Apache-2.0
 *
@@ -20,6 +20,20 @@
  *              - a single thread per host
  *              - detached pthreads ; pthread_join would stall the parent process.
  *
+ * Worker Pool: When threadUtil_workers sets a non-zero worker count the
+ *              LAUNCH stage queues the thread function to a daemon wide
+ *              pool of persistent workers rather than creating a pthread.
+ *              At most that many threads then run at once across all hosts.
+ *              Each host has at most one queued or running thread, so hosts
+ *              are served in FIFO order within a priority ; power and reset
+ *              commands ahead of queries ahead of sensor reads. A killed
+ *              thread keeps its worker until it exits or returns and
+ *              thread_launch fails with FAIL_THREAD_RUNNING until then.
+ *              A thread that is still queued does not time out.
+ *              A thread function must return rather than pthread_exit so
+ *              its worker can be reused. A worker that exits ; i.e. through
+ *              pthread_signal_handler SIGKILL ; is replaced when needed.
+ *
  * There are 2 main structures used for managing pthreads.
  *
  *   thread_ctrl_type - owned and updated and only visible to the parent service.
@@ -123,38 +137,38 @@ using namespace std;
 #include "nodeTimers.h"
 
 /** Info logger macro*/
-#define ilog_t(format, args...) { syslog(LOG_INFO, "[%ld.%05d] %s %s %-3s %-18s(%4d) %-24s: Info : " format, gettid(), lc(), _hn(), _pn, __AREA__, __FILE__, __LINE__, __FUNCTION__, ##args) ; }
+#define ilog_t(format, args...) { daemon_syslog(LOG_INFO, "[%ld.%05d] %s %s %-3s %-18s(%4d) %-24s: Info : " format, gettid(), lc(), _hn(), _pn, __AREA__, __FILE__, __LINE__, __FUNCTION__, ##args) ; }
 
-#define elog_t(format, args...) { syslog(LOG_INFO, "[%ld.%05d] %s %s %-3s %-18s(%4d) %-24s:Error : " format, gettid(), lc(), _hn(), _pn, __AREA__, __FILE__, __LINE__, __FUNCTION__, ##args) ; }
+#define elog_t(format, args...) { daemon_syslog(LOG_INFO, "[%ld.%05d] %s %s %-3s %-18s(%4d) %-24s:Error : " format, gettid(), lc(), _hn(), _pn, __AREA__, __FILE__, __LINE__, __FUNCTION__, ##args) ; }
 
-#define wlog_t(format, args...) { syslog(LOG_INFO, "[%ld.%05d] %s %s %-3s %-18s(%4d) %-24s: Warn : " format, gettid(), lc(), _hn(), _pn, __AREA__, __FILE__, __LINE__, __FUNCTION__, ##args) ; }
+#define wlog_t(format, args...) { daemon_syslog(LOG_INFO, "[%ld.%05d] %s %s %-3s %-18s(%4d) %-24s: Warn : " format, gettid(), lc(), _hn(), _pn, __AREA__, __FILE__, __LINE__, __FUNCTION__, ##args) ; }
 
 #define dlog_t(format, args...) { \
-    if(daemon_get_cfg_ptr()->debug_level&1) \
-    { syslog(LOG_INFO, "[%ld.%05d] %s %s %-3s %-18s(%4d) %-24s:debug : " format, gettid(), lc(), _hn(), _pn, __AREA__, __FILE__, __LINE__, __FUNCTION__, ##args) ; }}
+    if(LOG_COMPILED(1) && (daemon_get_cfg_ptr()->debug_level&1)) \
+    { daemon_syslog(LOG_INFO, "[%ld.%05d] %s %s %-3s %-18s(%4d) %-24s:debug : " format, gettid(), lc(), _hn(), _pn, __AREA__, __FILE__, __LINE__, __FUNCTION__, ##args) ; }}
 #define dlog1_t(format, args...) { \
-    if(daemon_get_cfg_ptr()->debug_level&2) \
-    { syslog(LOG_INFO, "[%ld.%05d] %s %s %-3s %-18s(%4d) %-24s:debug2: " format, gettid(), lc(), _hn(), _pn, __AREA__, __FILE__, __LINE__, __FUNCTION__, ##args) ; }}
+    if(LOG_COMPILED(2) && (daemon_get_cfg_ptr()->debug_level&2)) \
+    { daemon_syslog(LOG_INFO, "[%ld.%05d] %s %s %-3s %-18s(%4d) %-24s:debug2: " format, gettid(), lc(), _hn(), _pn, __AREA__, __FILE__, __LINE__, __FUNCTION__, ##args) ; }}
 #define dlog2_t(format, args...) { \
-    if(daemon_get_cfg_ptr()->debug_level&4) \
-    { syslog(LOG_INFO, "[%ld.%05d] %s %s %-3s %-18s(%4d) %-24s:debug4: " format, gettid(), lc(), _hn(), _pn, __AREA__, __FILE__, __LINE__, __FUNCTION__, ##args) ; }}
+    if(LOG_COMPILED(4) && (daemon_get_cfg_ptr()->debug_level&4)) \
+    { daemon_syslog(LOG_INFO, "[%ld.%05d] %s %s %-3s %-18s(%4d) %-24s:debug4: " format, gettid(), lc(), _hn(), _pn, __AREA__, __FILE__, __LINE__, __FUNCTION__, ##args) ; }}
 #define dlog3_t(format, args...) { \
-    if(daemon_get_cfg_ptr()->debug_level&8) \
-    { syslog(LOG_INFO, "[%ld.%05d] %s %s %-3s %-18s(%4d) %-24s:debug8: " format, gettid(), lc(), _hn(), _pn, __AREA__, __FILE__, __LINE__, __FUNCTION__, ##args) ; }}
+    if(LOG_COMPILED(8) && (daemon_get_cfg_ptr()->debug_level&8)) \
+    { daemon_syslog(LOG_INFO, "[%ld.%05d] %s %s %-3s %-18s(%4d) %-24s:debug8: " format, gettid(), lc(), _hn(), _pn, __AREA__, __FILE__, __LINE__, __FUNCTION__, ##args) ; }}
 
 
 #define blog_t(format, args...) { \
-    if(daemon_get_cfg_ptr()->debug_bmgmt&1) \
-    { syslog(LOG_INFO, "[%ld.%05d] %s %s %-3s %-18s(%4d) %-24s: bmgt : " format, gettid(), lc(), _hn(), _pn, __AREA__, __FILE__, __LINE__, __FUNCTION__, ##args) ; }}
+    if(LOG_COMPILED(1) && (daemon_get_cfg_ptr()->debug_bmgmt&1)) \
+    { daemon_syslog(LOG_INFO, "[%ld.%05d] %s %s %-3s %-18s(%4d) %-24s: bmgt : " format, gettid(), lc(), _hn(), _pn, __AREA__, __FILE__, __LINE__, __FUNCTION__, ##args) ; }}
 #define blog1_t(format, args...) { \
-    if(daemon_get_cfg_ptr()->debug_bmgmt&2) \
-    { syslog(LOG_INFO, "[%ld.%05d] %s %s %-3s %-18s(%4d) %-24s: bmgt2: " format, gettid(), lc(), _hn(), _pn, __AREA__, __FILE__, __LINE__, __FUNCTION__, ##args) ; }}
+    if(LOG_COMPILED(2) && (daemon_get_cfg_ptr()->debug_bmgmt&2)) \
+    { daemon_syslog(LOG_INFO, "[%ld.%05d] %s %s %-3s %-18s(%4d) %-24s: bmgt2: " format, gettid(), lc(), _hn(), _pn, __AREA__, __FILE__, __LINE__, __FUNCTION__, ##args) ; }}
 #define blog2_t(format, args...) { \
-    if(daemon_get_cfg_ptr()->debug_bmgmt&4) \
-    { syslog(LOG_INFO, "[%ld.%05d] %s %s %-3s %-18s(%4d) %-24s: bmgt4: " format, gettid(), lc(), _hn(), _pn, __AREA__, __FILE__, __LINE__, __FUNCTION__, ##args) ; }}
+    if(LOG_COMPILED(4) && (daemon_get_cfg_ptr()->debug_bmgmt&4)) \
+    { daemon_syslog(LOG_INFO, "[%ld.%05d] %s %s %-3s %-18s(%4d) %-24s: bmgt4: " format, gettid(), lc(), _hn(), _pn, __AREA__, __FILE__, __LINE__, __FUNCTION__, ##args) ; }}
 #define blog3_t(format, args...) { \
-    if(daemon_get_cfg_ptr()->debug_bmgmt&8) \
-    { syslog(LOG_INFO, "[%ld.%05d] %s %s %-3s %-18s(%4d) %-24s: bmgt8: " format, gettid(), lc(), _hn(), _pn, __AREA__, __FILE__, __LINE__, __FUNCTION__, ##args) ; }}
+    if(LOG_COMPILED(8) && (daemon_get_cfg_ptr()->debug_bmgmt&8)) \
+    { daemon_syslog(LOG_INFO, "[%ld.%05d] %s %s %-3s %-18s(%4d) %-24s: bmgt8: " format, gettid(), lc(), _hn(), _pn, __AREA__, __FILE__, __LINE__, __FUNCTION__, ##args) ; }}
 
 
 
@@ -163,6 +177,16 @@ using namespace std;
 #define DEFAULT_THREAD_TIMEOUT_SECS (100) /* default pthread exec timout     */
 #define MAX_LOG_PREFIX_LEN          (MAX_CHARS_ON_LINE)
 #define THREAD_POST_KILL_WAIT       (10) /* wait time between KILL and IDLE */
+#define THREAD_WORKERS_MAX          (64) /* max configurable pool workers  */
+
+/* Worker pool queue priorities ; see _thread_priority */
+typedef enum
+{
+    THREAD_PRIORITY__HIGH = 0, /* power and reset control                   */
+    THREAD_PRIORITY__NORMAL,   /* status, info and other queries            */
+    THREAD_PRIORITY__LOW,      /* sensor reads                              */
+    THREAD_PRIORITY__LEVELS,
+} thread_priority_enum ;
 
 typedef enum
 {
@@ -260,6 +284,10 @@ void threadUtil_fini ( void );
 int  threadUtil_init ( void (*handler)(int, siginfo_t*, void* ), size_t stack_size);
 
 #define DEFAULT_SYSTEM_REQUEST_LATENCY_SECS (unsigned long long)(15)
+
+/* kill a bmc system call that runs this long ; less than the
+ * DEFAULT_THREAD_TIMEOUT_SECS of the thread that makes it */
+#define DEFAULT_SYSTEM_REQUEST_TIMEOUT_SECS (90)
 int threadUtil_bmcSystemCall (string hostname,
                               string request,
                               string datafile,
@@ -267,6 +295,11 @@ int threadUtil_bmcSystemCall (string hostname,
 
 void threadUtil_setstack_size ( size_t stack_size );
 
+/* Set the worker pool size ; 0 for a pthread per launch.
+ * Takes effect on the next launch and may be called before threadUtil_init. */
+void threadUtil_workers      ( int workers );
+void threadUtil_workers_dump ( void );
+
 /* Onetime thread init setup */
 void   thread_init   ( thread_ctrl_type & ctrl,
                        thread_info_type & info,
@@ -276,6 +309,10 @@ void   thread_init   ( thread_ctrl_type & ctrl,
                        string & hostname,
                        string threadname );
 
+/* Release the thread of a host that is about to be freed */
+void   thread_fini   ( thread_ctrl_type & ctrl,
+                       thread_info_type & info );
+
 /* The thread FSM */
 int    thread_handler( thread_ctrl_type & ctrl, thread_info_type & info );
 
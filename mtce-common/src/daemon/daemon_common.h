@@ -98,8 +98,70 @@ void daemon_health_test ( void );
 
 bool daemon_is_file_present ( const char * filename );
 bool daemon_is_os_debian    ( void );
+
+/**
+ * Flag file watch service ; see daemon_watch.cpp
+ *
+ * Files registered with daemon_watch_file are answered from memory by
+ * daemon_is_file_present and daemon_get_file_int/uint/str. The daemon
+ * selects on daemon_watch_fd in its main loop and calls
+ * daemon_watch_handler when it fires.
+ */
+typedef void (*daemon_watch_callback_type) ( const char * filename, bool present );
+
+typedef struct
+{
+    unsigned long      files        ; /**< registered files               */
+    unsigned long      dirs         ; /**< directories being watched      */
+    unsigned long long stat_avoided ; /**< presence checks from memory    */
+    unsigned long long read_avoided ; /**< content reads from memory      */
+    unsigned long long events       ; /**< inotify events serviced        */
+    unsigned long long reloads      ; /**< reloads on overflow or lost dir*/
+} daemon_watch_stats_type ;
+
+int  daemon_watch_init    ( void );
+void daemon_watch_fini    ( void );
+int  daemon_watch_fd      ( void ); /**< -1 if not initialized          */
+int  daemon_watch_file    ( const char * filename,
+                            daemon_watch_callback_type callback = NULL );
+void daemon_watch_handler ( void );
+void daemon_watch_refresh ( const char * filename );
+bool daemon_watch_present ( const char * filename, bool & present );
+bool daemon_watch_content ( const char * filename, string & line );
+void daemon_watch_stats   ( daemon_watch_stats_type & stats );
+void daemon_watch_dump    ( void );
 int  daemon_get_rmem_max    ( void );
 
+/**
+ * Main loop event reactor ; see daemon_reactor.cpp
+ *
+ * File descriptors are registered once with the handler to call when
+ * they are readable. daemon_reactor_run waits up to timeout_msecs for
+ * any of them, -1 for no timeout, and dispatches those that are ready.
+ * It returns the number dispatched or -1 on a wait failure.
+ */
+typedef void (*daemon_reactor_handler_type) ( int fd, void * ctx );
+
+int  daemon_reactor_init       ( void );
+void daemon_reactor_fini       ( void );
+int  daemon_reactor_add        ( int fd,
+                                 daemon_reactor_handler_type handler,
+                                 void * ctx = NULL );
+int  daemon_reactor_del        ( int fd );
+bool daemon_reactor_registered ( int fd );
+int  daemon_reactor_run        ( int timeout_msecs );
+void daemon_reactor_dump       ( void );
+
+/**
+ * Asynchronous log backend ; see daemon_log.cpp
+ *
+ * target is "none" for synchronous syslog, "syslog" to batch to syslog
+ * from a writer thread or the path of a file to batch append to.
+ */
+int  daemon_log_async      ( const char * target );
+void daemon_log_flush      ( void );
+void daemon_log_async_dump ( void );
+
 typedef struct
 {
    int count    ;
@@ -49,11 +49,14 @@ void daemon_config_default ( daemon_config_type* config_ptr )
     config_ptr->fit_host              = strdup("none");
     config_ptr->multicast             = strdup("none");
     config_ptr->barbican_api_host     = strdup("none");
+    config_ptr->redfish_native_hosts  = strdup("none");
+    config_ptr->log_async             = strdup("none");
     config_ptr->lazy_reboot_delay     = 0 ;
     config_ptr->pod_drain_timeout     = 0 ;
 
     config_ptr->hostwd_kdump_on_stall = 0 ;
     config_ptr->bmc_audit_period      = 0 ;
+    config_ptr->bmc_workers           = 0 ;
 
     config_ptr->debug_all    = 0 ;
     config_ptr->debug_json   = 0 ;
@@ -86,6 +89,11 @@ int client_timeout_handler (       void * user,
         config_ptr->host_services_timeout = atoi(value);
         ilog ("Host Svcs TO: %3d secs\n" , config_ptr->host_services_timeout);
     }
+    else if (MATCH("timeouts", "luks_audit_period"))
+    {
+        config_ptr->luks_audit_period = atoi(value);
+        ilog ("LUKS  Audit: %3d secs\n" , config_ptr->luks_audit_period);
+    }
     return (PASS);
 }
 
@@ -439,5 +447,7 @@ void daemon_dump_cfg ( void )
     if ( ptr->debug_level ) { ilog ("debug_level           = %d\n", ptr->debug_level  );}
     ilog ("debug_filter          = %s\n", ptr->debug_filter );
     ilog ("debug_event           = %s\n", ptr->debug_event  );
+    ilog ("log_async             = %s\n", ptr->log_async    );
+    daemon_log_async_dump ();
 
 }
@@ -274,6 +274,13 @@ int debug_config_handler (        void * user,
     {
         config_ptr->flush_thld = atoi(value);
     }
+    else if (MATCH("debug", "log_async"))
+    {
+        if ( config_ptr->log_async )
+            free ( config_ptr->log_async );
+        config_ptr->log_async = strdup(value);
+        daemon_log_async ( config_ptr->log_async );
+    }
     else if (MATCH("debug", "debug_filter"))
     {
         config_ptr->debug_filter = strdup(value);
@@ -113,6 +113,11 @@ bool daemon_is_os_debian ( void )
 
 bool daemon_is_file_present ( const char * filename )
 {
+    /* answered from memory if the file is watched ; see daemon_watch.cpp */
+    bool present ;
+    if ( daemon_watch_present ( filename, present ) == true )
+        return ( present );
+
     struct stat p ;
     memset ( &p, 0 , sizeof(struct stat));
     stat ( filename, &p ) ;
@@ -221,6 +226,7 @@ int daemon_log_value ( const char * filename , const char * str, int val )
         fprintf ( file_stream,"%s %d\n", str, val );
         fflush (file_stream);
         fclose (file_stream);
+        daemon_watch_refresh ( filename );
         return (PASS);
     }
     return (FAIL_FILE_OPEN);
@@ -234,6 +240,7 @@ int daemon_log_value ( const char * filename , unsigned int val )
         fprintf ( file_stream,"%u\n", val );
         fflush (file_stream);
         fclose (file_stream);
+        daemon_watch_refresh ( filename );
         return (PASS);
     }
     return (FAIL_FILE_OPEN);
@@ -247,6 +254,7 @@ int daemon_log ( const char * filename , const char * str )
         fprintf ( file_stream,"%s\n", str );
         fflush (file_stream);
         fclose (file_stream);
+        daemon_watch_refresh ( filename );
         return (PASS);
     }
     return (FAIL_FILE_OPEN);
@@ -257,6 +265,22 @@ int daemon_log ( const char * filename , const char * str )
 unsigned int daemon_get_file_uint ( const char * filename )
 {
     unsigned int value = 0 ;
+
+    /* answered from memory if the file is watched ; see daemon_watch.cpp */
+    string line ;
+    if ( daemon_watch_content ( filename, line ) == true )
+    {
+        if ( line.empty() )
+        {
+            wlog ("failed to read integer from file:%s\n", filename );
+        }
+        else if ( sscanf ( line.c_str(), "%u", &value ) < 1 )
+        {
+            wlog ("failed to sscanf integer from file:%s\n", filename );
+        }
+        return ( value );
+    }
+
     FILE * __stream = fopen ( filename, "r" );
     if ( __stream != NULL )
     {
@@ -294,6 +318,22 @@ unsigned int daemon_get_file_uint ( const char * filename )
 int daemon_get_file_int ( const char * filename )
 {
     int    value = 0 ;
+
+    /* answered from memory if the file is watched ; see daemon_watch.cpp */
+    string line ;
+    if ( daemon_watch_content ( filename, line ) == true )
+    {
+        if ( line.empty() )
+        {
+            wlog ("failed to read integer from file:%s\n", filename );
+        }
+        else if ( sscanf ( line.c_str(), "%d", &value ) < 1 )
+        {
+            wlog ("failed to sscanf integer from file:%s\n", filename );
+        }
+        return ( value );
+    }
+
     FILE * __stream = fopen ( filename, "r" );
     if ( __stream != NULL )
     {
@@ -330,6 +370,21 @@ int daemon_get_file_int ( const char * filename )
 string daemon_get_file_str ( const char * filename )
 {
     string  value = "" ;
+
+    /* answered from memory if the file is watched ; see daemon_watch.cpp */
+    if ( daemon_watch_content ( filename, value ) == true )
+    {
+        if ( value.empty() )
+        {
+            wlog("no string data in %s", filename);
+        }
+        else if ( value[value.length()-1] == '\n' )
+        {
+            value.erase ( value.length()-1 );
+        }
+        return ( value );
+    }
+
     FILE * __stream = fopen ( filename, "r" );
     if ( __stream != NULL )
     {
@@ -996,6 +1051,7 @@ void daemon_logfile_open  ( void )
 
 void daemon_remove_file ( const char * filename )
 {
+    daemon_watch_refresh ( filename );
     if ( daemon_is_file_present ( filename ))
     {
         if ( remove(filename) )
@@ -1004,6 +1060,7 @@ void daemon_remove_file ( const char * filename )
         }
         else
         {
+            daemon_watch_refresh ( filename );
             if ( daemon_is_file_present ( filename ) )
             {
                 elog ("failed to remove file '%s' ; still present\n", filename );
@@ -1072,6 +1129,8 @@ void daemon_rename_file ( const char * path, const char * old_filename, const ch
             if ( rename ( _old.data(), _new.data()) == 0)
 	        {
 		        dlog ("file rename : %s -> %s\n", old_filename, new_filename);
+                daemon_watch_refresh ( _old.data() );
+                daemon_watch_refresh ( _new.data() );
 	        }
 	        else
 	        {
@@ -0,0 +1,414 @@
+/*
+ * Copyright (c) 2026 Wind River Systems, Inc.
+*
+* SPDX-License-Identifier: Apache-2.0
+*
+ */
+
+ /**
+  * @file
+  * Starling-X Maintenance Daemon Asynchronous Log Backend
+  *
+  * Every logMacros.h and threadUtil.h log macro ends in daemon_syslog.
+  * By default that is a synchronous vsyslog.
+  *
+  * With mtc.conf '[debug] log_async = syslog' or '= <file path>' the
+  * formatted line is instead copied into a preallocated lock-free
+  * multi-producer queue and a writer thread drains it in batches to
+  * syslog or appends it to the file. The logging thread never blocks
+  * on /dev/log ; if the queue is full the log is dropped and counted.
+  *
+  * Lines that do not fit a queue slot are logged synchronously.
+  * A child process created by fork logs synchronously.
+  * Queued logs are flushed on exit.
+  */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <stdarg.h>
+#include <string.h>
+#include <fcntl.h>
+#include <poll.h>
+#include <time.h>
+#include <signal.h>
+#include <pthread.h>
+#include <sched.h>
+#include <unistd.h>
+#include <sys/eventfd.h>
+
+using namespace std;
+
+#include "daemon_common.h" /* for ... daemon_log_async                 */
+#include "nodeBase.h"      /* for ... PASS, FAIL_xxxx                  */
+
+#define LOG_ASYNC_SLOTS      (1024)   /* must be a power of 2            */
+#define LOG_ASYNC_MSG_LEN    (1000)
+#define LOG_ASYNC_BATCH      (64)     /* logs per writer lock hold       */
+#define LOG_ASYNC_IDLE_MSECS (1000)   /* writer wakeup when idle         */
+
+typedef struct
+{
+    unsigned long long seq  ;         /**< queue sequence                */
+    unsigned long long nsec ;         /**< CLOCK_REALTIME at log time    */
+    int                prio ;
+    int                len  ;
+    char               msg [LOG_ASYNC_MSG_LEN] ;
+} log_async_slot_type ;
+
+typedef struct
+{
+    log_async_slot_type * slots      ;
+    unsigned long long    enqueue    ; /**< next producer sequence       */
+    unsigned long long    dequeue    ; /**< next consumer sequence       */
+    bool                  enabled    ;
+    bool                  sleeping   ; /**< writer waiting on event_fd   */
+    bool                  running    ; /**< writer thread running        */
+    unsigned int          inflight   ; /**< producers past enabled check */
+    int                   event_fd   ;
+    int                   file_fd    ; /**< 0 when writing to syslog     */
+    pthread_t             writer     ;
+    pthread_mutex_t       drain_lock ; /**< writer and flush consumers   */
+    char                  target [MAX_FILENAME_LEN] ;
+
+    unsigned long long    queued     ;
+    unsigned long long    written    ;
+    unsigned long long    dropped    ;
+    unsigned long long    oversize   ;
+    unsigned long long    reported   ; /**< dropped count last reported  */
+} log_async_type ;
+
+static log_async_type _log = { NULL, 0, 0, false, false, false, 0, 0, 0, 0,
+                               PTHREAD_MUTEX_INITIALIZER, { "none" },
+                               0, 0, 0, 0, 0 };
+
+/* a forked child has no writer thread */
+static void _log_async_atfork_child ( void )
+{
+    _log.enabled = false ;
+    _log.running = false ;
+}
+
+/*****************************************************************************
+ *
+ * Name       : _log_async_write
+ *
+ * Description: Write up to LOG_ASYNC_BATCH queued logs.
+ *              Caller holds drain_lock.
+ *
+ * Returns    : the number of logs written
+ *
+ ****************************************************************************/
+
+static int _log_async_write ( void )
+{
+    static char buf [LOG_ASYNC_BATCH*(LOG_ASYNC_MSG_LEN+32)] ;
+    size_t len = 0 ;
+    int    count = 0 ;
+
+    while ( count < LOG_ASYNC_BATCH )
+    {
+        log_async_slot_type * slot_ptr = &_log.slots[_log.dequeue & (LOG_ASYNC_SLOTS-1)] ;
+        if ( __atomic_load_n ( &slot_ptr->seq, __ATOMIC_ACQUIRE ) != _log.dequeue+1 )
+            break ; /* empty */
+
+        if ( slot_ptr->len )
+        {
+            if ( _log.file_fd )
+            {
+                struct tm t ;
+                time_t secs = (time_t)(slot_ptr->nsec/1000000000) ;
+                localtime_r ( &secs, &t );
+                len += strftime ( &buf[len], 32, "%FT%H:%M:%S", &t );
+                len += snprintf ( &buf[len], sizeof(buf)-len, ".%03llu %s",
+                                 (slot_ptr->nsec%1000000000)/1000000,
+                                  slot_ptr->msg );
+                if (( len ) && ( buf[len-1] != '\n' ))
+                    buf[len++] = '\n' ;
+            }
+            else
+            {
+                syslog ( slot_ptr->prio, "%s", slot_ptr->msg );
+            }
+        }
+        /* release the slot to producers one lap ahead */
+        __atomic_store_n ( &slot_ptr->seq, _log.dequeue+LOG_ASYNC_SLOTS, __ATOMIC_RELEASE );
+        _log.dequeue++ ;
+        count++ ;
+    }
+
+    if (( len ) && ( write ( _log.file_fd, buf, len ) < 0 ))
+    {
+        syslog ( LOG_INFO, "log_async write to %s failed (%d:%m)", _log.target, errno );
+    }
+    _log.written += count ;
+
+    unsigned long long dropped = __atomic_load_n ( &_log.dropped, __ATOMIC_RELAXED );
+    if ( dropped != _log.reported )
+    {
+        syslog ( LOG_INFO, "[%d.%05d] %s %s %-3s log queue full ; %llu logs dropped (%llu total)",
+                 getpid(), lc(), _hn(), _pn, "log", dropped-_log.reported, dropped );
+        _log.reported = dropped ;
+    }
+    return (count);
+}
+
+/* Drain the queue from the calling thread */
+void daemon_log_flush ( void )
+{
+    if ( _log.slots == NULL )
+        return ;
+
+    pthread_mutex_lock ( &_log.drain_lock );
+    while ( _log_async_write () ) ;
+    pthread_mutex_unlock ( &_log.drain_lock );
+}
+
+static void * _log_async_writer ( void * arg )
+{
+    UNUSED(arg);
+    struct pollfd pfd ;
+    pfd.fd     = _log.event_fd ;
+    pfd.events = POLLIN ;
+
+    while ( __atomic_load_n ( &_log.running, __ATOMIC_ACQUIRE ))
+    {
+        pthread_mutex_lock ( &_log.drain_lock );
+        int count = _log_async_write ();
+        pthread_mutex_unlock ( &_log.drain_lock );
+        if ( count )
+            continue ;
+
+        /* Tell producers to wake us and check once more
+         * before sleeping so a log is never stranded. */
+        __atomic_store_n ( &_log.sleeping, true, __ATOMIC_SEQ_CST );
+        log_async_slot_type * slot_ptr = &_log.slots[_log.dequeue & (LOG_ASYNC_SLOTS-1)] ;
+        if ( __atomic_load_n ( &slot_ptr->seq, __ATOMIC_SEQ_CST ) != _log.dequeue+1 )
+        {
+            if ( poll ( &pfd, 1, LOG_ASYNC_IDLE_MSECS ) > 0 )
+            {
+                uint64_t events ;
+                if ( read ( _log.event_fd, &events, sizeof(events)) < 0 ) { ; }
+            }
+        }
+        __atomic_store_n ( &_log.sleeping, false, __ATOMIC_RELAXED );
+    }
+    daemon_log_flush ();
+    return (NULL);
+}
+
+static void _log_async_stop ( void )
+{
+    if ( _log.running == false )
+        return ;
+
+    __atomic_store_n ( &_log.enabled, false, __ATOMIC_SEQ_CST );
+    __atomic_store_n ( &_log.running, false, __ATOMIC_RELEASE );
+    uint64_t wake = 1 ;
+    if ( write ( _log.event_fd, &wake, sizeof(wake)) < 0 ) { ; }
+    pthread_join ( _log.writer, NULL );
+
+    /* A producer that saw enabled just before it was cleared can still
+     * be publishing its slot ; wait for it and write what it queued */
+    while ( __atomic_load_n ( &_log.inflight, __ATOMIC_SEQ_CST ))
+        sched_yield ();
+    daemon_log_flush ();
+
+    if ( _log.file_fd )
+    {
+        close ( _log.file_fd );
+        _log.file_fd = 0 ;
+    }
+}
+
+static void _log_async_exit ( void )
+{
+    _log_async_stop ();
+}
+
+/*****************************************************************************
+ *
+ * Name       : daemon_log_async
+ *
+ * Description: Select the log backend.
+ *
+ *   "none"      - synchronous syslog ; the default
+ *   "syslog"    - asynchronous, batched to syslog by a writer thread
+ *   "/a/path"   - asynchronous, batched and appended to this file
+ *
+ * Called again on config reload ; only acts on a change.
+ *
+ ****************************************************************************/
+
+int daemon_log_async ( const char * target )
+{
+    if (( target == NULL ) || ( target[0] == '\0' ))
+        target = "none" ;
+
+    if ( strcmp ( target, _log.target ) == 0 )
+        return (PASS);
+
+    if ( strcmp ( target, "none" ) && strcmp ( target, "syslog" ) && ( target[0] != '/' ))
+    {
+        elog ("invalid log_async target '%s' ; expecting none, syslog or a file path\n", target );
+        return (FAIL_INVALID_DATA);
+    }
+
+    _log_async_stop ();
+    snprintf ( &_log.target[0], sizeof(_log.target), "%s", target );
+    if ( strcmp ( target, "none" ) == 0 )
+    {
+        ilog ("Log Async   : disabled (%llu written, %llu dropped, %llu oversize)\n",
+                  _log.written, _log.dropped, _log.oversize );
+        return (PASS);
+    }
+
+    /* one time allocation ; kept for the life of the process */
+    if ( _log.slots == NULL )
+    {
+        _log.slots = (log_async_slot_type*)calloc ( LOG_ASYNC_SLOTS, sizeof(log_async_slot_type));
+        _log.event_fd = eventfd ( 0, EFD_NONBLOCK | EFD_CLOEXEC );
+        if (( _log.slots == NULL ) || ( _log.event_fd < 0 ))
+        {
+            elog ("log_async init failed (%d:%m)\n", errno );
+            free ( _log.slots );
+            _log.slots = NULL ;
+            snprintf ( &_log.target[0], sizeof(_log.target), "none" );
+            return (FAIL_OPERATION);
+        }
+        for ( unsigned long long i = 0 ; i < LOG_ASYNC_SLOTS ; i++ )
+            _log.slots[i].seq = i ;
+        pthread_atfork ( NULL, NULL, _log_async_atfork_child );
+        atexit ( _log_async_exit );
+    }
+
+    if ( target[0] == '/' )
+    {
+        _log.file_fd = open ( target, O_WRONLY | O_CREAT | O_APPEND | O_CLOEXEC, 0640 );
+        if ( _log.file_fd < 0 )
+        {
+            elog ("log_async failed to open %s (%d:%m)\n", target, errno );
+            _log.file_fd = 0 ;
+            snprintf ( &_log.target[0], sizeof(_log.target), "none" );
+            return (FAIL_FILE_OPEN);
+        }
+    }
+
+    /* the writer takes no signals */
+    sigset_t all, prev ;
+    sigfillset ( &all );
+    pthread_sigmask ( SIG_SETMASK, &all, &prev );
+    _log.running = true ;
+    int rc = pthread_create ( &_log.writer, NULL, _log_async_writer, NULL );
+    pthread_sigmask ( SIG_SETMASK, &prev, NULL );
+    if ( rc )
+    {
+        _log.running = false ;
+        if ( _log.file_fd )
+        {
+            close ( _log.file_fd );
+            _log.file_fd = 0 ;
+        }
+        snprintf ( &_log.target[0], sizeof(_log.target), "none" );
+        elog ("log_async writer thread create failed (rc:%d)\n", rc );
+        return (FAIL_THREAD_CREATE);
+    }
+    __atomic_store_n ( &_log.enabled, true, __ATOMIC_RELEASE );
+    ilog ("Log Async   : %s (%d slots)\n", _log.target, LOG_ASYNC_SLOTS );
+    return (PASS);
+}
+
+/*****************************************************************************
+ *
+ * Name       : daemon_syslog
+ *
+ * Description: The log macro backend. Queue the log if the asynchronous
+ *              backend is enabled ; otherwise syslog it now.
+ *
+ ****************************************************************************/
+
+void daemon_syslog ( int priority, const char * format, ... )
+{
+    va_list args ;
+    va_start ( args, format );
+
+    /* counted in flight before the enabled check so that a stop that
+     * clears enabled can wait for this log to be published */
+    __atomic_add_fetch ( &_log.inflight, 1, __ATOMIC_SEQ_CST );
+    if ( __atomic_load_n ( &_log.enabled, __ATOMIC_SEQ_CST ) == false )
+    {
+        __atomic_sub_fetch ( &_log.inflight, 1, __ATOMIC_RELEASE );
+        vsyslog ( priority, format, args );
+        va_end ( args );
+        return ;
+    }
+
+    /* claim a slot ; Vyukov bounded queue */
+    log_async_slot_type * slot_ptr ;
+    unsigned long long pos = __atomic_load_n ( &_log.enqueue, __ATOMIC_RELAXED );
+    for ( ; ; )
+    {
+        slot_ptr = &_log.slots[pos & (LOG_ASYNC_SLOTS-1)] ;
+        unsigned long long seq = __atomic_load_n ( &slot_ptr->seq, __ATOMIC_ACQUIRE );
+        long long dif = (long long)seq - (long long)pos ;
+        if ( dif == 0 )
+        {
+            if ( __atomic_compare_exchange_n ( &_log.enqueue, &pos, pos+1, true,
+                                               __ATOMIC_RELAXED, __ATOMIC_RELAXED ))
+                break ;
+        }
+        else if ( dif < 0 )
+        {
+            /* full */
+            __atomic_add_fetch ( &_log.dropped, 1, __ATOMIC_RELAXED );
+            __atomic_sub_fetch ( &_log.inflight, 1, __ATOMIC_RELEASE );
+            va_end ( args );
+            return ;
+        }
+        else
+        {
+            pos = __atomic_load_n ( &_log.enqueue, __ATOMIC_RELAXED );
+        }
+    }
+
+    struct timespec ts ;
+    clock_gettime ( CLOCK_REALTIME, &ts );
+    slot_ptr->nsec = ((unsigned long long)ts.tv_sec*1000000000)+ts.tv_nsec ;
+    slot_ptr->prio = priority ;
+
+    va_list copy ;
+    va_copy ( copy, args );
+    int len = vsnprintf ( &slot_ptr->msg[0], LOG_ASYNC_MSG_LEN, format, args );
+    if (( len < 0 ) || ( len >= LOG_ASYNC_MSG_LEN ))
+    {
+        /* too big for a slot ; log it now and skip the slot */
+        __atomic_add_fetch ( &_log.oversize, 1, __ATOMIC_RELAXED );
+        vsyslog ( priority, format, copy );
+        len = 0 ;
+    }
+    va_end ( copy );
+    va_end ( args );
+    slot_ptr->len = len ;
+
+    __atomic_store_n ( &slot_ptr->seq, pos+1, __ATOMIC_RELEASE );
+    __atomic_add_fetch ( &_log.queued, 1, __ATOMIC_RELAXED );
+    __atomic_sub_fetch ( &_log.inflight, 1, __ATOMIC_RELEASE );
+
+    /* wake the writer only if it went to sleep */
+    if ( __atomic_exchange_n ( &_log.sleeping, false, __ATOMIC_SEQ_CST ))
+    {
+        uint64_t wake = 1 ;
+        if ( write ( _log.event_fd, &wake, sizeof(wake)) < 0 ) { ; }
+    }
+}
+
+void daemon_log_async_dump ( void )
+{
+    if ( strcmp ( _log.target, "none" ) == 0 )
+        return ;
+    syslog ( LOG_INFO, "Log Async   : %s ; queued:%llu written:%llu dropped:%llu oversize:%llu",
+                       _log.target,
+                       __atomic_load_n ( &_log.queued, __ATOMIC_RELAXED ),
+                       _log.written,
+                       __atomic_load_n ( &_log.dropped, __ATOMIC_RELAXED ),
+                       __atomic_load_n ( &_log.oversize, __ATOMIC_RELAXED ));
+}
@@ -36,6 +36,7 @@ bool testing = false ;
 #include "daemon_common.h"
 #include "nodeBase.h"
 #include "nodeUtil.h"         /* for ... mem_log_list_init */
+#include "flightRecorder.h"   /* for ... flightRecorder_init */
 
 /** 
  * Cache a copy of the current hostname.  
@@ -392,6 +393,12 @@ int main(int argc, char *argv[])
 
    mem_log_list_init ( );
 
+   /* Start the binary flight recorder ; /dev/shm/<daemon>.flight */
+   if ( flightRecorder_init ( program_invocation_short_name ) != PASS )
+   {
+       wlog ("Flight recorder file create failed ; recording in memory only\n");
+   }
+
    /* Init the daemon config structure */
    daemon_config_default ( daemon_get_cfg_ptr() );
 
@@ -432,6 +439,10 @@ int main(int argc, char *argv[])
            testing = true ;
        }
        ilog ("Build Date  : %s\n", BUILDINFO);
+       if ( flightRecorder_file()[0] != '\0' )
+       {
+           ilog ("Flight Rec  : %s\n", flightRecorder_file());
+       }
        ilog ("------------------------------------------------------\n");
 
        /* Call the test head if test mode is selected.
@@ -0,0 +1,223 @@
+/*
+ * Copyright (c) 2026 Wind River Systems, Inc.
+*
+* SPDX-License-Identifier: Apache-2.0
+*
+ */
+
+ /**
+  * @file
+  * Wind River CGTS Platform Maintenance Daemon Event Reactor
+  *
+  * The maintenance daemons used to rebuild an fd_set of their sockets
+  * and select on it every pass of their main loop.
+  *
+  * Instead a daemon can register each of its file descriptors ; sockets,
+  * netlink, inotify, the timer wheel timerfd and the like, once with
+  * daemon_reactor_add along with the handler to call when it is readable.
+  * Its main loop then calls daemon_reactor_run which waits on an epoll
+  * set for up to the supplied timeout and calls the handler of each file
+  * descriptor that is ready.
+  *
+  * Descriptors are level triggered so a handler that services only a
+  * batch of what is pending is simply called again on the next pass.
+  *
+  * A descriptor that is closed and reopened, i.e. a socket re-init, must
+  * be removed with daemon_reactor_del before it is closed and added again
+  * once it is reopened. Removing a descriptor from within a handler is
+  * safe ; any event already collected for it in that pass is dropped.
+  */
+
+#include <stdio.h>
+#include <string.h>
+#include <unistd.h>
+#include <errno.h>
+#include <sys/epoll.h>
+#include <vector>
+
+using namespace std;
+
+#include "daemon_common.h" /* for ... daemon_reactor_* prototypes   */
+
+/* max events collected from a single epoll_wait */
+#define DAEMON_REACTOR_EVENTS (64)
+
+typedef struct
+{
+    daemon_reactor_handler_type handler ; /* NULL if not registered */
+    void *                      ctx     ; /* passed to the handler  */
+    unsigned int                gen     ; /* registration generation*/
+    unsigned long long          fired   ; /* times dispatched       */
+} daemon_reactor_fd_type ;
+
+static int _reactor_fd = -1 ;
+
+/* registrations indexed by file descriptor */
+static vector<daemon_reactor_fd_type> _reactor_fds ;
+
+/* bumped on every add so a stale event for a reused fd is dropped */
+static unsigned int _reactor_gen = 0 ;
+
+static unsigned int       _reactor_registered = 0 ;
+static unsigned long long _reactor_waits      = 0 ;
+static unsigned long long _reactor_timeouts   = 0 ;
+static unsigned long long _reactor_dispatched = 0 ;
+static unsigned long long _reactor_stale      = 0 ;
+
+int daemon_reactor_init ( void )
+{
+    if ( _reactor_fd >= 0 )
+        return (PASS);
+
+    _reactor_fd = epoll_create1 ( EPOLL_CLOEXEC );
+    if ( _reactor_fd < 0 )
+    {
+        elog ("failed to create reactor epoll set (%d:%m)", errno );
+        return (FAIL_SOCKET_CREATE);
+    }
+    return (PASS);
+}
+
+void daemon_reactor_fini ( void )
+{
+    if ( _reactor_fd >= 0 )
+    {
+        close ( _reactor_fd );
+        _reactor_fd = -1 ;
+    }
+    _reactor_fds.clear();
+    _reactor_registered = 0 ;
+}
+
+int daemon_reactor_add ( int fd, daemon_reactor_handler_type handler, void * ctx )
+{
+    if (( fd < 0 ) || ( handler == NULL ))
+        return (FAIL_BAD_PARM);
+
+    if (( _reactor_fd < 0 ) && ( daemon_reactor_init () != PASS ))
+        return (FAIL_SOCKET_CREATE);
+
+    if ( (unsigned int)fd >= _reactor_fds.size() )
+    {
+        daemon_reactor_fd_type empty ;
+        memset ( &empty, 0, sizeof(empty));
+        _reactor_fds.resize ( fd+1, empty );
+    }
+
+    daemon_reactor_fd_type & entry = _reactor_fds[fd] ;
+    bool modify = ( entry.handler != NULL );
+
+    entry.handler = handler ;
+    entry.ctx     = ctx     ;
+    entry.gen     = ++_reactor_gen ;
+
+    struct epoll_event event ;
+    memset ( &event, 0, sizeof(event));
+    event.events   = EPOLLIN ;
+    event.data.u64 = ((unsigned long long)entry.gen << 32) | (unsigned int)fd ;
+    int rc = epoll_ctl ( _reactor_fd, modify ? EPOLL_CTL_MOD : EPOLL_CTL_ADD, fd, &event );
+
+    /* a registered fd that was closed without being removed is no
+     * longer in the set ; this is a new descriptor with the same number */
+    if (( rc != 0 ) && ( modify == true ) && ( errno == ENOENT ))
+        rc = epoll_ctl ( _reactor_fd, EPOLL_CTL_ADD, fd, &event );
+    if ( rc != 0 )
+    {
+        elog ("failed to add fd:%d to reactor (%d:%m)", fd, errno );
+        entry.handler = NULL ;
+        entry.ctx     = NULL ;
+        if ( modify )
+            _reactor_registered-- ;
+        return (FAIL_OPERATION);
+    }
+    if ( modify == false )
+        _reactor_registered++ ;
+    return (PASS);
+}
+
+int daemon_reactor_del ( int fd )
+{
+    if (( fd < 0 ) || ( (unsigned int)fd >= _reactor_fds.size() ) ||
+        ( _reactor_fds[fd].handler == NULL ))
+    {
+        return (FAIL_NOT_FOUND);
+    }
+
+    /* the fd may already be closed ; that removed it from the set */
+    epoll_ctl ( _reactor_fd, EPOLL_CTL_DEL, fd, NULL );
+
+    _reactor_fds[fd].handler = NULL ;
+    _reactor_fds[fd].ctx     = NULL ;
+    _reactor_fds[fd].fired   = 0    ;
+    _reactor_registered-- ;
+    return (PASS);
+}
+
+bool daemon_reactor_registered ( int fd )
+{
+    return (( fd >= 0 ) && ( (unsigned int)fd < _reactor_fds.size() ) &&
+            ( _reactor_fds[fd].handler != NULL ));
+}
+
+int daemon_reactor_run ( int timeout_msecs )
+{
+    if ( _reactor_fd < 0 )
+    {
+        /* nothing registered ; still honour the wait */
+        if ( timeout_msecs > 0 )
+            usleep ( timeout_msecs*1000 );
+        return (0);
+    }
+
+    struct epoll_event events[DAEMON_REACTOR_EVENTS] ;
+    _reactor_waits++ ;
+    int count = epoll_wait ( _reactor_fd, events, DAEMON_REACTOR_EVENTS, timeout_msecs );
+    if ( count < 0 )
+    {
+        if ( errno != EINTR )
+        {
+            elog ("reactor wait failed (%d:%m)", errno );
+            return (-1);
+        }
+        return (0);
+    }
+    if ( count == 0 )
+    {
+        _reactor_timeouts++ ;
+        return (0);
+    }
+
+    int dispatched = 0 ;
+    for ( int i = 0 ; i < count ; i++ )
+    {
+        int          fd  = (int)(events[i].data.u64 & 0xffffffff) ;
+        unsigned int gen = (unsigned int)(events[i].data.u64 >> 32) ;
+
+        /* removed, or removed and re-added, by an earlier handler */
+        if (( (unsigned int)fd >= _reactor_fds.size() ) ||
+            ( _reactor_fds[fd].handler == NULL ) ||
+            ( _reactor_fds[fd].gen != gen ))
+        {
+            _reactor_stale++ ;
+            continue ;
+        }
+        _reactor_fds[fd].fired++ ;
+        _reactor_dispatched++ ;
+        dispatched++ ;
+        _reactor_fds[fd].handler ( fd, _reactor_fds[fd].ctx );
+    }
+    return (dispatched);
+}
+
+void daemon_reactor_dump ( void )
+{
+    if ( _reactor_fd < 0 )
+        return ;
+
+    ilog ("Reactor     : %u fds ; %llu waits (%llu timeouts) ; %llu dispatched ; %llu stale",
+              _reactor_registered, _reactor_waits, _reactor_timeouts,
+              _reactor_dispatched, _reactor_stale );
+    for ( unsigned int fd = 0 ; fd < _reactor_fds.size() ; fd++ )
+        if ( _reactor_fds[fd].handler )
+            ilog ("Reactor     : fd:%-4u fired %llu times", fd, _reactor_fds[fd].fired );
+}
@@ -95,6 +95,9 @@ void __signal_hdlr ( int signo, siginfo_t * siginfo_ptr , void * uc )
 
 void daemon_signal_hdlr ( void )
 {
+    /* dispatch any expired timer wheel timers */
+    mtcTimer_wheel_service ();
+
     /* Monitor base level signal handler scheduling latency */
     if (( __signal_init_done ) && ( __signal_want_latency_monitor ))
     {
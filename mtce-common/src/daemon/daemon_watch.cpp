@@ -0,0 +1,369 @@
+/*
+ * Copyright (c) 2026 Wind River Systems, Inc.
+*
+* SPDX-License-Identifier: Apache-2.0
+*
+ */
+
+ /**
+  * @file
+  * Wind River CGTS Platform Maintenance Daemon Flag File Watch Service
+  *
+  * The maintenance daemons test for flag, fit and pid files with
+  * daemon_is_file_present and read them with daemon_get_file_int/str
+  * from their main loops and audits ; a stat or open per check.
+  *
+  * A daemon can instead register the files it polls with
+  * daemon_watch_file. The directory of each is watched with inotify and
+  * the presence of the file, along with its first line once it has been
+  * read, is kept in memory. daemon_is_file_present and
+  * daemon_get_file_int/str then answer registered files from memory.
+  *
+  * The daemon adds daemon_watch_fd to its main loop select and calls
+  * daemon_watch_handler when it fires. Files whose directory cannot be
+  * watched, and all files when inotify is not available, are checked on
+  * the filesystem as before.
+  */
+
+#include <stdio.h>
+#include <string.h>
+#include <unistd.h>
+#include <errno.h>
+#include <pthread.h>
+#include <sys/inotify.h>
+#include <sys/stat.h>
+#include <list>
+#include <vector>
+#include <unordered_map>
+
+using namespace std;
+
+#include "daemon_common.h" /* for ... daemon_watch_* prototypes     */
+#include "nodeBase.h"      /* for ... MAX_CHARS_ON_LINE             */
+
+#define DAEMON_WATCH_EVENTS ( IN_CREATE     | IN_DELETE   | \
+                              IN_MOVED_FROM | IN_MOVED_TO | \
+                              IN_MODIFY     | IN_CLOSE_WRITE )
+
+typedef struct
+{
+    string dir           ; /* directory that is watched              */
+    string name          ; /* file name within that directory        */
+    int    wd            ; /* directory watch descriptor or -1       */
+    bool   present       ; /* cached presence ; valid if wd >= 0     */
+    bool   content_valid ; /* content holds the current first line   */
+    string content       ; /* first line of the file                 */
+    daemon_watch_callback_type callback ; /* called on presence change */
+} daemon_watch_file_type ;
+
+static int _watch_fd = -1 ;
+
+/* registered files and the files under each directory watch */
+static unordered_map<string, daemon_watch_file_type> _watch_files ;
+static unordered_map<int, list<string> >             _watch_dirs  ;
+
+/* lookups may come from threads ; the tables change in the main loop */
+static pthread_mutex_t _watch_mutex = PTHREAD_MUTEX_INITIALIZER ;
+
+static daemon_watch_stats_type _watch_stats ;
+
+/* presence check of daemon_is_file_present without the cache */
+static bool _watch_stat ( const char * filename )
+{
+    struct stat p ;
+    memset ( &p, 0 , sizeof(struct stat));
+    stat ( filename, &p ) ;
+    return (( p.st_ino != 0 ) && ( p.st_dev != 0 ));
+}
+
+/* read the first line of 'filename' the way daemon_get_file_str does */
+static bool _watch_read_line ( const char * filename, string & line )
+{
+    FILE * __stream = fopen ( filename, "r" );
+    if ( __stream == NULL )
+        return (false);
+
+    char buffer [MAX_CHARS_ON_LINE] ;
+    memset ( buffer, 0, MAX_CHARS_ON_LINE );
+    if ( fgets ( buffer, MAX_CHARS_ON_LINE, __stream ) == NULL )
+        buffer[0] = '\0' ;
+    fclose ( __stream );
+    line = buffer ;
+    return (true);
+}
+
+/* (re)add the directory watch of 'file' and load its presence.
+ * Called with the mutex held. */
+static void _watch_load ( const string & filename, daemon_watch_file_type & file )
+{
+    int wd = inotify_add_watch ( _watch_fd, file.dir.c_str(), DAEMON_WATCH_EVENTS );
+    if ( wd != file.wd )
+    {
+        if ( file.wd >= 0 )
+            _watch_dirs[file.wd].remove ( filename );
+        if ( wd >= 0 )
+            _watch_dirs[wd].push_back ( filename );
+        else
+            dlog ("%s not watched ; %s (%d:%m)", filename.c_str(), file.dir.c_str(), errno );
+        file.wd = wd ;
+    }
+    /* load presence after the watch is in place so no change is missed */
+    file.present = _watch_stat ( filename.c_str() );
+    file.content_valid = false ;
+}
+
+int daemon_watch_init ( void )
+{
+    daemon_watch_fini ();
+
+    _watch_fd = inotify_init1 ( IN_NONBLOCK | IN_CLOEXEC );
+    if ( _watch_fd < 0 )
+    {
+        elog ("file watch inotify init error (%d:%m) ; using stat", errno );
+        return (FAIL_FILE_ACCESS);
+    }
+    MEMSET_ZERO ( _watch_stats );
+    return (PASS);
+}
+
+void daemon_watch_fini ( void )
+{
+    pthread_mutex_lock ( &_watch_mutex );
+    if ( _watch_fd >= 0 )
+        close ( _watch_fd ); /* removes all its watches */
+    _watch_fd = -1 ;
+    _watch_files.clear();
+    _watch_dirs.clear();
+    pthread_mutex_unlock ( &_watch_mutex );
+}
+
+int daemon_watch_fd ( void )
+{
+    return (_watch_fd);
+}
+
+int daemon_watch_file ( const char * filename, daemon_watch_callback_type callback )
+{
+    if ( _watch_fd < 0 )
+        return (FAIL_NOT_ACTIVE);
+
+    const char * slash = strrchr ( filename, '/' );
+    if (( slash == NULL ) || ( slash[1] == '\0' ))
+    {
+        wlog ("cannot watch '%s' ; full file path required", filename );
+        return (FAIL_INVALID_DATA);
+    }
+
+    pthread_mutex_lock ( &_watch_mutex );
+    daemon_watch_file_type & file = _watch_files[filename] ;
+    if ( file.name.empty() )
+    {
+        file.dir  = ( slash == filename ) ? string("/") : string ( filename, slash - filename );
+        file.name = slash + 1 ;
+        file.wd   = -1 ;
+        file.content_valid = false ;
+    }
+    file.callback = callback ;
+    _watch_load ( filename, file );
+    int rc = ( file.wd >= 0 ) ? PASS : FAIL_FILE_ACCESS ;
+    pthread_mutex_unlock ( &_watch_mutex );
+    return (rc);
+}
+
+void daemon_watch_handler ( void )
+{
+    char buf [4096] __attribute__ ((aligned(__alignof__(struct inotify_event))));
+    list<int> reload_wds ;
+    bool      reload_all = false ;
+    vector<pair<daemon_watch_callback_type, pair<string,bool> > > callbacks ;
+
+    if ( _watch_fd < 0 )
+        return ;
+
+    pthread_mutex_lock ( &_watch_mutex );
+    for ( ; ; )
+    {
+        ssize_t len = read ( _watch_fd, buf, sizeof(buf));
+        if ( len <= 0 )
+            break ;
+
+        for ( char * ptr = buf ; ptr < buf + len ; )
+        {
+            struct inotify_event * event_ptr = (struct inotify_event *)ptr ;
+            ptr += sizeof(struct inotify_event) + event_ptr->len ;
+            _watch_stats.events++ ;
+
+            if ( event_ptr->mask & IN_Q_OVERFLOW )
+            {
+                reload_all = true ;
+                continue ;
+            }
+            if ( event_ptr->mask & IN_IGNORED )
+            {
+                /* the directory was removed or moved */
+                reload_wds.push_back ( event_ptr->wd );
+                continue ;
+            }
+            if ( event_ptr->len == 0 )
+                continue ;
+
+            unordered_map<int, list<string> >::iterator dir_it = _watch_dirs.find ( event_ptr->wd );
+            if ( dir_it == _watch_dirs.end() )
+                continue ;
+
+            for ( list<string>::iterator it = dir_it->second.begin() ; it != dir_it->second.end() ; ++it )
+            {
+                daemon_watch_file_type & file = _watch_files[*it] ;
+                if ( file.name.compare ( event_ptr->name ) )
+                    continue ;
+
+                file.content_valid = false ;
+                if ( event_ptr->mask & ( IN_CREATE | IN_MOVED_TO | IN_DELETE | IN_MOVED_FROM ))
+                {
+                    bool present = ( event_ptr->mask & ( IN_CREATE | IN_MOVED_TO )) ? true : false ;
+                    if ( file.present != present )
+                    {
+                        dlog ("%s %s", it->c_str(), present ? "created" : "removed" );
+                        file.present = present ;
+                        if ( file.callback )
+                            callbacks.push_back ( make_pair ( file.callback, make_pair ( *it, present )));
+                    }
+                }
+            }
+        }
+    }
+
+    if ( reload_all )
+    {
+        wlog ("file watch event queue overflow ; reloading %ld files", (long)_watch_files.size());
+        for ( unordered_map<string, daemon_watch_file_type>::iterator it = _watch_files.begin() ;
+              it != _watch_files.end() ; ++it )
+        {
+            bool present = it->second.present ;
+            _watch_load ( it->first, it->second );
+            if (( it->second.callback ) && ( present != it->second.present ))
+                callbacks.push_back ( make_pair ( it->second.callback, make_pair ( it->first, it->second.present )));
+        }
+        _watch_stats.reloads++ ;
+    }
+    else
+    {
+        for ( list<int>::iterator wd_it = reload_wds.begin() ; wd_it != reload_wds.end() ; ++wd_it )
+        {
+            /* copy ; _watch_load moves files between directory lists */
+            list<string> filenames = _watch_dirs[*wd_it] ;
+            _watch_dirs.erase ( *wd_it );
+            for ( list<string>::iterator it = filenames.begin() ; it != filenames.end() ; ++it )
+            {
+                daemon_watch_file_type & file = _watch_files[*it] ;
+                bool present = file.present ;
+                file.wd = -1 ;
+                _watch_load ( *it, file );
+                if (( file.callback ) && ( present != file.present ))
+                    callbacks.push_back ( make_pair ( file.callback, make_pair ( *it, file.present )));
+            }
+            _watch_stats.reloads++ ;
+        }
+    }
+    pthread_mutex_unlock ( &_watch_mutex );
+
+    for ( size_t i = 0 ; i < callbacks.size() ; i++ )
+        callbacks[i].first ( callbacks[i].second.first.c_str(), callbacks[i].second.second );
+}
+
+/* Reload a watched file now rather than when its event is serviced.
+ * Used where the daemon itself creates, writes or removes the file and
+ * may test for it again before returning to its main loop select. */
+void daemon_watch_refresh ( const char * filename )
+{
+    if ( _watch_fd < 0 )
+        return ;
+
+    daemon_watch_callback_type callback = NULL ;
+    bool present = false ;
+    pthread_mutex_lock ( &_watch_mutex );
+    unordered_map<string, daemon_watch_file_type>::iterator it = _watch_files.find ( filename );
+    if (( it != _watch_files.end() ) && ( it->second.wd >= 0 ))
+    {
+        present = _watch_stat ( filename );
+        if ( present != it->second.present )
+            callback = it->second.callback ;
+        it->second.present = present ;
+        it->second.content_valid = false ;
+    }
+    pthread_mutex_unlock ( &_watch_mutex );
+
+    if ( callback )
+        callback ( filename, present );
+}
+
+/* cached presence of a watched file ; false if it is not watched */
+bool daemon_watch_present ( const char * filename, bool & present )
+{
+    if ( _watch_fd < 0 )
+        return (false);
+
+    bool cached = false ;
+    pthread_mutex_lock ( &_watch_mutex );
+    unordered_map<string, daemon_watch_file_type>::iterator it = _watch_files.find ( filename );
+    if (( it != _watch_files.end() ) && ( it->second.wd >= 0 ))
+    {
+        present = it->second.present ;
+        cached = true ;
+        _watch_stats.stat_avoided++ ;
+    }
+    pthread_mutex_unlock ( &_watch_mutex );
+    return (cached);
+}
+
+/* cached first line of a watched file that is present ; the file is
+ * read on the first request after each change. False if the file is
+ * not watched, not present or could not be read. */
+bool daemon_watch_content ( const char * filename, string & line )
+{
+    if ( _watch_fd < 0 )
+        return (false);
+
+    bool cached = false ;
+    pthread_mutex_lock ( &_watch_mutex );
+    unordered_map<string, daemon_watch_file_type>::iterator it = _watch_files.find ( filename );
+    if (( it != _watch_files.end() ) && ( it->second.wd >= 0 ) && ( it->second.present ))
+    {
+        if ( it->second.content_valid )
+        {
+            _watch_stats.read_avoided++ ;
+            cached = true ;
+        }
+        else if ( _watch_read_line ( filename, it->second.content ) == true )
+        {
+            it->second.content_valid = true ;
+            cached = true ;
+        }
+        if ( cached )
+            line = it->second.content ;
+    }
+    pthread_mutex_unlock ( &_watch_mutex );
+    return (cached);
+}
+
+void daemon_watch_stats ( daemon_watch_stats_type & stats )
+{
+    pthread_mutex_lock ( &_watch_mutex );
+    stats = _watch_stats ;
+    stats.files = _watch_files.size();
+    stats.dirs  = _watch_dirs.size();
+    pthread_mutex_unlock ( &_watch_mutex );
+}
+
+void daemon_watch_dump ( void )
+{
+    daemon_watch_stats_type stats ;
+    daemon_watch_stats ( stats );
+    if ( _watch_fd >= 0 )
+    {
+        ilog ("File Watch  : %lu files in %lu dirs ; %llu stat and %llu reads avoided ; %llu events %llu reloads",
+                stats.files, stats.dirs,
+                stats.stat_avoided, stats.read_avoided,
+                stats.events, stats.reloads );
+    }
+}
@@ -74,8 +74,16 @@ typedef struct
     string  prefix    ;
     FMTimeT timestamp ;
 
+    /* queue management */
+    unsigned long long queued  ; /* monotonic nsec when queued    */
+    unsigned long long retry   ; /* monotonic nsec of next retry  */
+    int                retries ; /* failed retryable submissions  */
+
 } queue_entry_type;
 
+/* Maximum number of FM submissions per alarmMgr_service_queue call */
+#define MAX_ALARMS_PER_SERVICE (50)
+
 #define MAX_FAILED_B2B_RECEIVES_B4_RESTART   (5)
 
 
@@ -106,7 +114,8 @@ int alarmHdlr_request_handler ( char * msg_ptr );
 
 void alarmMgr_queue_clear ( void );
 void alarmMgr_queue_alarm (queue_entry_type entry);
-void alarmMgr_service_queue(void);
+int  alarmMgr_service_queue(void);
+void alarmMgr_dump_stats  (void);
 
 int alarmUtil_clear        ( string hostname, string alarm_id, string entity );
 int alarmUtil_critical     ( string hostname, string alarm_id, string entity, FMTimeT & timestamp );
@@ -69,60 +69,46 @@ void _timer_handler ( int sig, siginfo_t *si, void *uc)
 int alarmHdlr_request_handler ( char * msg_ptr )
 {
     int rc = FAIL_JSON_PARSE ;
-    struct json_object *raw_obj = json_tokener_parse( msg_ptr );
+    jsonUtil_doc_type doc ;
     jlog ("Alarm Request: %s\n", msg_ptr );
-    if ( raw_obj )
+
+    /* Parse the request once and walk the alarm array in place */
+    if ( jsonUtil_doc_parse ( doc, msg_ptr ) == PASS )
     {
         int elements ;
 
         /* Check response sanity */
-        rc = jsonUtil_array_elements ( msg_ptr, MTCALARM_REQ_LABEL, elements );
+        struct json_object * array_obj =
+        jsonUtil_get_array ( doc.root, MTCALARM_REQ_LABEL, elements );
         if ( elements )
         {
             #define PARSE_FAILURE ((const char *)"failed to parse value for key")
             queue_entry_type entry ;
-            string alarm_req = "" ;
             string operation = "" ;
             string severity = "" ;
+            rc = PASS ;
             for ( int i = 0 ; i < elements ; i++ )
             {
-                if ( ( rc = jsonUtil_get_array_idx ( msg_ptr, MTCALARM_REQ_LABEL, i, alarm_req ) ) == PASS )
+                struct json_object * alarm_obj = jsonUtil_get_array_obj ( array_obj, i );
+                if ( alarm_obj && json_object_is_type ( alarm_obj, json_type_object ))
                 {
-                    if (( rc = jsonUtil_get_key_val ( (char*)alarm_req.data(), MTCALARM_REQ_KEY__ALARMID, entry.alarmid )) != PASS )
-                    {
-                     elog ("%s '%s'\n", PARSE_FAILURE, MTCALARM_REQ_KEY__ALARMID);
-                    }
-                    else if (( rc = jsonUtil_get_key_val ( (char*)alarm_req.data(), MTCALARM_REQ_KEY__HOSTNAME, entry.hostname )) != PASS )
-                    {
-                       elog ("%s '%s'\n", PARSE_FAILURE, MTCALARM_REQ_KEY__HOSTNAME);
-                    }
-                    else if (( rc = jsonUtil_get_key_val ( (char*)alarm_req.data(), MTCALARM_REQ_KEY__OPERATION, operation )) != PASS )
-                    {
-                       elog ("%s '%s'\n", PARSE_FAILURE, MTCALARM_REQ_KEY__OPERATION);
-                    }
-                    else if (( rc = jsonUtil_get_key_val ( (char*)alarm_req.data(), MTCALARM_REQ_KEY__SEVERITY, severity)) != PASS )
-                    {
-                       elog ("%s '%s'\n", PARSE_FAILURE, MTCALARM_REQ_KEY__SEVERITY);
-                    }
-                    else if (( rc = jsonUtil_get_key_val ( (char*)alarm_req.data(), MTCALARM_REQ_KEY__ENTITY, entry.entity )) != PASS )
-                    {
-                       elog ("%s '%s'\n", PARSE_FAILURE, MTCALARM_REQ_KEY__ENTITY);
-                    }
-                    else if (( rc = jsonUtil_get_key_val ( (char*)alarm_req.data(), MTCALARM_REQ_KEY__PREFIX, entry.prefix)) != PASS )
-                    {
-                       elog ("%s '%s'\n", PARSE_FAILURE, MTCALARM_REQ_KEY__PREFIX);
-                    }
-                    else
-                    {   entry.timestamp = _fm_timestamp ();
-                        entry.operation = tolowercase(operation);
-                        entry.severity = tolowercase(severity);
-                        alarmMgr_queue_alarm (entry);
-                    }
-                    if ( rc ) break ;
+                    entry.alarmid  = jsonUtil_get_key_value_string ( alarm_obj, MTCALARM_REQ_KEY__ALARMID   );
+                    entry.hostname = jsonUtil_get_key_value_string ( alarm_obj, MTCALARM_REQ_KEY__HOSTNAME  );
+                    operation      = jsonUtil_get_key_value_string ( alarm_obj, MTCALARM_REQ_KEY__OPERATION );
+                    severity       = jsonUtil_get_key_value_string ( alarm_obj, MTCALARM_REQ_KEY__SEVERITY  );
+                    entry.entity   = jsonUtil_get_key_value_string ( alarm_obj, MTCALARM_REQ_KEY__ENTITY    );
+                    entry.prefix   = jsonUtil_get_key_value_string ( alarm_obj, MTCALARM_REQ_KEY__PREFIX    );
+
+                    entry.timestamp = _fm_timestamp ();
+                    entry.operation = tolowercase(operation);
+                    entry.severity = tolowercase(severity);
+                    alarmMgr_queue_alarm (entry);
                 }
                 else
                 {
-                    wlog ("failed to get index '%d of %d' from alarm request", i, elements);
+                    elog ("%s at index '%d of %d'\n", PARSE_FAILURE, i, elements );
+                    rc = FAIL_JSON_PARSE ;
+                    break ;
                 }
             } /* for loop */
         }
@@ -139,6 +125,5 @@ int alarmHdlr_request_handler ( char * msg_ptr )
        elog (" ... %s\n", msg_ptr );
        rc = FAIL_JSON_OBJECT ;
     }
-    if (raw_obj) json_object_put(raw_obj);
     return (rc);
 }
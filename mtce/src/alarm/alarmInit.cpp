@@ -211,6 +211,9 @@ void daemon_service_run ( void )
       int failed_receiver_b2b_count    = 0 ;
       int failed_socket_log_throttle   = 0 ;
 
+      /* set when the last queue service pass used its full batch */
+      bool alarm_backlog = false ;
+
       socks.clear();
       socks.push_front (mtcalarm_req_sock_ptr->getFD());
       socks.sort();
@@ -220,7 +223,9 @@ void daemon_service_run ( void )
       {
          daemon_signal_hdlr ();
          waitd.tv_sec = 0;
-         waitd.tv_usec = SOCKET_WAIT_100MS;
+
+         /* don't wait if there are more alarms ready to submit */
+         waitd.tv_usec = alarm_backlog ? 0 : SOCKET_WAIT_100MS;
 
          /* Initialize the master fd_set */
          FD_ZERO(&readfds);
@@ -281,7 +286,7 @@ void daemon_service_run ( void )
          daemon_load_fit();
 #endif
 
-         alarmMgr_service_queue();
+         alarm_backlog = ( alarmMgr_service_queue() >= MAX_ALARMS_PER_SERVICE );
       }
    }
    else
@@ -296,6 +301,7 @@ void daemon_dump_info ( void )
 {
     daemon_dump_membuf_banner ();
     daemon_dump_membuf();
+    alarmMgr_dump_stats ();
 }
 
 const char MY_DATA [100] = { "eieio\n" } ;
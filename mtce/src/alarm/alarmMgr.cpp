@@ -1,5 +1,5 @@
 /*
- * Copyright (c) 2016-2017,2019, 2024 Wind River Systems, Inc.
+ * Copyright (c) 2016-2017,2019, 2024, 2026 Wind River Systems, Inc.
 *
 * SPDX-License-Identifier: Apache-2.0
 *
@@ -8,12 +8,22 @@
  /**
   * @file
   * Starling-X Maintenance Alarm Manager Daemon Manager
+  *
+  * Alarm requests are queued and submitted to FM in batches.
+  *
+  * A queued set or clear is superseded by a later set or clear of the
+  * same alarm id, hostname and entity ; only the latest is submitted.
+  *
+  * Failures that are likely to resolve with a retry leave the entry in
+  * the queue with its own backoff, so other entries continue to be
+  * submitted.
   */
 
 #include <iostream>
 #include <stdio.h>
 #include <stdlib.h>
 #include <string.h>
+#include <map>
 
 using namespace std;
 
@@ -26,40 +36,85 @@ using namespace std;
  * Up to 2 (Mgmnt and Cluster) for each node of up to 1000 nodes = 2000 */
 #define MAX_QUEUED_ALARMS (2000)
 
+/* Per entry FM retry backoff ; doubles from the min up to the max */
+#define RETRY_BACKOFF_MIN_NSECS ((unsigned long long)(250000000))
+#define RETRY_BACKOFF_MAX_NSECS ((unsigned long long)(5000000000))
+
+/* Stop a service pass after this many back-to-back retryable failures.
+ * These are typically FM connection failures that affect every entry
+ * so the whole queue is then held off ; see alarmMgr_service_queue */
+#define MAX_B2B_RETRY_FAILURES (3)
+
+/* monotonic nsec before which the queue is not serviced */
+static unsigned long long _hold_until   = 0 ;
+
+/* back-to-back passes that ended in a failure run ; sets the hold */
+static int                _hold_retries = 0 ;
+
 /* the alarm queue */
 static list<queue_entry_type> alarm_queue ;
 
-/* FM retry throttle */
-static unsigned long long _holdoff_timestamp = 0 ;
+/* queued set and clear requests by alarm key */
+static map<string, list<queue_entry_type>::iterator> alarm_index ;
+
+/* queue statistics */
+typedef struct
+{
+    unsigned long long queued    ; /* requests queued                  */
+    unsigned long long collapsed ; /* requests superseded while queued */
+    unsigned long long submitted ; /* requests accepted by FM          */
+    unsigned long long dropped   ; /* requests dropped                 */
+    unsigned long long retries   ; /* retryable FM failures            */
+    unsigned long long lat_total ; /* queue to FM latency total nsecs  */
+    unsigned long long lat_max   ; /* queue to FM latency max nsecs    */
+    size_t             depth_max ; /* queue high water mark            */
+    bool               busy      ; /* queue has been non-empty         */
+} alarm_queue_stats_type ;
+
+static alarm_queue_stats_type _stats ;
 
 /*************************************************************************
  *
- * Name       : _pop_front, _pop_back
+ * Name       : _alarm_key
  *
  * Scope      : local
  *
- * Purpose    : Remove the entry at the head/tail of the queue.
- *
- *              Also reset the log throttle counter.
+ * Purpose    : Build the key that identifies the alarm an entry acts on.
  *
  ************************************************************************/
 
-void _pop_front( void )
+static string _alarm_key ( queue_entry_type & entry )
 {
-    if ( alarm_queue.size() )
-    {
-        alarm_queue.pop_front();
-    }
-    _holdoff_timestamp = 0 ;
+    string key = entry.alarmid ;
+    key.append(":");
+    key.append(entry.hostname);
+    key.append(":");
+    key.append(entry.entity);
+    return (key);
 }
 
-void _pop_back( void )
+/*************************************************************************
+ *
+ * Name       : _erase
+ *
+ * Scope      : local
+ *
+ * Purpose    : Remove an entry from the queue and the index.
+ *
+ * Returns    : the iterator following the removed entry.
+ *
+ ************************************************************************/
+
+static list<queue_entry_type>::iterator _erase ( list<queue_entry_type>::iterator it )
 {
-    if ( alarm_queue.size() )
+    if ( it->operation != "msg" )
     {
-        alarm_queue.pop_back();
+        map<string, list<queue_entry_type>::iterator>::iterator index_it =
+            alarm_index.find ( _alarm_key ( *it ));
+        if (( index_it != alarm_index.end() ) && ( index_it->second == it ))
+            alarm_index.erase ( index_it );
     }
-    _holdoff_timestamp = 0 ;
+    return ( alarm_queue.erase ( it ));
 }
 
 /*************************************************************************
@@ -72,6 +127,8 @@ void _pop_back( void )
 void alarmMgr_queue_clear ( void )
 {
     alarm_queue.clear();
+    alarm_index.clear();
+    memset ( &_stats, 0, sizeof(_stats));
 }
 
 /*************************************************************************
@@ -80,6 +137,12 @@ void alarmMgr_queue_clear ( void )
  *
  * Purpose    : Add an incoming alarm request to the tail of the queue.
  *
+ * Description: A set or clear request replaces any queued set or clear
+ *              of the same alarm id, hostname and entity that has not
+ *              been submitted yet. Customer logs are never collapsed.
+ *
+ *              The most recent request is dropped if the queue is full.
+ *
  ************************************************************************/
 void alarmMgr_queue_alarm  ( queue_entry_type entry )
 {
@@ -88,54 +151,73 @@ void alarmMgr_queue_alarm  ( queue_entry_type entry )
               entry.alarmid.c_str(),
               alarm_queue.size() );
 
+    entry.queued  = gettime_monotonic_nsec ();
+    entry.retry   = 0 ;
+    entry.retries = 0 ;
+    _stats.queued++ ;
+
+    string key = "" ;
+    if ( entry.operation != "msg" )
+    {
+        key = _alarm_key ( entry );
+        map<string, list<queue_entry_type>::iterator>::iterator index_it =
+            alarm_index.find ( key );
+        if ( index_it != alarm_index.end() )
+        {
+            dlog ("%s %s '%s:%s' superseded by %s\n",
+                      entry.hostname.c_str(),
+                      index_it->second->operation.c_str(),
+                      entry.alarmid.c_str(),
+                      entry.entity.c_str(),
+                      entry.operation.c_str());
+
+            /* the request has been waiting since the first one was
+             * queued ; keep that for the queue latency stats */
+            entry.queued = index_it->second->queued ;
+
+            alarm_queue.erase ( index_it->second );
+            alarm_index.erase ( index_it );
+            _stats.collapsed++ ;
+        }
+    }
+
+    if ( alarm_queue.size() >= MAX_QUEUED_ALARMS )
+    {
+        wlog ("%s %s '%s:%s' dropped ; most recent ; queue full",
+                  entry.hostname.c_str(),
+                  entry.operation.c_str(),
+                  entry.alarmid.c_str(),
+                  entry.entity.c_str() );
+        _stats.dropped++ ;
+        return ;
+    }
+
     alarm_queue.push_back(entry);
+    if ( ! key.empty() )
+        alarm_index[key] = --alarm_queue.end() ;
+
+    _stats.busy = true ;
+    if ( alarm_queue.size() > _stats.depth_max )
+        _stats.depth_max = alarm_queue.size();
 }
 
 /*************************************************************************
  *
- * Name       : alarmMgr_service_queue
+ * Name       : _submit
  *
- * Purpose    : Service the alarm queue from the head.
+ * Scope      : local
  *
- * Description: Load the first/oldest element of the queue and submit it
- *              to FM.
+ * Purpose    : Submit one queued request to FM.
  *
- *              If it fails for a reason that is likely to resolve itself
- *              with a retry, then it is not popped of the head. Instead
- *              it is left there to be retried after the hold off period.
- *
- *              If it fails for a reason that is NOT likely to succeed
- *              by retries then an error log is produced and this faulty
- *              entry is dropped. It is done this way to avoid a bad
- *              entry from stalling/blocking the queue.
+ * Returns    : the FM return code ; action is set to a description
+ *              of the request for logging.
  *
  ************************************************************************/
 
-/* 5 second holdoff time before FM retry */
-#define RETRY_HOLDOFF_TIME_NSECS ((unsigned long long)(5000000000))
-
-void alarmMgr_service_queue ( void )
+static int _submit ( queue_entry_type & entry, string & action )
 {
-    dlog1 ("Elements: %ld\n", alarm_queue.size());
-    if ( alarm_queue.empty() )
-        return ;
-
-    /* throttle access to FM if in retry mode */
-    if ( _holdoff_timestamp )
-    {
-        unsigned long long _now_time = gettime_monotonic_nsec ();
-
-        /* retry only retry every RETRY_HOLDOFF_TIME_NSECS while in holdoff */
-        if (( _now_time-_holdoff_timestamp ) < RETRY_HOLDOFF_TIME_NSECS)
-            return ;
-        else
-            _holdoff_timestamp = 0 ;
-    }
-
-    queue_entry_type entry = alarm_queue.front() ;
-
     int rc = PASS ;
-    string action = entry.operation ;
+    action = entry.operation ;
     action.append (" alarm");
 
     dlog ("%s %s operation:%s severity:%s entity:%s prefix:%s\n",
@@ -201,115 +283,237 @@ void alarmMgr_service_queue ( void )
     {
         rc = FM_ERR_INVALID_PARAMETER ;
     }
+    return (rc);
+}
 
-    /* Handle behavior based on return code */
-    if ( rc == FM_ERR_OK )
+/*************************************************************************
+ *
+ * Name       : alarmMgr_service_queue
+ *
+ * Purpose    : Submit up to MAX_ALARMS_PER_SERVICE queued requests to FM
+ *              starting from the head.
+ *
+ * Description: Entries waiting out a retry backoff are skipped.
+ *
+ *              If a submission fails for a reason that is likely to
+ *              resolve itself with a retry, then the entry is left in
+ *              the queue and retried after its own backoff period. The
+ *              backoff doubles with each failure up to a 5 second max.
+ *
+ *              If it fails for a reason that is NOT likely to succeed
+ *              by retries then an error log is produced and this faulty
+ *              entry is dropped.
+ *
+ *              The pass ends early after back-to-back retryable failures
+ *              since FM is likely not reachable. The whole queue is then
+ *              held off until the earliest retry time of the entries that
+ *              failed, or a queue level backoff that doubles with each
+ *              such pass, whichever is later. Any FM response ends it.
+ *
+ * Returns    : the number of submission attempts made.
+ *
+ ************************************************************************/
+
+int alarmMgr_service_queue ( void )
+{
+    dlog1 ("Elements: %ld\n", alarm_queue.size());
+    if ( alarm_queue.empty() )
     {
-        /* alarm call succeeded, pop off the list. */
-        _pop_front();
+        if ( _stats.busy )
+        {
+            _stats.busy = false ;
+            alarmMgr_dump_stats ();
+        }
+        return (0);
     }
 
-    else if ( rc == FM_ERR_ENTITY_NOT_FOUND )
+    unsigned long long now = gettime_monotonic_nsec ();
+    if ( now < _hold_until )
+        return (0);
+
+    int attempts = 0 ;
+    int failures = 0 ;
+    unsigned long long earliest_retry = 0 ;
+
+    list<queue_entry_type>::iterator it = alarm_queue.begin();
+    while (( it != alarm_queue.end() ) &&
+           ( attempts < MAX_ALARMS_PER_SERVICE ) &&
+           ( failures < MAX_B2B_RETRY_FAILURES ))
     {
-        ilog ("%s %s '%s:%s' ; not found",
+        queue_entry_type & entry = *it ;
+
+        /* in retry backoff */
+        if ( entry.retry > now )
+        {
+            ++it ;
+            continue ;
+        }
+
+        string action ;
+        int rc = _submit ( entry, action );
+        attempts++ ;
+
+        /* Handle behavior based on return code */
+        if ( rc == FM_ERR_OK )
+        {
+            /* alarm call succeeded, pop off the list. */
+            unsigned long long latency = gettime_monotonic_nsec() - entry.queued ;
+            _stats.submitted++ ;
+            _stats.lat_total += latency ;
+            if ( latency > _stats.lat_max )
+                _stats.lat_max = latency ;
+            failures = 0 ;
+            _hold_retries = 0 ;
+            it = _erase ( it );
+            continue ;
+        }
+
+        else if ( rc == FM_ERR_ENTITY_NOT_FOUND )
+        {
+            ilog ("%s %s '%s:%s' ; not found",
+                      entry.hostname.c_str(),
+                      action.c_str(),
+                      entry.alarmid.c_str(),
+                      entry.entity.c_str());
+        }
+
+        /*******************************************************************
+         * Now these are non-success cases.
+         *******************************************************************/
+
+        /* Most typical failure case first - FM not running */
+        else if (( rc == FM_ERR_NOCONNECT       ) ||
+                 ( rc == FM_ERR_REQUEST_PENDING ) ||
+                 ( rc == FM_ERR_COMMUNICATIONS  ))
+        {
+            unsigned long long backoff = RETRY_BACKOFF_MIN_NSECS << ( entry.retries < 5 ? entry.retries : 5 );
+            if ( backoff > RETRY_BACKOFF_MAX_NSECS )
+                backoff = RETRY_BACKOFF_MAX_NSECS ;
+            entry.retry = now + backoff ;
+            entry.retries++ ;
+            _stats.retries++ ;
+            failures++ ;
+            if (( earliest_retry == 0 ) || ( entry.retry < earliest_retry ))
+                earliest_retry = entry.retry ;
+
+            string type = "" ;
+            if ( rc == FM_ERR_NOCONNECT ) type = "not connected" ;
+            else if ( rc == FM_ERR_COMMUNICATIONS ) type = "communication error" ;
+            else if ( rc == FM_ERR_REQUEST_PENDING ) type = "pending request" ;
+
+            wlog ("%s %s '%s:%s' failure ; %s ; retry %d in %llu msecs [q=%ld]",
+                      entry.hostname.c_str(),
+                      action.c_str(),
+                      entry.alarmid.c_str(),
+                      entry.entity.c_str(),
+                      type.c_str(),
+                      entry.retries,
+                      backoff/1000000,
+                      alarm_queue.size());
+            ++it ;
+            continue ;
+        }
+
+        /* Look for cases where we don't want to retry.
+         *
+         * These would be cases that are unlikely to resolve with retry.
+         */
+
+        /* pop off if alarm already asserted */
+        else if ( rc == FM_ERR_ALARM_EXISTS )
+        {
+            wlog ("%s %s '%s:%s' ; already exists",
                   entry.hostname.c_str(),
                   action.c_str(),
                   entry.alarmid.c_str(),
                   entry.entity.c_str());
-        _pop_front();
-    }
-
-    /*******************************************************************
-     * Now these are non-success cases.
-     *******************************************************************/
-
-    /* Most typical failure case first - FM not running */
-    else if (( rc == FM_ERR_NOCONNECT       ) ||
-             ( rc == FM_ERR_REQUEST_PENDING ) ||
-             ( rc == FM_ERR_COMMUNICATIONS  ))
-    {
-        if ( _holdoff_timestamp == 0 )
-             _holdoff_timestamp = gettime_monotonic_nsec();
-
-        string type = "" ;
-        if ( rc == FM_ERR_NOCONNECT ) type = "not connected" ;
-        else if ( rc == FM_ERR_COMMUNICATIONS ) type = "communication error" ;
-        else if ( rc == FM_ERR_REQUEST_PENDING ) type = "pending request" ;
+        }
 
-        wlog ("%s %s '%s:%s' failure ; %s ; retrying [q=%ld]",
+        /* never retry on any of these error cases */
+        else if (( rc == FM_ERR_INVALID_REQ          ) ||
+                 ( rc == FM_ERR_INVALID_ATTRIBUTE    ) ||
+                 ( rc == FM_ERR_INVALID_PARAMETER    ) ||
+                 ( rc == FM_ERR_DB_OPERATION_FAILURE ) ||
+                 ( rc == FM_ERR_RESOURCE_UNAVAILABLE ))
+        {
+            wlog ("%s failed to %s '%s:%s' ; dropped ; bad request [rc=%d]",
                   entry.hostname.c_str(),
                   action.c_str(),
                   entry.alarmid.c_str(),
-                  entry.entity.c_str(),
-                  type.c_str(),
-                  alarm_queue.size());
-    }
+                  entry.entity.c_str(), rc);
+            _stats.dropped++ ;
+        }
 
-    /* Look for cases where we don't want to retry.
-     *
-     * These would be cases that are unlikely to resolve with retry.
-     */
+        /* never retry due to resource error on assert cases */
+        else if (( rc == FM_ERR_NOMEM            ) ||
+                 ( rc == FM_ERR_SERVER_NO_MEM    ) ||
+                 ( rc == FM_ERR_NOT_ENOUGH_SPACE ))
+        {
+            wlog ("%s failed to %s '%s:%s' ; dropped ; resource error [rc=%d]",
+                  entry.hostname.c_str(),
+                  action.c_str(),
+                  entry.alarmid.c_str(),
+                  entry.entity.c_str(),rc );
+            _stats.dropped++ ;
+        }
+        else
+        {
+            wlog ("%s failed to %s '%s:%s' ; dropped ; unexpected [rc=%d]",
+                  entry.hostname.c_str(),
+                  action.c_str(),
+                  entry.alarmid.c_str(),
+                  entry.entity.c_str(),rc );
+            _stats.dropped++ ;
+        }
 
-    /* pop off if alarm already asserted */
-    else if ( rc == FM_ERR_ALARM_EXISTS )
-    {
-        wlog ("%s %s '%s:%s' ; already exists",
-              entry.hostname.c_str(),
-              action.c_str(),
-              entry.alarmid.c_str(),
-              entry.entity.c_str());
-        _pop_front();
+        /* FM responded ; done with this entry */
+        failures = 0 ;
+        _hold_retries = 0 ;
+        it = _erase ( it );
     }
 
-    /* never retry on any of these error cases */
-    else if (( rc == FM_ERR_INVALID_REQ          ) ||
-             ( rc == FM_ERR_INVALID_ATTRIBUTE    ) ||
-             ( rc == FM_ERR_INVALID_PARAMETER    ) ||
-             ( rc == FM_ERR_DB_OPERATION_FAILURE ) ||
-             ( rc == FM_ERR_RESOURCE_UNAVAILABLE ))
+    if ( failures >= MAX_B2B_RETRY_FAILURES )
     {
-        wlog ("%s failed to %s '%s:%s' ; dropped ; bad request [rc=%d]",
-              entry.hostname.c_str(),
-              action.c_str(),
-              entry.alarmid.c_str(),
-              entry.entity.c_str(), rc);
-        _pop_front();
+        unsigned long long backoff = RETRY_BACKOFF_MIN_NSECS << ( _hold_retries < 5 ? _hold_retries : 5 );
+        if ( backoff > RETRY_BACKOFF_MAX_NSECS )
+            backoff = RETRY_BACKOFF_MAX_NSECS ;
+        _hold_retries++ ;
+        _hold_until = now + backoff ;
+        if ( earliest_retry > _hold_until )
+            _hold_until = earliest_retry ;
+
+        wlog ("%d back-to-back FM failures ; holding %ld queued requests for %llu msecs",
+                  failures, alarm_queue.size(), (_hold_until - now)/1000000 );
     }
 
-    /* never retry due to resource error on assert cases */
-    else if (( rc == FM_ERR_NOMEM            ) ||
-             ( rc == FM_ERR_SERVER_NO_MEM    ) ||
-             ( rc == FM_ERR_NOT_ENOUGH_SPACE ))
+    if ( attempts )
     {
-        wlog ("%s failed to %s '%s:%s' ; dropped ; resource error [rc=%d]",
-              entry.hostname.c_str(),
-              action.c_str(),
-              entry.alarmid.c_str(),
-              entry.entity.c_str(),rc );
-        _pop_front();
-    }
-    else
-    {
-        wlog ("%s failed to %s '%s:%s' ; dropped ; unexpected [rc=%d]",
-              entry.hostname.c_str(),
-              action.c_str(),
-              entry.alarmid.c_str(),
-              entry.entity.c_str(),rc );
-        _pop_front();
+        dlog ("%d submitted ; %ld queue entries to service", attempts, alarm_queue.size());
     }
+    return (attempts);
+}
 
-    /* pop from back if the queue is loaded to the max */
-    if ( alarm_queue.size() > MAX_QUEUED_ALARMS )
-    {
-        wlog ("%s %s '%s:%s' dropped ; most recent ; queue full",
-                  entry.hostname.c_str(),
-                  action.c_str(),
-                  entry.alarmid.c_str(),
-                  entry.entity.c_str() );
-        _pop_back();
-    }
-    else
-    {
-        ilog ("%ld queue entries to service", alarm_queue.size());
-    }
+/*************************************************************************
+ *
+ * Name       : alarmMgr_dump_stats
+ *
+ * Purpose    : Log the queue statistics.
+ *
+ *              Called when a busy queue drains and on a state dump.
+ *
+ ************************************************************************/
+
+void alarmMgr_dump_stats ( void )
+{
+    ilog ("Alarm Queue : depth:%ld max:%ld queued:%llu submitted:%llu collapsed:%llu retries:%llu dropped:%llu\n",
+              alarm_queue.size(),
+              _stats.depth_max,
+              _stats.queued,
+              _stats.submitted,
+              _stats.collapsed,
+              _stats.retries,
+              _stats.dropped );
+    ilog ("Alarm Queue : latency avg:%llu max:%llu msecs\n",
+              _stats.submitted ? (_stats.lat_total/_stats.submitted)/1000000 : 0,
+              _stats.lat_max/1000000 );
 }
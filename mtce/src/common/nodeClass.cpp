@@ -41,6 +41,7 @@ using namespace std;
 #include "alarm.h"
 #include "hbsAlarm.h"
 #include "hbsBase.h"
+#include "flightRecorder.h" /* for ... flightRecorder_log   */
 
 /** Initialize the supplied command buffer */
 void mtcCmd_init ( mtcCmd & cmd )
@@ -246,17 +247,17 @@ nodeLinkClass::nodeLinkClass()
     memory_used   = 0 ;
     hosts = 0 ;
     host_deleted = false ;
+    fsm_sweep_time = 0 ;
+    fsm_sweep_now  = true ;
+    fsm_passes = fsm_sweeps = fsm_runs = 0 ;
     power_off_retry_wait = DEFAULT_POWER_OFF_RETRY_WAIT ;
 
     /* Init the base level pulse info and pointers for all interfaces */
     pulse_ptr = NULL ;
+    memset ( &pulse_table, 0, sizeof(pulse_table));
     for ( int i = 0 ; i < MAX_IFACES ; i++ )
-    {
-        pulse_list[i].head_ptr = NULL ;
-        pulse_list[i].tail_ptr = NULL ;
-        pulse_list[i].last_ptr = NULL ;
-        pulses[i] = 0 ;
-    }
+        for ( int rri = 0 ; rri < MAX_NODES ; rri++ )
+            pulse_table[i].slot[rri] = -1 ;
     /* init the resource reference index to null */
     rrri = 0 ;
 
@@ -650,7 +651,6 @@ nodeLinkClass::node* nodeLinkClass::addNode( string hostname )
     mtcTimer_init ( ptr->offline_timer,    hostname, "offline timer");   /* Init node's FH offline timer     */
     mtcTimer_init ( ptr->http_timer,       hostname, "http timer" );     /* Init node's http timer           */
     mtcTimer_init ( ptr->bm_timer,         hostname, "bm timer" );       /* Init node's bm timer             */
-    mtcTimer_init ( ptr->bm_ping_info.timer,hostname,"ping timer" );     /* Init node's ping timer           */
     mtcTimer_init ( ptr->bmc_access_timer, hostname, "bmc acc timer" );  /* Init node's bm access timer      */
     mtcTimer_init ( ptr->bmc_audit_timer,  hostname, "bmc aud timer" );  /* Init node's bm audit timer       */
     mtcTimer_init ( ptr->host_services_timer, hostname, "host services timer" ); /* host services timer      */
@@ -745,6 +745,7 @@ nodeLinkClass::node* nodeLinkClass::addNode( string hostname )
     ptr->libEvent_work_fifo.clear();
 
     ptr->oper_sequence   = 0 ;
+    ptr->oper_coalesced  = 0 ;
     ptr->oper_failures   = 0 ;
 
     ptr->mtcCmd_work_fifo.clear();
@@ -779,6 +780,7 @@ nodeLinkClass::node* nodeLinkClass::addNode( string hostname )
     ptr->log_throttle = 0 ;
     ptr->no_work_log_throttle = 0 ;
     ptr->no_rri_log_throttle = 0 ;
+    ptr->rri = 0 ;
 
     ptr->degrade_mask = ptr->degrade_mask_save = DEGRADE_MASK_NONE ;
 
@@ -799,18 +801,11 @@ nodeLinkClass::node* nodeLinkClass::addNode( string hostname )
 
     for ( int i = 0 ; i < MAX_IFACES ; i++ )
     {
-        ptr->pulse_link[i].next_ptr = NULL  ;
-        ptr->pulse_link[i].prev_ptr = NULL  ;
         ptr->monitor[i]             = false ;
         ptr->hbs_minor[i]           = false ;
         ptr->hbs_degrade[i]         = false ;
         ptr->hbs_failure[i]         = false ;
-        ptr->max_count[i]           = 0 ;
-        ptr->hbs_count[i]           = 0 ;
         ptr->hbs_minor_count[i]     = 0 ;
-        ptr->hbs_misses_count[i]    = 0 ;
-        ptr->b2b_misses_count[i]    = 0 ;
-        ptr->b2b_pulses_count[i]    = 0 ;
         ptr->hbs_degrade_count[i]   = 0 ;
         ptr->hbs_failure_count[i]   = 0 ;
         ptr->heartbeat_failed[i]    = false;
@@ -821,6 +816,9 @@ nodeLinkClass::node* nodeLinkClass::addNode( string hostname )
     ptr->pmon_missing_count = 0;
     ptr->pmon_degraded = false ;
 
+    ptr->fsm_queued    = false ;
+    ptr->fsm_wake_time = 0 ;
+
     /* now add it to the node list ; dealing with all conditions */
 
     /* if the node list is empty add it to the head */
@@ -849,6 +847,11 @@ nodeLinkClass::node* nodeLinkClass::addNode( string hostname )
 
     hosts++ ;
 
+    index_node ( ptr );
+
+    /* run the new host on the next fsm pass */
+    fsm_wake ( ptr );
+
     /* (re)build the Resource Reference Array */
     if ( heartbeat )
         build_rra ();
@@ -857,6 +860,93 @@ nodeLinkClass::node* nodeLinkClass::addNode( string hostname )
 }
 
 
+/* Returns true if the specified key is one of this node's lookup keys */
+static bool _node_key_match ( string & key,
+                              string & hostname,
+                              string & ip,
+                              string & clstr_ip,
+                              string & uuid,
+                              string & pxeboot_ip )
+{
+    return (( key == hostname ) || ( key == ip ) || ( key == clstr_ip ) ||
+            ( key == uuid ) || ( key == pxeboot_ip ));
+}
+
+/* File the node under its hostname, uuid and each of its ip addresses.
+ * Any keys it was previously filed under are removed first so this
+ * can be called after any of those keys are modified. */
+void nodeLinkClass::index_node ( struct nodeLinkClass::node * node_ptr )
+{
+    if ( node_ptr == NULL )
+        return ;
+
+    unindex_node ( node_ptr );
+
+    string * keys[] = { &node_ptr->hostname,
+                        &node_ptr->uuid,
+                        &node_ptr->ip,
+                        &node_ptr->clstr_ip,
+                        &node_ptr->pxeboot_ip } ;
+
+    for ( unsigned int i = 0 ; i < sizeof(keys)/sizeof(keys[0]) ; i++ )
+    {
+        if ( keys[i]->empty() )
+            continue ;
+
+        node_index[*keys[i]] = node_ptr ;
+        node_ptr->index_keys.push_back ( *keys[i] );
+
+        /* the ip addresses are also indexed in binary form */
+        msgClassAddrKey key ;
+        if (( i >= 2 ) && ( msgClassAddrKey_set ( key, keys[i]->c_str()) == PASS ))
+        {
+            addr_index[key] = node_ptr ;
+            node_ptr->addr_keys.push_back ( key );
+        }
+    }
+}
+
+/* Remove all the keys the node is filed under.
+ * Keys since refiled under another node are left alone. */
+void nodeLinkClass::unindex_node ( struct nodeLinkClass::node * node_ptr )
+{
+    if ( node_ptr == NULL )
+        return ;
+
+    for ( unsigned int i = 0 ; i < node_ptr->index_keys.size() ; i++ )
+    {
+        std::unordered_map<string, struct node *>::iterator it =
+            node_index.find ( node_ptr->index_keys[i] );
+        if (( it != node_index.end()) && ( it->second == node_ptr ))
+            node_index.erase ( it );
+    }
+    for ( unsigned int i = 0 ; i < node_ptr->addr_keys.size() ; i++ )
+    {
+        std::unordered_map<msgClassAddrKey, struct node *, msgClassAddrKeyHash>::iterator it =
+            addr_index.find ( node_ptr->addr_keys[i] );
+        if (( it != addr_index.end()) && ( it->second == node_ptr ))
+            addr_index.erase ( it );
+    }
+    node_ptr->index_keys.clear();
+    node_ptr->addr_keys.clear();
+}
+
+struct nodeLinkClass::node* nodeLinkClass::searchNode ( string & key )
+{
+   for ( struct node * ptr = head ; ptr != NULL ; ptr = ptr->next )
+   {
+       if ( _node_key_match ( key, ptr->hostname, ptr->ip, ptr->clstr_ip,
+                                   ptr->uuid, ptr->pxeboot_ip ))
+       {
+           return ptr ;
+       }
+       if ( ptr == tail )
+          break ;
+    }
+    return static_cast<struct node *>(NULL);
+}
+
+/* Node can be looked up by hostname, uuid or any of its ip addresses */
 struct nodeLinkClass::node* nodeLinkClass::getNode ( string hostname )
 {
    /* check for empty list condition */
@@ -866,39 +956,121 @@ struct nodeLinkClass::node* nodeLinkClass::getNode ( string hostname )
    if ( hostname.empty() )
       return static_cast<struct node *>(NULL);
 
-   for ( struct node * ptr = head ;  ; ptr = ptr->next )
+   std::unordered_map<string, struct node *>::iterator it = node_index.find ( hostname );
+   if ( it == node_index.end() )
+       return static_cast<struct node *>(NULL);
+
+   struct node * ptr = it->second ;
+   if ( _node_key_match ( hostname, ptr->hostname, ptr->ip, ptr->clstr_ip,
+                                    ptr->uuid, ptr->pxeboot_ip ))
    {
-       if ( !hostname.compare ( ptr->hostname ))
-       {
-           return ptr ;
-       }
-       /* Node can be looked up by ip addr too */
-       if ( !hostname.compare ( ptr->ip ))
-       {
-           return ptr ;
-       }
-       /* Node can be looked up by cluster_host_ip addr too */
-       if ( !hostname.compare ( ptr->clstr_ip ))
-       {
-           return ptr ;
-       }
-       /* Node can be looked up by uuid too */
-       if ( !hostname.compare ( ptr->uuid ))
-       {
-           return ptr ;
-       }
-       /* Node can be looked up by pxeboot ip */
-       if ( !hostname.compare ( ptr->pxeboot_ip ))
-       {
-           return ptr ;
-       }
+       return ptr ;
+   }
 
-       if (( ptr->next == NULL ) || ( ptr == tail ))
-          break ;
+   /* A key was modified without the node being re-indexed.
+    * Fall back to a list search and repair the index. */
+   slog ("%s stale node index entry for '%s'\n",
+             ptr->hostname.c_str(), hostname.c_str());
+   index_node ( ptr );
+   ptr = searchNode ( hostname );
+   if ( ptr )
+       index_node ( ptr );
+   return ptr ;
+}
+
+/* Node lookup by binary ip address ; i.e. a received message's source */
+struct nodeLinkClass::node* nodeLinkClass::getNode ( const struct sockaddr * hostaddr )
+{
+   msgClassAddrKey key ;
+   if (( head == NULL ) || ( msgClassAddrKey_set ( key, hostaddr ) != PASS ))
+      return static_cast<struct node *>(NULL);
+
+   return ( getNode ( key ));
+}
+
+/* Node lookup by a msgClassAddrKey already resolved by the receiving socket */
+struct nodeLinkClass::node* nodeLinkClass::getNode ( const msgClassAddrKey & key )
+{
+   if (( head == NULL ) || ( key.family == AF_UNSPEC ))
+      return static_cast<struct node *>(NULL);
+
+   std::unordered_map<msgClassAddrKey, struct node *, msgClassAddrKeyHash>::iterator it =
+       addr_index.find ( key );
+   if ( it != addr_index.end() )
+       return ( it->second );
+
+   return static_cast<struct node *>(NULL);
+}
+
+/* Put the host on the fsm run queue if it is not already there */
+void nodeLinkClass::fsm_wake ( struct nodeLinkClass::node * node_ptr )
+{
+    if (( node_ptr == NULL ) || ( node_ptr->fsm_queued == true ))
+        return ;
+
+    node_ptr->fsm_queued = true ;
+    fsm_runq.push_back ( node_ptr );
+}
+
+void nodeLinkClass::fsm_wake ( string & hostname )
+{
+    fsm_wake ( getNode ( hostname ));
+}
+
+void nodeLinkClass::fsm_wake_all ( void )
+{
+    fsm_sweep_now = true ;
+}
+
+/* Take the host off the run queue, the current fsm batch and the
+ * timed wake-up list ; called before the node is freed */
+void nodeLinkClass::fsm_unqueue ( struct nodeLinkClass::node * node_ptr )
+{
+    if ( node_ptr == NULL )
+        return ;
+
+    for ( unsigned int i = 0 ; i < fsm_runq.size() ; )
+    {
+        if ( fsm_runq[i] == node_ptr )
+            fsm_runq.erase ( fsm_runq.begin() + i );
+        else
+            i++ ;
     }
-    return static_cast<struct node *>(NULL);
+
+    /* the batch may be mid walk ; null the entry rather than erase it */
+    for ( unsigned int i = 0 ; i < fsm_batch.size() ; i++ )
+        if ( fsm_batch[i] == node_ptr )
+            fsm_batch[i] = NULL ;
+
+    fsm_timer_set ( node_ptr, 0 );
+    node_ptr->fsm_queued = false ;
 }
 
+void nodeLinkClass::fsm_timer_set ( struct nodeLinkClass::node * node_ptr,
+                                    unsigned long long wake_time )
+{
+    if (( node_ptr == NULL ) || ( node_ptr->fsm_wake_time == wake_time ))
+        return ;
+
+    if ( node_ptr->fsm_wake_time )
+    {
+        std::pair<std::multimap<unsigned long long, struct node *>::iterator,
+                  std::multimap<unsigned long long, struct node *>::iterator> range =
+            fsm_timers.equal_range ( node_ptr->fsm_wake_time );
+        for ( std::multimap<unsigned long long, struct node *>::iterator it = range.first ;
+              it != range.second ; ++it )
+        {
+            if ( it->second == node_ptr )
+            {
+                fsm_timers.erase ( it );
+                break ;
+            }
+        }
+    }
+    node_ptr->fsm_wake_time = wake_time ;
+    if ( wake_time )
+        fsm_timers.insert ( std::make_pair ( wake_time, node_ptr ));
+}
 
 struct nodeLinkClass::node* nodeLinkClass::getEventBaseNode ( libEvent_enum request,
                                                        struct event_base * base_ptr)
@@ -1009,49 +1181,11 @@ int nodeLinkClass::remNode( string hostname )
     mtcTimer_fini ( ptr->bm_timer );
     mtcTimer_fini ( ptr->bmc_access_timer );
     mtcTimer_fini ( ptr->bmc_audit_timer );
-    mtcTimer_fini ( ptr->bm_ping_info.timer );
-
-#ifdef WANT_PULSE_LIST_SEARCH_ON_DELETE
+    pingUtil_fini ( ptr->bm_ping_info );
+    thread_fini   ( ptr->bmc_thread_ctrl, ptr->bmc_thread_info );
 
-    /* Splice the node out of the pulse monitor list */
-
-    for ( int i = 0 ; i < MAX_IFACES ; i++ )
-    {
-        /* Does the pulse monitor list exist ? */
-        if ( pulse_list[i].head_ptr != NULL )
-        {
-            pulse_ptr = ptr ;
-            if ( pulse_list[i].head_ptr == pulse_ptr )
-            {
-                if ( pulse_list[i].head_ptr == pulse_list[i].tail_ptr )
-                {
-                    pulse_list[i].head_ptr = NULL ;
-                    pulse_list[i].tail_ptr = NULL ;
-                    dlog ("Pulse: Single Node -> Head Case\n");
-                }
-                else
-                {
-                    dlog ("Pulse: Multiple Nodes -> Head Case\n");
-                    pulse_list[i].head_ptr = pulse_list[i].head_ptr->pulse_link[i].next_ptr ;
-                    pulse_list[i].head_ptr->pulse_link[i].prev_ptr = NULL ;
-                }
-            }
-            else if ( pulse_list[i].tail_ptr == pulse_ptr )
-            {
-                dlog ("Pulse: Multiple Node -> Tail Case\n");
-                pulse_list[i].tail_ptr = pulse_list[i].tail_ptr->pulse_link[i].prev_ptr ;
-                pulse_list[i].tail_ptr->pulse_link[i].next_ptr = NULL ;
-            }
-            else
-            {
-                dlog ("Pulse: Multiple Node -> Full Splice Out\n");
-                pulse_ptr->pulse_link[i].prev_ptr->pulse_link[i].next_ptr = pulse_ptr->pulse_link[i].next_ptr ;
-                pulse_ptr->pulse_link[i].next_ptr->pulse_link[i].prev_ptr = pulse_ptr->pulse_link[i].prev_ptr ;
-            }
-        }
-    }
-
-#endif
+    unindex_node ( ptr );
+    fsm_unqueue  ( ptr );
 
     /* If the node is the head node */
     if ( ptr == head )
@@ -1295,12 +1429,12 @@ void nodeLinkClass::print_node_info ( void )
                 syslog ( LOG_INFO, "| %-12s |  %c  | %5i | %5i | %5i | %5i | %10x | %8x | %d msec\n",
                     ptr->hostname.c_str(),
                     ptr->monitor[i] ? 'Y' : 'n',
-                    ptr->hbs_misses_count[i],
-                    ptr->max_count[i],
+                    pulse_table[i].hbs_misses_count[pulse_row(ptr)],
+                    pulse_table[i].max_count[pulse_row(ptr)],
                     ptr->hbs_degrade_count[i],
                     ptr->hbs_failure_count[i],
-                    ptr->hbs_count[i],
-                    ptr->b2b_pulses_count[i],
+                    pulse_table[i].hbs_count[pulse_row(ptr)],
+                    pulse_table[i].b2b_pulses_count[pulse_row(ptr)],
                     hbs_pulse_period );
             }
         }
@@ -2569,6 +2703,7 @@ int nodeLinkClass::mod_host ( node_inv_type & inv )
                       node_ptr->uuid.c_str(), inv.uuid.c_str() );
             node_ptr->uuid = inv.uuid ;
             send_hwmon_command ( node_ptr->hostname, MTC_CMD_ADD_HOST );
+            index_node ( node_ptr );
             modify = true ; /* we have a delta */
         }
         if ( node_ptr->type.compare ( inv.type ) )
@@ -2596,6 +2731,7 @@ int nodeLinkClass::mod_host ( node_inv_type & inv )
                         node_ptr->ip.c_str(), inv.ip.c_str());
                 node_ptr->ip = inv.ip ;
                 mtcInfo_clr ( node_ptr, MTCE_INFO_KEY__BMC_PROTOCOL );
+                index_node ( node_ptr );
                 mtcInvApi_update_mtcInfo ( node_ptr );
 
                 /* Tell the guestAgent the new IP */
@@ -2624,6 +2760,7 @@ int nodeLinkClass::mod_host ( node_inv_type & inv )
 
             modify = true ; /* we have a delta */
             node_ptr->clstr_ip = inv.clstr_ip ;
+            index_node ( node_ptr );
         }
 
         if ( (!inv.name.empty()) && (node_ptr->hostname.compare ( inv.name)) )
@@ -2634,6 +2771,7 @@ int nodeLinkClass::mod_host ( node_inv_type & inv )
             cmd.cmd = MTC_OPER__MODIFY_HOSTNAME ;
             cmd.name = inv.name ;
             node_ptr->mtcCmd_work_fifo.push_back(cmd);
+            fsm_wake ( node_ptr );
             plog ("%s Modify 'hostname' to %s (mtcCmd_queue:%ld)\n",
                       node_ptr->hostname.c_str(),
                       cmd.name.c_str() ,
@@ -3030,6 +3168,7 @@ int nodeLinkClass::add_host ( node_inv_type & inv )
             node_ptr->uuid = inv.uuid ;
             node_ptr->clstr_ip  = inv.clstr_ip  ;
             node_ptr->mtce_info = inv.mtce_info ;
+            index_node ( node_ptr );
 
             if ( inv.uptime.length() )
             {
@@ -3045,7 +3184,6 @@ int nodeLinkClass::add_host ( node_inv_type & inv )
             node_ptr->thread_extra_info.bm_un  = node_ptr->bm_un   = inv.bm_un   ;
             node_ptr->bm_type = inv.bm_type ;
             node_ptr->bm_pw_wait_log_throttle = 0 ;
-            node_ptr->bm_ping_info.sock = 0 ;
 
             /* initialize the host power and reset control thread */
             thread_init ( node_ptr->bmc_thread_ctrl,
@@ -3309,6 +3447,7 @@ int nodeLinkClass::add_heartbeat_host ( const node_inv_type & inv )
             node_ptr->ip = inv.ip ;
             node_ptr->clstr_ip = inv.clstr_ip ;
             rc = PASS ;
+            index_node ( node_ptr );
         }
         /* Otherwise add it as a new node */
         else
@@ -3321,6 +3460,7 @@ int nodeLinkClass::add_heartbeat_host ( const node_inv_type & inv )
                 node_ptr->ip = inv.ip ;
                 node_ptr->clstr_ip = inv.clstr_ip ;
                 dlog ("%s added to linked list\n", inv.name.c_str());
+                index_node ( node_ptr );
                 rc = PASS ;
             }
             else
@@ -3351,6 +3491,7 @@ void nodeLinkClass::set_uuid ( string hostname, string uuid )
     if ( node_ptr )
     {
         node_ptr->uuid = uuid ;
+        index_node ( node_ptr );
     }
 }
 
@@ -3779,6 +3920,7 @@ void nodeLinkClass::pxebootInfo_loader ( string my_mac )
                                     ip.c_str());
                         }
                         node_ptr->pxeboot_ip = ip ;
+                        index_node ( node_ptr );
 
                         // Also load the my_pxeboot_ip at the process level for eacy access
                         if (( node_ptr->hostname == this->my_hostname ) && ( this->my_pxeboot_ip != ip ))
@@ -4003,6 +4145,7 @@ void nodeLinkClass::set_my_hostname ( string hostname )
     if ( node_ptr != NULL )
     {
         node_ptr->hostname = hostname ;
+        index_node ( node_ptr );
     }
 }
 
@@ -4023,6 +4166,7 @@ void nodeLinkClass::set_my_local_ip ( string & ip )
     if ( node_ptr != NULL )
     {
         node_ptr->ip = ip ;
+        index_node ( node_ptr );
     }
 }
 
@@ -4099,6 +4243,7 @@ int nodeLinkClass::set_hostaddr ( string & hostname, string & ip )
     if ( node_ptr != NULL )
     {
         node_ptr->ip = ip ;
+        index_node ( node_ptr );
         rc = PASS ;
     }
     return ( rc );
@@ -4115,6 +4260,7 @@ int nodeLinkClass::set_pxeboot_hostaddr ( string hostname, string ip )
         if (( hostUtil_is_valid_ip_addr(ip)) && ( node_ptr->pxeboot_ip != ip ))
         {
             node_ptr->pxeboot_ip = ip ;
+            index_node ( node_ptr );
             ilog ("%s pxeboot ip set to %s",
                       node_ptr->hostname.c_str(),
                       node_ptr->pxeboot_ip.c_str());
@@ -4143,6 +4289,7 @@ int nodeLinkClass::set_clstr_hostaddr ( string & hostname, string & ip )
                    node_ptr->clstr_ip.empty() ? "none" : node_ptr->clstr_ip.c_str(),
                    ip.c_str());
             node_ptr->clstr_ip = ip ;
+            index_node ( node_ptr );
             send_hbs_command ( node_ptr->hostname, MTC_CMD_MOD_HOST );
         }
         rc = PASS ;
@@ -4193,6 +4340,33 @@ string nodeLinkClass::get_hostname ( string hostaddr )
     return ( null_str );
 }
 
+/* Resolve a binary source address to a hostname through the address
+ * index. Only addresses not filed under a node, such as loopback or
+ * the floating address, fall back to the string based lookup. */
+string nodeLinkClass::get_hostname ( const struct sockaddr * hostaddr )
+{
+    msgClassAddrKey key ;
+    if ( msgClassAddrKey_set ( key, hostaddr ) != PASS )
+        return ( null_str );
+
+    return ( get_hostname ( key ));
+}
+
+string nodeLinkClass::get_hostname ( const msgClassAddrKey & hostaddr )
+{
+    nodeLinkClass::node* node_ptr = nodeLinkClass::getNode ( hostaddr );
+    if ( node_ptr != NULL )
+    {
+        return ( node_ptr->hostname );
+    }
+    else if ( hostaddr.family != AF_UNSPEC )
+    {
+        char addr_str[INET6_ADDRSTRLEN] ;
+        return ( get_hostname ( msgClassAddrKey_str ( hostaddr, addr_str, sizeof(addr_str))));
+    }
+    return ( null_str );
+}
+
 string nodeLinkClass::get_hostname_from_bm_ip ( string bm_ip )
 {
     if ( head )
@@ -5158,8 +5332,6 @@ void nodeLinkClass::bmc_access_data_init ( struct nodeLinkClass::node * node_ptr
         bmc_default_query_controls ( node_ptr );
 
         node_ptr->bm_ping_info.stage = PINGUTIL_MONITOR_STAGE__OPEN ;
-        mtcTimer_reset ( node_ptr->bm_ping_info.timer );
-        node_ptr->bm_ping_info.timer_handler = &mtcTimer_handler ;
 
         node_ptr->bm_ping_info.ip = node_ptr->bm_ip ;
         node_ptr->bm_ping_info.hostname = node_ptr->hostname ;
@@ -7105,6 +7277,9 @@ int nodeLinkClass::allStateChange ( struct nodeLinkClass::node * node_ptr,
 {
     int  rc     = FAIL  ;
 
+    /* the host is run on the next fsm pass to act on the change */
+    fsm_wake ( node_ptr );
+
     if (( adminState  < MTC_ADMIN_STATES ) &&
         ( operState   < MTC_OPER_STATES ) &&
         ( availStatus < MTC_AVAIL_STATUS ))
@@ -7145,6 +7320,11 @@ int nodeLinkClass::allStateChange ( struct nodeLinkClass::node * node_ptr,
                       mtc_nodeOperState_str  [node_ptr->operState  ],
                       mtc_nodeAvailStatus_str[node_ptr->availStatus],
                       node_ptr->oper_sequence-1);
+            flightRecorder_log ( FLIGHT_EVENT__STATE_CHANGE,
+                                 node_ptr->hostname.c_str(),
+                                 node_ptr->adminState,
+                                 node_ptr->operState,
+                                 node_ptr->availStatus );
         }
     }
     else
@@ -7160,6 +7340,8 @@ int nodeLinkClass::subfStateChange ( struct nodeLinkClass::node * node_ptr,
 {
     int  rc     = FAIL  ;
 
+    fsm_wake ( node_ptr );
+
     if (( operState_subf   < MTC_OPER_STATES ) &&
         ( availStatus_subf < MTC_AVAIL_STATUS ))
     {
@@ -7212,6 +7394,7 @@ int nodeLinkClass::adminActionChange ( struct nodeLinkClass::node * node_ptr,
 {
     int rc = FAIL ;
 
+    fsm_wake ( node_ptr );
 
     if ((        newActionState < MTC_ADMIN_ACTIONS ) &&
         ( node_ptr->adminAction < MTC_ADMIN_ACTIONS ))
@@ -7315,6 +7498,9 @@ int nodeLinkClass::adminActionChange ( struct nodeLinkClass::node * node_ptr,
 
         node_ptr->adminAction = newActionState ;
         node_ptr->action      = mtc_nodeAdminAction_str [node_ptr->adminAction] ;
+        flightRecorder_log ( FLIGHT_EVENT__ADMIN_ACTION,
+                             node_ptr->hostname.c_str(),
+                             oldActionState, newActionState );
 
         /* If we are starting a new ( not 'none' ) action ...
          * be sure we start at the beginning */
@@ -7448,6 +7634,8 @@ int nodeLinkClass::adminStateChange ( struct nodeLinkClass::node * node_ptr,
 {
     int rc = FAIL ;
 
+    fsm_wake ( node_ptr );
+
     if ((        newAdminState < MTC_ADMIN_STATES ) &&
         ( node_ptr->adminState < MTC_ADMIN_STATES ))
     {
@@ -7464,6 +7652,11 @@ int nodeLinkClass::adminStateChange ( struct nodeLinkClass::node * node_ptr,
                                    mtc_nodeOperState_str  [node_ptr->operState],
                                    mtc_nodeAvailStatus_str[node_ptr->availStatus]);
             node_ptr->adminState = newAdminState ;
+            flightRecorder_log ( FLIGHT_EVENT__STATE_CHANGE,
+                                 node_ptr->hostname.c_str(),
+                                 node_ptr->adminState,
+                                 node_ptr->operState,
+                                 node_ptr->availStatus );
         }
     }
     else
@@ -7480,6 +7673,8 @@ int nodeLinkClass::operStateChange ( struct nodeLinkClass::node * node_ptr,
 {
     int rc = FAIL ;
 
+    fsm_wake ( node_ptr );
+
     if ((        newOperState < MTC_OPER_STATES ) &&
         ( node_ptr->operState < MTC_OPER_STATES ))
     {
@@ -7509,6 +7704,11 @@ int nodeLinkClass::operStateChange ( struct nodeLinkClass::node * node_ptr,
             }
 
             node_ptr->operState = newOperState ;
+            flightRecorder_log ( FLIGHT_EVENT__STATE_CHANGE,
+                                 node_ptr->hostname.c_str(),
+                                 node_ptr->adminState,
+                                 node_ptr->operState,
+                                 node_ptr->availStatus );
 
             clog ("%s %s-%s-%s\n", node_ptr->hostname.c_str(),
                                    mtc_nodeAdminState_str [node_ptr->adminState],
@@ -7529,6 +7729,8 @@ int nodeLinkClass::availStatusChange ( struct nodeLinkClass::node * node_ptr,
 {
     int rc = FAIL ;
 
+    fsm_wake ( node_ptr );
+
     if ((        newAvailStatus < MTC_AVAIL_STATUS ) &&
         ( node_ptr->availStatus < MTC_AVAIL_STATUS ))
     {
@@ -7660,6 +7862,11 @@ int nodeLinkClass::availStatusChange ( struct nodeLinkClass::node * node_ptr,
                                    mtc_nodeAvailStatus_str[node_ptr->availStatus]);
 
             node_ptr->availStatus = newAvailStatus ;
+            flightRecorder_log ( FLIGHT_EVENT__STATE_CHANGE,
+                                 node_ptr->hostname.c_str(),
+                                 node_ptr->adminState,
+                                 node_ptr->operState,
+                                 node_ptr->availStatus );
         }
     }
     else
@@ -8090,24 +8297,6 @@ struct nodeLinkClass::node * nodeLinkClass::get_thread_timer ( timer_t tid )
     return static_cast<struct node *>(NULL);
 }
 
-struct nodeLinkClass::node * nodeLinkClass::get_ping_timer ( timer_t tid )
-{
-   /* check for empty list condition */
-   if ( tid != NULL )
-   {
-       for ( struct node * ptr = head ;  ; ptr = ptr->next )
-       {
-           if ( ptr->bm_ping_info.timer.tid == tid )
-           {
-               return ptr ;
-           }
-           if (( ptr->next == NULL ) || ( ptr == tail ))
-               break ;
-        }
-    }
-    return static_cast<struct node *>(NULL);
-}
-
 struct nodeLinkClass::node * nodeLinkClass::get_bm_timer ( timer_t tid )
 {
    /* check for empty list condition */
@@ -8981,10 +9170,10 @@ int nodeLinkClass::mon_host ( const string & hostname, bool true_false, bool sen
                           node_ptr->monitor[iface] ? "re" : "");
 
                 node_ptr->no_work_log_throttle = 0 ;
-                node_ptr->b2b_misses_count[iface] = 0 ;
-                node_ptr->hbs_misses_count[iface] = 0 ;
-                node_ptr->b2b_pulses_count[iface] = 0 ;
-                node_ptr->max_count[iface] = 0 ;
+                pulse_table[iface].b2b_misses_count[pulse_row(node_ptr)] = 0 ;
+                pulse_table[iface].hbs_misses_count[pulse_row(node_ptr)] = 0 ;
+                pulse_table[iface].b2b_pulses_count[pulse_row(node_ptr)] = 0 ;
+                pulse_table[iface].max_count[pulse_row(node_ptr)] = 0 ;
                 node_ptr->hbs_failure[iface] = false ;
                 node_ptr->hbs_minor[iface] = false ;
                 node_ptr->hbs_degrade[iface] = false ;
@@ -8998,7 +9187,7 @@ int nodeLinkClass::mon_host ( const string & hostname, bool true_false, bool sen
                               get_iface_name_str(iface));
                 }
             }
-            node_ptr->monitor[iface] = true_false ;
+            set_monitor ( node_ptr, iface, true_false );
         }
         return PASS ;
     }
@@ -9101,12 +9290,12 @@ void nodeLinkClass::manage_pulse_flags ( struct nodeLinkClass::node * node_ptr,
      *            pulse responses. */
     if ( node_ptr->monitor[MGMNT_IFACE] == false )
     {
-        node_ptr->monitor[CLSTR_IFACE] = false ;
+        set_monitor ( node_ptr, CLSTR_IFACE, false );
     }
     else if ( flags & CLSTR_FLAG )
     {
         /* TODO: Does this need to be debounced ??? */
-        node_ptr->monitor[CLSTR_IFACE] = true ;
+        set_monitor ( node_ptr, CLSTR_IFACE, true );
     }
 
     /* A host indicates that its process monitor is running by setting the
@@ -9177,68 +9366,157 @@ void nodeLinkClass::manage_pulse_flags ( struct nodeLinkClass::node * node_ptr,
     }
 }
 
-/* Create the monitored pulse list for the specified interface */
-int nodeLinkClass::create_pulse_list ( iface_enum iface )
+/* Add a host to an interface's pulse table.
+ * A host that joins mid period is not expected until the next period */
+void nodeLinkClass::pulse_table_add ( struct nodeLinkClass::node * node_ptr, int iface )
 {
-    struct node * ptr = head ;
+    int rri = node_ptr->rri ;
+    if (( rri <= 0 ) || ( rri >= MAX_NODES ) || ( hbs_rra[rri] != node_ptr ))
+        return ;
+
+    if ( pulse_table[iface].slot[rri] >= 0 )
+        return ;
+
+    pulse_table[iface].slot[rri] = pulse_table[iface].members ;
+    pulse_table[iface].rri[pulse_table[iface].members++] = rri ;
+    pulse_table[iface].responded[rri] = pulse_table[iface].generation ;
+
+    /* take the full path on the first response so that any
+     * stale heartbeat alarm or event state gets cleared */
+    pulse_table[iface].transition[rri] = true ;
+}
 
+/* Remove a host from an interface's pulse table */
+void nodeLinkClass::pulse_table_del ( struct nodeLinkClass::node * node_ptr, int iface )
+{
+    int rri = node_ptr->rri ;
+    if (( rri <= 0 ) || ( rri >= MAX_NODES ))
+        return ;
+
+    int slot = pulse_table[iface].slot[rri] ;
+    if ( slot < 0 )
+        return ;
+
+    if (( pulse_table[iface].responded[rri] != pulse_table[iface].generation ) &&
+        ( pulse_table[iface].pending ))
+    {
+        pulse_table[iface].pending-- ;
+    }
+
+    /* keep the member list compact by moving the last member into the hole */
+    int last = pulse_table[iface].rri[--pulse_table[iface].members] ;
+    pulse_table[iface].rri[slot] = last ;
+    pulse_table[iface].slot[last] = slot ;
+    pulse_table[iface].slot[rri] = -1 ;
+}
+
+/* Rebuild all pulse table member lists from the RRA.
+ * Called whenever the RRA is rebuilt since that changes the rris.
+ * The per rri rows have already been moved by build_rra so the
+ * responded state of the current period is preserved. */
+void nodeLinkClass::pulse_table_build ( void )
+{
+    for ( int iface = 0 ; iface < MAX_IFACES ; iface++ )
+    {
+        struct pulse_table_type & table = pulse_table[iface] ;
+        for ( int rri = 0 ; rri < MAX_NODES ; rri++ )
+            table.slot[rri] = -1 ;
+
+        table.members = 0 ;
+        table.pending = 0 ;
+
+        for ( int rri = 1 ; rri < MAX_NODES ; rri++ )
+        {
+            if ( hbs_rra[rri] == NULL )
+                break ;
+            if ( hbs_rra[rri]->monitor[iface] == false )
+                continue ;
+
+            table.slot[rri] = table.members ;
+            table.rri[table.members++] = rri ;
+            if ( table.responded[rri] != table.generation )
+                table.pending++ ;
+        }
+    }
+}
+
+/* Returns the node's row in the pulse tables.
+ * Row 0 is never a member so it is returned for nodes without a valid rri */
+int nodeLinkClass::pulse_row ( struct nodeLinkClass::node * node_ptr )
+{
+    int rri = node_ptr->rri ;
+    if (( rri > 0 ) && ( rri < MAX_NODES ) && ( hbs_rra[rri] == node_ptr ))
+        return rri ;
+    return 0 ;
+}
+
+/* Copy row 'from' of the specified tables into row 'to' of the
+ * pulse tables. A 'from' of 0 clears the row instead. */
+void nodeLinkClass::pulse_row_copy ( struct pulse_table_type * from_ptr, int from, int to )
+{
+    for ( int iface = 0 ; iface < MAX_IFACES ; iface++ )
+    {
+        struct pulse_table_type & src = from_ptr[iface] ;
+        struct pulse_table_type & dst = pulse_table[iface] ;
+        if ( from == 0 )
+        {
+            dst.responded       [to] = dst.generation ;
+            dst.hbs_count       [to] = 0 ;
+            dst.hbs_misses_count[to] = 0 ;
+            dst.b2b_misses_count[to] = 0 ;
+            dst.b2b_pulses_count[to] = 0 ;
+            dst.max_count       [to] = 0 ;
+            dst.transition      [to] = true ;
+        }
+        else
+        {
+            dst.responded       [to] = src.responded       [from] ;
+            dst.hbs_count       [to] = src.hbs_count       [from] ;
+            dst.hbs_misses_count[to] = src.hbs_misses_count[from] ;
+            dst.b2b_misses_count[to] = src.b2b_misses_count[from] ;
+            dst.b2b_pulses_count[to] = src.b2b_pulses_count[from] ;
+            dst.max_count       [to] = src.max_count       [from] ;
+            dst.transition      [to] = src.transition      [from] ;
+        }
+    }
+}
+
+/* Start or stop heartbeat monitoring of a host on one interface */
+void nodeLinkClass::set_monitor ( struct nodeLinkClass::node * node_ptr, int iface, bool state )
+{
+    if ( node_ptr->monitor[iface] == state )
+        return ;
+
+    node_ptr->monitor[iface] = state ;
+    if ( state == true )
+        pulse_table_add ( node_ptr, iface );
+    else
+        pulse_table_del ( node_ptr, iface );
+}
+
+/* Start a new heartbeat period for the specified interface */
+int nodeLinkClass::create_pulse_list ( iface_enum iface )
+{
     if ( iface >= MAX_IFACES )
     {
         dlog ("Invalid interface (%d)\n", iface );
         return 0;
     }
 
-    pulses[iface] = 0;
-    pulse_list[iface].last_ptr = NULL ;
-    pulse_list[iface].head_ptr = NULL ;
-    pulse_list[iface].tail_ptr = NULL ;
-
     /* No check-in list if there is no inventory */
     if (( head == NULL ) || ( hosts == 0 ))
     {
+        pulse_table[iface].pending = 0 ;
         return 0;
     }
 
-    /* walk the node list looking for nodes that should be monitored */
-    for ( ; ptr != NULL ; ptr = ptr->next )
-    {
-        if ( ptr->monitor[iface] == true )
-        {
-            /* current monitored node pointer */
-            pulse_ptr = ptr ;
-            
-            /* if first pulse node */
-            if ( pulse_list[iface].head_ptr == NULL )
-            {
-                /* need to keep track of the last node so we can deal with 
-                 * skipped nodes when they are not in monitor mode */
-                pulse_list[iface].last_ptr = pulse_ptr ;
-                pulse_list[iface].head_ptr = pulse_ptr ;
-                pulse_list[iface].tail_ptr = pulse_ptr ;
-                pulse_ptr->pulse_link[iface].prev_ptr = NULL ;
-            }
-            else 
-            {
-                pulse_list[iface].last_ptr->pulse_link[iface].next_ptr = pulse_ptr ;
-                pulse_ptr->pulse_link[iface].prev_ptr = pulse_list[iface].last_ptr ;
-                pulse_list[iface].last_ptr = pulse_ptr ; /* save current to handle a skip */
-                pulse_list[iface].tail_ptr = pulse_ptr ; /* migrate tail as list is built */
-            }
-            pulse_ptr->pulse_link[iface].next_ptr = NULL ;
-
-            pulse_ptr->linknum[iface] = ++pulses[iface] ;
+    pulse_table[iface].generation++ ;
+    pulse_table[iface].pending = pulse_table[iface].members ;
 
-            mlog2 ("%s %s Pulse Info: %d:%d - %d:%p\n",
-                      pulse_ptr->hostname.c_str(),
-                      get_iface_name_str(iface),
-                      pulse_ptr->linknum[iface], 
-                      pulses[iface], 
-                      pulse_ptr->rri, 
-                      pulse_ptr);
-        }
-    }
+#ifdef WANT_HBS_MEM_LOGS
     print_pulse_list(iface);
-    return (pulses[iface]);
+#endif
+    return (pulse_table[iface].pending);
 }
 
 /** Clear heartbeat stats in support of failed heartbeat restart */
@@ -9249,11 +9527,11 @@ void nodeLinkClass::hbs_clear_all_stats ( void )
     {
         for ( int iface = 0 ; iface < MAX_IFACES ; iface++ )
         {
-            ptr->max_count[iface] = 0 ;
-            ptr->hbs_count[iface] = 0 ;
-            ptr->hbs_misses_count[iface] = 0 ;
-            ptr->b2b_pulses_count[iface] = 0 ;
-            ptr->b2b_misses_count[iface] = 0 ;
+            pulse_table[iface].max_count[pulse_row(ptr)] = 0 ;
+            pulse_table[iface].hbs_count[pulse_row(ptr)] = 0 ;
+            pulse_table[iface].hbs_misses_count[pulse_row(ptr)] = 0 ;
+            pulse_table[iface].b2b_pulses_count[pulse_row(ptr)] = 0 ;
+            pulse_table[iface].b2b_misses_count[pulse_row(ptr)] = 0 ;
             ptr->hbs_minor_count[iface] = 0 ;
             ptr->hbs_degrade_count[iface] = 0 ;
             ptr->hbs_failure_count[iface] = 0 ;
@@ -9270,10 +9548,23 @@ void nodeLinkClass::hbs_clear_all_stats ( void )
 /** Build the Reasource Reference Array */ 
 void nodeLinkClass::build_rra ( void )
 {
+    /* The pulse table rows are indexed by rri so they have to move
+     * with their node. Work from a snapshot of the current tables. */
+    static struct pulse_table_type saved [MAX_IFACES] ;
+    static struct node * saved_rra [MAX_NODES] ;
+    memcpy ( saved, pulse_table, sizeof(saved));
+    memcpy ( saved_rra, hbs_rra, sizeof(saved_rra));
+
     struct node * ptr = NULL ;
     int x = 1 ;
     for ( ptr = head ; ptr != NULL ; ptr = ptr->next )
     {
+        /* a node that was not in the old rra gets a cleared row */
+        int old_rri = ptr->rri ;
+        if (( old_rri <= 0 ) || ( old_rri >= MAX_NODES ) || ( saved_rra[old_rri] != ptr ))
+            old_rri = 0 ;
+        pulse_row_copy ( saved, old_rri, x );
+
         hbs_rra [x] = ptr ; 
         ptr->rri=x ; 
         x++ ;
@@ -9288,10 +9579,16 @@ void nodeLinkClass::build_rra ( void )
 
     /* fill the rest with NULL */
     for ( ; x < MAX_NODES ; x++ )
+    {
         hbs_rra[x] = NULL ;
+        pulse_row_copy ( saved, 0, x );
+    }
 
     /* Reset the "Running RRI" */
     rrri = 0 ;
+
+    /* the pulse tables are indexed by rri */
+    pulse_table_build ();
 }
 
 /** Gets the next hostname and resource reference identifier 
@@ -9320,22 +9617,16 @@ void   nodeLinkClass::get_rris ( string & hostname, int & rri )
 
 struct nodeLinkClass::node* nodeLinkClass::getPulseNode ( string & hostname , iface_enum iface )
 {
-    /* check for empty list condition */
-    if ( pulse_list[iface].head_ptr == NULL )
-        return NULL ;
+    struct node * node_ptr = getNode ( hostname );
+    if (( node_ptr == NULL ) || ( node_ptr->rri <= 0 ) || ( node_ptr->rri >= MAX_NODES ))
+        return static_cast<struct node *>(NULL);
 
-    for ( pulse_ptr = pulse_list[iface].head_ptr ;  ; pulse_ptr = pulse_ptr->pulse_link[iface].next_ptr )
+    /* only if its still expected to respond in this period */
+    if (( pulse_table[iface].slot[node_ptr->rri] >= 0 ) &&
+        ( pulse_table[iface].responded[node_ptr->rri] != pulse_table[iface].generation ))
     {
-        if ( !hostname.compare ( pulse_ptr->hostname ))
-        {
-            return pulse_ptr ;  
-        }
-        if (( pulse_ptr->pulse_link[iface].next_ptr == NULL ) || 
-            ( pulse_ptr==pulse_list[iface].tail_ptr ))
-        {
-            break ;
-        }
-    } 
+        return node_ptr ;
+    }
     return static_cast<struct node *>(NULL);
 }
 
@@ -9395,17 +9686,6 @@ int nodeLinkClass::remPulse_by_name ( string & hostname, iface_enum iface, bool
     return ( remPulse ( getPulseNode ( hostname, iface ), iface, clear_b2b_misses_count, flags ));
 }
 
-/** WANT_LINKLIST_FIT is not defined by default.
- *  Needs to be explicitely defined and the undef commented out for testing
- **/
-#ifdef WANT_LINKLIST_FIT
-#undef WANT_LINKLIST_FIT
-#endif
-
-#ifdef WANT_LINKLIST_FIT
-static bool already_fit = false ;
-#endif
-
 /* Find the node  in the list of nodes being heartbeated and splice it out */
 int nodeLinkClass::remPulse ( struct node * node_ptr, iface_enum iface, bool clear_b2b_misses_count, unsigned int flags )
 {
@@ -9422,15 +9702,18 @@ int nodeLinkClass::remPulse ( struct node * node_ptr, iface_enum iface, bool cle
     }
 
     struct node * ptr = node_ptr ;
+    struct pulse_table_type & table = pulse_table[iface] ;
+    int rri = ptr->rri ;
 
     // dlog ("%s\n", node_ptr->hostname.c_str());
 
-    /* Splice the node out of the pulse monitor list */
+    /* Mark the node as having responded in this heartbeat period */
 
-    /* Does the pulse monitor list exist and is the node in the list */
-    /* Need to gracefully handle being called when there is no pulse */
-    /* list and/or the specified host is not in the pulse list       */
-    if (( pulse_list[iface].head_ptr != NULL ) && ( ptr != NULL ) && ( ptr->linknum[iface] != 0))
+    /* Need to gracefully handle being called for a host that is not  */
+    /* monitored or that has already responded in this period         */
+    if (( rri > 0 ) && ( rri < MAX_NODES ) &&
+        ( table.slot[rri] >= 0 ) &&
+        ( table.responded[rri] != table.generation ))
     {
         pulse_ptr = ptr ;
 
@@ -9439,22 +9722,25 @@ int nodeLinkClass::remPulse ( struct node * node_ptr, iface_enum iface, bool cle
         /* clear_b2b_misses_count override check ; thresold recovery */
         if ( clear_b2b_misses_count == true )
         {
-            ptr->hbs_count[iface]++ ;
-            ptr->b2b_pulses_count[iface]++ ;
+            table.hbs_count[rri]++ ;
+            table.b2b_pulses_count[rri]++ ;
 
-            if ( ptr->b2b_pulses_count[iface] == hbs_failure_threshold )
+            if ( table.b2b_pulses_count[rri] == hbs_failure_threshold )
             {
                 hbs_cluster_change( ptr->hostname + " " + get_iface_name_str(iface) + " heartbeat pass" );
             }
-            else if ( ptr->b2b_pulses_count[iface] == 1 )
+            else if ( table.b2b_pulses_count[rri] == 1 )
             {
                 hbs_cluster_change( ptr->hostname + " " + get_iface_name_str(iface) + " heartbeat start" );
             }
 
-            if ( ptr->hbs_failure[iface] == true )
+            /* The node's heartbeat state only needs to be looked
+             * at if a previous miss may have changed it */
+            if (( table.transition[rri] == true ) &&
+                ( ptr->hbs_failure[iface] == true ))
             {
                 /* threshold failure recovery */
-                if ( ptr->b2b_pulses_count[iface] < HBS_PULSES_REQUIRED_FOR_RECOVERY )
+                if ( table.b2b_pulses_count[rri] < HBS_PULSES_REQUIRED_FOR_RECOVERY )
                 {
                     /* don't clear the alarm or send clear notifications to mtc
                      * if this interfaces failed and has not yet received the
@@ -9463,7 +9749,7 @@ int nodeLinkClass::remPulse ( struct node * node_ptr, iface_enum iface, bool cle
                     dlog ("%s %s heartbeat failure recovery (%d of %d)\n",
                                  node_ptr->hostname.c_str(),
                                  get_iface_name_str(iface),
-                                 ptr->b2b_pulses_count[iface],
+                                 table.b2b_pulses_count[rri],
                                  HBS_PULSES_REQUIRED_FOR_RECOVERY);
                 }
                 else
@@ -9472,37 +9758,39 @@ int nodeLinkClass::remPulse ( struct node * node_ptr, iface_enum iface, bool cle
                     ilog ("%s %s heartbeat failure recovery (%d)\n",
                                  node_ptr->hostname.c_str(),
                                  get_iface_name_str(iface),
-                                 ptr->b2b_pulses_count[iface]);
+                                 table.b2b_pulses_count[rri]);
                 }
             }
             else
             {
-                ptr->b2b_misses_count[iface] = 0 ;
+                table.b2b_misses_count[rri] = 0 ;
             }
         }
         else
         {
-            if (( ptr->b2b_pulses_count[iface] != 0 ) && ( ptr->hbs_failure[iface] == true ))
+            if (( table.b2b_pulses_count[rri] != 0 ) &&
+                ( table.transition[rri] == true ) &&
+                ( ptr->hbs_failure[iface] == true ))
             {
                 ilog ("%s %s failed but %d\n", node_ptr->hostname.c_str(),
                                  get_iface_name_str(iface),
-                                 ptr->b2b_pulses_count[iface]);
+                                 table.b2b_pulses_count[rri]);
             }
 
         }
 
-        if ( clear_b2b_misses_count == true )
+        if (( clear_b2b_misses_count == true ) && ( table.transition[rri] == true ))
         {
             manage_heartbeat_alarm ( pulse_ptr, FM_ALARM_SEVERITY_CLEAR, iface );
-            if ( ptr->b2b_misses_count[iface] > hbs_degrade_threshold )
+            if ( table.b2b_misses_count[rri] > hbs_degrade_threshold )
             {
                 ilog ("%s %s Pulse Rxed (after %d misses)\n",
                              node_ptr->hostname.c_str(),
                              get_iface_name_str(iface),
-                             node_ptr->b2b_misses_count[iface]);
+                             table.b2b_misses_count[rri]);
             }
 
-            ptr->b2b_misses_count[iface] = 0 ;
+            table.b2b_misses_count[rri] = 0 ;
             if ( pulse_ptr->hbs_degrade[iface] == true )
             {
                 /* Send a degrade clear event to maintenance */
@@ -9518,92 +9806,20 @@ int nodeLinkClass::remPulse ( struct node * node_ptr, iface_enum iface, bool cle
                     pulse_ptr->hbs_minor[iface] = false ;
                 }
             }
-        }
-        rc = PASS ;
-#ifdef WANT_LINKLIST_FIT
-        if ( already_fit == false )
-        {
-            if ( daemon_is_file_present ( MTC_CMD_FIT__LINKLIST ) == true )
-            {
-                if ( pulse_list[iface].head_ptr->pulse_link[iface].next_ptr != NULL )
-                {
-                    slog ("FIT of next pointer\n");
-                    pulse_list[iface].head_ptr->pulse_link[iface].next_ptr = NULL ;
-                    already_fit = true ;
-                }
-            }
-        }
-#endif
-        if ( pulse_list[iface].head_ptr == pulse_ptr )
-        {
-            if ( pulse_list[iface].head_ptr == pulse_list[iface].tail_ptr )
-            {
-                qlog2 ("%s Pulse: Single   Node -> Head Case  : %d of %d\n", node_ptr->hostname.c_str(), pulse_ptr->linknum[iface], pulses[iface] );
-                pulse_list[iface].head_ptr = NULL ;
-                pulse_list[iface].tail_ptr = NULL ;
-            }
-            else
-            {
-                qlog2 ("%s Pulse: Multiple Node -> Head Case  : %d of %d\n", node_ptr->hostname.c_str(), pulse_ptr->linknum[iface], pulses[iface] );
-                if ( pulse_list[iface].head_ptr->pulse_link[iface].next_ptr == NULL )
-                {
-                    slog ("%s unexpected NULL next_ptr ; aborting this pulse window\n", node_ptr->hostname.c_str());
-                    pulse_list[iface].head_ptr = NULL ;
-                    pulse_list[iface].tail_ptr = NULL ;
-                    pulse_ptr->linknum[iface] = 0 ;
-                    pulses[iface] = 0 ;
-                    return (FAIL_NULL_POINTER);
-                }
-                else
-                {
-                    pulse_list[iface].head_ptr = pulse_list[iface].head_ptr->pulse_link[iface].next_ptr ;
-                    pulse_list[iface].head_ptr->pulse_link[iface].prev_ptr = NULL ;
-                }
-            }
-        }
-        else if ( pulse_list[iface].tail_ptr == pulse_ptr )
-        {
-            qlog2 ("%s Pulse: Multiple Node -> Tail Case  : %d of %d\n", node_ptr->hostname.c_str(), pulse_ptr->linknum[iface], pulses[iface] );
-            if ( pulse_list[iface].tail_ptr->pulse_link[iface].prev_ptr == NULL )
-            {
-                slog ("%s unexpected NULL prev_ptr ; aborting this pulse window\n", node_ptr->hostname.c_str());
-                pulse_list[iface].head_ptr = NULL ;
-                pulse_list[iface].tail_ptr = NULL ;
-                pulse_ptr->linknum[iface] = 0 ;
-                pulses[iface] = 0 ;
-                return (FAIL_NULL_POINTER);
-            }
-            else
-            {
-                pulse_list[iface].tail_ptr = pulse_list[iface].tail_ptr->pulse_link[iface].prev_ptr ;
-                pulse_list[iface].tail_ptr->pulse_link[iface].next_ptr = NULL ;
-            }
-        }
-        else
-        {
-            /* July 1 emacdona: Make failure path case more robust */
-            if ( pulse_ptr                                  == NULL ) { slog ("Internal Err 1\n"); rc = FAIL; }
-            else if ( pulse_ptr->pulse_link[iface].prev_ptr == NULL ) { slog ("Internal Err 2\n"); rc = FAIL; }
-            else if ( pulse_ptr->pulse_link[iface].next_ptr == NULL ) { slog ("Internal Err 3\n"); rc = FAIL; }
-            if ( rc == FAIL )
-            {
-                slog ("%s Null pointer error splicing %s out of pulse list with %d pulses remaining (Monitoring:%s)\n",
-                          node_ptr->hostname.c_str(),
-                          get_iface_name_str(iface),
-                          pulses[iface],
-                          node_ptr->monitor[iface] ? "Yes" : "No" );
-            }
-            else
+
+            /* back on the fast path once everything is cleared */
+            if (( pulse_ptr->hbs_failure[iface] == false ) &&
+                ( pulse_ptr->hbs_degrade[iface] == false ) &&
+                ( pulse_ptr->hbs_minor[iface]   == false ))
             {
-                pulse_ptr->pulse_link[iface].prev_ptr->pulse_link[iface].next_ptr = pulse_ptr->pulse_link[iface].next_ptr ;
-                pulse_ptr->pulse_link[iface].next_ptr->pulse_link[iface].prev_ptr = pulse_ptr->pulse_link[iface].prev_ptr ;
+                table.transition[rri] = false ;
             }
         }
-        if ( rc == PASS )
-        {
-           pulse_ptr->linknum[iface]-- ;
-        }
-        pulses[iface]-- ;
+        rc = PASS ;
+
+        table.responded[rri] = table.generation ;
+        if ( table.pending )
+            table.pending-- ;
     }
     else if ( node_ptr )
     {
@@ -9646,20 +9862,10 @@ int nodeLinkClass::remove_pulse ( string & hostname, iface_enum iface, int index
 
 void nodeLinkClass::clear_pulse_list ( iface_enum iface )
 {
-   struct node * ptr = head ;
-   for ( ; ptr != NULL ; ptr = ptr->next )
-   {
-      ptr->pulse_link[iface].prev_ptr = NULL ;
-      ptr->pulse_link[iface].next_ptr = NULL ;
-   }
-   pulse_list[iface].head_ptr = NULL ;
-   pulse_list[iface].tail_ptr = NULL ;
-
-   if ( ptr != NULL )
-   {
-       ptr->linknum[iface] = 0    ;
-       pulses[iface] = 0 ;
-   }
+    /* no host is expected to respond for the rest of this period */
+    for ( int i = 0 ; i < pulse_table[iface].members ; i++ )
+        pulse_table[iface].responded[pulse_table[iface].rri[i]] = pulse_table[iface].generation ;
+    pulse_table[iface].pending = 0 ;
 }
 
 /** Runs in the hbsAgent to set or clear heartbat alarms for all supported interfaces */
@@ -9762,21 +9968,26 @@ int nodeLinkClass::lost_pulses ( iface_enum iface, bool & storage_0_responding )
     storage_0_responding = true ;
 
     /*
-     * Loop over the pulse_list which now onoly contains a list of hosts
+     * Loop over the pulse table members looking for hosts
      * that have not responded in this heartbeat period.
      */
-    for (  ; pulse_list[iface].head_ptr != NULL ; )
+    struct pulse_table_type & table = pulse_table[iface] ;
+    for ( int i = 0 ; ( table.pending ) && ( i < table.members ) ; i++ )
     {
+        int rri = table.rri[i] ;
+        if ( table.responded[rri] == table.generation )
+            continue ;
+
         daemon_signal_hdlr ();
-        pulse_ptr = pulse_list[iface].head_ptr ;
+        pulse_ptr = hbs_rra[rri] ;
         lost++ ;
         if ( active )
         {
-            string flat = "Flat Line:" ;
-            pulse_ptr->b2b_misses_count[iface]++ ;
-            pulse_ptr->hbs_misses_count[iface]++ ;
-            pulse_ptr->b2b_pulses_count[iface] = 0 ;
-            // pulse_ptr->max_count[iface]++ ;
+            table.transition[rri] = true ;
+            table.b2b_misses_count[rri]++ ;
+            table.hbs_misses_count[rri]++ ;
+            table.b2b_pulses_count[rri] = 0 ;
+            // table.max_count[rri]++ ;
 
             /*
              * Update storage_0_responding reference to false if storage-0
@@ -9787,55 +9998,55 @@ int nodeLinkClass::lost_pulses ( iface_enum iface, bool & storage_0_responding )
                 storage_0_responding = false ;
             }
 
-            if ( pulse_ptr->b2b_misses_count[iface] > 1 )
+            if ( table.b2b_misses_count[rri] > 1 )
             {
-                if ( pulse_ptr->b2b_misses_count[iface] < hbs_failure_threshold )
+                if ( table.b2b_misses_count[rri] < hbs_failure_threshold )
                 {
                     hbs_cluster_change ( pulse_ptr->hostname + " " +
                             get_iface_name_str(iface) +
                             " heartbeat miss " +
-                            itos(pulse_ptr->b2b_misses_count[iface]));
+                            itos(table.b2b_misses_count[rri]));
                 }
-                if ( pulse_ptr->b2b_misses_count[iface] >= hbs_failure_threshold )
+                if ( table.b2b_misses_count[rri] >= hbs_failure_threshold )
                 {
-                    if ( pulse_ptr->b2b_misses_count[iface] == hbs_failure_threshold )
+                    if ( table.b2b_misses_count[rri] == hbs_failure_threshold )
                     {
                         ilog ("%s %s Pulse Miss (%d) (log throttled to every %d)\n",
                                                      pulse_ptr->hostname.c_str(),
                                                      get_iface_name_str(iface),
-                                                     pulse_ptr->b2b_misses_count[iface],
+                                                     table.b2b_misses_count[rri],
                                                      0xfff);
                     }
                     /* Once the misses exceed 4095 then throttle the logging to avoid flooding */
-                    if ( (pulse_ptr->b2b_misses_count[iface] & 0xfff) == 0 )
+                    if ( (table.b2b_misses_count[rri] & 0xfff) == 0 )
                     {
                         ilog ("%s %s Pulse Miss (%d)\n", pulse_ptr->hostname.c_str(),
                                                      get_iface_name_str(iface),
-                                                     pulse_ptr->b2b_misses_count[iface] );
+                                                     table.b2b_misses_count[rri] );
                     }
                 }
                 else
                 {
-                    if ( pulse_ptr->b2b_misses_count[iface] > hbs_degrade_threshold )
+                    if ( table.b2b_misses_count[rri] > hbs_degrade_threshold )
                     {
                         ilog ("%s %s Pulse Miss (%3d) (max:%3d) (in degrade)\n", pulse_ptr->hostname.c_str(),
                                                                     get_iface_name_str(iface),
-                                                                    pulse_ptr->b2b_misses_count[iface],
-                                                                    pulse_ptr->max_count[iface]);
+                                                                    table.b2b_misses_count[rri],
+                                                                    table.max_count[rri]);
                     }
-                    else if ( pulse_ptr->b2b_misses_count[iface] > hbs_minor_threshold )
+                    else if ( table.b2b_misses_count[rri] > hbs_minor_threshold )
                     {
                         ilog ("%s %s Pulse Miss (%3d) (max:%3d) (in minor)\n",   pulse_ptr->hostname.c_str(),
                                                                     get_iface_name_str(iface),
-                                                                    pulse_ptr->b2b_misses_count[iface] ,
-                                                                    pulse_ptr->max_count[iface]);
+                                                                    table.b2b_misses_count[rri] ,
+                                                                    table.max_count[rri]);
                     }
                     else
                     {
                         ilog ("%s %s Pulse Miss (%3d) (max:%3d)\n", pulse_ptr->hostname.c_str(),
                                                          get_iface_name_str(iface),
-                                                         pulse_ptr->b2b_misses_count[iface],
-                                                         pulse_ptr->max_count[iface]);
+                                                         table.b2b_misses_count[rri],
+                                                         table.max_count[rri]);
                     }
                 }
             }
@@ -9843,14 +10054,16 @@ int nodeLinkClass::lost_pulses ( iface_enum iface, bool & storage_0_responding )
             {
                 dlog ("%s %s Pulse Miss (%d)\n", pulse_ptr->hostname.c_str(),
                                                  get_iface_name_str(iface),
-                                                 pulse_ptr->b2b_misses_count[iface] );
+                                                 table.b2b_misses_count[rri] );
             }
-#ifdef WANT_HBS_MEM_LOGS
-            mem_log ( flat, pulse_ptr->b2b_misses_count[iface], pulse_ptr->hostname.c_str());
-#endif
+            flightRecorder_log ( FLIGHT_EVENT__PULSE_MISS,
+                                 pulse_ptr->hostname.c_str(),
+                                 iface,
+                                 table.b2b_misses_count[rri],
+                                 table.max_count[rri] );
             if ( iface == MGMNT_IFACE )
             {
-                if ( pulse_ptr->b2b_misses_count[iface] == hbs_minor_threshold )
+                if ( table.b2b_misses_count[rri] == hbs_minor_threshold )
                 {
                     if ( this->active_controller )
                     {
@@ -9861,7 +10074,7 @@ int nodeLinkClass::lost_pulses ( iface_enum iface, bool & storage_0_responding )
                     wlog ("%s %s -> MINOR\n", pulse_ptr->hostname.c_str(), get_iface_name_str(iface));
                 }
             }
-            if ( pulse_ptr->b2b_misses_count[iface] == hbs_degrade_threshold )
+            if ( table.b2b_misses_count[rri] == hbs_degrade_threshold )
             {
                 if ( this->active_controller )
                 {
@@ -9882,7 +10095,7 @@ int nodeLinkClass::lost_pulses ( iface_enum iface, bool & storage_0_responding )
 
             }
             /* Handle lost degrade event case */
-            if (( pulse_ptr->b2b_misses_count[iface] > hbs_degrade_threshold ) &&
+            if (( table.b2b_misses_count[rri] > hbs_degrade_threshold ) &&
                 ( pulse_ptr->hbs_degrade[iface] == false ))
             {
                 wlog ("%s -> DEGRADED - Auto-Correction\n", pulse_ptr->hostname.c_str());
@@ -9910,7 +10123,7 @@ int nodeLinkClass::lost_pulses ( iface_enum iface, bool & storage_0_responding )
                  ( clstr_degrade_only == true )))
             {
                 /* Only print the log at the threshold boundary */
-                if ( pulse_ptr->b2b_misses_count[iface]%HBS_LOSS_REPORT_THROTTLE == hbs_failure_threshold )
+                if ( table.b2b_misses_count[rri]%HBS_LOSS_REPORT_THROTTLE == hbs_failure_threshold )
                 {
                     if ( this->active_controller )
                     {
@@ -9924,13 +10137,13 @@ int nodeLinkClass::lost_pulses ( iface_enum iface, bool & storage_0_responding )
                 }
             }
 
-            else if ((pulse_ptr->b2b_misses_count[iface]%HBS_LOSS_REPORT_THROTTLE) == hbs_failure_threshold )
+            else if ((table.b2b_misses_count[rri]%HBS_LOSS_REPORT_THROTTLE) == hbs_failure_threshold )
             // else if ( pulse_ptr->hbs_failure[iface] == false )
             {
                 elog ("%s %s *** Heartbeat Loss *** (b2b_misses:0x%x)\n",
                           pulse_ptr->hostname.c_str(),
                           get_iface_name_str(iface),
-                          pulse_ptr->b2b_misses_count[iface]);
+                          table.b2b_misses_count[rri]);
                 hbs_cluster_change ( pulse_ptr->hostname + " " + get_iface_name_str(iface) + " heartbeat loss" );
 
                 if ( this->active_controller )
@@ -9950,22 +10163,17 @@ int nodeLinkClass::lost_pulses ( iface_enum iface, bool & storage_0_responding )
 
                 pulse_ptr->hbs_failure_count[iface]++ ;
             }
-            if ( pulse_ptr->b2b_misses_count[iface] > pulse_ptr->max_count[iface] )
-                 pulse_ptr->max_count[iface] = pulse_ptr->b2b_misses_count[iface] ;
+            if ( table.b2b_misses_count[rri] > table.max_count[rri] )
+                 table.max_count[rri] = table.b2b_misses_count[rri] ;
         }
 
-        if ( remPulse_by_name ( pulse_ptr->hostname, iface, false, NULL_PULSE_FLAGS ))
+        if ( remPulse ( pulse_ptr, iface, false, NULL_PULSE_FLAGS ))
         {
            elog ("%s %s not in pulse list\n", pulse_ptr->hostname.c_str(),
                                               get_iface_name_str(iface));
            clear_pulse_list ( iface );
            break ;
         }
-        if ( pulse_list[iface].head_ptr == NULL )
-        {
-           // dlog ("Pulse list is Empty\n");
-           break ;
-        }
     }
     return (lost);
 }
@@ -9991,7 +10199,7 @@ bool nodeLinkClass::monitored_pulse ( string hostname , iface_enum iface )
  */
 bool nodeLinkClass::pulse_list_empty ( iface_enum iface )
 {
-    if ( pulse_list[iface].head_ptr == NULL )
+    if ( pulse_table[iface].pending == 0 )
        return true ;
     return false ;
 }
@@ -10000,24 +10208,25 @@ void nodeLinkClass::print_pulse_list ( iface_enum iface )
 {
     string pulse_host_list = "- " ;
 
-    if ( pulse_list[iface].head_ptr != NULL )
+    if ( pulse_table[iface].pending )
     {
-        for ( pulse_ptr = pulse_list[iface].head_ptr ;
-              pulse_ptr != NULL ;
-              pulse_ptr = pulse_ptr->pulse_link[iface].next_ptr )
+        for ( int i = 0 ; i < pulse_table[iface].members ; i++ )
         {
-            pulse_host_list.append(pulse_ptr->hostname.c_str());
+            int rri = pulse_table[iface].rri[i] ;
+            if ( pulse_table[iface].responded[rri] == pulse_table[iface].generation )
+                continue ;
+            pulse_host_list.append(hbs_rra[rri]->hostname.c_str());
             pulse_host_list.append(" ");
         }
         dlog ("Patients: %s\n", pulse_host_list.c_str());
     }
 
 #ifdef WANT_HBS_MEM_LOGS
-    if ( pulses[iface] && !pulse_host_list.empty() )
+    if ( pulse_table[iface].pending && !pulse_host_list.empty() )
     {
         string temp = get_iface_name_str(iface) ;
         temp.append(" Patients :") ;
-        mem_log ( temp, pulses[iface], pulse_host_list );
+        mem_log ( temp, pulse_table[iface].pending, pulse_host_list );
     }
 #endif
 }
@@ -10123,13 +10332,12 @@ void nodeLinkClass::mem_log_ping ( struct nodeLinkClass::node * node_ptr )
     if ( node_ptr->bmc_provisioned )
     {
         char str[MAX_MEM_LOG_DATA] ;
-        snprintf (&str[0], MAX_MEM_LOG_DATA, "%s\tPing stage:%d ok:%s mon:%s %s tid:%p\n",
+        snprintf (&str[0], MAX_MEM_LOG_DATA, "%s\tPing stage:%d ok:%s mon:%s %s\n",
                 node_ptr->bm_ping_info.hostname.c_str(),
                 node_ptr->bm_ping_info.stage,
                 node_ptr->bm_ping_info.ok ? "Yes" : "No",
                 node_ptr->bm_ping_info.monitoring ? "Yes" : "No",
-                node_ptr->bm_ping_info.ip.c_str(),
-                node_ptr->bm_ping_info.timer.tid);
+                node_ptr->bm_ping_info.ip.c_str());
         mem_log (str);
     }
 }
@@ -10352,10 +10560,10 @@ void nodeLinkClass::mem_log_hbs_cnts ( struct nodeLinkClass::node * node_ptr )
                    node_ptr->hbs_minor_count[iface],
                    node_ptr->hbs_degrade_count[iface],
                    node_ptr->hbs_failure_count[iface],
-                   node_ptr->hbs_misses_count[iface],
-                   node_ptr->max_count[iface],
-                   node_ptr->b2b_pulses_count[iface],
-                   node_ptr->hbs_count[iface]);
+                   pulse_table[iface].hbs_misses_count[pulse_row(node_ptr)],
+                   pulse_table[iface].max_count[pulse_row(node_ptr)],
+                   pulse_table[iface].b2b_pulses_count[pulse_row(node_ptr)],
+                   pulse_table[iface].hbs_count[pulse_row(node_ptr)]);
         mem_log (str);
     }
 }
@@ -10491,8 +10699,186 @@ void nodeLinkClass::memDumpAllState ( void )
  *                                                                         *
  ***************************************************************************/
 
+/* Test 1: Node lookup cost.
+ *
+ * Times getNode by hostname, by ip string and by binary address through
+ * the node indexes against the linear list search they replaced, at
+ * increasing host counts. Host count is capped at MAX_NODES. */
+int nodeLinkClass::testhead_node_lookup ( int host_count )
+{
+    #define LOOKUP_LOOPS (20)
+    int rc = PASS ;
+    int count = ( host_count > MAX_NODES ) ? MAX_NODES : host_count ;
+    std::vector<string> names, addrs ;
+    std::vector<struct sockaddr_in> sockaddrs ;
+
+    for ( int i = 0 ; i < count ; i++ )
+    {
+        char name[MAX_HOST_NAME_SIZE] ;
+        char addr[INET6_ADDRSTRLEN] ;
+        snprintf ( name, sizeof(name), "worker-%d", i );
+        snprintf ( addr, sizeof(addr), "192.168.%d.%d", (i/250)+1, (i%250)+1 );
+        names.push_back ( name );
+        addrs.push_back ( addr );
+
+        struct sockaddr_in sa ;
+        MEMSET_ZERO ( sa );
+        sa.sin_family = AF_INET ;
+        inet_pton ( AF_INET, addr, &sa.sin_addr );
+        sockaddrs.push_back ( sa );
+
+        if ( addNode ( names[i] ) == NULL )
+        {
+            printf ("| failed to add %s\n", name );
+            return (FAIL);
+        }
+        set_hostaddr ( names[i], addrs[i] );
+    }
+
+    unsigned long long t0 = gettime_monotonic_nsec ();
+    for ( int l = 0 ; l < LOOKUP_LOOPS ; l++ )
+        for ( int i = 0 ; i < count ; i++ )
+            if ( searchNode ( addrs[i] ) == NULL ) rc = FAIL ;
+    unsigned long long t1 = gettime_monotonic_nsec ();
+    for ( int l = 0 ; l < LOOKUP_LOOPS ; l++ )
+        for ( int i = 0 ; i < count ; i++ )
+            if ( getNode ( names[i] ) == NULL ) rc = FAIL ;
+    unsigned long long t2 = gettime_monotonic_nsec ();
+    for ( int l = 0 ; l < LOOKUP_LOOPS ; l++ )
+        for ( int i = 0 ; i < count ; i++ )
+            if ( get_hostname ( addrs[i] ) != names[i] ) rc = FAIL ;
+    unsigned long long t3 = gettime_monotonic_nsec ();
+    for ( int l = 0 ; l < LOOKUP_LOOPS ; l++ )
+        for ( int i = 0 ; i < count ; i++ )
+            if ( get_hostname ((const struct sockaddr*)&sockaddrs[i]) != names[i] ) rc = FAIL ;
+    unsigned long long t4 = gettime_monotonic_nsec ();
+
+    unsigned long long lookups = (unsigned long long)count * LOOKUP_LOOPS ;
+    printf ("| %4d hosts%s: ns/lookup  search:%llu  name:%llu  ip:%llu  sockaddr:%llu\n",
+             count, ( count != host_count ) ? " (capped)" : "",
+             (t1-t0)/lookups, (t2-t1)/lookups, (t3-t2)/lookups, (t4-t3)/lookups );
+
+    for ( int i = 0 ; i < count ; i++ )
+        remNode ( names[i] );
+
+    if ( !node_index.empty() || !addr_index.empty() )
+    {
+        printf ("| node index not empty after removing all hosts\n");
+        rc = FAIL ;
+    }
+    return (rc);
+}
+
+/* Test 2: Heartbeat period cost.
+ *
+ * Runs full heartbeat periods ; create the pulse list, remove the
+ * pulses of the responding hosts and account for the lost ones ;
+ * with one host in ten missing a pulse in each period. Hosts are
+ * rotated through the missing set so that nobody reaches the minor
+ * threshold. Host count is capped at MAX_NODES-1 since rri 0 is
+ * never used. */
+int nodeLinkClass::testhead_pulse_period ( int host_count )
+{
+    #define PULSE_PERIODS (100)
+    int rc = PASS ;
+    int count = ( host_count >= MAX_NODES ) ? MAX_NODES-1 : host_count ;
+    std::vector<string> names ;
+
+    /* run as a standby hbsAgent with no failure action so that
+     * the lost pulse handling does not send events or alarms */
+    bool save_heartbeat = heartbeat ;
+    bool save_active    = active ;
+    bool save_active_controller = active_controller ;
+    hbs_failure_action_enum save_action = hbs_failure_action ;
+    heartbeat = true ;
+    active    = true ;
+    active_controller  = false ;
+    hbs_failure_action = HBS_FAILURE_ACTION__NONE ;
+
+    for ( int i = 0 ; i < count ; i++ )
+    {
+        char name[MAX_HOST_NAME_SIZE] ;
+        snprintf ( name, sizeof(name), "worker-%d", i );
+        names.push_back ( name );
+        if ( addNode ( names[i] ) == NULL )
+        {
+            printf ("| failed to add %s\n", name );
+            rc = FAIL ;
+            count = i ;
+            break ;
+        }
+        mon_host ( names[i], true, false );
+    }
+
+    int lost = 0 ;
+    unsigned long long t0 = gettime_monotonic_nsec ();
+    for ( int p = 0 ; ( rc == PASS ) && ( p < PULSE_PERIODS ) ; p++ )
+    {
+        bool storage_0_responding ;
+        create_pulse_list ( MGMNT_IFACE );
+        for ( int i = 0 ; i < count ; i++ )
+        {
+            if ((( i + p ) % 10 ) == 0 )
+                continue ;
+            remove_pulse ( names[i], MGMNT_IFACE, i+1, NULL_PULSE_FLAGS );
+        }
+        lost += lost_pulses ( MGMNT_IFACE, storage_0_responding );
+    }
+    unsigned long long t1 = gettime_monotonic_nsec ();
+
+    int expected = 0 ;
+    for ( int p = 0 ; p < PULSE_PERIODS ; p++ )
+        for ( int i = 0 ; i < count ; i++ )
+            if ((( i + p ) % 10 ) == 0 )
+                expected++ ;
+
+    if (( rc == PASS ) && ( lost != expected ))
+    {
+        printf ("| lost %d pulses ; expected %d\n", lost, expected );
+        rc = FAIL ;
+    }
+
+    printf ("| %4d hosts%s: ns/period:%llu  lost:%d\n",
+             count, ( count != host_count ) ? " (capped)" : "",
+             (t1-t0)/PULSE_PERIODS, lost );
+
+    for ( int i = 0 ; i < count ; i++ )
+        remNode ( names[i] );
+
+    heartbeat = save_heartbeat ;
+    active    = save_active ;
+    active_controller  = save_active_controller ;
+    hbs_failure_action = save_action ;
+    return (rc);
+}
+
 int nodeLinkClass::testhead ( int test )
 {
-    UNUSED(test);
-    return (PASS) ;
+    int rc = PASS ;
+    switch ( test )
+    {
+        case 1:
+        {
+            printf ("| Node Lookup Benchmark\n");
+            int host_counts[] = { 50, 500, 5000 } ;
+            for ( unsigned int i = 0 ; i < sizeof(host_counts)/sizeof(int) ; i++ )
+                if ( testhead_node_lookup ( host_counts[i] ) != PASS )
+                    rc = FAIL ;
+            printf ("| Node Lookup Benchmark ....................................... ");
+            break ;
+        }
+        case 2:
+        {
+            printf ("| Heartbeat Period Benchmark\n");
+            int host_counts[] = { 50, 200, 500 } ;
+            for ( unsigned int i = 0 ; i < sizeof(host_counts)/sizeof(int) ; i++ )
+                if ( testhead_pulse_period ( host_counts[i] ) != PASS )
+                    rc = FAIL ;
+            printf ("| Heartbeat Period Benchmark .................................. ");
+            break ;
+        }
+        default:
+            break ;
+    }
+    return (rc) ;
 }
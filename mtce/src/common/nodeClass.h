@@ -18,7 +18,9 @@
 #include <string.h>
 #include <stdio.h>
 #include <list>
+#include <map>
 #include <vector>
+#include <unordered_map>
 
 #define WANT_MTC
 #define WANT_HBS
@@ -45,6 +47,7 @@ using namespace std;
 #include "alarmUtil.h"    /* for ... SFmAlarmDataT                    */
 #include "mtcAlarm.h"     /* for ... MTC_ALARM_ID__xx and utils       */
 #include "mtcThreads.h"   /* for ... mtcThread_bmc               */
+#include "msgClass.h"     /* for ... msgClassAddrKey             */
 
 /**Default back-to-back heartbeat failures for disabled-failed condition */
 #define HBS_FAILURE_THRESHOLD  10
@@ -229,6 +232,18 @@ private:
         /** Pointer to the next node in the list */
         struct node *next;
 
+        /** The keys this node is currently filed under in the
+         *  node_index and addr_index lookup tables ; see index_node */
+        std::vector<std::string>     index_keys ;
+        std::vector<msgClassAddrKey> addr_keys  ;
+
+        /** True while this node is on the fsm run queue ; see fsm_wake */
+        bool fsm_queued ;
+
+        /** Monotonic nsec this idle node is next due to be run by the
+         *  fsm ; 0 if it is only run when woken */
+        unsigned long long fsm_wake_time ;
+
         /** @} private_Node_variables */
 
 
@@ -524,6 +539,7 @@ private:
         // bool work_ready ;
         int  oper_sequence ;
         int  oper_failures ;
+        int  oper_coalesced ; /**< sysinv PATCHes merged into a queued one */
         int  no_work_log_throttle ;
         int          log_throttle ;
 
@@ -563,38 +579,11 @@ private:
         int lookup_mismatch_log_throttle ;
         int unexpected_pulse_log_throttle ;
 
-        /** Pulse Next and Previous Link pointers for creating
-         *  a per-interface pulse link list */
-        struct {
-
-            /** previous pulse pointer used to create the pulse linked list for one interface */
-            struct node * prev_ptr ;
-
-            /** next pulse pointer used to create the pulse linked list for one interface  */
-            struct node * next_ptr ;
-
-        } pulse_link [MAX_IFACES] ;
-
-        /** The link index number for this node is while in an interface pulse linked list */
-        int  linknum [MAX_IFACES] ;
-
         /** true if this host is to be monitored for this indexed interface */
         bool monitor [MAX_IFACES] ;
 
-        /** Ongoing heartbeat count cleared on HBS_START reset */
-        int  hbs_count [MAX_IFACES] ;
-
-        /** Keep track of the number of misses since heartbeat was started */
-        int  hbs_misses_count [MAX_IFACES];
-
-        /** Immediate running count of consecutive heartbeat misses */
-        int  b2b_misses_count [MAX_IFACES];
-
-        /** Number of consecutive pulses received since last miss */
-        int  b2b_pulses_count [MAX_IFACES];
-
-        /** Maximum heartbeat misses since node was last brought into service */
-        int  max_count [MAX_IFACES];
+        /* The per pulse heartbeat counters live in the
+         * nodeLinkClass pulse_table, indexed by rri */
 
         /** total times minor count was exceeded */
         int  hbs_minor_count [MAX_IFACES];
@@ -787,6 +776,63 @@ private:
     struct node * head ; /**< Node Linked List Head pointer */
     struct node * tail ; /**< Node Linked List Tail pointer */
 
+    /** Node lookup indexes.
+     *
+     *  node_index maps each of a node's lookup strings ; hostname, uuid
+     *  and its mgmt, cluster-host and pxeboot ip addresses, to that node.
+     *  addr_index maps the binary form of those ip addresses to the node
+     *  so that a received message's source address can be resolved
+     *  without building a string.
+     *
+     *  Both are maintained by index_node and unindex_node whenever a
+     *  node is added, removed or has any of these keys modified. */
+    std::unordered_map<std::string, struct node *> node_index ;
+    std::unordered_map<msgClassAddrKey, struct node *, msgClassAddrKeyHash> addr_index ;
+
+    /** (Re)file a node under its current set of lookup keys */
+    void index_node   ( struct node * node_ptr );
+
+    /** Remove all of a node's lookup keys from the indexes */
+    void unindex_node ( struct node * node_ptr );
+
+    /** Linear node list search by hostname, uuid or ip address.
+     *  Only used to recover from a stale index entry. */
+    struct nodeLinkClass::node* searchNode ( string & key );
+
+    /** FSM run queue.
+     *
+     *  Rather than visit every host on every pass the main fsm only
+     *  runs the hosts that have been woken by fsm_wake ; by a timer,
+     *  message, admin request or work queue entry, along with any
+     *  host whose next ping is due in fsm_timers. A host stays on the
+     *  run queue for as long as fsm_idle says it has work in progress.
+     *
+     *  All hosts are still swept every MTC_FSM_SWEEP_MSECS, or on the
+     *  next pass if fsm_sweep_now is set, so a missed wake-up only
+     *  delays a host rather than stalling it. */
+    std::vector<struct node *> fsm_runq  ;
+    std::vector<struct node *> fsm_batch ;
+    std::multimap<unsigned long long, struct node *> fsm_timers ;
+    unsigned long long fsm_sweep_time ;
+    bool               fsm_sweep_now  ;
+
+    /** fsm scheduling stats ; see fsm_dump */
+    unsigned long long fsm_passes ;
+    unsigned long long fsm_sweeps ;
+    unsigned long long fsm_runs   ;
+
+    /** Returns true if the host has nothing in progress that needs it
+     *  run before its next wake-up. Loads the time of its next ping
+     *  into wake_time or 0 if there is none. */
+    bool fsm_idle    ( struct node * node_ptr, unsigned long long & wake_time );
+
+    /** File the host in fsm_timers to be run at wake_time ; replacing
+     *  any earlier entry. A wake_time of 0 just removes the entry. */
+    void fsm_timer_set ( struct node * node_ptr, unsigned long long wake_time );
+
+    /** Remove a host from the run queue and fsm_timers */
+    void fsm_unqueue ( struct node * node_ptr );
+
     /* System-wide Swact mutex gate - prevents admin actions during swact */
     bool swact_mutex ;
     int  swact_mutex_stuck ;
@@ -849,6 +895,8 @@ private:
     *  a pointer to the hostname's node
     */
     struct nodeLinkClass::node* getNode ( string hostname );
+    struct nodeLinkClass::node* getNode ( const struct sockaddr * hostaddr );
+    struct nodeLinkClass::node* getNode ( const msgClassAddrKey & hostaddr );
 
    /** Get the node pointer based on the service and libevent base pointer.
     *
@@ -1216,7 +1264,6 @@ private:
     struct nodeLinkClass::node * get_power_timer      ( timer_t tid );
     struct nodeLinkClass::node * get_http_timer       ( timer_t tid );
     struct nodeLinkClass::node * get_thread_timer     ( timer_t tid );
-    struct nodeLinkClass::node * get_ping_timer       ( timer_t tid );
     struct nodeLinkClass::node * get_bm_timer         ( timer_t tid );
     struct nodeLinkClass::node * get_bmc_access_timer ( timer_t tid );
     struct nodeLinkClass::node * get_bmc_audit_timer  ( timer_t tid );
@@ -1312,17 +1359,68 @@ private:
     void manage_dor_recovery ( struct nodeLinkClass::node * node_ptr, EFmAlarmSeverityT severity );
     void report_dor_recovery ( struct nodeLinkClass::node * node_ptr, string node_state_log_prefix, string extra );
 
-    struct {
-        struct node * head_ptr ; /**< Pulse Linked List Head pointer */
-        struct node * tail_ptr ; /**< Pulse Linked List Tail pointer */
-        struct node * last_ptr ; /**< Pulse Linked List running last pointer */
-    } pulse_list [MAX_IFACES]  ;
+    /** Per-interface pulse table indexed by resource reference identifier.
+     *
+     *  The set of monitored hosts is maintained incrementally as heartbeat
+     *  monitoring of a host starts and stops, and is only rebuilt along
+     *  with the RRA when a host is added or deleted.
+     *
+     *  A heartbeat period is started by advancing the generation. A host
+     *  has responded in the current period when its responded generation
+     *  matches the table's.
+     *
+     *  The table also holds, as dense arrays, the heartbeat counters that
+     *  are updated for every pulse and every miss so that the receive and
+     *  lost_pulses loops don't touch the node struct of a healthy host.
+     *  Row 0 is not used by any host ; it reads as zero for hosts that
+     *  do not have an rri. */
+    struct pulse_table_type {
+        int          members    ; /**< number of monitored hosts          */
+        int          pending    ; /**< members yet to respond this period */
+        unsigned int generation ; /**< current heartbeat period           */
+        int          rri       [MAX_NODES] ; /**< compact member rri list */
+        int          slot      [MAX_NODES] ; /**< rri's index in rri[] or -1 */
+        unsigned int responded [MAX_NODES] ; /**< rri's last response period */
 
-    /** General Pulse Pointer used to build pulse linked list */
-    struct node * pulse_ptr    ;
+        /** Ongoing heartbeat count cleared on HBS_START reset */
+        int  hbs_count        [MAX_NODES] ;
+
+        /** Number of misses since heartbeat was started */
+        int  hbs_misses_count [MAX_NODES] ;
+
+        /** Immediate running count of consecutive heartbeat misses */
+        int  b2b_misses_count [MAX_NODES] ;
+
+        /** Number of consecutive pulses received since last miss */
+        int  b2b_pulses_count [MAX_NODES] ;
+
+        /** Maximum heartbeat misses since node was last brought into service */
+        int  max_count        [MAX_NODES] ;
+
+        /** Set when a miss may have put the node into heartbeat minor,
+         *  degrade or failure state or raised its heartbeat alarm.
+         *  Cleared by a pulse response once all of those are clear. */
+        bool transition       [MAX_NODES] ;
+    } pulse_table [MAX_IFACES] ;
+
+    /** A node's row in the pulse tables ; 0 if it has no rri */
+    int pulse_row ( struct nodeLinkClass::node * node_ptr );
+
+    /** Move or clear one host's row of every pulse table */
+    void pulse_row_copy ( struct pulse_table_type * from_ptr, int from, int to );
+
+    /** Add or remove a host from an interface's pulse table */
+    void pulse_table_add ( struct nodeLinkClass::node * node_ptr, int iface );
+    void pulse_table_del ( struct nodeLinkClass::node * node_ptr, int iface );
+
+    /** Rebuild all pulse tables from the RRA and host monitor states */
+    void pulse_table_build ( void );
 
-    /** Number monitored hosts (nodes) for a specified interface */
-    int  pulses[MAX_IFACES] ;
+    /** Start or stop heartbeat monitoring of a host on one interface */
+    void set_monitor ( struct nodeLinkClass::node * node_ptr, int iface, bool state );
+
+    /** General Pulse Pointer */
+    struct node * pulse_ptr    ;
 
     /** Resource reference Array: An array used to store
      *  resource references for the purpose of fast resource
@@ -1334,12 +1432,13 @@ private:
 
    /** Pulse list node lookup pointer by hostname.
     *
-    * Get pointer to "hostname" node located in the pulse list.
+    * Get pointer to "hostname" node if it is still expected to
+    * respond in the current heartbeat period.
     *
     * @param hostname - a string containing the name of the host
     *                   to be searched for in the pulse list.
-    * @param iface    - iface_enum specifying which interface linked
-    *                   list to search.
+    * @param iface    - iface_enum specifying which interface's
+    *                   pulse table to search.
     *
     * @return pointer to the node's control struct
     */
@@ -1484,6 +1583,16 @@ public:
     /* the main fsm entrypoint to service all hosts */
     void fsm ( void ) ;
 
+    /** Mark a host runnable so that the main fsm runs it on its next pass */
+    void fsm_wake     ( struct nodeLinkClass::node * node_ptr );
+    void fsm_wake     ( string & hostname );
+
+    /** Run all hosts on the next fsm pass */
+    void fsm_wake_all ( void );
+
+    /** Log the fsm scheduling stats */
+    void fsm_dump     ( void );
+
     void mnfa_recovery_handler ( string & hostname );
 
     /** This controller's hostname set'er */
@@ -1537,6 +1646,10 @@ public:
     /** get hostname for any hostname */
     string get_hostname ( string hostaddr );
 
+    /** get hostname from a binary source address without string conversion */
+    string get_hostname ( const struct sockaddr * hostaddr );
+    string get_hostname ( const msgClassAddrKey & hostaddr );
+
     /******************************/
     /* NODE TYPE Member Functions */
     /******************************/
@@ -1801,6 +1914,8 @@ public:
     void print_node_info ( void );
 
     int testhead ( int test );
+    int testhead_node_lookup ( int host_count );
+    int testhead_pulse_period ( int host_count );
 
     int testmode ;
 
@@ -1848,6 +1963,8 @@ public:
     /** handle an expired timer. Find the node with this
       * timer ID and set its ringer */
     void timer_handler   ( int sig, siginfo_t *si, void *uc);
+    bool timer_handler_node   ( struct nodeLinkClass::node * node_ptr, struct mtc_timer * fired );
+    bool timer_handler_global ( struct mtc_timer * fired );
 
     struct mtc_timer mtcTimer         ;
     struct mtc_timer mtcTimer_mnfa    ;
@@ -2091,14 +2208,14 @@ public:
 
     /*********************** Public Heartbeat Interfaces *********************/
 
-    /** Creates a linked list of nodes to heartbeat for the specified port
+    /** Starts a new heartbeat period for the specified port
     *
-    * Based on unlocked enabled hosts and provisioned ports
+    * All hosts monitored on this port are expected to respond again.
     *
     * @param
-    *  iface_enum specifying the port to create the pulse list for
+    *  iface_enum specifying the port to start the period for
     * @return
-    *  a pointer to the head of the burndown checkin list for the specified port
+    *  the number of pulse responses expected this period
     */
     int  create_pulse_list ( iface_enum iface );
 
@@ -0,0 +1,154 @@
+/*
+ * Copyright (c) 2026 Wind River Systems, Inc.
+*
+* SPDX-License-Identifier: Apache-2.0
+*
+ */
+
+ /**
+  * @file
+  * Starling-X Maintenance Flight Recorder Decoder
+  *
+  * Decodes the binary flight recordings that the maintenance daemons
+  * keep in /dev/shm/<daemon>.flight ; and the previous run's recording
+  * in /dev/shm/<daemon>.flight.prev ; into one line of text per event.
+  *
+  * Works on a live recording or one left behind by a crashed daemon.
+  * The file may also be copied off the host and decoded elsewhere.
+  *
+  * Usage: mtcFlight [-n <last>] [-e <event>] [-t <tag>] [file ...]
+  *
+  *   -n  only show the last <last> events of each file
+  *   -e  only show events with this name ; i.e. pulse_miss
+  *   -t  only show events with this tag  ; i.e. controller-1
+  *
+  * With no file all recordings in /dev/shm are decoded.
+  */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include <fcntl.h>
+#include <glob.h>
+#include <unistd.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <string>
+#include <vector>
+
+using namespace std;
+
+#include "returnCodes.h"    /* for ... PASS                             */
+#include "flightRecorder.h" /* for ... flightRecorder_load / _format    */
+
+static size_t       _last  = 0    ;
+static const char * _event = NULL ;
+static const char * _tag   = NULL ;
+
+static int decode ( const char * filename )
+{
+    int fd = open ( filename, O_RDONLY );
+    if ( fd < 0 )
+    {
+        fprintf ( stderr, "unable to open %s: %m\n", filename );
+        return (FAIL_FILE_OPEN);
+    }
+
+    struct stat st ;
+    if (( fstat ( fd, &st ) != 0 ) || ( st.st_size == 0 ))
+    {
+        fprintf ( stderr, "%s is empty\n", filename );
+        close ( fd );
+        return (FAIL_INVALID_DATA);
+    }
+
+    void * base = mmap ( NULL, st.st_size, PROT_READ, MAP_SHARED, fd, 0 );
+    close ( fd );
+    if ( base == MAP_FAILED )
+    {
+        fprintf ( stderr, "unable to map %s: %m\n", filename );
+        return (FAIL_FILE_ACCESS);
+    }
+
+    flight_header_type header ;
+    vector<flight_record_type> records ;
+    int rc = flightRecorder_load ( base, st.st_size, header, records );
+    munmap ( base, st.st_size );
+    if ( rc != PASS )
+    {
+        fprintf ( stderr, "%s is not a flight recording\n", filename );
+        return (rc);
+    }
+
+    char buf [256] ;
+    struct tm tm ;
+    time_t secs = (time_t)(header.start / 1000000000) ;
+    localtime_r ( &secs, &tm );
+    strftime ( buf, sizeof(buf), "%Y-%m-%dT%H:%M:%S", &tm );
+    printf ("%s: %s pid:%d started:%s events:%llu (%zu in ring of %u)\n",
+             filename, header.name, header.pid, buf,
+             (unsigned long long)header.head,
+             records.size(), header.records );
+
+    size_t first = 0 ;
+    if (( _last ) && ( records.size() > _last ))
+        first = records.size() - _last ;
+
+    for ( size_t i = first ; i < records.size() ; i++ )
+    {
+        if (( _event ) && strcmp ( _event, flightRecorder_event_str ( records[i].event )))
+            continue ;
+        if (( _tag ) && strcmp ( _tag, records[i].tag ))
+            continue ;
+        flightRecorder_format ( records[i], buf, sizeof(buf) );
+        printf ("%s\n", buf );
+    }
+    return (PASS);
+}
+
+int main ( int argc, char ** argv )
+{
+    int opt ;
+    while (( opt = getopt ( argc, argv, "n:e:t:h" )) != -1 )
+    {
+        switch ( opt )
+        {
+            case 'n': _last  = strtoul ( optarg, NULL, 10 ); break ;
+            case 'e': _event = optarg ; break ;
+            case 't': _tag   = optarg ; break ;
+            default:
+                printf ("usage: %s [-n <last>] [-e <event>] [-t <tag>] [file ...]\n", argv[0]);
+                return (opt == 'h' ? 0 : 1);
+        }
+    }
+
+    int rc = 0 ;
+    if ( optind < argc )
+    {
+        for ( int i = optind ; i < argc ; i++ )
+            if ( decode ( argv[i] ) != PASS )
+                rc = 1 ;
+        return (rc);
+    }
+
+    /* no files ; decode every recording in /dev/shm */
+    glob_t files ;
+    string pattern = FLIGHT_RECORDER_DIR ;
+    pattern.append("/*");
+    pattern.append(FLIGHT_RECORDER_SUFFIX);
+    pattern.append("*");
+    if ( glob ( pattern.c_str(), 0, NULL, &files ) != 0 )
+    {
+        printf ("no flight recordings found in %s\n", FLIGHT_RECORDER_DIR );
+        return (1);
+    }
+    for ( size_t i = 0 ; i < files.gl_pathc ; i++ )
+    {
+        if ( decode ( files.gl_pathv[i] ) != PASS )
+            rc = 1 ;
+        printf ("\n");
+    }
+    globfree ( &files );
+    return (rc);
+}
@@ -71,8 +71,21 @@ using namespace std;
 
 #define CONFIG_MASK CONFIG_AUDIT_PERIOD
 
+/* Probe defaults ; see fsmond.conf */
+#define FSMON_PROBE_TIMEOUT_DEFAULT  (10)   /* secs  */
+#define FSMON_SLOW_THRESHOLD_DEFAULT (1000) /* msecs */
+#define FSMON_SLOW_COUNT_DEFAULT     (3)
 
-void fsmon_service ( unsigned int nodetype );
+/* Filesystem probe controls loaded from fsmond.conf */
+typedef struct
+{
+    int probe_timeout  ; /**< secs a probe may run before it is failed    */
+    int slow_threshold ; /**< msecs ; a probe op slower than this is slow */
+    int slow_count     ; /**< back to back slow probes to declare slow    */
+} fsmon_ctrl_type ;
+
+void fsmon_service   ( unsigned int nodetype, fsmon_ctrl_type * ctrl_ptr );
+void fsmon_dump_info ( void );
 
 /**
  * @} fsmon_base
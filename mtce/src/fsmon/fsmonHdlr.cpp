@@ -19,11 +19,14 @@
 #include <unistd.h>
 #include <fcntl.h>
 #include <errno.h>
+#include <pthread.h>
+#include <sys/syscall.h>  /* for ... SYS_gettid */
 
 using namespace std;
 
 #include "fsmon.h"
 #include "nodeEvent.h"
+#include "threadUtil.h"   /* for ... dlog_t */
 
 #define FILE_TEST_DATA  "TEST-FILE"
 
@@ -40,6 +43,64 @@ static FileNameT _files[] =
 
 static struct mtc_timer mtcTimer_audit ;
 
+/*******************************************************************
+ * Filesystem probes
+ *
+ * Each monitored file is probed by its own worker thread so that a
+ * hung filesystem only stalls its own worker. The main loop posts a
+ * probe every audit, collects completed results and fails a probe
+ * that has not completed within the probe_timeout deadline. A stuck
+ * worker is not re-posted until its probe finally returns.
+ *
+ * Per filesystem latency histograms of the write, read and unlink
+ * phases are kept for the dump info and for the slow threshold.
+ ******************************************************************/
+
+typedef enum
+{
+    FSMON_OP__WRITE  = 0,
+    FSMON_OP__READ   = 1,
+    FSMON_OP__UNLINK = 2,
+    FSMON_OP__OPS    = 3,
+} fsmon_op_enum ;
+
+static const char * _op_str[FSMON_OP__OPS] = { "write", "read", "unlink" } ;
+
+/* histogram bucket upper bounds in msecs ; the last bucket is unbounded */
+#define FSMON_HIST_BUCKETS (12)
+static const unsigned int _hist_msecs[FSMON_HIST_BUCKETS-1] =
+{ 1, 2, 5, 10, 20, 50, 100, 200, 500, 1000, 5000 } ;
+
+typedef struct
+{
+    const char *   filename ;
+    pthread_t      thread   ;
+    pthread_cond_t cond     ; /**< signals the worker to probe           */
+    bool           started  ; /**< worker thread is running              */
+
+    /* shared with the worker ; protected by _probe_mutex                */
+    bool           pending  ; /**< probe posted and not yet complete     */
+    bool           done     ; /**< probe result ready for collection     */
+    bool           passed   ; /**< probe result                          */
+    unsigned int   msecs[FSMON_OP__OPS] ; /**< probe op latencies        */
+
+    /* main loop only                                                    */
+    unsigned long long start_nsec ; /**< when the probe was posted       */
+    bool           stuck    ; /**< probe exceeded its deadline           */
+    bool           failed   ; /**< last probe failed or is stuck         */
+    bool           slow     ; /**< slow threshold reached                */
+    int            slow_cnt ; /**< back to back slow probes              */
+    unsigned int   probes   ;
+    unsigned int   failures ;
+    unsigned int   timeouts ;
+    unsigned int   max [FSMON_OP__OPS] ;
+    unsigned int   hist[FSMON_OP__OPS][FSMON_HIST_BUCKETS] ;
+} fsmon_probe_type ;
+
+static fsmon_probe_type _probe[sizeof(_files)/sizeof(_files[0])] ;
+static int              _probes = 0 ;
+static pthread_mutex_t  _probe_mutex = PTHREAD_MUTEX_INITIALIZER ;
+
 /*******************************************************************
  *                   Module Utilities                              *
  ******************************************************************/
@@ -78,12 +139,13 @@ void fsmon_timer_handler ( int sig, siginfo_t *si, void *uc)
 // ****************************************************************************
 // Do File Test
 // ============
-static bool do_file_test( char filename[] )
+static bool do_file_test( const char * filename, unsigned int msecs[] )
 {
     int fd = -1;
     char test_data[sizeof(FILE_TEST_DATA)*2];
     ssize_t result;
     bool success = false;
+    unsigned long long start = gettime_monotonic_nsec ();
 
     memset( test_data, 0, sizeof(test_data) );
 
@@ -92,7 +154,7 @@ static bool do_file_test( char filename[] )
                S_IRUSR | S_IRGRP | S_IROTH );
     if( 0 > fd )
     {
-        dlog( "Failed to open %s for writing, error=%s.",
+        dlog_t( "Failed to open %s for writing, error=%s.",
                  filename, strerror(errno) );
         success = (EINTR == errno);
         goto ERROR;
@@ -101,7 +163,7 @@ static bool do_file_test( char filename[] )
     result = write( fd, FILE_TEST_DATA, sizeof(FILE_TEST_DATA) ); 
     if( 0 > result )
     {
-        dlog( "Write to %s failed, error=%s.", filename,
+        dlog_t( "Write to %s failed, error=%s.", filename,
                  strerror(errno) );
         success = (EINTR == errno);
         goto ERROR;
@@ -109,12 +171,14 @@ static bool do_file_test( char filename[] )
 
     close( fd );
     fd = -1;
+    msecs[FSMON_OP__WRITE] = (gettime_monotonic_nsec() - start)/1000000 ;
+    start = gettime_monotonic_nsec ();
 
     // File read test.
     fd = open( filename, O_RDONLY | O_CLOEXEC );
     if( 0 > fd )
     {
-        dlog( "Failed to open %s for reading, error=%s.", filename,
+        dlog_t( "Failed to open %s for reading, error=%s.", filename,
                  strerror(errno) );
         success = (EINTR == errno);
         goto ERROR;
@@ -123,7 +187,7 @@ static bool do_file_test( char filename[] )
     result = read( fd, test_data, sizeof(test_data) );
     if( 0 > result )
     {
-        dlog( "Read of %s failed, error=%s.", filename,
+        dlog_t( "Read of %s failed, error=%s.", filename,
                  strerror(errno) );
         success = (EINTR == errno);
         goto ERROR;
@@ -133,7 +197,7 @@ static bool do_file_test( char filename[] )
 
     if( 0 != strcmp( FILE_TEST_DATA, test_data ) )
     {
-        dlog( "Read data from %s does not match, error=%s.", filename,
+        dlog_t( "Read data from %s does not match, error=%s.", filename,
                  strerror(errno) );
         success = false;
         goto ERROR;
@@ -141,16 +205,19 @@ static bool do_file_test( char filename[] )
 
     close( fd );
     fd = -1;
+    msecs[FSMON_OP__READ] = (gettime_monotonic_nsec() - start)/1000000 ;
+    start = gettime_monotonic_nsec ();
 
     // Delete file test.
     result = remove( filename );
     if( 0 > result )
     {
-        dlog( "Failed to delete %s, error=%s.", filename,
+        dlog_t( "Failed to delete %s, error=%s.", filename,
                  strerror(errno) );
         success = (EINTR == errno);
         goto ERROR;
     }
+    msecs[FSMON_OP__UNLINK] = (gettime_monotonic_nsec() - start)/1000000 ;
 
     return( true );
 
@@ -165,11 +232,256 @@ ERROR:
     return( success );
 }
 
-void fsmon_service ( unsigned int nodetype )
+/* Probe worker ; runs a file test each time one is posted */
+static void * _probe_worker ( void * arg )
+{
+    fsmon_probe_type * probe_ptr = (fsmon_probe_type*)arg ;
+
+    pthread_mutex_lock ( &_probe_mutex );
+    for ( ; ; )
+    {
+        while ( probe_ptr->pending == false )
+            pthread_cond_wait ( &probe_ptr->cond, &_probe_mutex );
+        pthread_mutex_unlock ( &_probe_mutex );
+
+        unsigned int msecs[FSMON_OP__OPS] = { 0, 0, 0 } ;
+        bool passed = do_file_test ( probe_ptr->filename, msecs );
+
+        pthread_mutex_lock ( &_probe_mutex );
+        memcpy ( probe_ptr->msecs, msecs, sizeof(msecs));
+        probe_ptr->passed  = passed ;
+        probe_ptr->pending = false  ;
+        probe_ptr->done    = true   ;
+    }
+    return (NULL);
+}
+
+/* Create a detached worker for each monitored file */
+static void _probe_init ( void )
+{
+    for ( int i = 0 ; '\0' != _files[i][0] ; i++ )
+    {
+        fsmon_probe_type * probe_ptr = &_probe[i] ;
+        pthread_attr_t attr ;
+
+        probe_ptr->filename = _files[i] ;
+        pthread_cond_init ( &probe_ptr->cond, NULL );
+        pthread_attr_init ( &attr );
+        pthread_attr_setdetachstate ( &attr, PTHREAD_CREATE_DETACHED );
+        int rc = pthread_create ( &probe_ptr->thread, &attr, _probe_worker, probe_ptr );
+        pthread_attr_destroy ( &attr );
+        if ( rc )
+        {
+            elog ("File (%s) probe worker create failed (%d:%s)\n",
+                   probe_ptr->filename, rc, strerror(rc));
+        }
+        else
+        {
+            probe_ptr->started = true ;
+        }
+        _probes++ ;
+    }
+    ilog ("%d filesystem probe workers\n", _probes );
+}
+
+static unsigned int _hist_bucket ( unsigned int msecs )
+{
+    unsigned int b = 0 ;
+    while (( b < FSMON_HIST_BUCKETS-1 ) && ( msecs > _hist_msecs[b] ))
+        b++ ;
+    return (b);
+}
+
+/* Account a completed probe and manage its failed and slow states */
+static void _probe_result ( fsmon_probe_type * probe_ptr,
+                            fsmon_ctrl_type  * ctrl_ptr,
+                            bool passed, unsigned int msecs[] )
+{
+    unsigned int worst = 0 ;
+
+    probe_ptr->probes++ ;
+    if ( probe_ptr->stuck )
+    {
+        ilog ("File (%s) probe returned after %llu secs\n",
+               probe_ptr->filename,
+               (gettime_monotonic_nsec() - probe_ptr->start_nsec)/1000000000ULL );
+        probe_ptr->stuck = false ;
+    }
+
+    if ( passed == false )
+    {
+        probe_ptr->failures++ ;
+        probe_ptr->failed = true ;
+        wlog( "File (%s) test failed\n", probe_ptr->filename );
+        return ;
+    }
+
+    for ( int op = 0 ; op < FSMON_OP__OPS ; op++ )
+    {
+        probe_ptr->hist[op][_hist_bucket(msecs[op])]++ ;
+        if ( msecs[op] > probe_ptr->max[op] )
+            probe_ptr->max[op] = msecs[op] ;
+        if ( msecs[op] > worst )
+            worst = msecs[op] ;
+    }
+    dlog( "File (%s) test passed (%u:%u:%u msecs)\n", probe_ptr->filename,
+           msecs[FSMON_OP__WRITE], msecs[FSMON_OP__READ], msecs[FSMON_OP__UNLINK]);
+
+    if ( probe_ptr->failed )
+    {
+        ilog ("File (%s) test passed ; recovered\n", probe_ptr->filename );
+        probe_ptr->failed = false ;
+    }
+
+    if (( ctrl_ptr->slow_threshold ) &&
+        ( worst > (unsigned int)ctrl_ptr->slow_threshold ))
+    {
+        if (( ++probe_ptr->slow_cnt >= ctrl_ptr->slow_count ) &&
+            ( probe_ptr->slow == false ))
+        {
+            probe_ptr->slow = true ;
+            wlog ("File (%s) is slow ; %d probes over %d msecs (%u:%u:%u msecs)\n",
+                   probe_ptr->filename,
+                   probe_ptr->slow_cnt,
+                   ctrl_ptr->slow_threshold,
+                   msecs[FSMON_OP__WRITE], msecs[FSMON_OP__READ], msecs[FSMON_OP__UNLINK]);
+        }
+    }
+    else
+    {
+        probe_ptr->slow_cnt = 0 ;
+        if ( probe_ptr->slow )
+        {
+            probe_ptr->slow = false ;
+            ilog ("File (%s) is no longer slow (%u msecs)\n", probe_ptr->filename, worst );
+        }
+    }
+}
+
+/* Collect completed probes and fail those past their deadline.
+ * Returns true once every probe of the current audit has completed
+ * or been failed. */
+static bool _probe_collect ( fsmon_ctrl_type * ctrl_ptr, bool & all_passed )
+{
+    bool complete = true ;
+    unsigned long long now = gettime_monotonic_nsec ();
+    unsigned long long deadline = (unsigned long long)ctrl_ptr->probe_timeout*1000000000ULL ;
+
+    all_passed = true ;
+    for ( int i = 0 ; i < _probes ; i++ )
+    {
+        fsmon_probe_type * probe_ptr = &_probe[i] ;
+        unsigned int msecs[FSMON_OP__OPS] ;
+        bool done, pending, passed ;
+
+        pthread_mutex_lock ( &_probe_mutex );
+        done    = probe_ptr->done    ;
+        pending = probe_ptr->pending ;
+        passed  = probe_ptr->passed  ;
+        memcpy ( msecs, probe_ptr->msecs, sizeof(msecs));
+        probe_ptr->done = false ;
+        pthread_mutex_unlock ( &_probe_mutex );
+
+        if ( done )
+        {
+            _probe_result ( probe_ptr, ctrl_ptr, passed, msecs );
+        }
+        else if (( pending ) && ( probe_ptr->stuck == false ))
+        {
+            if (( now - probe_ptr->start_nsec ) > deadline )
+            {
+                probe_ptr->stuck  = true ;
+                probe_ptr->failed = true ;
+                probe_ptr->timeouts++ ;
+                wlog( "File (%s) test failed ; no response in %d secs\n",
+                       probe_ptr->filename, ctrl_ptr->probe_timeout );
+            }
+            else
+            {
+                complete = false ;
+            }
+        }
+        if (( probe_ptr->failed ) || ( probe_ptr->started == false ))
+        {
+            all_passed = false ;
+        }
+    }
+    return (complete);
+}
+
+/* Post a probe to every idle worker */
+static void _probe_post ( void )
+{
+    unsigned long long now = gettime_monotonic_nsec ();
+    pthread_mutex_lock ( &_probe_mutex );
+    for ( int i = 0 ; i < _probes ; i++ )
+    {
+        fsmon_probe_type * probe_ptr = &_probe[i] ;
+        if (( probe_ptr->started ) &&
+            ( probe_ptr->pending == false ) &&
+            ( probe_ptr->done    == false ))
+        {
+            probe_ptr->start_nsec = now ;
+            probe_ptr->pending = true ;
+            pthread_cond_signal ( &probe_ptr->cond );
+        }
+    }
+    pthread_mutex_unlock ( &_probe_mutex );
+}
+
+/* Push the per filesystem probe stats and latency histograms to the dump */
+void fsmon_dump_info ( void )
+{
+    #define MAX_LEN 500
+    char str[MAX_LEN] ;
+    for ( int i = 0 ; i < _probes ; i++ )
+    {
+        fsmon_probe_type * probe_ptr = &_probe[i] ;
+        snprintf (&str[0], MAX_LEN, "%-20s Probes:%u Failures:%u Timeouts:%u %s%s%s\n",
+                   probe_ptr->filename,
+                   probe_ptr->probes,
+                   probe_ptr->failures,
+                   probe_ptr->timeouts,
+                   probe_ptr->failed ? "failed " : "",
+                   probe_ptr->stuck  ? "stuck "  : "",
+                   probe_ptr->slow   ? "slow"    : "");
+        mem_log (str);
+        for ( int op = 0 ; op < FSMON_OP__OPS ; op++ )
+        {
+            int len = snprintf (&str[0], MAX_LEN, "  %-6s max:%5u msecs |",
+                                 _op_str[op], probe_ptr->max[op] );
+            for ( int b = 0 ; b < FSMON_HIST_BUCKETS ; b++ )
+            {
+                if ( b < FSMON_HIST_BUCKETS-1 )
+                    len += snprintf (&str[len], MAX_LEN-len, " <=%u:%u",
+                                      _hist_msecs[b], probe_ptr->hist[op][b]);
+                else
+                    len += snprintf (&str[len], MAX_LEN-len, " >%u:%u\n",
+                                      _hist_msecs[b-1], probe_ptr->hist[op][b]);
+            }
+            mem_log (str);
+        }
+    }
+}
+
+void fsmon_service ( unsigned int nodetype, fsmon_ctrl_type * ctrl_ptr )
 {
     int flush_thld = 0 ;
+    bool audit_active = false ;
     daemon_config_type * cfg_ptr  = daemon_get_cfg_ptr ();
 
+    /* only support stall monitor on computes */
+    if (( nodetype & WORKER_TYPE) == WORKER_TYPE )
+    {
+        _probe_init ();
+    }
+
+    /* Run this daemon's timers off the timer wheel rather than
+     * with a posix timer and signal per timer. This loop has no
+     * reactor ; the wheel is serviced by daemon_signal_hdlr on
+     * each pass. */
+    mtcTimer_wheel_init ();
+
     ilog ("Starting 'Audit' timer (%d secs)\n", cfg_ptr->audit_period );
     mtcTimer_start ( mtcTimer_audit, fsmon_timer_handler, cfg_ptr->audit_period ); 
 
@@ -179,29 +491,25 @@ void fsmon_service ( unsigned int nodetype )
         {
             mtcTimer_audit.ring = false ;
 
-            /* only support stall monitor on computes */
-            if (( nodetype & WORKER_TYPE) == WORKER_TYPE )
+            if ( _probes )
             {
-                int file_i;
-                int rc = PASS ;
-                for( file_i=0; '\0' != _files[file_i][0]; ++file_i )
-                {
-                    if( do_file_test( _files[file_i] ) )
-                    {
-                        dlog( "File (%s) test passed\n", _files[file_i] );
-                    }
-                    else
-                    {
-                        wlog( "File (%s) test failed\n", _files[file_i] );
-                        rc = FAIL ;
-                    }
-                }
-                if ( rc == PASS )
+                _probe_post ();
+                audit_active = true ;
+            }
+            mtcTimer_start ( mtcTimer_audit, fsmon_timer_handler, cfg_ptr->audit_period );
+        }
+
+        if ( _probes )
+        {
+            bool all_passed = true ;
+            if (( _probe_collect ( ctrl_ptr, all_passed ) == true ) && ( audit_active ))
+            {
+                audit_active = false ;
+                if ( all_passed )
                 {
                     ilog ("tests passed\n");
                 }
             }
-            mtcTimer_start ( mtcTimer_audit, fsmon_timer_handler, cfg_ptr->audit_period );
         }
 
         daemon_signal_hdlr ();
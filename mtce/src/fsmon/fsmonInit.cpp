@@ -25,6 +25,9 @@ static char hostname_str [MAX_HOST_NAME_SIZE+1];
 static daemon_config_type fsmon_config ; 
 daemon_config_type * daemon_get_cfg_ptr () { return &fsmon_config ; }
 
+/* Filesystem probe controls */
+static fsmon_ctrl_type fsmon_ctrl ;
+
 /* Cleanup exit handler */
 void daemon_exit ( void )
 {
@@ -47,6 +50,18 @@ static int fsmon_config_handler ( void * user,
         config_ptr->audit_period = atoi(value);
         config_ptr->mask |= CONFIG_AUDIT_PERIOD ;
     }
+    else if (MATCH("timeouts", "probe_timeout"))
+    {
+        fsmon_ctrl.probe_timeout = atoi(value);
+    }
+    else if (MATCH("config", "slow_threshold"))
+    {
+        fsmon_ctrl.slow_threshold = atoi(value);
+    }
+    else if (MATCH("config", "slow_count"))
+    {
+        fsmon_ctrl.slow_count = atoi(value);
+    }
     return (PASS);
 }
 
@@ -61,6 +76,10 @@ int daemon_configure ( void )
 {
     int rc = PASS ;
 
+    fsmon_ctrl.probe_timeout  = FSMON_PROBE_TIMEOUT_DEFAULT ;
+    fsmon_ctrl.slow_threshold = FSMON_SLOW_THRESHOLD_DEFAULT ;
+    fsmon_ctrl.slow_count     = FSMON_SLOW_COUNT_DEFAULT ;
+
     if (ini_parse( CONFIG_FILE, fsmon_config_handler, &fsmon_config) < 0)
     {
         elog("Can't load '%s'\n", CONFIG_FILE );
@@ -85,6 +104,15 @@ int daemon_configure ( void )
 
     ilog("Audit Period: %d\n", fsmon_config.audit_period );
 
+    if ( fsmon_ctrl.probe_timeout <= 0 )
+        fsmon_ctrl.probe_timeout = FSMON_PROBE_TIMEOUT_DEFAULT ;
+    if ( fsmon_ctrl.slow_count <= 0 )
+        fsmon_ctrl.slow_count = FSMON_SLOW_COUNT_DEFAULT ;
+
+    ilog("Probe Tmout : %d secs\n", fsmon_ctrl.probe_timeout );
+    ilog("Slow Thld   : %d msecs x %d\n", fsmon_ctrl.slow_threshold,
+                                           fsmon_ctrl.slow_count );
+
     return (rc);
 }
 
@@ -163,7 +191,7 @@ int daemon_init ( string iface, string nodeType_str )
  */
 void daemon_service_run ( void )
 {
-    fsmon_service ( my_nodetype );
+    fsmon_service ( my_nodetype, &fsmon_ctrl );
     daemon_exit ();
 }
 
@@ -172,6 +200,7 @@ void daemon_service_run ( void )
 void daemon_dump_info ( void )
 {
     daemon_dump_membuf_banner ();
+    fsmon_dump_info ();
     daemon_dump_membuf();
 }
 
@@ -42,6 +42,7 @@ using namespace std;
 #include "hbsAlarm.h"      /* for ... hbsAlarm_clear_all                 */
 #include "alarm.h"         /* for ... alarm send message to mtcalarmd    */
 #include "jsonUtil.h"      /* for ... jsonUtil_get_key_val               */
+#include "flightRecorder.h" /* for ... flightRecorder_log                */
 
 /**************************************************************
  *            Implementation Structure
@@ -160,6 +161,27 @@ void monitor_scheduling ( unsigned long long & this_time, unsigned long long & p
     prev_time = this_time ;
 }
 
+/* Log the batched pulse receive counters ; messages per recvmmsg call */
+void pulse_receive_stats_log ( void )
+{
+    for ( int iface = 0 ; iface < MAX_IFACES ; iface++ )
+    {
+        unsigned long long reads = 0 ;
+        unsigned long long msgs  = 0 ;
+
+        if ( hbs_sock.rx_sock[iface] == NULL )
+            continue ;
+
+        hbs_sock.rx_sock[iface]->getBatchStats ( reads, msgs );
+        if ( reads )
+        {
+            ilog ("%s Pulse Rx: %llu msgs in %llu reads (%llu.%02llu msgs per read)\n",
+                      get_iface_name_str(iface), msgs, reads,
+                      msgs/reads, ((msgs*100)/reads)%100 );
+        }
+    }
+}
+
 /* Cleanup exit handler */
 void daemon_exit ( void )
 {
@@ -1050,18 +1072,12 @@ hbs_pulse_request_out:
             hbs_sock.tx_mesg[iface].f,
             hbs_sock.tx_mesg[iface].m,
             hbs_sock.tx_mesg[iface].c);
-#ifdef WANT_HBS_MEM_LOGS
-    char str[MAX_LEN] ;
-    snprintf ( &str[0], MAX_LEN, "%s Pulse Req: (%d) %s:%d: s:%u f:%x [%s] RRI:%d\n",
-                get_iface_name_str(iface), bytes,
-                hbs_sock.tx_sock[iface]->get_dst_addr()->toString(),
-                hbs_sock.tx_sock[iface]->get_dst_addr()->getPort(),
-                hbs_sock.tx_mesg[iface].s,
-                hbs_sock.tx_mesg[iface].f,
-                hbs_sock.tx_mesg[iface].m,
-                hbs_sock.tx_mesg[iface].c);
-    mem_log (&str[0]);
-#endif
+    flightRecorder_log ( FLIGHT_EVENT__PULSE_REQ,
+                         get_iface_name_str(iface),
+                         iface,
+                         hbs_sock.tx_mesg[iface].s,
+                         bytes,
+                         hbs_sock.tx_mesg[iface].c );
 
     return (PASS);
 }
@@ -1069,6 +1085,7 @@ hbs_pulse_request_out:
 int _pulse_receive ( iface_enum iface , unsigned int seq_num )
 {
     int bytes = 0 ;
+    int msgs  = 0 ;
 
     int detected_pulses = 0 ;
 
@@ -1076,22 +1093,28 @@ int _pulse_receive ( iface_enum iface , unsigned int seq_num )
     unsigned long long  after_rx_time ;
     unsigned long long before_rx_time =  gettime_monotonic_nsec ();
 
+    if ( hbs_sock.rx_sock[iface] == NULL )
+    {
+        elog ("%s cannot receive pulses - null object\n", get_iface_name_str(iface) );
+        return (0);
+    }
+
+    /* Receive pulses a batch at a time. Each batch is a single recvmmsg
+     * call into the socket's preallocated ring which zeros only the unused
+     * tail of short messages. A partial batch means the socket is drained. */
     do
     {
-        /* Clean the receive buffer */
-        memset ( hbs_sock.rx_mesg[iface].m, 0, sizeof(hbs_message_type) );
-        hbs_sock.rx_mesg[iface].s = 0 ;
-        hbs_sock.rx_mesg[iface].c = 0 ;
-        if ( hbs_sock.rx_sock[iface] == NULL )
-        {
-            elog ("%s cannot receive pulses - null object\n", get_iface_name_str(iface) );
-            return (0);
-        }
-        if ( (bytes = hbs_sock.rx_sock[iface]->read((char*)&hbs_sock.rx_mesg[iface], sizeof(hbs_message_type))) != -1 )
+        msgs = hbs_sock.rx_sock[iface]->readBatch ( sizeof(hbs_message_type) );
+        for ( int m = 0 ; m < msgs ; m++ )
         {
+            hbs_message_type * rx_ptr = (hbs_message_type *)
+                hbs_sock.rx_sock[iface]->getBatchMsg ( m, &bytes );
+            if ( rx_ptr == NULL )
+                break ;
+
             /* Look for messages that are not for this controller ..... */
             if ( hbs_ctrl.controller !=
-               ((hbs_sock.rx_mesg[iface].f & CTRLX_MASK ) >> CTRLX_BIT))
+               ((rx_ptr->f & CTRLX_MASK ) >> CTRLX_BIT))
             {
                 /* This path has been verified to not get hit during cluster
                  * feature testing. Leaving the check/continue in just in case.
@@ -1099,23 +1122,23 @@ int _pulse_receive ( iface_enum iface , unsigned int seq_num )
                  * for debug but has no runtime impact */
                 // dlog ("controller-%d pulse not for this controller ; for controller-%d",
                 //        hbs_ctrl.controller,
-                //       (hbs_sock.rx_mesg[iface].f & CTRLX_MASK ) >> CTRLX_BIT);
+                //       (rx_ptr->f & CTRLX_MASK ) >> CTRLX_BIT);
                 continue ;
             }
             mlog ("%s Pulse Rsp: (%d) from:%s:%d: s:%d flags:%x [%-27s] RRI:%d\n",
                       get_iface_name_str(iface), bytes,
                       hbs_sock.rx_sock[iface]->get_src_str(),
                       hbs_sock.rx_sock[iface]->get_dst_addr()->getPort(),
-                      hbs_sock.rx_mesg[iface].s,
-                      hbs_sock.rx_mesg[iface].f,
-                      hbs_sock.rx_mesg[iface].m,
-                      hbs_sock.rx_mesg[iface].c);
+                      rx_ptr->s,
+                      rx_ptr->f,
+                      rx_ptr->m,
+                      rx_ptr->c);
 
             /* Validate the header */
-            if ( strstr ( hbs_sock.rx_mesg[iface].m, rsp_msg_header) )
+            if ( strstr ( rx_ptr->m, rsp_msg_header) )
             {
                 int rc = RETRY ;
-                string hostname = hbsInv.get_hostname (hbs_sock.rx_sock[iface]->get_src_str());
+                string hostname = hbsInv.get_hostname (hbs_sock.rx_sock[iface]->get_src_key());
 
 #ifdef WANT_FIT_TESTING
                 if ( hbs_config.testmode == 1 )
@@ -1142,10 +1165,10 @@ int _pulse_receive ( iface_enum iface , unsigned int seq_num )
                               get_iface_name_str(iface),
                               hbs_sock.rx_sock[iface]->get_dst_addr()->toString(),
                               hbs_sock.rx_sock[iface]->get_dst_addr()->getPort(),
-                              hbs_sock.rx_mesg[iface].s,
-                              hbs_sock.rx_mesg[iface].f,
-                              hbs_sock.rx_mesg[iface].m,
-                              hbs_sock.rx_mesg[iface].c);
+                              rx_ptr->s,
+                              rx_ptr->f,
+                              rx_ptr->m,
+                              rx_ptr->c);
                 }
                 else if ( hostname == hbsInv.my_hostname)
                 {
@@ -1153,12 +1176,12 @@ int _pulse_receive ( iface_enum iface , unsigned int seq_num )
                               get_iface_name_str(iface),
                               hbs_sock.rx_sock[iface]->get_dst_addr()->toString(),
                               hbs_sock.rx_sock[iface]->get_dst_addr()->getPort(),
-                              hbs_sock.rx_mesg[iface].s,
-                              hbs_sock.rx_mesg[iface].f,
-                              hbs_sock.rx_mesg[iface].m,
-                              hbs_sock.rx_mesg[iface].c);
+                              rx_ptr->s,
+                              rx_ptr->f,
+                              rx_ptr->m,
+                              rx_ptr->c);
 
-                    hbsInv.manage_pulse_flags ( hostname, hbs_sock.rx_mesg[iface].f );
+                    hbsInv.manage_pulse_flags ( hostname, rx_ptr->f );
                 }
                 else
                 {
@@ -1166,27 +1189,20 @@ int _pulse_receive ( iface_enum iface , unsigned int seq_num )
                     {
                         string extra = "Rsp" ;
 
-                        if ( seq_num != hbs_sock.rx_mesg[iface].s )
+                        if ( seq_num != rx_ptr->s )
                         {
                             extra = "SEQ" ;
                         }
                         else
                         {
-                            rc = hbsInv.remove_pulse ( hostname, iface, hbs_sock.rx_mesg[iface].c, hbs_sock.rx_mesg[iface].f ) ;
+                            rc = hbsInv.remove_pulse ( hostname, iface, rx_ptr->c, rx_ptr->f ) ;
                         }
-#ifdef WANT_HBS_MEM_LOGS
-                        char str[MAX_LEN] ;
-                        snprintf  (&str[0], MAX_LEN, "%s Pulse %s: (%d): %s:%d: %u:%u:%x:%s\n",
-                                    get_iface_name_str(iface), extra.c_str(), bytes,
-                                    hbs_sock.rx_sock[iface]->get_dst_addr()->toString(),
-                                    hbs_sock.rx_sock[iface]->get_dst_addr()->getPort(),
-                                    hbs_sock.rx_mesg[iface].s,
-                                    hbs_sock.rx_mesg[iface].c,
-                                    hbs_sock.rx_mesg[iface].f,
-                                    hbs_sock.rx_mesg[iface].m);
-                        // mlog ("%s", &str[0]);
-                        mem_log (str);
-#endif
+                        flightRecorder_log ( FLIGHT_EVENT__PULSE_RSP,
+                                             hostname.c_str(),
+                                             iface,
+                                             rx_ptr->s,
+                                             rx_ptr->f,
+                                             bytes );
                         if ( !extra.compare("Rsp"))
                         {
                             detected_pulses++ ;
@@ -1194,12 +1210,12 @@ int _pulse_receive ( iface_enum iface , unsigned int seq_num )
                         /* don't save data from self */
                         if ( hostname != hbsInv.my_hostname )
                         {
-                            if (  hbs_sock.rx_mesg[iface].v >= HBS_MESSAGE_VERSION )
+                            if (  rx_ptr->v >= HBS_MESSAGE_VERSION )
                             {
                                 if ( iface == MGMNT_IFACE )
-                                    hbs_cluster_save ( hostname, MTCE_HBS_NETWORK_MGMT , hbs_sock.rx_mesg[iface]);
+                                    hbs_cluster_save ( hostname, MTCE_HBS_NETWORK_MGMT , *rx_ptr);
                                 else
-                                    hbs_cluster_save ( hostname, MTCE_HBS_NETWORK_CLSTR , hbs_sock.rx_mesg[iface]);
+                                    hbs_cluster_save ( hostname, MTCE_HBS_NETWORK_CLSTR , *rx_ptr);
                             }
                         }
                     }
@@ -1209,10 +1225,10 @@ int _pulse_receive ( iface_enum iface , unsigned int seq_num )
                                   get_iface_name_str(iface), bytes,
                                   hbs_sock.rx_sock[iface]->get_dst_addr()->toString(),
                                   hbs_sock.rx_sock[iface]->get_dst_addr()->getPort(),
-                                  hbs_sock.rx_mesg[iface].s,
-                                  hbs_sock.rx_mesg[iface].f,
-                                  hbs_sock.rx_mesg[iface].m,
-                                  hbs_sock.rx_mesg[iface].c);
+                                  rx_ptr->s,
+                                  rx_ptr->f,
+                                  rx_ptr->m,
+                                  rx_ptr->c);
                     }
 
                 }
@@ -1220,7 +1236,7 @@ int _pulse_receive ( iface_enum iface , unsigned int seq_num )
                 if ( rc == ENXIO )
                 {
                     mlog3 ("Unexpected %s Pulse: <%s>\n", get_iface_name_str(iface),
-                                                          &hbs_sock.rx_mesg[iface].m[0] );
+                                                          &rx_ptr->m[0] );
                     unexpected_pulse_list[iface].append ( hostname.c_str());
                     unexpected_pulse_list[iface].append ( " " );
                 }
@@ -1238,11 +1254,11 @@ int _pulse_receive ( iface_enum iface , unsigned int seq_num )
                                 get_iface_name_str(iface),
                                 hbs_sock.rx_sock[iface]->get_dst_addr()->toString(),
                                 hbs_sock.rx_sock[iface]->get_dst_addr()->getPort(),
-                                  hbs_sock.rx_mesg[iface].s,
-                                  hbs_sock.rx_mesg[iface].m) ;
+                                  rx_ptr->s,
+                                  rx_ptr->m) ;
             }
         }
-    } while ( bytes > 0 ) ;
+    } while ( msgs == MSGCLASS_BATCH_MAX ) ;
     monitor_scheduling ( after_rx_time, before_rx_time, detected_pulses, SCHED_MONITOR__RECEIVER );
     return (detected_pulses);
 }
@@ -1605,6 +1621,304 @@ bool manage_sm_heartbeat ( void )
     return heartbeat_ok;
 }
 
+/*****************************************************************************
+ *
+ * Main loop reactor handlers and registration ; see daemon_reactor_add
+ *
+ *****************************************************************************/
+
+static void _reactor_wheel ( int fd, void * ctx )
+{
+    UNUSED(fd); UNUSED(ctx);
+    mtcTimer_wheel_service ();
+}
+
+/* Service a command from maintenance ; host add, delete, start, stop ... */
+static void _reactor_mtc_command ( int fd, void * ctx )
+{
+    UNUSED(fd); UNUSED(ctx);
+    int bytes ;
+    mtc_message_type msg ;
+
+    /* Look for maintenance command messages */
+    memset (&msg, 0, sizeof(mtc_message_type));
+    bytes = hbs_sock.mtc_to_hbs_sock->read((char*)&msg,sizeof(mtc_message_type));
+    if ( bytes > 0 )
+    {
+        if ( !strncmp ( get_hbs_cmd_req_header(), &msg.hdr[0], MSG_HEADER_SIZE ))
+        {
+            string hostname ;
+            node_inv_type inv ;
+            node_inv_init(inv);
+
+            /* 64 byte hostname support adds a json string to
+             * the message buffer containing the hostname as a
+             * key/value pair. */
+            if (( msg.ver >= MTC_CMD_FEATURE_VER__KEYVALUE_IN_BUF ) &&
+                ( msg.buf[msg.res] == '{' ))
+            {
+                if ( jsonUtil_get_key_val(&msg.buf[msg.res],
+                            MTC_JSON_INV_NAME, hostname) == PASS )
+                {
+                    inv.name = hostname ;
+                    if (( msg.cmd == MTC_CMD_ADD_HOST ) ||
+                        ( msg.cmd == MTC_CMD_MOD_HOST ))
+                    {
+                        jsonUtil_get_key_val(&msg.buf[msg.res], MTC_JSON_INV_HOSTIP, inv.ip);
+                        if ( hbsInv.clstr_network_provisioned == true )
+                        {
+                            jsonUtil_get_key_val(&msg.buf[msg.res], MTC_JSON_INV_CLSTRIP, inv.clstr_ip);
+                        }
+                    }
+                }
+            }
+            else if ( msg.hdr[MSG_HEADER_SIZE] != '\0' )
+            {
+                /* get hostname by legacy method,
+                 * ... from the header */
+                hostname = &msg.hdr[MSG_HEADER_SIZE] ;
+            }
+            if ( hostname.empty() )
+            {
+                /* no hostname ; no action to take */
+                wlog ("unable to get hostname from %s command",
+                       get_mtcNodeCommand_str(msg.cmd));
+            }
+
+            else if ( msg.cmd == MTC_CMD_ACTIVE_CTRL )
+            {
+                bool logit = false ;
+                if ( hostname == hbsInv.my_hostname )
+                {
+                    if ( hbsInv.active_controller == false )
+                    {
+                        logit = true ;
+                        hbs_ctrl.clear_alarms = true ;
+                    }
+                    hbsInv.active_controller = true ;
+                }
+                else
+                {
+                    if ( hbsInv.active_controller == true )
+                        logit = true ;
+                    hbsInv.active_controller = false ;
+                }
+                if ( logit == true )
+                {
+                    ilog ("%s is %sactive",
+                              hbsInv.my_hostname.c_str(),
+                              hbsInv.active_controller ? "" : "in" );
+
+                    /* no need for the heartbeat audit in a simplex system */
+                    if ( hbsInv.system_type != SYSTEM_TYPE__AIO__SIMPLEX )
+                    {
+                        /* Due to activity state change we will dump
+                         * the heartbeat cluster state at now time
+                         * and then again in 5 seconds only to get
+                         * the regular audit dump restarted at
+                         * regular interval after that. */
+                        hbs_state_audit ();
+                        mtcTimer_reset ( hbsTimer_audit);
+                        mtcTimer_start ( hbsTimer_audit, hbsTimer_handler, MTC_SECS_5 );
+                    }
+                }
+            }
+            else if ( msg.cmd == MTC_CMD_ADD_HOST )
+            {
+                inv.nodetype = msg.parm[0];
+                hbsInv.add_heartbeat_host ( inv ) ;
+                hostname_inventory.push_back ( inv.name );
+                hostname_inventory.unique(); // avoid duplicates
+                ilog ("%s added to heartbeat service (%d)\n",
+                          inv.name.c_str(),
+                          inv.nodetype);
+
+                /* clear any outstanding alarms on the ADD */
+                if (( hbsInv.hbs_failure_action != HBS_FAILURE_ACTION__NONE ) &&
+                    ( hbsInv.active_controller == true ))
+                {
+                    hbsAlarm_clear_all ( hostname,
+                    hbsInv.clstr_network_provisioned );
+                }
+            }
+            else if ( msg.cmd == MTC_CMD_MOD_HOST )
+            {
+                inv.nodetype = msg.parm[0];
+                hbsInv.add_heartbeat_host ( inv ) ;
+                ilog ("%s modified heartbeat info [%d]\n",
+                          inv.name.c_str(),
+                          inv.nodetype );
+
+                /* clear any outstanding alarms on the ADD */
+                if ( hbsInv.hbs_failure_action != HBS_FAILURE_ACTION__NONE )
+                {
+                    hbsAlarm_clear_all ( hostname, hbsInv.clstr_network_provisioned );
+                }
+            }
+            else if ( msg.cmd == MTC_CMD_DEL_HOST )
+            {
+                hbsInv.mon_host ( hostname, false, false );
+                hostname_inventory.remove ( hostname );
+                hbsInv.del_host ( hostname );
+                ilog ("%s deleted from heartbeat service\n", hostname.c_str());
+
+                /* clear any outstanding alarms on the DEL */
+                if (( hbsInv.hbs_failure_action != HBS_FAILURE_ACTION__NONE ) &&
+                    ( hbsInv.active_controller == true ))
+                {
+                    hbsAlarm_clear_all ( hostname,
+                    hbsInv.clstr_network_provisioned );
+                }
+            }
+            else if ( msg.cmd == MTC_CMD_STOP_HOST )
+            {
+                if ( hostname != hbsInv.my_hostname )
+                {
+                    hbsInv.mon_host ( hostname, false, false );
+                    hbs_cluster_del ( hostname );
+                    ilog ("%s heartbeat service disabled by stop command",
+                              hostname.c_str());
+                }
+            }
+            else if ( msg.cmd == MTC_CMD_START_HOST )
+            {
+                if ( hostname == hbsInv.my_hostname )
+                {
+                    dlog ("%s stopping heartbeat of self\n",
+                              hostname.c_str());
+
+                    hbsInv.mon_host ( hostname, false, true );
+                    hbs_cluster_del ( hostname );
+
+                }
+                else
+                {
+                    hbs_cluster_add ( hostname );
+                    hbsInv.mon_host ( hostname, true, true );
+                }
+            }
+            else if (( msg.cmd == MTC_RESTART_HBS ) &&
+                     ( hostname != hbsInv.my_hostname ))
+            {
+                hbsInv.mon_host ( hostname, true, true  );
+                ilog ("%s heartbeat restart", hostname.c_str());
+                hbsInv.print_node_info();
+            }
+            else if ( msg.cmd == MTC_RECOVER_HBS )
+            {
+                hbsInv.hbs_pulse_period = hbsInv.hbs_pulse_period_save ;
+                ilog ("%s starting heartbeat recovery (period:%d msec)\n", hostname.c_str(), hbsInv.hbs_pulse_period);
+                hbsInv.print_node_info();
+            }
+            else if ( msg.cmd == MTC_BACKOFF_HBS )
+            {
+                hbsInv.hbs_pulse_period = (hbsInv.hbs_pulse_period_save * HBS_BACKOFF_FACTOR) ;
+                ilog ("%s starting heartbeat backoff (period:%d msecs)\n", hostname.c_str(), hbsInv.hbs_pulse_period );
+                hbs_cluster_change ( "backoff" );
+                hbsInv.print_node_info();
+            }
+            else
+            {
+                wlog ("Unsupport maintenance command\n");
+            }
+        }
+        else
+        {
+            elog ("Unexpected maintenance message header\n");
+        }
+    }
+    else
+    {
+        elog ("Failed receive from agent domain socket (%i)\n", bytes );
+    }
+}
+
+/* ctx is the interface ; the pulses are received by the main loop
+ * in the pulse period */
+static void _reactor_pulse ( int fd, void * ctx )
+{
+    UNUSED(fd);
+    if ( hbsInv.hbs_disabled == false )
+        hbs_sock.fired[(int)(long)ctx] = true ;
+}
+
+static void _reactor_sm ( int fd, void * ctx )
+{
+    UNUSED(fd); UNUSED(ctx);
+    hbs_sm_handler();
+}
+
+static void _reactor_netlink ( int fd, void * ctx )
+{
+    UNUSED(ctx);
+    dlog ("netlink socket fired\n");
+    int rc = hbsInv.service_netlink_events ( fd, hbs_sock.ioctl_sock );
+    if ( rc )
+    {
+        elog ("service_netlink_events failed (rc:%d)\n", rc );
+    }
+}
+
+/* the receive fds currently registered with the reactor ; 0 if none */
+static int _reactor_mtc_fd     = 0 ;
+static int _reactor_mgmnt_fd   = 0 ;
+static int _reactor_clstr_fd   = 0 ;
+static int _reactor_sm_fd      = 0 ;
+static int _reactor_netlink_fd = 0 ;
+
+/* Move a registration from the 'registered' fd to 'fd'. Done when the
+ * fd changes or is forced after a socket re-init that may have reused
+ * the same fd number. */
+static void _reactor_slot ( int & registered, int fd, bool force,
+                            daemon_reactor_handler_type handler,
+                            void * ctx = NULL )
+{
+    if (( fd == registered ) && ( force == false ))
+        return ;
+
+    if ( registered > 0 )
+        daemon_reactor_del ( registered );
+    if (( fd > 0 ) && ( daemon_reactor_add ( fd, handler, ctx ) != PASS ))
+        fd = 0 ;
+    registered = fd ;
+}
+
+static int _reactor_sock_fd ( msgClassSock * sock_ptr )
+{
+    if (( sock_ptr ) && ( sock_ptr->return_status == PASS ))
+        return ( sock_ptr->getFD() );
+    return (0);
+}
+
+/* Keep the reactor waiting on the sockets that are provisioned and, for
+ * the pulse receivers, not disabled. The heartbeat service is disabled
+ * and enabled by lock and link state and the pulse sockets re-created
+ * on errors so this is run every pass ; it only touches the reactor when
+ * one of them has changed. */
+static void _reactor_sync ( bool force )
+{
+    _reactor_slot ( _reactor_mtc_fd, _reactor_sock_fd ( hbs_sock.mtc_to_hbs_sock ),
+                    force, _reactor_mtc_command );
+
+    int fd = 0 ;
+    if ( hbsInv.hbs_disabled == false )
+        fd = _reactor_sock_fd ( hbs_sock.rx_sock[MGMNT_INTERFACE] );
+    _reactor_slot ( _reactor_mgmnt_fd, fd, force, _reactor_pulse, (void*)(long)MGMNT_INTERFACE );
+
+    fd = 0 ;
+    if (( hbsInv.hbs_disabled == false ) &&
+        ( hbsInv.clstr_network_provisioned == true ))
+    {
+        fd = _reactor_sock_fd ( hbs_sock.rx_sock[CLSTR_INTERFACE] );
+    }
+    _reactor_slot ( _reactor_clstr_fd, fd, force, _reactor_pulse, (void*)(long)CLSTR_INTERFACE );
+
+    _reactor_slot ( _reactor_sm_fd, _reactor_sock_fd ( hbs_sock.sm_server_sock ),
+                    force, _reactor_sm );
+
+    _reactor_slot ( _reactor_netlink_fd, hbs_sock.netlink_sock, force, _reactor_netlink );
+}
+
 /****************************************************************************
  *
  * Name       : daemon_service_run
@@ -1642,8 +1956,8 @@ void daemon_service_run ( void )
     bool heartbeat_request = true ;
     unsigned int seq_num = 0 ;
 
-    /* socket descriptor list */
-    std::list<int> socks ;
+    /* set to re-register the reactor fds after a socket re-init */
+    bool reactor_resync = false ;
 
     hbsInv.hbs_state_change = true ;
     hbsInv.hbs_disabled = false ;
@@ -1652,6 +1966,18 @@ void daemon_service_run ( void )
     hbsInv.maintenance = false ;
     hbsInv.heartbeat   = true  ;
 
+    /* Run this daemon's timers off the timer wheel rather than
+     * with a posix timer and signal per timer */
+    mtcTimer_wheel_init ();
+
+    if ( daemon_reactor_init () != PASS )
+    {
+        elog ("Failed to create main loop reactor");
+        daemon_exit ();
+    }
+    if ( mtcTimer_wheel_enabled () )
+        daemon_reactor_add ( mtcTimer_wheel_fd(), _reactor_wheel );
+
     /* Load the expected pulses and zero detected */
     for ( int iface = 0 ; iface < MAX_IFACES ; iface++ )
     {
@@ -1679,6 +2005,7 @@ void daemon_service_run ( void )
             {
                 hbsInv.print_node_info();
                 hbs_state_audit ();
+                pulse_receive_stats_log ();
             }
 
             /* The first audit was run after 30 seconds but then the
@@ -1924,310 +2251,15 @@ void daemon_service_run ( void )
             }
         }
 
-        /* Initialize the master fd_set and clear socket list */
-        FD_ZERO(&hbs_sock.readfds);
-        socks.clear();
-
-        /* Add the mtc command receiver to the select list */
-        if (( hbs_sock.mtc_to_hbs_sock  ) &&
-            ( hbs_sock.mtc_to_hbs_sock->getFD()))
-        {
-            socks.push_front (hbs_sock.mtc_to_hbs_sock->getFD());
-            FD_SET(hbs_sock.mtc_to_hbs_sock->getFD(), &hbs_sock.readfds);
-        }
-
-        if ( sockets_init )
-        {
-            /* Add the netlink event listener to the select list */
-            if ( hbs_sock.netlink_sock )
-            {
-                socks.push_back (hbs_sock.netlink_sock);
-                FD_SET(hbs_sock.netlink_sock, &hbs_sock.readfds);
-            }
-
-            if ( ! hbsInv.hbs_disabled )
-            {
-                /* Add the management interface to the select list */
-                if (( hbs_sock.rx_sock[MGMNT_INTERFACE] ) &&
-                    ( hbs_sock.rx_sock[MGMNT_INTERFACE]->getFD()))
-                {
-                    socks.push_back (hbs_sock.rx_sock[MGMNT_INTERFACE]->getFD());
-                    FD_SET(hbs_sock.rx_sock[MGMNT_INTERFACE]->getFD(), &hbs_sock.readfds );
-                }
-
-                /* Add the cluster-host network pulse rx socket if its provisioned and have a valid socket */
-                if (( hbsInv.clstr_network_provisioned == true ) &&
-                    ( hbs_sock.rx_sock[CLSTR_INTERFACE] ) &&
-                    ( hbs_sock.rx_sock[CLSTR_INTERFACE]->getFD()))
-                {
-                    socks.push_back  (hbs_sock.rx_sock[CLSTR_INTERFACE]->getFD());
-                    FD_SET(hbs_sock.rx_sock[CLSTR_INTERFACE]->getFD(), &hbs_sock.readfds );
-                }
-            }
-
-            /* Add the SM receiver to the socket select list */
-            if (( hbs_sock.sm_server_sock ) &&
-                ( hbs_sock.sm_server_sock->getFD()))
-            {
-                socks.push_back  (hbs_sock.sm_server_sock->getFD());
-                FD_SET(hbs_sock.sm_server_sock->getFD(), &hbs_sock.readfds );
-            }
-        }
+        /* Keep the reactor on the sockets that are provisioned and
+         * not disabled, then wait up to HBS_SOCKET_MSEC for and
+         * dispatch the ready ones ; a failed wait is logged by the reactor */
+        _reactor_sync ( reactor_resync );
+        reactor_resync = false ;
 
         monitor_scheduling ( this_time, prev_time, seq_num, SCHED_MONITOR__MAIN_LOOP );
 
-        /* Sort and select() at HBS_SOCKET_NSEC timeout */
-        hbs_sock.waitd.tv_sec = 0;
-        hbs_sock.waitd.tv_usec = HBS_SOCKET_NSEC;
-        socks.sort();
-
-        rc = select( socks.back()+1, &hbs_sock.readfds, NULL, NULL, &hbs_sock.waitd);
-
-        /* If the select time out expired then  */
-        if (( rc < 0 ) || ( rc == 0 ))
-        {
-            /* Check to see if the select call failed. */
-            /* ... but filter Interrupt signal         */
-            if (( rc < 0 ) && ( errno != EINTR ))
-            {
-                elog ("rx_socket select() failed (rc:%d) %s\n",
-                    errno, strerror(errno));
-            }
-        }
-        else
-        {
-            if ((hbs_sock.mtc_to_hbs_sock != NULL ) &&
-                ( FD_ISSET(hbs_sock.mtc_to_hbs_sock->getFD(), &hbs_sock.readfds)))
-            {
-                int bytes ;
-                mtc_message_type msg ;
-
-                /* Look for maintenance command messages */
-                memset (&msg, 0, sizeof(mtc_message_type));
-                bytes = hbs_sock.mtc_to_hbs_sock->read((char*)&msg,sizeof(mtc_message_type));
-                if ( bytes > 0 )
-                {
-                    if ( !strncmp ( get_hbs_cmd_req_header(), &msg.hdr[0], MSG_HEADER_SIZE ))
-                    {
-                        string hostname ;
-                        node_inv_type inv ;
-                        node_inv_init(inv);
-
-                        /* 64 byte hostname support adds a json string to
-                         * the message buffer containing the hostname as a
-                         * key/value pair. */
-                        if (( msg.ver >= MTC_CMD_FEATURE_VER__KEYVALUE_IN_BUF ) &&
-                            ( msg.buf[msg.res] == '{' ))
-                        {
-                            if ( jsonUtil_get_key_val(&msg.buf[msg.res],
-                                        MTC_JSON_INV_NAME, hostname) == PASS )
-                            {
-                                inv.name = hostname ;
-                                if (( msg.cmd == MTC_CMD_ADD_HOST ) ||
-                                    ( msg.cmd == MTC_CMD_MOD_HOST ))
-                                {
-                                    jsonUtil_get_key_val(&msg.buf[msg.res], MTC_JSON_INV_HOSTIP, inv.ip);
-                                    if ( hbsInv.clstr_network_provisioned == true )
-                                    {
-                                        jsonUtil_get_key_val(&msg.buf[msg.res], MTC_JSON_INV_CLSTRIP, inv.clstr_ip);
-                                    }
-                                }
-                            }
-                        }
-                        else if ( msg.hdr[MSG_HEADER_SIZE] != '\0' )
-                        {
-                            /* get hostname by legacy method,
-                             * ... from the header */
-                            hostname = &msg.hdr[MSG_HEADER_SIZE] ;
-                        }
-                        if ( hostname.empty() )
-                        {
-                            /* no hostname ; no action to take */
-                            wlog ("unable to get hostname from %s command",
-                                   get_mtcNodeCommand_str(msg.cmd));
-                        }
-
-                        else if ( msg.cmd == MTC_CMD_ACTIVE_CTRL )
-                        {
-                            bool logit = false ;
-                            if ( hostname == hbsInv.my_hostname )
-                            {
-                                if ( hbsInv.active_controller == false )
-                                {
-                                    logit = true ;
-                                    hbs_ctrl.clear_alarms = true ;
-                                }
-                                hbsInv.active_controller = true ;
-                            }
-                            else
-                            {
-                                if ( hbsInv.active_controller == true )
-                                    logit = true ;
-                                hbsInv.active_controller = false ;
-                            }
-                            if ( logit == true )
-                            {
-                                ilog ("%s is %sactive",
-                                          hbsInv.my_hostname.c_str(),
-                                          hbsInv.active_controller ? "" : "in" );
-
-                                /* no need for the heartbeat audit in a simplex system */
-                                if ( hbsInv.system_type != SYSTEM_TYPE__AIO__SIMPLEX )
-                                {
-                                    /* Due to activity state change we will dump
-                                     * the heartbeat cluster state at now time
-                                     * and then again in 5 seconds only to get
-                                     * the regular audit dump restarted at
-                                     * regular interval after that. */
-                                    hbs_state_audit ();
-                                    mtcTimer_reset ( hbsTimer_audit);
-                                    mtcTimer_start ( hbsTimer_audit, hbsTimer_handler, MTC_SECS_5 );
-                                }
-                            }
-                        }
-                        else if ( msg.cmd == MTC_CMD_ADD_HOST )
-                        {
-                            inv.nodetype = msg.parm[0];
-                            hbsInv.add_heartbeat_host ( inv ) ;
-                            hostname_inventory.push_back ( inv.name );
-                            hostname_inventory.unique(); // avoid duplicates
-                            ilog ("%s added to heartbeat service (%d)\n",
-                                      inv.name.c_str(),
-                                      inv.nodetype);
-
-                            /* clear any outstanding alarms on the ADD */
-                            if (( hbsInv.hbs_failure_action != HBS_FAILURE_ACTION__NONE ) &&
-                                ( hbsInv.active_controller == true ))
-                            {
-                                hbsAlarm_clear_all ( hostname,
-                                hbsInv.clstr_network_provisioned );
-                            }
-                        }
-                        else if ( msg.cmd == MTC_CMD_MOD_HOST )
-                        {
-                            inv.nodetype = msg.parm[0];
-                            hbsInv.add_heartbeat_host ( inv ) ;
-                            ilog ("%s modified heartbeat info [%d]\n",
-                                      inv.name.c_str(),
-                                      inv.nodetype );
-
-                            /* clear any outstanding alarms on the ADD */
-                            if ( hbsInv.hbs_failure_action != HBS_FAILURE_ACTION__NONE )
-                            {
-                                hbsAlarm_clear_all ( hostname, hbsInv.clstr_network_provisioned );
-                            }
-                        }
-                        else if ( msg.cmd == MTC_CMD_DEL_HOST )
-                        {
-                            hbsInv.mon_host ( hostname, false, false );
-                            hostname_inventory.remove ( hostname );
-                            hbsInv.del_host ( hostname );
-                            ilog ("%s deleted from heartbeat service\n", hostname.c_str());
-
-                            /* clear any outstanding alarms on the DEL */
-                            if (( hbsInv.hbs_failure_action != HBS_FAILURE_ACTION__NONE ) &&
-                                ( hbsInv.active_controller == true ))
-                            {
-                                hbsAlarm_clear_all ( hostname,
-                                hbsInv.clstr_network_provisioned );
-                            }
-                        }
-                        else if ( msg.cmd == MTC_CMD_STOP_HOST )
-                        {
-                            if ( hostname != hbsInv.my_hostname )
-                            {
-                                hbsInv.mon_host ( hostname, false, false );
-                                hbs_cluster_del ( hostname );
-                                ilog ("%s heartbeat service disabled by stop command",
-                                          hostname.c_str());
-                            }
-                        }
-                        else if ( msg.cmd == MTC_CMD_START_HOST )
-                        {
-                            if ( hostname == hbsInv.my_hostname )
-                            {
-                                dlog ("%s stopping heartbeat of self\n",
-                                          hostname.c_str());
-
-                                hbsInv.mon_host ( hostname, false, true );
-                                hbs_cluster_del ( hostname );
-
-                            }
-                            else
-                            {
-                                hbs_cluster_add ( hostname );
-                                hbsInv.mon_host ( hostname, true, true );
-                            }
-                        }
-                        else if (( msg.cmd == MTC_RESTART_HBS ) &&
-                                 ( hostname != hbsInv.my_hostname ))
-                        {
-                            hbsInv.mon_host ( hostname, true, true  );
-                            ilog ("%s heartbeat restart", hostname.c_str());
-                            hbsInv.print_node_info();
-                        }
-                        else if ( msg.cmd == MTC_RECOVER_HBS )
-                        {
-                            hbsInv.hbs_pulse_period = hbsInv.hbs_pulse_period_save ;
-                            ilog ("%s starting heartbeat recovery (period:%d msec)\n", hostname.c_str(), hbsInv.hbs_pulse_period);
-                            hbsInv.print_node_info();
-                        }
-                        else if ( msg.cmd == MTC_BACKOFF_HBS )
-                        {
-                            hbsInv.hbs_pulse_period = (hbsInv.hbs_pulse_period_save * HBS_BACKOFF_FACTOR) ;
-                            ilog ("%s starting heartbeat backoff (period:%d msecs)\n", hostname.c_str(), hbsInv.hbs_pulse_period );
-                            hbs_cluster_change ( "backoff" );
-                            hbsInv.print_node_info();
-                        }
-                        else
-                        {
-                            wlog ("Unsupport maintenance command\n");
-                        }
-                    }
-                    else
-                    {
-                        elog ("Unexpected maintenance message header\n");
-                    }
-                }
-                else
-                {
-                    elog ("Failed receive from agent domain socket (%i)\n", bytes );
-                }
-            }
-
-            if ( ! hbsInv.hbs_disabled )
-            {
-                if (( hbs_sock.rx_sock[MGMNT_INTERFACE] ) &&
-                    ( FD_ISSET(hbs_sock.rx_sock[MGMNT_INTERFACE]->getFD(), &hbs_sock.readfds)))
-                {
-                    hbs_sock.fired[MGMNT_INTERFACE] = true ;
-                }
-
-                if (( hbsInv.clstr_network_provisioned == true ) &&
-                    ( hbs_sock.rx_sock[CLSTR_INTERFACE] ) &&
-                    (  hbs_sock.rx_sock[CLSTR_INTERFACE]->getFD()) &&
-                    ( FD_ISSET(hbs_sock.rx_sock[CLSTR_INTERFACE]->getFD(), &hbs_sock.readfds)))
-                {
-                    hbs_sock.fired[CLSTR_INTERFACE] = true ;
-                }
-            }
-
-            if ((hbs_sock.sm_server_sock != NULL ) &&
-                ( FD_ISSET(hbs_sock.sm_server_sock->getFD(), &hbs_sock.readfds)))
-            {
-                hbs_sm_handler();
-            }
-
-            if (FD_ISSET( hbs_sock.netlink_sock, &hbs_sock.readfds))
-            {
-                dlog ("netlink socket fired\n");
-                rc = hbsInv.service_netlink_events ( hbs_sock.netlink_sock, hbs_sock.ioctl_sock );
-                if ( rc )
-                {
-                    elog ("service_netlink_events failed (rc:%d)\n", rc );
-                }
-            }
-        }
+        daemon_reactor_run ( HBS_SOCKET_MSEC );
 
         /***************************************************************/
         /**************** Manage Heartbeat Service *********************/
@@ -2401,6 +2433,7 @@ void daemon_service_run ( void )
                         if ( pulse_request_fail_log_counter[iface] > INTERFACE_ERRORS_FOR_REINIT )
                         {
                             rc = _setup_pulse_messaging ( (iface_enum)iface , daemon_get_rmem_max ()) ;
+                            reactor_resync = true ;
                             if ( rc )
                                 continue ;
                         }
@@ -2573,7 +2606,9 @@ void daemon_dump_info ( void )
 
     hbsInv.print_node_info ();
     hbs_state_audit();
+    pulse_receive_stats_log ();
     hbsInv.memDumpAllState ();
+    daemon_reactor_dump ();
 
 #ifdef WANT_HBS_MEM_LOGS
     daemon_dump_membuf (); /* write mem_logs to log file and clear log list */
@@ -150,7 +150,7 @@ typedef struct
     int                tx_port   [MAX_IFACES]; /**< tx pulse port number      */
     hbs_message_type   tx_mesg   [MAX_IFACES]; /**< tx pulse message buffer   */
 
-    bool fired                   [MAX_IFACES]; /**< true if select fired      */
+    bool fired                   [MAX_IFACES]; /**< true if rx fd was ready   */
 
     msgSock_type       mtclogd ; /* Not used */
 
@@ -158,11 +158,6 @@ typedef struct
     msgClassSock*   alarm_sock ;               /**< tx socket file descriptor */
     int             alarm_port ;               /**< tx pulse port number      */
 
-
-    /* For select dispatch */
-    struct timeval waitd  ;
-            fd_set readfds;
-
     int netlink_sock ; /* netlink socket */
     int   ioctl_sock ; /* general ioctl socket */
 
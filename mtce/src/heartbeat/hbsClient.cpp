@@ -168,6 +168,9 @@ void daemon_exit ( void )
     if ( hbs_sock.netlink_sock > 0 )
        close (hbs_sock.netlink_sock);
 
+    daemon_watch_dump ();
+    daemon_watch_fini ();
+
     exit (0);
 }
 
@@ -1294,6 +1297,108 @@ int daemon_init ( string iface, string nodeType_str )
     return (rc);
 }
 
+/*****************************************************************************
+ *
+ * Main loop reactor handlers ; see daemon_reactor_add
+ *
+ * The pulse and pmon pulse handlers are passed the main loop's
+ * heartbeat flags as ctx.
+ *
+ *****************************************************************************/
+
+static void _reactor_pulse_mgmnt ( int fd, void * ctx )
+{
+    UNUSED(fd);
+    unsigned int & flags = *(unsigned int *)ctx ;
+    int count = 0 ;
+
+    /* Receive pulse request and send a response */
+    /* Note: The flags are taken from the last round of get_pmon_pulses */
+    int rc = _service_pulse_request ( MGMNT_IFACE, flags );
+    if ( rc != PASS )
+    {
+        if ( rc == FAIL_TO_RECEIVE )
+        {
+            mlog ("Failed to receive pulse request on management network (rc:%d)\n",rc);
+        }
+        else
+        {
+            wlog_throttled ( count, 200, "Failed to service pulse request on management network (rc:%d)\n",rc);
+        }
+    }
+    /* Clear 'flags'. If no pmon pulses come in then flags will not be updated
+     * and we will be stuck in the last flags state */
+     flags = 0 ;
+}
+
+static void _reactor_pulse_clstr ( int fd, void * ctx )
+{
+    UNUSED(fd);
+    unsigned int & flags = *(unsigned int *)ctx ;
+    int count = 0 ;
+
+    /* Receive pulse request from the cluster-host interface and send a response */
+    /* Note: The flags are taken from the last round of get_pmon_pulses */
+    int rc = _service_pulse_request ( CLSTR_IFACE, flags );
+    if ( rc != PASS )
+    {
+        if ( rc == FAIL_TO_RECEIVE )
+        {
+            mlog ("Failed to receive pulse request on cluster-host network (rc:%d)\n",rc);
+        }
+        else
+        {
+            wlog_throttled ( count, 200, "Failed to service pulse request on cluster-host network (rc:%d)\n",rc);
+        }
+    }
+}
+
+static void _reactor_pmon_pulse ( int fd, void * ctx )
+{
+    UNUSED(fd);
+    unsigned int & flags = *(unsigned int *)ctx ;
+
+    pmonPulse_counter += get_pmon_pulses ( );
+    if ( pmonPulse_counter )
+    {
+        flags |= ( PMOND_FLAG ) ;
+        if ( stallMon.monitor_mode == true )
+        {
+            stallMon_init ();
+        }
+    }
+}
+
+static void _reactor_amon ( int fd, void * ctx )
+{
+    UNUSED(fd); UNUSED(ctx);
+    dlog3 ("Active Monitor Select Fired\n");
+    active_monitor_dispatch ();
+}
+
+static void _reactor_netlink ( int fd, void * ctx )
+{
+    UNUSED(ctx);
+    log_link_events ( fd,
+                      hbs_sock.ioctl_sock,
+                      hbs_config.mgmnt_iface,
+                      hbs_config.clstr_iface,
+                      hbs_sock.mgmnt_link_up_and_running,
+                      hbs_sock.clstr_link_up_and_running) ;
+}
+
+static void _reactor_watch ( int fd, void * ctx )
+{
+    UNUSED(fd); UNUSED(ctx);
+    daemon_watch_handler ();
+}
+
+static void _reactor_wheel ( int fd, void * ctx )
+{
+    UNUSED(fd); UNUSED(ctx);
+    mtcTimer_wheel_service ();
+}
+
 int stall_threshold_log = 0 ;
 int stall_times_threshold_log = 0 ;
 void daemon_service_run ( void )
@@ -1301,7 +1406,6 @@ void daemon_service_run ( void )
     bool stall_monitor_ready       = false ;
 
     unsigned int flags  = 0 ;
-             int rc     = 0 ;
              int count  = 0 ;
 
     /* Make the main loop schedule in real-time */
@@ -1314,6 +1418,10 @@ void daemon_service_run ( void )
                param.sched_priority, errno, strerror(errno));
     }
 
+    /* Run this daemon's timers off the timer wheel rather than
+     * with a posix timer and signal per timer */
+    mtcTimer_wheel_init ();
+
     if (( hbs_sock.ioctl_sock = open_ioctl_socket ( )) <= 0 )
     {
         elog ("Failed to create ioctl socket");
@@ -1328,20 +1436,42 @@ void daemon_service_run ( void )
     }
 
     hbs_sock.amon_socket = active_monitor_get_sel_obj ();
-    std::list<int> socks ;
-    socks.clear();
-    for ( int i = 0 ; i < MAX_IFACES ; i++ )
+    /* Register the receive file descriptors with the reactor once */
+    if ( daemon_reactor_init () != PASS )
     {
-        if (hbs_sock.rx_sock[i] && hbs_sock.rx_sock[i]->getFD() > 0 )
-        {
-            socks.push_front (hbs_sock.rx_sock[i]->getFD());
-        }
+        elog ("Failed to create main loop reactor");
+        daemon_exit ();
+    }
+    if ( hbs_sock.rx_sock[MGMNT_IFACE] && hbs_sock.rx_sock[MGMNT_IFACE]->getFD() > 0 )
+    {
+        daemon_reactor_add ( hbs_sock.rx_sock[MGMNT_IFACE]->getFD(), _reactor_pulse_mgmnt, &flags );
     }
-    socks.push_front (hbs_sock.pmon_pulse_sock->getFD());
-    socks.push_front (hbs_sock.amon_socket );
-    socks.push_front (hbs_sock.netlink_sock);
+    if ( hbs_sock.rx_sock[CLSTR_IFACE] && hbs_sock.rx_sock[CLSTR_IFACE]->getFD() > 0 )
+    {
+        daemon_reactor_add ( hbs_sock.rx_sock[CLSTR_IFACE]->getFD(), _reactor_pulse_clstr, &flags );
+    }
+    if ( hbs_sock.pmon_pulse_sock && hbs_sock.pmon_pulse_sock->getFD() )
+        daemon_reactor_add ( hbs_sock.pmon_pulse_sock->getFD(), _reactor_pmon_pulse, &flags );
+    if ( hbs_sock.amon_socket )
+        daemon_reactor_add ( hbs_sock.amon_socket, _reactor_amon );
+    if ( hbs_sock.netlink_sock > 0 )
+        daemon_reactor_add ( hbs_sock.netlink_sock, _reactor_netlink );
+    if ( mtcTimer_wheel_enabled () )
+        daemon_reactor_add ( mtcTimer_wheel_fd(), _reactor_wheel );
 
-    socks.sort();
+    /* Watch the fit files tested for every pulse and ready event */
+    if ( daemon_watch_init () == PASS )
+    {
+        daemon_watch_file ( NODE_LOCKED_FILE );
+#ifdef WANT_PULSE_RESPONSE_FIT
+        daemon_watch_file ( MTC_CMD_FIT__NO_CLSTR_RSP );
+        daemon_watch_file ( MTC_CMD_FIT__NO_MGMNT_RSP );
+#endif
+#ifdef WANT_FIT_TESTING
+        daemon_watch_file ( "/tmp/no_ready_event" );
+#endif
+        daemon_reactor_add ( daemon_watch_fd (), _reactor_watch );
+    }
 
     bool locked = daemon_is_file_present ( NODE_LOCKED_FILE ) ;
 
@@ -1366,122 +1496,16 @@ void daemon_service_run ( void )
     /* Run heartbeat service forever or until stop condition */
     for ( ;  ; )
     {
-        hbs_sock.waitd.tv_sec = 0;
-        hbs_sock.waitd.tv_usec = SOCKET_WAIT;
-
-        /* Initialize the master fd_set */
-        FD_ZERO(&hbs_sock.readfds);
-        for ( int i = 0 ; i < MAX_IFACES ; i++ )
-        {
-            if ( hbs_sock.rx_sock[i] && hbs_sock.rx_sock[i]->getFD() )
-            {
-                FD_SET(hbs_sock.rx_sock[i]->getFD(), &hbs_sock.readfds);
-            }
-        }
-
-        if ( hbs_sock.pmon_pulse_sock && hbs_sock.pmon_pulse_sock->getFD() )
-        {
-            FD_SET(hbs_sock.pmon_pulse_sock->getFD(), &hbs_sock.readfds);
-        }
-
-        if ( hbs_sock.amon_socket )
-        {
-            FD_SET(hbs_sock.amon_socket, &hbs_sock.readfds);
-        }
-
-        if ( hbs_sock.netlink_sock )
-        {
-            FD_SET(hbs_sock.netlink_sock, &hbs_sock.readfds);
-        }
-        rc = select( socks.back()+1,
-                     &hbs_sock.readfds, NULL, NULL,
-                     &hbs_sock.waitd);
-
         if ( clstr_network_provisioned == true )
         {
             flags |= CLSTR_FLAG ;
         }
 
-        /* Select error */
-        if ( rc < 0 )
+        /* Wait up to SOCKET_WAIT for and dispatch the ready fds */
+        if ( daemon_reactor_run ( SOCKET_WAIT/1000 ) < 0 )
         {
-            if ( errno != EINTR )
-            {
-                wlog_throttled ( count, 100, "select failed (%d:%s)\n",
-                                 errno, strerror(errno));
-            }
-        }
-
-        /* Only service sockets for the rc > 0 case */
-        else if ( rc )
-        {
-            if (hbs_sock.rx_sock[MGMNT_IFACE]&&FD_ISSET(hbs_sock.rx_sock[MGMNT_IFACE]->getFD(), &hbs_sock.readfds))
-            {
-                /* Receive pulse request and send a response */
-                /* Note: The flags are taken from the last round of get_pmon_pulses below */
-                int rc = _service_pulse_request ( MGMNT_IFACE, flags );
-                if ( rc != PASS )
-                {
-                    if ( rc == FAIL_TO_RECEIVE )
-                    {
-                        mlog ("Failed to receive pulse request on management network (rc:%d)\n",rc);
-                    }
-                    else
-                    {
-                        wlog_throttled ( count, 200, "Failed to service pulse request on management network (rc:%d)\n",rc);
-                    }
-                }
-                /* Clear 'flags'. If no pmon pulses come in then flags will not be updated
-                 * and we will be stuck in the last flags state */
-                 flags = 0 ;
-            }
-
-            if (hbs_sock.rx_sock[CLSTR_IFACE]&&FD_ISSET(hbs_sock.rx_sock[CLSTR_IFACE]->getFD(), &hbs_sock.readfds))
-            {
-                /* Receive pulse request from the cluster-host interface and send a response */
-                /* Note: The flags are taken from the last round of get_pmon_pulses below */
-                int rc = _service_pulse_request ( CLSTR_IFACE, flags );
-                if ( rc != PASS )
-                {
-                    if ( rc == FAIL_TO_RECEIVE )
-                    {
-                        mlog ("Failed to receive pulse request on cluster-host network (rc:%d)\n",rc);
-                    }
-                    else
-                    {
-                        wlog_throttled ( count, 200, "Failed to service pulse request on cluster-host network (rc:%d)\n",rc);
-                    }
-                }
-            }
-
-            if ( FD_ISSET(hbs_sock.pmon_pulse_sock->getFD(), &hbs_sock.readfds))
-            {
-                pmonPulse_counter += get_pmon_pulses ( );
-                if ( pmonPulse_counter )
-                {
-                    flags |= ( PMOND_FLAG ) ;
-                    if ( stallMon.monitor_mode == true )
-                    {
-                        stallMon_init ();
-                    }
-                }
-            }
-
-            if ( FD_ISSET(hbs_sock.amon_socket, &hbs_sock.readfds))
-            {
-                dlog3 ("Active Monitor Select Fired\n");
-                active_monitor_dispatch ();
-            }
-
-            if (FD_ISSET(hbs_sock.netlink_sock, &hbs_sock.readfds))
-            {
-                log_link_events ( hbs_sock.netlink_sock,
-                                  hbs_sock.ioctl_sock,
-                                  hbs_config.mgmnt_iface,
-                                  hbs_config.clstr_iface,
-                                  hbs_sock.mgmnt_link_up_and_running,
-                                  hbs_sock.clstr_link_up_and_running) ;
-            }
+            wlog_throttled ( count, 100, "select failed (%d:%s)\n",
+                             errno, strerror(errno));
         }
 
         count  = 0 ;
@@ -144,6 +144,10 @@ int hbs_self_recovery ( unsigned int cmd )
 
             syslog ( LOG_INFO, "child");
 
+            /* Nothing services the parent's timer wheel in this child
+             * so drop it and run the reboot timer as a posix timer */
+            mtcTimer_wheel_fini ();
+
             mtcTimer_init ( _timer );
             mtcTimer_start( _timer, hbs_recovery_timer_handler, 10 );
 
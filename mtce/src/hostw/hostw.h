@@ -136,7 +136,6 @@ typedef struct
     /** Unix socket used to listen for status updates */
     int                 status_sock; /**< Tx Event Socket            */
     struct sockaddr_un  status_addr; /**< Address to use for unix socket */
-    fd_set readfds;
 } hostw_socket_type ;
 
 /* functions called between files */
@@ -240,13 +240,43 @@ void manage_quorum_failed ( void )
  * indicate system issues, we take the appropriate action (log what we can
  * and reboot the system).
  */
+/* Main loop reactor handler for the pmon status socket */
+static void _reactor_status ( int fd, void * ctx )
+{
+    UNUSED(fd); UNUSED(ctx);
+    hostw_ctrl_type    * ctrl   = get_ctrl_ptr ();
+    daemon_config_type * config = daemon_get_cfg_ptr ();
+
+    if ( ctrl->quorum_failed == true )
+        return ;
+
+    int rc = hostw_service_command ( hostw_getSock_ptr ());
+    if ( rc == PASS ) /* got "all is well" message */
+    {
+        /* reset the pmon quorum health timer */
+        mtcTimer_reset(pmonTimer);
+        mtcTimer_start(pmonTimer, hostwTimer_handler, config->hostwd_update_period);
+
+        /* reload pmon grace loops count down */
+        if ( ctrl->pmon_grace_loops != config->hostwd_failure_threshold )
+        {
+            ilog("Process Quorum Health messaging restored");
+            ctrl->pmon_grace_loops = config->hostwd_failure_threshold;
+        }
+    }
+    else if ( rc != RETRY )
+        ctrl->quorum_failed = true ;
+}
+
+static void _reactor_wheel ( int fd, void * ctx )
+{
+    UNUSED(fd); UNUSED(ctx);
+    mtcTimer_wheel_service ();
+}
+
 void hostw_service ( void )
 {
-    std::list<int> socks ; /* we have a "list" of 1 socket, to allow for
-                            * future extension and to mirror code flow of
-                            * other utilities */
     hostw_socket_type * hostw_socket = hostw_getSock_ptr ();
-    struct timeval timeout;
     int rc;
 
     hostw_ctrl_type *ctrl = get_ctrl_ptr ();
@@ -256,46 +286,42 @@ void hostw_service ( void )
 
     get_kdump_support(); /* query for kdump support */
 
+    /* Run this daemon's timers off the timer wheel rather than
+     * with a posix timer and signal per timer */
+    mtcTimer_wheel_init ();
+
     mtcTimer_init ( pmonTimer, my_hostname, "pmon" );
     mtcTimer_start( pmonTimer, hostwTimer_handler, config->hostwd_update_period);
 
     ctrl->pmon_grace_loops = config->hostwd_failure_threshold;
 
-    socks.clear();
+    if ( daemon_reactor_init () != PASS )
+    {
+        elog ("Failed to create main loop reactor\n");
+        daemon_exit ();
+    }
     if ( hostw_socket->status_sock )
     {
-        socks.push_front (hostw_socket->status_sock);
-        FD_SET(hostw_socket->status_sock, &(hostw_socket->readfds));
+        daemon_reactor_add ( hostw_socket->status_sock, _reactor_status );
     }
-    socks.sort();
+    if ( mtcTimer_wheel_enabled () )
+        daemon_reactor_add ( mtcTimer_wheel_fd(), _reactor_wheel );
 
     ilog("Host Watchdog Service running\n");
     for ( ; ; )
     {
-        timeout.tv_sec =1; /* 1 second select ; pet watchdog every second */
-        timeout.tv_usec=0;
-
         kernel_watchdog_pet();
 
-        /* set the master fd_set */
-        FD_ZERO(&(hostw_socket->readfds));
-        FD_SET(hostw_socket->status_sock, &(hostw_socket->readfds));
-
-        rc = select (socks.back() + 1,
-            &(hostw_socket->readfds), NULL, NULL, &timeout);
+        /* 1 second wait ; pet watchdog every second */
+        rc = daemon_reactor_run ( 1000 );
 
-        /* If the select time out expired then no new message to process */
+        /* Check to see if the wait failed. */
         if ( rc < 0 )
         {
-            /* Check to see if the select call failed. */
-            /* ... but filter Interrupt signal         */
-            if ( errno != EINTR  )
-            {
-                elog ("Select Failed (rc:%d) %s \n", errno, strerror(errno));
-                if ( ctrl->pmon_grace_loops > 0 )
-                    ctrl->pmon_grace_loops--;
-            }
+            if ( ctrl->pmon_grace_loops > 0 )
+                ctrl->pmon_grace_loops--;
         }
+        /* If the wait timed out then no new message to process */
         else if ( rc == 0 )
         {
             if ( pmonTimer.ring == true )
@@ -320,28 +346,6 @@ void hostw_service ( void )
                 pmonTimer.ring = false ;
             }
         }
-        else if ( ctrl->quorum_failed == false )
-        {
-            if (FD_ISSET(hostw_socket->status_sock, &(hostw_socket->readfds)))
-            {
-                rc = hostw_service_command ( hostw_socket);
-                if ( rc == PASS ) /* got "all is well" message */
-                {
-                    /* reset the pmon quorum health timer */
-                    mtcTimer_reset(pmonTimer);
-                    mtcTimer_start(pmonTimer, hostwTimer_handler, config->hostwd_update_period);
-
-                    /* reload pmon grace loops count down */
-                    if ( ctrl->pmon_grace_loops != config->hostwd_failure_threshold )
-                    {
-                        ilog("Process Quorum Health messaging restored");
-                        ctrl->pmon_grace_loops = config->hostwd_failure_threshold;
-                    }
-                }
-                else if ( rc != RETRY )
-                    ctrl->quorum_failed = true ;
-            }
-        }
         if ( 0 >= ctrl->pmon_grace_loops )
         {
             if ( ctrl->quorum_failed == false )
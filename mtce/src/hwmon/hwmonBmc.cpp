@@ -112,28 +112,120 @@ int bmc_load_json_sensor ( string & hostname, sensor_data_type & sensor_data , s
     int rc = FAIL_KEY_VALUE_PARSE ;
     // ilog ("sensor data:%s\n", json_sensor_data.c_str() );
 
-    struct json_object *raw_obj = json_tokener_parse( (char*)json_sensor_data.data());
-    if ( raw_obj )
+    jsonUtil_doc_type doc ;
+    if ( jsonUtil_doc_parse ( doc, json_sensor_data.data() ) == PASS )
     {
-        sensor_data.name   = jsonUtil_get_key_value_string ( raw_obj, "n" ) ;
-        sensor_data.value  = jsonUtil_get_key_value_string ( raw_obj, "v" ) ;
-        sensor_data.unit   = jsonUtil_get_key_value_string ( raw_obj, "u" ) ;
-        sensor_data.status = jsonUtil_get_key_value_string ( raw_obj, "s" ) ;
-        sensor_data.lnr    = jsonUtil_get_key_value_string ( raw_obj, "lnr" ) ;
-        sensor_data.lcr    = jsonUtil_get_key_value_string ( raw_obj, "lcr" ) ;
-        sensor_data.lnc    = jsonUtil_get_key_value_string ( raw_obj, "lnc" ) ;
-        sensor_data.unr    = jsonUtil_get_key_value_string ( raw_obj, "unr" ) ;
-        sensor_data.ucr    = jsonUtil_get_key_value_string ( raw_obj, "ucr" ) ;
-        sensor_data.unc    = jsonUtil_get_key_value_string ( raw_obj, "unc" ) ;
+        rc = bmc_load_json_sensor ( hostname, sensor_data, doc.root );
+    }
+    return (rc);
+}
+
+/* Load a sensor sample from an already parsed json sample object */
+int bmc_load_json_sensor ( string & hostname, sensor_data_type & sensor_data , struct json_object * sensor_obj )
+{
+    int rc = FAIL_KEY_VALUE_PARSE ;
+    if ( sensor_obj )
+    {
+        sensor_data.name   = jsonUtil_get_key_value_string ( sensor_obj, "n" ) ;
+        sensor_data.value  = jsonUtil_get_key_value_string ( sensor_obj, "v" ) ;
+        sensor_data.unit   = jsonUtil_get_key_value_string ( sensor_obj, "u" ) ;
+        sensor_data.status = jsonUtil_get_key_value_string ( sensor_obj, "s" ) ;
+        sensor_data.lnr    = jsonUtil_get_key_value_string ( sensor_obj, "lnr" ) ;
+        sensor_data.lcr    = jsonUtil_get_key_value_string ( sensor_obj, "lcr" ) ;
+        sensor_data.lnc    = jsonUtil_get_key_value_string ( sensor_obj, "lnc" ) ;
+        sensor_data.unr    = jsonUtil_get_key_value_string ( sensor_obj, "unr" ) ;
+        sensor_data.ucr    = jsonUtil_get_key_value_string ( sensor_obj, "ucr" ) ;
+        sensor_data.unc    = jsonUtil_get_key_value_string ( sensor_obj, "unc" ) ;
 
         sensor_data_print ( hostname, sensor_data );
 
-        json_object_put(raw_obj);
         rc = PASS ;
     }
     return (rc);
 }
 
+/****************************************************************************
+ *
+ * Name       : bmc_load_sample
+ *
+ * Purpose    : Load a sensor sample from the bmc thread's sample list
+ *              into the specified sensor data element.
+ *
+ *              Thresholds the thread read as 'na' load as 'none' ; the
+ *              same as they did when the samples were passed as json
+ *              with those thresholds left out.
+ *
+ *****************************************************************************/
+
+static inline void _load_threshold ( string & to, const char * from )
+{
+    if ( strcmp ( from, "na" ) )
+        to = from ;
+    else
+        to = "none" ;
+}
+
+int bmc_load_sample ( string & hostname, sensor_data_type & sensor_data , const bmc_sample_type & sample )
+{
+    sensor_data.name   = sample.name   ;
+    sensor_data.value  = sample.value  ;
+    sensor_data.unit   = sample.unit   ;
+    sensor_data.status = sample.status ;
+    _load_threshold ( sensor_data.lnr, sample.lnr );
+    _load_threshold ( sensor_data.lcr, sample.lcr );
+    _load_threshold ( sensor_data.lnc, sample.lnc );
+    _load_threshold ( sensor_data.unr, sample.unr );
+    _load_threshold ( sensor_data.ucr, sample.ucr );
+    _load_threshold ( sensor_data.unc, sample.unc );
+
+    sensor_data_print ( hostname, sensor_data );
+
+    return (PASS);
+}
+
+/****************************************************************************
+ *
+ * Name       : bmc_sample_to_json
+ *
+ * Purpose    : Append the json tuple of a thread sample to 'json'.
+ *              Thresholds that are 'na' are left out.
+ *
+ *****************************************************************************/
+
+static inline void _add_json_threshold ( string & json, const char * key, const char * value )
+{
+    if ( strcmp ( value, "na" ) )
+    {
+        json.append (",\"");
+        json.append (key);
+        json.append ("\":\"");
+        json.append (value);
+        json.append ("\"");
+    }
+}
+
+void bmc_sample_to_json ( const bmc_sample_type & sample, string & json )
+{
+    json.append ("{\"n\":\"");
+    json.append (sample.name);
+    json.append ("\",\"v\":\"");
+    json.append (sample.value);
+    json.append ("\",\"u\":\"");
+    json.append (sample.unit);
+    json.append ("\",\"s\":\"");
+    json.append (sample.status);
+    json.append ("\"");
+
+    /* Include the threshold value of each below if not 'na' */
+    _add_json_threshold ( json, "lnr", sample.lnr );
+    _add_json_threshold ( json, "lcr", sample.lcr );
+    _add_json_threshold ( json, "lnc", sample.lnc );
+    _add_json_threshold ( json, "unc", sample.unc );
+    _add_json_threshold ( json, "ucr", sample.ucr );
+    _add_json_threshold ( json, "unr", sample.unr );
+    json.append("}");
+}
+
 /****************************************************************************
  *
  * Name       : sensor_data_copy
@@ -172,91 +264,168 @@ void sensor_data_copy ( sensor_data_type & from, sensor_data_type & to )
  *              cr
  *              nr
  *
+ *              dup_ptr is the already loaded sample with the same name as
+ *              this_sample, as found in the sample name index, or NULL.
+ *
  * Returns    : True is returned if this sensor is a duplicate.
  *
  ****************************************************************************/
 
 bool _handle_dup_sensors ( string             hostname,
-                           sensor_data_type * samples_ptr,
-                           int                samples,
+                           sensor_data_type * dup_ptr,
                            sensor_data_type & this_sample )
 {
-    if ( samples_ptr )
+    if ( dup_ptr == NULL )
+        return (false);
+
+    bool update = false ;
+
+    /* Treat 'Not Specified' as 'Not Applicable' */
+    if ( dup_ptr->status == "ns" )
+        dup_ptr->status = "na" ;
+
+    if ( this_sample.status == "na" )
     {
-        for ( int i = 0 ; i < samples ; i++, samples_ptr++ )
+        if ( dup_ptr->status != "na" )
         {
-            if ( samples_ptr->name == this_sample.name )
-            {
-                bool update = false ;
+            ; /* current status is better than last status ; no update */
+        }
+    }
+    else if ( this_sample.status == "ok" )
+    {
+        if ( dup_ptr->status == "na" )
+        {
+            update = true ;
+        }
+    }
+    else if ( this_sample.status == "nc" )
+    {
+        if ( dup_ptr->status == "ok" )
+        {
+            update = true ;
+        }
+        else if ( dup_ptr->status == "na" )
+        {
+            update = true ;
+        }
+    }
+    else if ( this_sample.status == "cr" )
+    {
+        if ( dup_ptr->status == "ok" )
+        {
+            update = true ;
+        }
+        else if ( dup_ptr->status == "na" )
+        {
+            update = true ;
+        }
+        else if ( dup_ptr->status == "nc" )
+        {
+            update = true ;
+        }
+    }
+    else if ( this_sample.status == "nr" )
+    {
+        if ( dup_ptr->status != "nr" )
+        {
+            update = true ;
+        }
+    }
 
-                /* Treat 'Not Specified' as 'Not Applicable' */
-                if ( samples_ptr->status == "ns" )
-                    samples_ptr->status = "na" ;
+    dlog ("%s %s is a duplicate sensor ; ( '%s' %c '%s')\n",
+            hostname.c_str(),
+            this_sample.name.c_str(),
+            dup_ptr->status.c_str(),
+            update ? '>' : ':',
+            this_sample.status.c_str());
 
-                if ( this_sample.status == "na" )
-                {
-                    if ( samples_ptr->status != "na" )
-                    {
-                        ; /* current status is better than last status ; no update */
-                    }
-                }
-                else if ( this_sample.status == "ok" )
-                {
-                    if ( samples_ptr->status == "na" )
-                    {
-                        update = true ;
-                    }
-                }
-                else if ( this_sample.status == "nc" )
-                {
-                    if ( samples_ptr->status == "ok" )
-                    {
-                        update = true ;
-                    }
-                    else if ( samples_ptr->status == "na" )
-                    {
-                        update = true ;
-                    }
-                }
-                else if ( this_sample.status == "cr" )
-                {
-                    if ( samples_ptr->status == "ok" )
-                    {
-                        update = true ;
-                    }
-                    else if ( samples_ptr->status == "na" )
-                    {
-                        update = true ;
-                    }
-                    else if ( samples_ptr->status == "nc" )
-                    {
-                        update = true ;
-                    }
-                }
-                else if ( this_sample.status == "nr" )
-                {
-                    if ( samples_ptr->status != "nr" )
-                    {
-                        update = true ;
-                    }
-                }
+    /* update the ORed status */
+    if ( update )
+        dup_ptr->status = this_sample.status ;
 
-                dlog ("%s %s is a duplicate sensor ; ( '%s' %c '%s')\n",
-                        hostname.c_str(),
-                        this_sample.name.c_str(),
-                        samples_ptr->status.c_str(),
-                        update ? '>' : ':',
-                        this_sample.status.c_str());
+    return (true) ;
+}
 
-                /* update the ORed status */
-                if ( update )
-                    samples_ptr->status = this_sample.status ;
+/*****************************************************************************
+ *
+ * Name       : bmc_find_sensor
+ *              bmc_find_sample
+ *
+ * Description: Look up the sensor[] or sample[] index of the named sensor
+ *              in the host's name to index maps rather than comparing the
+ *              name against every entry.
+ *
+ *              The sensor map is rebuilt only when the sensor model has
+ *              changed ; sensor_index_stale is set where the model is
+ *              loaded, created or deleted. The sample map is built as each
+ *              sensor read is loaded. Either map is rebuilt if it no longer
+ *              agrees with its list.
+ *
+ *              Every lookup is counted in sensor_lookups.
+ *
+ * Returns    : the index or -1 if the name is not in the list.
+ *
+ ****************************************************************************/
 
-                return (true) ;
-            }
+static void _index_rebuild ( std::unordered_map<string,int> & index,
+                             sensor_type * sensor_ptr, int sensors )
+{
+    index.clear();
+    for ( int i = 0 ; i < sensors ; i++ )
+        index.emplace ( sensor_ptr[i].sensorname, i ); /* first one wins */
+}
+
+static void _index_rebuild ( std::unordered_map<string,int> & index,
+                             sensor_data_type * sample_ptr, int samples )
+{
+    index.clear();
+    for ( int i = 0 ; i < samples ; i++ )
+        index.emplace ( sample_ptr[i].name, i ); /* first one wins */
+}
+
+int hwmonHostClass::bmc_find_sensor ( struct hwmonHostClass::hwmon_host * host_ptr,
+                                      const string & name )
+{
+    host_ptr->sensor_lookups++ ;
+    for ( int retry = 0 ; retry < 2 ; retry++ )
+    {
+        if (( host_ptr->sensor_index_stale ) || ( retry ) ||
+            ( host_ptr->sensor_index_sensors != host_ptr->sensors ))
+        {
+            _index_rebuild ( host_ptr->sensor_index, &host_ptr->sensor[0], host_ptr->sensors );
+            host_ptr->sensor_index_sensors = host_ptr->sensors ;
+            host_ptr->sensor_index_stale = false ;
+            dlog ("%s sensor index rebuilt (%d)\n", host_ptr->hostname.c_str(), host_ptr->sensors );
+        }
+        std::unordered_map<string,int>::iterator it = host_ptr->sensor_index.find ( name );
+        if ( it == host_ptr->sensor_index.end() )
+            return (-1);
+        if (( it->second < host_ptr->sensors ) &&
+            ( host_ptr->sensor[it->second].sensorname == name ))
+            return (it->second);
+    }
+    return (-1);
+}
+
+int hwmonHostClass::bmc_find_sample ( struct hwmonHostClass::hwmon_host * host_ptr,
+                                      const string & name )
+{
+    host_ptr->sensor_lookups++ ;
+    for ( int retry = 0 ; retry < 2 ; retry++ )
+    {
+        if (( retry ) || ( host_ptr->sample_index_samples != host_ptr->samples ))
+        {
+            _index_rebuild ( host_ptr->sample_index, &host_ptr->sample[0], host_ptr->samples );
+            host_ptr->sample_index_samples = host_ptr->samples ;
         }
+        std::unordered_map<string,int>::iterator it = host_ptr->sample_index.find ( name );
+        if ( it == host_ptr->sample_index.end() )
+            return (-1);
+        if (( it->second < host_ptr->samples ) &&
+            ( host_ptr->sample[it->second].name == name ))
+            return (it->second);
     }
-    return (false);
+    return (-1);
 }
 
 /*****************************************************************************
@@ -265,117 +434,90 @@ bool _handle_dup_sensors ( string             hostname,
  *
  * Description: Load all the sensor samples into hardware mon.
  *
+ *              Takes ownership of the sample list the bmc thread just
+ *              filled by swapping it with the list of the previous read,
+ *              which the thread fills next time. The samples are then
+ *              loaded straight from that list.
+ *
  ****************************************************************************/
 
-int hwmonHostClass::bmc_load_sensor_samples ( struct hwmonHostClass::hwmon_host * host_ptr, char * msg_ptr )
+int hwmonHostClass::bmc_load_sensor_samples ( struct hwmonHostClass::hwmon_host * host_ptr )
 {
-    int rc ;
-
-    int samples = 0 ;
+    int samples = host_ptr->thread_extra_info.samples ;
     host_ptr->samples = 0 ;
+    host_ptr->sample_index.clear();
+    host_ptr->sample_index_samples = 0 ;
+    host_ptr->sensor_lookups = 0 ;
+
+    if (( host_ptr->thread_extra_info.sample_list == NULL ) ||
+        ( host_ptr->bmc_sample_list == NULL ))
+    {
+        host_ptr->bmc_thread_info.status_string = "null sample list" ;
+        host_ptr->bmc_thread_info.status = FAIL_NULL_POINTER ;
+        return (host_ptr->bmc_thread_info.status);
+    }
+
+    bmc_sample_type * sample_list = host_ptr->thread_extra_info.sample_list ;
+    host_ptr->thread_extra_info.sample_list = host_ptr->bmc_sample_list ;
+    host_ptr->bmc_sample_list = sample_list ;
+
+    jlog ("%s samples: %d\n", host_ptr->hostname.c_str(), samples );
+
+    if (( samples < 0 ) || ( samples >= MAX_HOST_SENSORS ))
+    {
+        wlog ("%s too many sensors (%d); must be error condition ; rejecting\n",
+                  host_ptr->hostname.c_str(),
+                  samples );
+        return (FAIL_OUT_OF_RANGE);
+    }
 
-    rc = jsonUtil_array_elements ( msg_ptr, BMC_JSON__SENSORS_LABEL, samples ) ;
-    if ( rc == PASS )
+    /****************************************************************************
+     * Load samples into hwmond sample sensor list.
+     *
+     * Warning  : Sample readings from a server that is powered off can
+     *            be misleading. The unit type can change. To handle this we
+     *            filter out sensors that are not already in the list AND don't
+     *            fit into a valid group.
+     *
+     ****************************************************************************/
+    for ( int index = 0 ; index < samples ; index++ )
     {
-        string sensor_data ;
+        sensor_data_type & this_sample = host_ptr->sample[host_ptr->samples] ;
 
-        jlog ("%s samples: %d:%d : %s\n", host_ptr->hostname.c_str(), samples, host_ptr->thread_extra_info.samples, msg_ptr );
+        bmc_load_sample ( host_ptr->hostname, this_sample, sample_list[index] );
 
-        if ( samples != host_ptr->thread_extra_info.samples )
+        if ( host_ptr->samples > 0 )
         {
-            wlog ("%s sample accounting mismatch (%d:%d)\n",
-                      host_ptr->hostname.c_str(),
-                      samples, host_ptr->thread_extra_info.samples );
+            int dup = bmc_find_sample ( host_ptr, this_sample.name );
+            if ( _handle_dup_sensors ( host_ptr->hostname,
+                                       dup < 0 ? NULL : &host_ptr->sample[dup],
+                                       this_sample ) == true )
+            {
+                continue ;
+            }
         }
-        if ( samples >= MAX_HOST_SENSORS )
+        if ( bmc_find_sensor ( host_ptr, this_sample.name ) < 0 )
         {
-            wlog ("%s too many sensors (%d); must be error condition ; rejecting\n",
-                      host_ptr->hostname.c_str(),
-                      samples );
-            return (FAIL_OUT_OF_RANGE);
-        }
+            /* Drop any sensors that don't fall into a valid group */
+            this_sample.group_enum =
+            bmc_get_groupenum ( host_ptr->hostname,
+                                 this_sample.unit,
+                                 this_sample.name);
 
-        /****************************************************************************
-         * Load samples into hwmond sample sensor list.
-         *
-         * Warning  : Sample readings from a server that is powered off can
-         *            be misleading. The unit type can change. To handle this we
-         *            filter out sensors that are not already in the list AND don't
-         *            fit into a valid group.
-         *
-         ****************************************************************************/
-        for ( int index = 0 ; index < samples ; index++ )
-        {
-            sensor_data.clear();
-            rc = jsonUtil_get_array_idx ( msg_ptr, BMC_JSON__SENSORS_LABEL, index, sensor_data ) ;
-            if ( rc == PASS )
+            if ( this_sample.group_enum == HWMON_CANNED_GROUP__NULL )
             {
-                if ( bmc_load_json_sensor ( host_ptr->hostname , host_ptr->sample[host_ptr->samples], sensor_data ) == PASS )
-                {
-                    bool found = false ;
+                blog3 ("%s ignore sensor : %s\n", host_ptr->hostname.c_str(), this_sample.name.c_str());
+                continue ;
+            }
+        }
+        blog2 ("%s  valid sensor : %s\n", host_ptr->hostname.c_str(), this_sample.name.c_str());
 
-                    if ( host_ptr->samples > 0 )
-                    {
-                        if ( _handle_dup_sensors ( host_ptr->hostname,
-                                                  &host_ptr->sample[0],
-                                                   host_ptr->samples,
-                                                   host_ptr->sample[host_ptr->samples]) == true )
-                        {
-                            continue ;
-                        }
-                    }
-                    for ( int s = 0 ; s < host_ptr->sensors ; ++s )
-                    {
-                        if ( !host_ptr->sensor[s].sensorname.compare(host_ptr->sample[host_ptr->samples].name))
-                        {
-                            found = true ;
-                            break ;
-                        }
-                    }
-                    if ( found == false )
-                    {
-                        /* Drop any sensors that don't fall into a valid group */
-                        host_ptr->sample[host_ptr->samples].group_enum =
-                        bmc_get_groupenum ( host_ptr->hostname,
-                                             host_ptr->sample[host_ptr->samples].unit,
-                                             host_ptr->sample[host_ptr->samples].name);
+        /* keep the sample name index in step with the list */
+        host_ptr->sample_index.emplace ( this_sample.name, host_ptr->samples );
+        host_ptr->sample_index_samples = ++host_ptr->samples ;
+    } /* for end */
+    blog1 ("%s provided %d sensor samples\n", host_ptr->hostname.c_str(), host_ptr->samples);
 
-                        if ( host_ptr->sample[host_ptr->samples].group_enum == HWMON_CANNED_GROUP__NULL )
-                        {
-                            blog3 ("%s ignore sensor : %s\n", host_ptr->hostname.c_str(), sensor_data.c_str());
-                            continue ;
-                        }
-                    }
-                    blog2 ("%s  valid sensor : %s\n", host_ptr->hostname.c_str(), sensor_data.c_str());
-                }
-                else
-                {
-                    wlog ("%s invalid sensor data:%s\n", host_ptr->hostname.c_str(), sensor_data.c_str());
-                    host_ptr->bmc_thread_info.status_string =
-                    "failed to load sensor sample data from incoming json string" ;
-                    host_ptr->bmc_thread_info.status = FAIL_JSON_PARSE ;
-                    break ;
-                }
-            }
-            else
-            {
-                host_ptr->bmc_thread_info.status_string = "sensor data parse error for index '" ;
-                host_ptr->bmc_thread_info.status_string.append(itos(host_ptr->thread_extra_info.samples));
-                host_ptr->bmc_thread_info.status_string.append("'");
-                host_ptr->bmc_thread_info.status = FAIL_JSON_PARSE ;
-                break ;
-            }
-            host_ptr->samples++ ;
-        } /* for end */
-        blog1 ("%s provided %d sensor samples\n", host_ptr->hostname.c_str(), host_ptr->samples);
-    }
-    else
-    {
-        host_ptr->bmc_thread_info.status_string = "failed to find '" ;
-        host_ptr->bmc_thread_info.status_string.append(BMC_JSON__SENSORS_LABEL);
-        host_ptr->bmc_thread_info.status_string.append("' label") ;
-        host_ptr->bmc_thread_info.status = FAIL_JSON_PARSE ;
-    }
     return (host_ptr->bmc_thread_info.status);
 }
 
@@ -402,248 +544,248 @@ int hwmonHostClass::bmc_update_sensors ( struct hwmonHostClass::hwmon_host * hos
     }
     for ( int i = 0 ; i < host_ptr->sensors ; ++i )
     {
-        for ( int j = 0 ; j < host_ptr->samples ; j++ )
+        /* the sample for this sensor, if any */
+        int j = bmc_find_sample ( host_ptr, host_ptr->sensor[i].sensorname );
+        if ( j >= 0 )
         {
-            if ( host_ptr->sensor[i].sensorname.compare(host_ptr->sample[j].name) == 0 )
-            {
-                host_ptr->sensor[i].updated = true ;
+            host_ptr->sensor[i].updated = true ;
 
-                blog1 ("%s %s curr:%s this:%s last:%s\n",
-                               host_ptr->hostname.c_str(),
-                               host_ptr->sensor[i].sensorname.c_str(),
-                               host_ptr->sensor[i].status.c_str(),
-                               host_ptr->sample[j].status.c_str(),
-                               host_ptr->sensor[i].sample_status_last.c_str());
+            blog1 ("%s %s curr:%s this:%s last:%s\n",
+                           host_ptr->hostname.c_str(),
+                           host_ptr->sensor[i].sensorname.c_str(),
+                           host_ptr->sensor[i].status.c_str(),
+                           host_ptr->sample[j].status.c_str(),
+                           host_ptr->sensor[i].sample_status_last.c_str());
 
 #ifdef WANT_FIT_TESTING
-                /* Handle Fault Insertion Test Requests ...
-                 * for host and sensor with FIT specified status
-                 */
-                string fit_status = "" ;
-                if ( daemon_want_fit ( FIT_CODE__HWMON__SENSOR_STATUS, host_ptr->hostname, host_ptr->sensor[i].sensorname, fit_status ) )
-                {
-                    slog ("%s FIT %s sensor with '%s' status (was %s)\n",
-                              host_ptr->hostname.c_str(),
-                              host_ptr->sensor[i].sensorname.c_str(),
-                              fit_status.c_str(),
-                              host_ptr->sensor[i].status.c_str());
+            /* Handle Fault Insertion Test Requests ...
+             * for host and sensor with FIT specified status
+             */
+            string fit_status = "" ;
+            if ( daemon_want_fit ( FIT_CODE__HWMON__SENSOR_STATUS, host_ptr->hostname, host_ptr->sensor[i].sensorname, fit_status ) )
+            {
+                slog ("%s FIT %s sensor with '%s' status (was %s)\n",
+                          host_ptr->hostname.c_str(),
+                          host_ptr->sensor[i].sensorname.c_str(),
+                          fit_status.c_str(),
+                          host_ptr->sensor[i].status.c_str());
 
-                    /* override existing status */
-                    host_ptr->sample[j].status = fit_status ;
-                }
+                /* override existing status */
+                host_ptr->sample[j].status = fit_status ;
+            }
 #endif
 
-                /*************************************************************
-                 ***************  Sensor Debounce Control Start **************
-                 *************************************************************
-                 *
-                 * If the last severity is the same as this severity then
-                 * the state change is persistent ; no debounce.
-                 * If the current and last readings are different and the
-                 * debounce bool indicating we are in debounce mode.
-                 *
-                 *************************************************************/
-                if ( host_ptr->sensor_query_count > START_DEBOUCE_COUNT )
+            /*************************************************************
+             ***************  Sensor Debounce Control Start **************
+             *************************************************************
+             *
+             * If the last severity is the same as this severity then
+             * the state change is persistent ; no debounce.
+             * If the current and last readings are different and the
+             * debounce bool indicating we are in debounce mode.
+             *
+             *************************************************************/
+            if ( host_ptr->sensor_query_count > START_DEBOUCE_COUNT )
+            {
+                /* ***** Fix this up once verified */
+
+                /* if the current sensor state is the same as the current
+                 * sensor sample then don't clear the debounce count as it
+                 * might be indicating that there was a transient */
+                if ( host_ptr->sensor[i].sample_status.compare(host_ptr->sample[j].status) == 0 )
+                   ;
+
+                /* If we get 2 same readings in a row then this is not
+                 * a transient or flapper */
+                else if ( host_ptr->sensor[i].sample_status_last.compare(host_ptr->sample[j].status) == 0 )
+                   host_ptr->sensor[i].debounce_count = 0 ;
+
+                /* if this sample reading is different from the last
+                 * then this is a transient candidate */
+                else if ( host_ptr->sensor[i].sample_status_last.compare(host_ptr->sample[j].status) )
                 {
-                    /* ***** Fix this up once verified */
-
-                    /* if the current sensor state is the same as the current
-                     * sensor sample then don't clear the debounce count as it
-                     * might be indicating that there was a transient */
-                    if ( host_ptr->sensor[i].sample_status.compare(host_ptr->sample[j].status) == 0 )
-                       ;
-
-                    /* If we get 2 same readings in a row then this is not
-                     * a transient or flapper */
-                    else if ( host_ptr->sensor[i].sample_status_last.compare(host_ptr->sample[j].status) == 0 )
-                       host_ptr->sensor[i].debounce_count = 0 ;
-
-                    /* if this sample reading is different from the last
-                     * then this is a transient candidate */
-                    else if ( host_ptr->sensor[i].sample_status_last.compare(host_ptr->sample[j].status) )
+                    host_ptr->sensor[i].debounce_count++ ;
+                    if ( host_ptr->sensor[i].debounce_count > 1 )
                     {
-                        host_ptr->sensor[i].debounce_count++ ;
-                        if ( host_ptr->sensor[i].debounce_count > 1 )
+                        /* do not generate logs for suppressed sensors */
+                        if ( host_ptr->sensor[i].suppress == false )
                         {
-                            /* do not generate logs for suppressed sensors */
-                            if ( host_ptr->sensor[i].suppress == false )
-                            {
-                                /* debounced */
-                                string reason = "'" ;
-                                reason.append(host_ptr->sensor[i].status) ;
-                                reason.append("' but saw changing readings '") ;
-                                reason.append(host_ptr->sensor[i].sample_status_last);
-                                reason.append("' to '");
-                                reason.append(host_ptr->sample[j].status);
-                                reason.append("'");
-
-                                hwmonLog ( host_ptr->hostname,
-                                           HWMON_ALARM_ID__SENSOR,
-                                           FM_ALARM_SEVERITY_WARNING,
-                                           host_ptr->sensor[i].sensorname,
-                                           reason );
-
-                                ilog ("%s %s is '%s:%s' status ; flapping '%s' then '%s'\n",
-                                          host_ptr->hostname.c_str(),
-                                          host_ptr->sensor[i].sensorname.c_str(),
-                                          host_ptr->sensor[i].status.c_str(),
-                                          host_ptr->sensor[i].sample_status.c_str(),
-                                          host_ptr->sensor[i].sample_status_last.c_str(),
-                                          host_ptr->sample[j].status.c_str());
-                            }
+                            /* debounced */
+                            string reason = "'" ;
+                            reason.append(host_ptr->sensor[i].status) ;
+                            reason.append("' but saw changing readings '") ;
+                            reason.append(host_ptr->sensor[i].sample_status_last);
+                            reason.append("' to '");
+                            reason.append(host_ptr->sample[j].status);
+                            reason.append("'");
+
+                            hwmonLog ( host_ptr->hostname,
+                                       HWMON_ALARM_ID__SENSOR,
+                                       FM_ALARM_SEVERITY_WARNING,
+                                       host_ptr->sensor[i].sensorname,
+                                       reason );
+
+                            ilog ("%s %s is '%s:%s' status ; flapping '%s' then '%s'\n",
+                                      host_ptr->hostname.c_str(),
+                                      host_ptr->sensor[i].sensorname.c_str(),
+                                      host_ptr->sensor[i].status.c_str(),
+                                      host_ptr->sensor[i].sample_status.c_str(),
+                                      host_ptr->sensor[i].sample_status_last.c_str(),
+                                      host_ptr->sample[j].status.c_str());
                         }
-                        host_ptr->sensor[i].sample_status_last = host_ptr->sample[j].status ;
-                        break ; // continue ;
                     }
+                    host_ptr->sensor[i].sample_status_last = host_ptr->sample[j].status ;
+                    goto sensor_sample_done ;
                 }
+            }
 
-                /***************** Sensor Debounce Handling ******************/
-                host_ptr->sensor[i].want_debounce_log_if_ok = false ;
-                if ( host_ptr->sensor[i].debounce_count == 1 )
+            /***************** Sensor Debounce Handling ******************/
+            host_ptr->sensor[i].want_debounce_log_if_ok = false ;
+            if ( host_ptr->sensor[i].debounce_count == 1 )
+            {
+                /* do not generate logs for suppressed sensors */
+                if ( host_ptr->sensor[i].suppress == false )
                 {
-                    /* do not generate logs for suppressed sensors */
-                    if ( host_ptr->sensor[i].suppress == false )
+                    if ( host_ptr->sensor[i].sample_status_last.compare("na"))
                     {
-                        if ( host_ptr->sensor[i].sample_status_last.compare("na"))
-                        {
-                            host_ptr->sensor[i].want_debounce_log_if_ok = true ;
-                        }
-                        ilog ("%s %s is '%s' but saw a transient '%s' reading\n",
-                                  host_ptr->hostname.c_str(),
-                                  host_ptr->sensor[i].sensorname.c_str(),
-                                  host_ptr->sensor[i].sample_status.c_str(),
-                                  host_ptr->sensor[i].sample_status_last.c_str());
+                        host_ptr->sensor[i].want_debounce_log_if_ok = true ;
                     }
+                    ilog ("%s %s is '%s' but saw a transient '%s' reading\n",
+                              host_ptr->hostname.c_str(),
+                              host_ptr->sensor[i].sensorname.c_str(),
+                              host_ptr->sensor[i].sample_status.c_str(),
+                              host_ptr->sensor[i].sample_status_last.c_str());
                 }
+            }
 
-                host_ptr->sensor[i].debounce_count = 0;
-
-                /*************************************************************/
-                /*******************  Sensor Debounce End ********************/
-                /*************************************************************/
+            host_ptr->sensor[i].debounce_count = 0;
 
-                /* update sample status now that we are beyond the debounce check.
-                 * The last status is updated at the end of this condition */
-                host_ptr->sensor[i].sample_status = host_ptr->sample[j].status ;
+            /*************************************************************/
+            /*******************  Sensor Debounce End ********************/
+            /*************************************************************/
 
-                /* if we get a match and its status is 'na' then just mark it as 'offline' */
-                if ( host_ptr->sample[j].status.compare("na") == 0 )
-                {
-                    host_ptr->sensor[i].sample_severity =
-                    get_bmc_severity (host_ptr->sample[j].status);
-                }
-                else if ( host_ptr->sample[j].unit.compare(DISCRETE))
-                {
-                    /* not a descrete sensor */
+            /* update sample status now that we are beyond the debounce check.
+             * The last status is updated at the end of this condition */
+            host_ptr->sensor[i].sample_status = host_ptr->sample[j].status ;
 
-                    /* get severity level */
-                    host_ptr->sensor[i].sample_severity =
-                    get_bmc_severity (host_ptr->sample[j].status);
+            /* if we get a match and its status is 'na' then just mark it as 'offline' */
+            if ( host_ptr->sample[j].status.compare("na") == 0 )
+            {
+                host_ptr->sensor[i].sample_severity =
+                get_bmc_severity (host_ptr->sample[j].status);
+            }
+            else if ( host_ptr->sample[j].unit.compare(DISCRETE))
+            {
+                /* not a descrete sensor */
 
-                    /* Check to see if we need to generate the transient log.
-                     * Only generate it if want_debounce_log_if_ok is true and
-                     * the reading is ok */
-                    if (( host_ptr->sensor[i].want_debounce_log_if_ok == true ) &&
-                        ( host_ptr->sensor[i].sample_severity == HWMON_SEVERITY_GOOD ))
-                    {
-                        _generate_transient_log ( &host_ptr->sensor[i] );
-                    }
+                /* get severity level */
+                host_ptr->sensor[i].sample_severity =
+                get_bmc_severity (host_ptr->sample[j].status);
 
-                    /* Minor severity from get_bmc_severity means
-                     * that the severity status is unexpected */
-                    if ( host_ptr->sensor[i].sample_severity == HWMON_SEVERITY_MINOR )
-                    {
-                        if ( host_ptr->sensor[i].status.compare("minor") == 0 )
-                        {
-                            /* only print this log on the first state transition */
-                            wlog ("%s '%s' unexpected bmc sensor reading '%s'\n",
-                                      host_ptr->hostname.c_str(),
-                                      host_ptr->sensor[i].sensorname.c_str(),
-                                      host_ptr->sample[j].status.c_str());
-                        }
-                    }
+                /* Check to see if we need to generate the transient log.
+                 * Only generate it if want_debounce_log_if_ok is true and
+                 * the reading is ok */
+                if (( host_ptr->sensor[i].want_debounce_log_if_ok == true ) &&
+                    ( host_ptr->sensor[i].sample_severity == HWMON_SEVERITY_GOOD ))
+                {
+                    _generate_transient_log ( &host_ptr->sensor[i] );
                 }
 
-                /*
-                 * The Quanta Air Frame server's power sensors are reported as discrete sensors.
-                 * In order to maintain backward compatibility for Quanta we need to search for
-                 * these sensor status and prop that status to the sensor list.
-                 */
-                else if ( host_ptr->quanta_server )
+                /* Minor severity from get_bmc_severity means
+                 * that the severity status is unexpected */
+                if ( host_ptr->sensor[i].sample_severity == HWMON_SEVERITY_MINOR )
                 {
-                    /* otherwise if the status is not prefixed with a 0x then the
-                     * reading is unknown so set its severity to minor as we do
-                     * for all unknown sensor readings */
-                    if ( host_ptr->sample[j].status.find("0x", 0 ) == std::string::npos )
+                    if ( host_ptr->sensor[i].status.compare("minor") == 0 )
                     {
-                        wlog ("%s '%s' unexpected discrete status reading '%s'\n",
+                        /* only print this log on the first state transition */
+                        wlog ("%s '%s' unexpected bmc sensor reading '%s'\n",
                                   host_ptr->hostname.c_str(),
                                   host_ptr->sensor[i].sensorname.c_str(),
                                   host_ptr->sample[j].status.c_str());
-
-                        host_ptr->sensor[i].sample_severity = HWMON_SEVERITY_MINOR ;
                     }
-                    /* otherwise correlate the status against the sensors we care about */
-                    else
+                }
+            }
+
+            /*
+             * The Quanta Air Frame server's power sensors are reported as discrete sensors.
+             * In order to maintain backward compatibility for Quanta we need to search for
+             * these sensor status and prop that status to the sensor list.
+             */
+            else if ( host_ptr->quanta_server )
+            {
+                /* otherwise if the status is not prefixed with a 0x then the
+                 * reading is unknown so set its severity to minor as we do
+                 * for all unknown sensor readings */
+                if ( host_ptr->sample[j].status.find("0x", 0 ) == std::string::npos )
+                {
+                    wlog ("%s '%s' unexpected discrete status reading '%s'\n",
+                              host_ptr->hostname.c_str(),
+                              host_ptr->sensor[i].sensorname.c_str(),
+                              host_ptr->sample[j].status.c_str());
+
+                    host_ptr->sensor[i].sample_severity = HWMON_SEVERITY_MINOR ;
+                }
+                /* otherwise correlate the status against the sensors we care about */
+                else
+                {
+                    unsigned short bmc_status = (unsigned short)strtol((char*)host_ptr->sample[j].status.data(), NULL, 0 );
+
+                    /* interpret discrete sensor readings for known Quanta discrete
+                     * sensors that need to be represented with a correlated status */
+                    blog3 ("%s '%s' discrete sensor found - need to update status %s:0x%04x ...\n",
+                               host_ptr->hostname.c_str(),
+                               host_ptr->sensor[i].sensorname.c_str(),
+                               host_ptr->sample[j].status.c_str(),
+                               bmc_status );
+
+                    /* treat thermal trip sensors failures as Major.
+                     * A good reading is 0x0080 */
+                    if (( host_ptr->sensor[i].sensorname.compare("PCH Thermal Trip") == 0 ) ||
+                        ( host_ptr->sensor[i].sensorname.compare("MB Thermal Trip") == 0 ))
                     {
-                        unsigned short bmc_status = (unsigned short)strtol((char*)host_ptr->sample[j].status.data(), NULL, 0 );
-
-                        /* interpret discrete sensor readings for known Quanta discrete
-                         * sensors that need to be represented with a correlated status */
-                        blog3 ("%s '%s' discrete sensor found - need to update status %s:0x%04x ...\n",
-                                   host_ptr->hostname.c_str(),
-                                   host_ptr->sensor[i].sensorname.c_str(),
-                                   host_ptr->sample[j].status.c_str(),
-                                   bmc_status );
-
-                        /* treat thermal trip sensors failures as Major.
-                         * A good reading is 0x0080 */
-                        if (( host_ptr->sensor[i].sensorname.compare("PCH Thermal Trip") == 0 ) ||
-                            ( host_ptr->sensor[i].sensorname.compare("MB Thermal Trip") == 0 ))
+                        if ( bmc_status == 0x0080 )
                         {
-                            if ( bmc_status == 0x0080 )
+                            host_ptr->sensor[i].sample_severity = HWMON_SEVERITY_GOOD ;
+                            if ( host_ptr->sensor[i].want_debounce_log_if_ok == true )
                             {
-                                host_ptr->sensor[i].sample_severity = HWMON_SEVERITY_GOOD ;
-                                if ( host_ptr->sensor[i].want_debounce_log_if_ok == true )
-                                {
-                                    _generate_transient_log ( &host_ptr->sensor[i] );
-                                }
-                            }
-                            else
-                            {
-                                host_ptr->sensor[i].sample_severity = HWMON_SEVERITY_MAJOR ;
+                                _generate_transient_log ( &host_ptr->sensor[i] );
                             }
                         }
-                        else if ( host_ptr->sensor[i].sensorname.compare("PSU Redundancy") == 0 )
+                        else
                         {
-                            if ( bmc_status == 0x0180 ) /* Fully Redundant */
-                            {
-                                host_ptr->sensor[i].sample_severity = HWMON_SEVERITY_GOOD ;
-                                if ( host_ptr->sensor[i].want_debounce_log_if_ok == true )
-                                {
-                                    _generate_transient_log ( &host_ptr->sensor[i] );
-                                }
-                            }
-                            else if ( bmc_status == 0x0280 ) /* Redundancy Lost */
+                            host_ptr->sensor[i].sample_severity = HWMON_SEVERITY_MAJOR ;
+                        }
+                    }
+                    else if ( host_ptr->sensor[i].sensorname.compare("PSU Redundancy") == 0 )
+                    {
+                        if ( bmc_status == 0x0180 ) /* Fully Redundant */
+                        {
+                            host_ptr->sensor[i].sample_severity = HWMON_SEVERITY_GOOD ;
+                            if ( host_ptr->sensor[i].want_debounce_log_if_ok == true )
                             {
-                                host_ptr->sensor[i].sample_severity = HWMON_SEVERITY_MAJOR ;
+                                _generate_transient_log ( &host_ptr->sensor[i] );
                             }
-                            else
-                            {
-                                wlog ("%s '%s' unexpected discrete status reading '0x%04x'\n",
-                                          host_ptr->hostname.c_str(),
-                                          host_ptr->sensor[i].sensorname.c_str(),
-                                          bmc_status);
+                        }
+                        else if ( bmc_status == 0x0280 ) /* Redundancy Lost */
+                        {
+                            host_ptr->sensor[i].sample_severity = HWMON_SEVERITY_MAJOR ;
+                        }
+                        else
+                        {
+                            wlog ("%s '%s' unexpected discrete status reading '0x%04x'\n",
+                                      host_ptr->hostname.c_str(),
+                                      host_ptr->sensor[i].sensorname.c_str(),
+                                      bmc_status);
 
-                                sensor_data_print ( host_ptr->hostname, host_ptr->sample[j]);
-                                blog3 ("%s ... %s\n", host_ptr->hostname.c_str(), host_ptr->bmc_thread_info.data.c_str());
+                            sensor_data_print ( host_ptr->hostname, host_ptr->sample[j]);
+                            blog3 ("%s ... %s\n", host_ptr->hostname.c_str(), host_ptr->bmc_thread_info.data.c_str());
 
-                                host_ptr->sensor[i].sample_severity = HWMON_SEVERITY_MINOR ;
-                            }
+                            host_ptr->sensor[i].sample_severity = HWMON_SEVERITY_MINOR ;
                         }
-                        else if (( host_ptr->sensor[i].sensorname.compare("PSU1 Status") == 0 ) ||
-                                 ( host_ptr->sensor[i].sensorname.compare("PSU2 Status") == 0 ))
-                        {
+                    }
+                    else if (( host_ptr->sensor[i].sensorname.compare("PSU1 Status") == 0 ) ||
+                             ( host_ptr->sensor[i].sensorname.compare("PSU2 Status") == 0 ))
+                    {
 #define STATUS_BIT_MASK        (0x3F00)
 #define NO_PRESENCE_DETECTED   (0x0000)
 #define PRESENCE_DETECTED      (0x0100)
@@ -653,68 +795,66 @@ int hwmonHostClass::bmc_update_sensors ( struct hwmonHostClass::hwmon_host * hos
 #define INPUT_LOST_OOR         (0x1000)
 #define INPUT_OOR_PRESENT      (0x2000)
 
-                            /* Presence Detected and ok */
-                            // if ( bmc_status == 0x0180 )
-                            if ( (bmc_status&STATUS_BIT_MASK) == PRESENCE_DETECTED )
+                        /* Presence Detected and ok */
+                        // if ( bmc_status == 0x0180 )
+                        if ( (bmc_status&STATUS_BIT_MASK) == PRESENCE_DETECTED )
+                        {
+                            host_ptr->sensor[i].sample_severity = HWMON_SEVERITY_GOOD ;
+                            if ( host_ptr->sensor[i].want_debounce_log_if_ok == true )
                             {
-                                host_ptr->sensor[i].sample_severity = HWMON_SEVERITY_GOOD ;
-                                if ( host_ptr->sensor[i].want_debounce_log_if_ok == true )
-                                {
-                                    _generate_transient_log ( &host_ptr->sensor[i] );
-                                }
+                                _generate_transient_log ( &host_ptr->sensor[i] );
                             }
+                        }
 
-                            /* No Presence Detect */
-                            // else if (( bmc_status == 0x0080 ) || ( bmc_status == 0x0000 ))
-                            else if ( (bmc_status&STATUS_BIT_MASK) == NO_PRESENCE_DETECTED )
-                            {
-                                host_ptr->sensor[i].sample_severity = HWMON_SEVERITY_MINOR ;
-                            }
+                        /* No Presence Detect */
+                        // else if (( bmc_status == 0x0080 ) || ( bmc_status == 0x0000 ))
+                        else if ( (bmc_status&STATUS_BIT_MASK) == NO_PRESENCE_DETECTED )
+                        {
+                            host_ptr->sensor[i].sample_severity = HWMON_SEVERITY_MINOR ;
+                        }
 
-                            /* Failure Detected with anything else */
-                            /* 0x02xx */
-                            else if ( (bmc_status&STATUS_BIT_MASK) & FAILURE_DETECTED )
-                            {
-                                host_ptr->sensor[i].sample_severity = HWMON_SEVERITY_CRITICAL ;
-                            }
+                        /* Failure Detected with anything else */
+                        /* 0x02xx */
+                        else if ( (bmc_status&STATUS_BIT_MASK) & FAILURE_DETECTED )
+                        {
+                            host_ptr->sensor[i].sample_severity = HWMON_SEVERITY_CRITICAL ;
+                        }
 
-                            /* Presence Detected & Predictive Failure */
-                            //else if ( (bmc_status&STATUS_BIT_MASK) == ( PRESENCE_DETECTED | PREDICTIVE_FAILURE ))
-                            // TODO: Fix this ...
-                            else if ( ( bmc_status == 0x1580 ) || /* Presence Detected & Predictive Failure & Input Lost Or Out Of Range */
-                                      ( bmc_status == 0x2580 ) || /* Presence Detected & Predictive Failure & Input Out Of Range         */
-                                      ( bmc_status == 0x3580 ) || /* Presence Detected & Predictive Failure & both of the above          */
-                                      ( bmc_status == 0x0580 ) || /* Presence Detected & Predictive Failure */
-                                      ( bmc_status == 0x0980 ) || /* Presence Detected & Power Supply Input Lost */
-                                      ( bmc_status == 0x0d80 ) )  /* Presence Detected & Power Supply Input Out Of Range */
-                            {
-                                host_ptr->sensor[i].sample_severity = HWMON_SEVERITY_MAJOR ;
-                            }
+                        /* Presence Detected & Predictive Failure */
+                        //else if ( (bmc_status&STATUS_BIT_MASK) == ( PRESENCE_DETECTED | PREDICTIVE_FAILURE ))
+                        // TODO: Fix this ...
+                        else if ( ( bmc_status == 0x1580 ) || /* Presence Detected & Predictive Failure & Input Lost Or Out Of Range */
+                                  ( bmc_status == 0x2580 ) || /* Presence Detected & Predictive Failure & Input Out Of Range         */
+                                  ( bmc_status == 0x3580 ) || /* Presence Detected & Predictive Failure & both of the above          */
+                                  ( bmc_status == 0x0580 ) || /* Presence Detected & Predictive Failure */
+                                  ( bmc_status == 0x0980 ) || /* Presence Detected & Power Supply Input Lost */
+                                  ( bmc_status == 0x0d80 ) )  /* Presence Detected & Power Supply Input Out Of Range */
+                        {
+                            host_ptr->sensor[i].sample_severity = HWMON_SEVERITY_MAJOR ;
+                        }
 
-                            else
-                            {
-                                wlog ("%s '%s' unexpected discrete status reading '0x%04x'\n",
-                                          host_ptr->hostname.c_str(),
-                                          host_ptr->sensor[i].sensorname.c_str(),
-                                          bmc_status);
+                        else
+                        {
+                            wlog ("%s '%s' unexpected discrete status reading '0x%04x'\n",
+                                      host_ptr->hostname.c_str(),
+                                      host_ptr->sensor[i].sensorname.c_str(),
+                                      bmc_status);
 
-                                sensor_data_print ( host_ptr->hostname, host_ptr->sample[j]);
-                                blog3 ("%s ... %s\n", host_ptr->hostname.c_str(), host_ptr->bmc_thread_info.data.c_str());
+                            sensor_data_print ( host_ptr->hostname, host_ptr->sample[j]);
+                            blog3 ("%s ... %s\n", host_ptr->hostname.c_str(), host_ptr->bmc_thread_info.data.c_str());
 
-                                host_ptr->sensor[i].sample_severity = HWMON_SEVERITY_MINOR ;
-                            }
+                            host_ptr->sensor[i].sample_severity = HWMON_SEVERITY_MINOR ;
                         }
                     }
                 }
+            }
 
-                /* update last status AFTER the severity interpretation so
-                 * that debouce logging can report the transient status correctly */
-                host_ptr->sensor[i].sample_status_last = host_ptr->sample[j].status ;
+            /* update last status AFTER the severity interpretation so
+             * that debouce logging can report the transient status correctly */
+            host_ptr->sensor[i].sample_status_last = host_ptr->sample[j].status ;
+        } /* end handling of this sensor's sample */
 
-                /* we already found the sample so got to the next sensor */
-                break ;
-            }
-        } /* end for loop over sensor samples */
+sensor_sample_done:
 
         if ( host_ptr->sensor[i].updated == true )
         {
@@ -771,5 +911,10 @@ int hwmonHostClass::bmc_update_sensors ( struct hwmonHostClass::hwmon_host * hos
             }
         }
     }
+    blog1 ("%s matched %d sensors to %d samples with %u lookups\n",
+               host_ptr->hostname.c_str(),
+               host_ptr->sensors,
+               host_ptr->samples,
+               host_ptr->sensor_lookups);
     return (PASS);
 }
@@ -45,5 +45,12 @@ void sensor_data_print ( string & hostname, const sensor_data_type & data );
 void sensor_data_copy  ( sensor_data_type & from, sensor_data_type & to );
 
 int bmc_load_json_sensor ( string & hostname, sensor_data_type & sensor_data , string json_sensor_data );
+int bmc_load_json_sensor ( string & hostname, sensor_data_type & sensor_data , struct json_object * sensor_obj );
+
+/* Load a sensor sample from the bmc thread's sample list */
+int bmc_load_sample ( string & hostname, sensor_data_type & sensor_data , const bmc_sample_type & sample );
+
+/* Append the json form of a thread sample to 'json' ; debug logging only */
+void bmc_sample_to_json ( const bmc_sample_type & sample, string & json );
 
 #endif
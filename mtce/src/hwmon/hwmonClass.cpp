@@ -28,6 +28,7 @@ hwmonHostClass::hwmonHostClass()
     memory_used = 0 ;
     hwmon_head = NULL ;
     hwmon_tail = NULL ;
+    host_index.clear() ;
     hosts = 0 ;
     host_deleted = false ;
     config_reload = false ;
@@ -81,7 +82,6 @@ int hwmonHostClass::addStageChange ( struct hwmonHostClass::hwmon_host * ptr,
 /* Initialize bmc data for bmc mode monitoring */
 void hwmonHostClass::bmc_data_init ( struct hwmonHostClass::hwmon_host * host_ptr )
 {
-    host_ptr->ping_info.timer_handler = &hwmonTimer_handler ;
     host_ptr->accessible = false;
     host_ptr->degraded   = false ;
 
@@ -130,19 +130,24 @@ struct hwmonHostClass::hwmon_host* hwmonHostClass::addHost( string hostname )
     ptr->retries     = 0     ;
     ptr->delStage = HWMON_DEL__START ;
 
-    ptr->ping_info.timer_handler = &hwmonTimer_handler ;
     mtcTimer_init ( ptr->hostTimer,          ptr->hostname, "host timer" );
     mtcTimer_init ( ptr->addTimer,           ptr->hostname, "add timer"  );
     mtcTimer_init ( ptr->secretTimer,        ptr->hostname, "secret timer" );
     mtcTimer_init ( ptr->relearnTimer,       ptr->hostname, "relearn timer" );
 
-    mtcTimer_init ( ptr->ping_info.timer,    ptr->hostname, "ping monitor timer" );
     mtcTimer_init ( ptr->monitor_ctrl.timer, ptr->hostname, "sensor monitor timer") ;
 
     ptr->groups           = 0 ;
     ptr->sensors          = 0 ;
     ptr->samples          = 0 ;
 
+    ptr->sensor_index.clear();
+    ptr->sample_index.clear();
+    ptr->sensor_index_sensors = 0 ;
+    ptr->sample_index_samples = 0 ;
+    ptr->sensor_index_stale   = true ;
+    ptr->sensor_lookups       = 0 ;
+
     /* http event pre-init
      * PATCHBACK - consider patchback to REL3 and earlier */
     ptr->event.base = NULL ;
@@ -174,6 +179,7 @@ struct hwmonHostClass::hwmon_host* hwmonHostClass::addHost( string hostname )
         ptr->next  = NULL ;
         hwmon_tail = ptr ;
     }
+    host_index[ptr->hostname] = ptr ;
 
     /* Default to not monitoring */
     ptr->monitor        = false ;
@@ -193,10 +199,10 @@ void hwmonHostClass::free_host_timers ( struct hwmon_host * ptr )
     mtcTimer_fini ( ptr->addTimer );
     mtcTimer_fini ( ptr->secretTimer );
     mtcTimer_fini ( ptr->relearnTimer );
-    mtcTimer_fini ( ptr->ping_info.timer );
+    pingUtil_fini ( ptr->ping_info );
 
     mtcTimer_fini ( ptr->monitor_ctrl.timer );
-    mtcTimer_fini ( ptr->bmc_thread_ctrl.timer );
+    thread_fini   ( ptr->bmc_thread_ctrl, ptr->bmc_thread_info );
 }
 
 /* Remove a hist from the linked list of hosts - may require splice action */
@@ -248,6 +254,7 @@ int hwmonHostClass::remHost( string hostname )
         ptr->next->prev = ptr->prev ;
     }
 
+    host_index.erase ( ptr->hostname );
     hwmonHostClass::delHost ( ptr );
     hosts-- ;
     return (PASS) ;
@@ -256,22 +263,10 @@ int hwmonHostClass::remHost( string hostname )
 
 struct hwmonHostClass::hwmon_host* hwmonHostClass::getHost ( string hostname )
 {
-   /* check for empty list condition */
-   if ( hwmon_head == NULL )
-      return NULL ;
-
-   for ( struct hwmon_host * ptr = hwmon_head ;  ; ptr = ptr->next )
-   {
-       if ( !hostname.compare ( ptr->hostname ))
-       {
-           // dlog2 ("Fetched hwmonHostClass host instance %s\n", ptr->hostname.c_str());
-           return ptr ;
-       }
-
-       if (( ptr->next == NULL ) || ( ptr == hwmon_tail ))
-           break ;
-    }
-    return static_cast<struct hwmon_host *>(NULL);
+   std::unordered_map<string, struct hwmon_host *>::iterator it = host_index.find ( hostname );
+   if ( it == host_index.end() )
+      return static_cast<struct hwmon_host *>(NULL);
+   return it->second ;
 }
 
 /*
@@ -298,6 +293,12 @@ struct hwmonHostClass::hwmon_host * hwmonHostClass::newHost ( void )
           memory_allocs++ ;
           memory_used += sizeof (struct hwmonHostClass::hwmon_host);
 
+          /* the pair of sample lists swapped between the bmc thread and hwmond */
+          temp_host_ptr->bmc_sample_list = new bmc_sample_type[MAX_HOST_SENSORS] ;
+          temp_host_ptr->thread_extra_info.sample_list = new bmc_sample_type[MAX_HOST_SENSORS] ;
+          temp_host_ptr->thread_extra_info.samples = 0 ;
+          memory_used += 2*sizeof(bmc_sample_type)*MAX_HOST_SENSORS ;
+
           return temp_host_ptr ;
       }
    }
@@ -452,10 +453,13 @@ int hwmonHostClass::delHost ( struct hwmonHostClass::hwmon_host * host_ptr )
         {
             if ( hwmonHostClass::host_ptrs[i] == host_ptr )
             {
+                delete [] host_ptr->bmc_sample_list ;
+                delete [] host_ptr->thread_extra_info.sample_list ;
                 delete host_ptr ;
                 hwmonHostClass::host_ptrs[i] = NULL ;
                 hwmonHostClass::memory_allocs-- ;
                 hwmonHostClass::memory_used -= sizeof (struct hwmonHostClass::hwmon_host);
+                hwmonHostClass::memory_used -= 2*sizeof(bmc_sample_type)*MAX_HOST_SENSORS ;
                 return PASS ;
             }
         }
@@ -524,7 +528,6 @@ int hwmonHostClass::set_bm_prov ( struct hwmonHostClass::hwmon_host * host_ptr,
              * ---------------------------------------*/
 
             blog ("%s setting up ping socket\n", host_ptr->hostname.c_str() );
-            mtcTimer_reset ( host_ptr->ping_info.timer ) ;
             host_ptr->ping_info.stage    = PINGUTIL_MONITOR_STAGE__OPEN ;
             host_ptr->ping_info.ip       = host_ptr->bm_ip ;
             host_ptr->ping_info.hostname = host_ptr->hostname ;
@@ -763,9 +766,6 @@ int hwmonHostClass::add_host ( node_inv_type & inv )
             else
                 host_ptr->protocol = BMC_PROTOCOL__DYNAMIC ;
 
-            /* default the socket number to closed */
-            host_ptr->ping_info.sock = 0 ;
-
             host_ptr->quanta_server= false ;
 
             bmc_data_init ( host_ptr );
@@ -1065,10 +1065,6 @@ struct hwmonHostClass::hwmon_host * hwmonHostClass::getHost_timer ( timer_t tid
            {
                return host_ptr ;
            }
-           if ( host_ptr->ping_info.timer.tid == tid )
-           {
-               return host_ptr ;
-           }
            if ( host_ptr->monitor_ctrl.timer.tid == tid )
            {
                return host_ptr ;
@@ -1212,6 +1208,8 @@ int hwmonHostClass::add_sensor ( string hostname, sensor_type & sensor )
 
                 if ( found == false )
                     host_ptr->sensors++ ;
+
+                host_ptr->sensor_index_stale = true ;
             }
         }
     }
@@ -1543,6 +1541,7 @@ int hwmonHostClass::hwmon_del_sensors ( struct hwmonHostClass::hwmon_host * host
     host_ptr->profile_sensor_checksum =
     host_ptr->sample_sensor_checksum =
     host_ptr->last_sample_sensor_checksum = 0 ;
+    host_ptr->sensor_index_stale = true ;
     return (rc);
 }
 
@@ -8,6 +8,8 @@
 *
  */
 
+#include <unordered_map>
+
 #include "nodeBase.h"      /* for ...                                  */
 #include "hostUtil.h"      /* for ... server_enum                      */
 #include "httpUtil.h"      /* for ... libEvent                         */
@@ -130,9 +132,14 @@ class hwmonHostClass
 
         int want_degrade_audit ;
 
-        /* the last json string containing the last read sensor data */
+        /* the last json string containing the last read sensor data ;
+         * only produced by the thread when bmgmt debug lane 8 is on */
         string     json_bmc_sensors ;
 
+        /* sample list of the last completed sensor read. It is swapped
+         * with thread_extra_info.sample_list after every read. */
+        bmc_sample_type  * bmc_sample_list ;
+
         int          sensors ; /**< # of sensors in the sysinv database        */
         int          samples ; /**< # of parsed samples from the reader thread */
         /*
@@ -144,6 +151,14 @@ class hwmonHostClass
 
         sensor_data_type   sample[MAX_HOST_SENSORS] ; /* last read analog samples */
 
+        /* sensor and sample name to list index maps ; see bmc_find_sensor */
+        std::unordered_map<string,int> sensor_index ;
+        std::unordered_map<string,int> sample_index ;
+        int          sensor_index_sensors ; /**< sensors when sensor_index was built */
+        int          sample_index_samples ; /**< samples in sample_index             */
+        bool         sensor_index_stale   ; /**< set on sensor model change          */
+        unsigned int sensor_lookups       ; /**< name lookups of the last audit      */
+
         /*
          *  Sequential checksum of all the sensor names in ther various
          *  sensor lists. See hwmonUtil.cpp for checksum utilities or
@@ -232,6 +247,10 @@ class hwmonHostClass
     struct hwmon_host * hwmon_head ; /**< Host Linked List Head pointer */
     struct hwmon_host * hwmon_tail ; /**< Host Linked List Tail pointer */
 
+    /** Host lookup index ; maps each host's name to its host struct.
+     *  Maintained by addHost and remHost. */
+    std::unordered_map<string, struct hwmon_host *> host_index ;
+
     struct hwmonHostClass::hwmon_host* newHost ( void );
     struct hwmonHostClass::hwmon_host* addHost ( string hostname );
     struct hwmonHostClass::hwmon_host* getHost ( string hostname );
@@ -335,9 +354,13 @@ class hwmonHostClass
      *                              sample severity level for the specified host.
      *
      *************************************************************************/
-    int  bmc_load_sensor_samples ( struct hwmonHostClass::hwmon_host * host_ptr, char * msg_ptr );
+    int  bmc_load_sensor_samples ( struct hwmonHostClass::hwmon_host * host_ptr );
     int  bmc_update_sensors      ( struct hwmonHostClass::hwmon_host * host_ptr );
 
+    /* sensor[] and sample[] index of the named sensor or -1 */
+    int  bmc_find_sensor ( struct hwmonHostClass::hwmon_host * host_ptr, const string & name );
+    int  bmc_find_sample ( struct hwmonHostClass::hwmon_host * host_ptr, const string & name );
+
     /**************************************************************************
      *
      * Name   : manage_startup_states
@@ -448,6 +471,7 @@ class hwmonHostClass
     system_type_enum system_type ;
 
     void timer_handler ( int sig, siginfo_t *si, void *uc);
+    bool timer_handler_host ( struct hwmonHostClass::hwmon_host * host_ptr, struct mtc_timer * fired );
 
     /** This is a list of host names. */
     std::list<string>           hostlist ;
@@ -167,6 +167,49 @@ void daemon_sigchld_hdlr ( void )
 }
 
 
+/* Asserts the ringer of the host timer that fired ; false if the
+ * timer does not belong to this host */
+bool hwmonHostClass::timer_handler_host ( struct hwmonHostClass::hwmon_host * host_ptr,
+                                          struct mtc_timer * fired )
+{
+    if ( fired == &host_ptr->monitor_ctrl.timer )
+    {
+        mtcTimer_stop_int_safe ( host_ptr->monitor_ctrl.timer );
+        host_ptr->monitor_ctrl.timer.ring = true ;
+    }
+    else if ( fired == &host_ptr->bmc_thread_ctrl.timer )
+    {
+        mtcTimer_stop_int_safe ( host_ptr->bmc_thread_ctrl.timer );
+        host_ptr->bmc_thread_ctrl.timer.ring = true ;
+    }
+    else if ( fired == &host_ptr->hostTimer )
+    {
+        mtcTimer_stop_int_safe ( host_ptr->hostTimer );
+        host_ptr->hostTimer.ring = true ;
+    }
+    else if ( fired == &host_ptr->addTimer )
+    {
+        mtcTimer_stop_int_safe ( host_ptr->addTimer );
+        host_ptr->addTimer.ring = true ;
+    }
+    else if ( fired == &host_ptr->relearnTimer )
+    {
+        mtcTimer_stop_int_safe ( host_ptr->relearnTimer );
+        host_ptr->relearnTimer.ring = true ;
+        host_ptr->relearn = false ;
+    }
+    else if ( fired == &host_ptr->secretTimer )
+    {
+        mtcTimer_stop_int_safe ( host_ptr->secretTimer );
+        host_ptr->secretTimer.ring = true ;
+    }
+    else
+    {
+        return (false);
+    }
+    return (true);
+}
+
 /* Looks up the timer ID and asserts the corresponding ringer */
 void hwmonHostClass::timer_handler ( int sig, siginfo_t *si, void *uc)
 {
@@ -207,57 +250,26 @@ void hwmonHostClass::timer_handler ( int sig, siginfo_t *si, void *uc)
         return ;
     }
 #endif
-    else
+
+    /* Timer wheel timers are dispatched at base level rather than from
+     * a signal so the owning host can be found through the host index
+     * rather than by searching every timer of every host. */
+    if ( fired->wheel == true )
     {
-        for ( hwmon_host_ptr = hwmon_head ; hwmon_host_ptr != NULL ; hwmon_host_ptr = hwmon_host_ptr->next )
-        {
-            if ( fired == &hwmon_host_ptr->monitor_ctrl.timer )
-            {
-                mtcTimer_stop_int_safe ( hwmon_host_ptr->monitor_ctrl.timer );
-                hwmon_host_ptr->monitor_ctrl.timer.ring = true ;
-                return ;
-            }
-            else if ( fired == &hwmon_host_ptr->bmc_thread_ctrl.timer )
-            {
-                mtcTimer_stop_int_safe ( hwmon_host_ptr->bmc_thread_ctrl.timer );
-                hwmon_host_ptr->bmc_thread_ctrl.timer.ring = true ;
-                return ;
-            }
-            else if ( fired == &hwmon_host_ptr->ping_info.timer )
-            {
-                mtcTimer_stop_int_safe ( hwmon_host_ptr->ping_info.timer );
-                hwmon_host_ptr->ping_info.timer.ring = true ;
-                return ;
-            }
-            else if ( fired == &hwmon_host_ptr->hostTimer )
-            {
-                mtcTimer_stop_int_safe ( hwmon_host_ptr->hostTimer );
-                hwmon_host_ptr->hostTimer.ring = true ;
-                return ;
-            }
-            else if ( fired == &hwmon_host_ptr->addTimer )
-            {
-                mtcTimer_stop_int_safe ( hwmon_host_ptr->addTimer );
-                hwmon_host_ptr->addTimer.ring = true ;
-                return ;
-            }
-            else if ( fired == &hwmon_host_ptr->relearnTimer )
-            {
-                mtcTimer_stop_int_safe ( hwmon_host_ptr->relearnTimer );
-                hwmon_host_ptr->relearnTimer.ring = true ;
-                hwmon_host_ptr->relearn = false ;
-                return ;
-            }
-            else if ( fired == &hwmon_host_ptr->secretTimer )
-            {
-                mtcTimer_stop_int_safe ( hwmon_host_ptr->secretTimer );
-                hwmon_host_ptr->secretTimer.ring = true ;
-                return ;
-            }
+        hwmon_host_ptr = getHost ( fired->hostname );
+        if (( hwmon_host_ptr ) && ( timer_handler_host ( hwmon_host_ptr, fired ) == true ))
+            return ;
+    }
 
-            if ( hwmon_host_ptr->next == NULL )
-                break ;
-        }
+    /* posix timers, which may fire in signal context, and any timer
+     * not filed under its host's name are found by search */
+    for ( hwmon_host_ptr = hwmon_head ; hwmon_host_ptr != NULL ; hwmon_host_ptr = hwmon_host_ptr->next )
+    {
+        if ( timer_handler_host ( hwmon_host_ptr, fired ) == true )
+            return ;
+
+        if ( hwmon_host_ptr->next == NULL )
+            break ;
     }
     mtcTimer_stop_tid_int_safe (&fired->tid);
 }
@@ -266,11 +278,28 @@ void hwmonHostClass::timer_handler ( int sig, siginfo_t *si, void *uc)
 bool toggle = false ;
 #endif
 
+/* Main loop reactor handler for the command receiver socket */
+static void _reactor_cmd ( int fd, void * ctx )
+{
+    UNUSED(fd); UNUSED(ctx);
+    int rc = hwmon_service_inbox ();
+    if ( rc > RETRY )
+    {
+        elog ("Failure servicing inbox (rc:%d)\n", rc);
+    }
+}
+
+/* Main loop reactor handler for the timer wheel tick */
+static void _reactor_wheel ( int fd, void * ctx )
+{
+    UNUSED(fd); UNUSED(ctx);
+    mtcTimer_wheel_service ();
+}
+
 void hwmon_service ( hwmon_ctrl_type * ctrl_ptr )
 {
-    std::list<int> socks ;
-    struct timeval waitd;
-    fd_set readfds;
+    /* the command socket fd registered with the reactor */
+    int cmd_fd = 0 ;
 
     daemon_config_type * config_ptr = daemon_get_cfg_ptr();
     hwmon_socket_type  * sock_ptr   = getSock_ptr();
@@ -279,6 +308,10 @@ void hwmon_service ( hwmon_ctrl_type * ctrl_ptr )
     hostInv.hostBase.my_local_ip = ctrl_ptr->my_local_ip ;
     hostInv.hostBase.my_float_ip = ctrl_ptr->my_float_ip ;
 
+    /* Run this daemon's timers off the timer wheel rather than
+     * with a posix timer and signal per timer */
+    mtcTimer_wheel_init ();
+
     if ( config_ptr->token_refresh_rate )
     {
         if ( config_ptr->token_refresh_rate < 300 )
@@ -302,68 +335,45 @@ void hwmon_service ( hwmon_ctrl_type * ctrl_ptr )
 
     // client_len = sizeof(client_addr);
 
-    socks.clear();
-    if ( sock_ptr->cmd_sock )
+    if ( daemon_reactor_init () != PASS )
     {
-        socks.push_front (sock_ptr->cmd_sock->getFD());
+        elog ("Failed to create main loop reactor\n");
+        daemon_exit ();
     }
-    else
+    if ( mtcTimer_wheel_enabled () )
+        daemon_reactor_add ( mtcTimer_wheel_fd(), _reactor_wheel );
+    if ( sock_ptr->cmd_sock == NULL )
     {
         elog ("cannot service Null cmd_sock\n");
     }
 
-    socks.sort();
-
     ilog ("Starting 'Audit' timer (%d secs)\n", ctrl_ptr->audit_period );
     mtcTimer_start ( hwmonTimer_audit, hwmonTimer_handler, ctrl_ptr->audit_period );
 
     for ( ; ; )
     {
-        /* Initialize the master fd_set */
-        FD_ZERO(&readfds);
-
-        /* add the command receiver socket ro the FD set mask */
+        /* the command socket is registered with the reactor once ;
+         * only again if it is recreated with a new fd */
         if ( sock_ptr->cmd_sock )
         {
-            if ( sock_ptr->cmd_sock->getFD())
+            int fd = sock_ptr->cmd_sock->getFD() ;
+            if ( fd != cmd_fd )
             {
-                FD_SET(sock_ptr->cmd_sock->getFD(), &readfds);
+                if ( cmd_fd )
+                    daemon_reactor_del ( cmd_fd );
+                if ( fd )
+                    daemon_reactor_add ( fd, _reactor_cmd );
+                cmd_fd = fd ;
             }
-            else
+            if ( fd == 0 )
             {
                 /* force a re-init if we have no FD */
                 sock_ptr->cmd_sock->sock_ok(false);
             }
         } /* Null sockts are auto recovered below */
 
-        waitd.tv_sec  = 0;
-        waitd.tv_usec = (SOCKET_WAIT*3) ;
-
-        /* This is used as a delay up to select_timeout */
-        int rc = select( socks.back()+1, &readfds, NULL, NULL, &waitd);
-
-        /* If the select time out expired then  */
-        if (( rc < 0 ) || ( rc == 0 ))
-        {
-            /* Check to see if the select call failed. */
-            /* ... but filter Interrupt signal         */
-            if (( rc < 0 ) && ( errno != EINTR ))
-            {
-                elog ( "Select Failed (rc:%d) %s \n", errno, strerror(errno));
-            }
-        }
-        else if ( FD_ISSET(sock_ptr->cmd_sock->getFD(), &readfds))
-        {
-            rc = hwmon_service_inbox ();
-            if ( rc > RETRY )
-            {
-                elog ("Failure servicing inbox (rc:%d)\n", rc);
-            }
-        }
-        else
-        {
-            wlog ("unexpected select (%d)\n", rc );
-        }
+        /* Wait up to the select timeout for and dispatch the ready fds */
+        daemon_reactor_run ( (SOCKET_WAIT*3)/1000 );
 
         if ( hwmonTimer_audit.ring == true )
         {
@@ -395,6 +405,9 @@ void hwmon_service ( hwmon_ctrl_type * ctrl_ptr )
         /* Run the FSM */
         hostInv.hwmon_fsm ( ) ;
 
+        /* send the bmc pings queued by this fsm pass */
+        pingUtil_service ();
+
         daemon_signal_hdlr ();
 
         daemon_load_fit ( );
@@ -1139,7 +1152,7 @@ int hwmonHostClass::bmc_sensor_monitor ( struct hwmonHostClass::hwmon_host * hos
              *  1. Wait for the bmc command completion from the READ stage
              *     while monitoring for and handling the unbrella timeout case.
              *
-             *  2. PARSE the sensor data json string into the sample list
+             *  2. LOAD the thread's sample list into the sample list
              *
              *          sample[MAX_HOST_SENSORS]
              *
@@ -1245,70 +1258,35 @@ int hwmonHostClass::bmc_sensor_monitor ( struct hwmonHostClass::hwmon_host * hos
                     if ( daemon_want_fit ( FIT_CODE__HWMON__NO_DATA, host_ptr->hostname ))
                     {
                         host_ptr->bmc_thread_info.data.clear ();
-                        host_ptr->bmc_thread_info.status = 0 ;
-                        host_ptr->bmc_thread_info.status_string.clear ();
+                        host_ptr->bmc_thread_info.status = FAIL_NO_DATA ;
+                        host_ptr->bmc_thread_info.status_string = "no sensor data" ;
                     }
 #endif
 
                     if ( host_ptr->bmc_thread_info.status == PASS )
                     {
-                        /* NOTE: This parsing method is not leaking memory ; verified ! */
+                        /* the thread only produces the json form for debug */
+                        host_ptr->json_bmc_sensors = host_ptr->bmc_thread_info.data ;
 
-                        json_bool status ;
-                        struct json_object * raw_obj = json_tokener_parse( host_ptr->bmc_thread_info.data.data() );
-                        if ( raw_obj )
+                        host_ptr->bmc_thread_info.status = bmc_load_sensor_samples ( host_ptr );
+                        if ( host_ptr->bmc_thread_info.status == PASS )
                         {
-                            /* Look for ... BMC_JSON__SENSOR_DATA_MESSAGE_HEADER */
-                            struct json_object * req_obj = (struct json_object *)(NULL) ;
-                            status = json_object_object_get_ex ( raw_obj, BMC_JSON__SENSOR_DATA_MESSAGE_HEADER, &req_obj );
-                            if (( status == true ) && req_obj )
+                            if ( host_ptr->samples != host_ptr->sensors )
                             {
-                                char * msg_ptr = (char*)json_object_to_json_string(req_obj) ;
-                                host_ptr->json_bmc_sensors = msg_ptr ;
-                                if ( msg_ptr )
-                                {
-                                    host_ptr->bmc_thread_info.status = bmc_load_sensor_samples ( host_ptr , msg_ptr);
-                                    if ( host_ptr->bmc_thread_info.status == PASS )
-                                    {
-                                        if ( host_ptr->samples != host_ptr->sensors )
-                                        {
-                                            if ( host_ptr->quanta_server == false )
-                                            {
-                                                blog ("%s read %d sensor samples but expected %d\n",
-                                                          host_ptr->hostname.c_str(),
-                                                          host_ptr->samples,
-                                                          host_ptr->sensors );
-                                            }
-                                        }
-                                        _stage_change ( host_ptr->hostname, host_ptr->monitor_ctrl.stage, HWMON_SENSOR_MONITOR__CHECK );
-
-                                    }
-                                    else
-                                    {
-                                        host_ptr->bmc_thread_info.status_string = "failed to load sensor data" ;
-                                    }
-                                }
-                                else
+                                if ( host_ptr->quanta_server == false )
                                 {
-                                    host_ptr->bmc_thread_info.status_string = "failed to get json message after header" ;
-                                    host_ptr->bmc_thread_info.status = FAIL_JSON_PARSE ;
+                                    blog ("%s read %d sensor samples but expected %d\n",
+                                              host_ptr->hostname.c_str(),
+                                              host_ptr->samples,
+                                              host_ptr->sensors );
                                 }
                             }
-                            else
-                            {
-                                host_ptr->bmc_thread_info.status_string = "failed to find '" ;
-                                host_ptr->bmc_thread_info.status_string.append(BMC_JSON__SENSOR_DATA_MESSAGE_HEADER);
-                                host_ptr->bmc_thread_info.status_string.append("' label") ;
-                                host_ptr->bmc_thread_info.status = FAIL_JSON_PARSE ;
-                            }
+                            _stage_change ( host_ptr->hostname, host_ptr->monitor_ctrl.stage, HWMON_SENSOR_MONITOR__CHECK );
                         }
                         else
                         {
-                            host_ptr->bmc_thread_info.status_string = "failed to parse bmc sensor data string" ;
-                            host_ptr->bmc_thread_info.status = FAIL_JSON_PARSE ;
+                            host_ptr->bmc_thread_info.status_string = "failed to load sensor data" ;
                         }
-
-                        if (raw_obj) json_object_put(raw_obj);
                     }
 
                     if ( host_ptr->bmc_thread_info.status )
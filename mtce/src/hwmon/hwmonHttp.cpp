@@ -143,13 +143,24 @@ int hwmonJson_load_sensor ( string hostname , string sensor_record , sensor_type
     {
         jlog ("Event Payload: %s", sensor_record.c_str());
 
-        struct json_object *json_obj = json_tokener_parse((char*)sensor_record.data());
-        if ( !json_obj )
+        jsonUtil_doc_type doc ;
+        if ( jsonUtil_doc_parse ( doc, sensor_record.data() ) != PASS )
         {
             elog ("%s No or invalid sysinv sensor record\n", hostname.c_str());
             return (FAIL_JSON_PARSE);
         }
+        rc = hwmonJson_load_sensor ( hostname, doc.root, sensor );
+    }
+    return (rc);
+}
 
+/* Load a sensor from an already parsed sysinv sensor record object */
+int hwmonJson_load_sensor ( string hostname , struct json_object * json_obj , sensor_type & sensor )
+{
+    int rc = FAIL_JSON_PARSE ;
+
+    if ( json_obj )
+    {
         /* Get all required fields */
         sensor.uuid           = jsonUtil_get_key_value_string ( json_obj, MTC_JSON_INV_UUID );
         sensor.group_uuid     = jsonUtil_get_key_value_string ( json_obj, "sensorgroup_uuid");
@@ -216,10 +227,12 @@ int hwmonJson_load_sensor ( string hostname , string sensor_record , sensor_type
             sensor.unit_rate        = jsonUtil_get_key_value_string ( json_obj, "unit_rate" );
             sensor.unit_modifier    = jsonUtil_get_key_value_string ( json_obj, "unit_modifier" );
         }
-
-        if (json_obj) json_object_put(json_obj);
         rc = PASS ;
     }
+    else
+    {
+        elog ("%s No or invalid sysinv sensor record\n", hostname.c_str());
+    }
     return (rc);
 }
 
@@ -231,12 +244,24 @@ int hwmonJson_load_group ( string hostname , string group_record , struct sensor
     {
         jlog ("Event Payload: %s", group_record.c_str());
 
-        struct json_object *json_obj = json_tokener_parse((char*)group_record.data());
-        if ( !json_obj )
+        jsonUtil_doc_type doc ;
+        if ( jsonUtil_doc_parse ( doc, group_record.data() ) != PASS )
         {
             elog ("%s No or invalid sysinv sensor group record\n", hostname.c_str());
             return (FAIL_JSON_PARSE);
         }
+        rc = hwmonJson_load_group ( hostname, doc.root, group );
+    }
+    return (rc);
+}
+
+/* Load a sensor group from an already parsed sysinv group record object */
+int hwmonJson_load_group ( string hostname , struct json_object * json_obj , struct sensor_group_type & group )
+{
+    int rc = FAIL_JSON_PARSE ;
+
+    if ( json_obj )
+    {
         /* Get all required fields */
         group.group_name          = jsonUtil_get_key_value_string ( json_obj, "sensorgroupname" );
         group.actions_minor_group = jsonUtil_get_key_value_string ( json_obj, "actions_minor_group"   );
@@ -290,10 +315,12 @@ int hwmonJson_load_group ( string hostname , string group_record , struct sensor
         group.actions_minor_choices = jsonUtil_get_key_value_string ( json_obj, "actions_minor_choices");
         group.actions_major_choices = jsonUtil_get_key_value_string ( json_obj, "actions_major_choices");
         group.actions_critical_choices = jsonUtil_get_key_value_string ( json_obj, "actions_critical_choices");
-
-        if (json_obj) json_object_put(json_obj);
         rc = PASS ;
     }
+    else
+    {
+        elog ("%s No or invalid sysinv sensor group record\n", hostname.c_str());
+    }
     return (rc);
 }
 
@@ -1183,9 +1210,6 @@ int hwmonHttp_handler ( libEvent & event )
 
     hlog ("%s handler called\n", event.log_prefix.c_str() );
 
-    /* request shared  string iterator */
-    std::list<string>::iterator iter_curr_ptr ;
-
     if ( event.status != PASS )
     {
         elog ("%s handler request (%d) failed (rc:%d)", event.log_prefix.c_str(), event.request, event.status);
@@ -1207,22 +1231,26 @@ int hwmonHttp_handler ( libEvent & event )
     {
         if ( event.status == PASS )
         {
-            std::list<string> sensor_list ;
-            sensor_list.clear();
-
-            rc = jsonUtil_get_list ( (char*)event.response.data(), SYSINV_ISENSOR_LABEL, sensor_list );
+            /* Parse the sensor list once and load each sensor from its object */
+            jsonUtil_doc_type doc ;
+            int sensors = 0 ;
+            struct json_object * sensors_obj = (struct json_object *)(NULL);
+
+            rc = jsonUtil_doc_parse ( doc, event.response.data() );
+            if (( rc == PASS ) && ( !jsonUtil_get_key_object ( doc.root, SYSINV_ISENSOR_LABEL )))
+                rc = FAIL_JSON_OBJECT ;
             if ( rc == PASS )
             {
-                hlog ("%s has %ld sensors in the database\n", hn.c_str(), sensor_list.size() );
+                sensors_obj = jsonUtil_get_array ( doc.root, SYSINV_ISENSOR_LABEL, sensors );
+                hlog ("%s has %d sensors in the database\n", hn.c_str(), sensors );
                 sensor_type sysinv_sensor ;
 
                 /* Load the list of sensors for this host */
-                for ( iter_curr_ptr  = sensor_list.begin();
-                      iter_curr_ptr != sensor_list.end() ;
-                    ++iter_curr_ptr )
+                for ( int i = 0 ; i < sensors ; i++ )
                 {
+                    struct json_object * sensor_obj = jsonUtil_get_array_obj ( sensors_obj, i );
                     hwmonSensor_init ( hn, &sysinv_sensor );
-                    rc = hwmonJson_load_sensor ( hn, iter_curr_ptr->data(), sysinv_sensor );
+                    rc = hwmonJson_load_sensor ( hn, sensor_obj, sysinv_sensor );
                     if ( rc == PASS )
                     {
                         blog2 ("%s '%s' sensor read (from sysinv)\n", hn.c_str(), sysinv_sensor.sensorname.c_str() );
@@ -1246,7 +1274,7 @@ int hwmonHttp_handler ( libEvent & event )
                         elog ("%s failed parsing sensor record (from sysinv)\n", hn.c_str());
                         wlog ("%s ... Raw Sensor Record: \n%s\n",
                                   event.log_prefix.c_str(),
-                                  iter_curr_ptr->c_str());
+                                  json_object_get_string(sensor_obj));
                         event.status = rc =  FAIL_JSON_PARSE ;
                         break ;
                     }
@@ -1359,24 +1387,28 @@ int hwmonHttp_handler ( libEvent & event )
     {
         if ( event.status == PASS )
         {
-            std::list<string> group_list ;
-            group_list.clear();
-
-            rc = jsonUtil_get_list ( (char*)event.response.data(), SYSINV_ISENSORGROUPS_LABEL, group_list );
+            /* Parse the group list once and load each group from its object */
+            jsonUtil_doc_type doc ;
+            int groups = 0 ;
+            struct json_object * groups_obj = (struct json_object *)(NULL);
+
+            rc = jsonUtil_doc_parse ( doc, event.response.data() );
+            if (( rc == PASS ) && ( !jsonUtil_get_key_object ( doc.root, SYSINV_ISENSORGROUPS_LABEL )))
+                rc = FAIL_JSON_OBJECT ;
             if ( rc == PASS )
             {
-                hlog ("%s has %ld sensor groups in the database\n", hn.c_str(), group_list.size() );
+                groups_obj = jsonUtil_get_array ( doc.root, SYSINV_ISENSORGROUPS_LABEL, groups );
+                hlog ("%s has %d sensor groups in the database\n", hn.c_str(), groups );
 
                 struct sensor_group_type sysinv_group ;
 
                 /* Load the list of sensors for this host */
-                for ( iter_curr_ptr  = group_list.begin();
-                      iter_curr_ptr != group_list.end() ;
-                    ++iter_curr_ptr )
+                for ( int i = 0 ; i < groups ; i++ )
                 {
+                    struct json_object * group_obj = jsonUtil_get_array_obj ( groups_obj, i );
                     sysinv_group.timer.tid = NULL ;
                     hwmonGroup_init ( hn, &sysinv_group );
-                    rc = hwmonJson_load_group ( hn, iter_curr_ptr->data(), sysinv_group );
+                    rc = hwmonJson_load_group ( hn, group_obj, sysinv_group );
                     if ( rc == PASS )
                     {
                         blog ("%s '%s' sensor group read (from sysinv) [uuid:%s]\n",
@@ -1408,7 +1440,7 @@ int hwmonHttp_handler ( libEvent & event )
                         elog ("%s failed parsing sensor group record (from sysinv)\n", hn.c_str());
                         wlog ("%s ... Raw Group Record: \n%s\n",
                                   event.log_prefix.c_str(), 
-                                  iter_curr_ptr->c_str());
+                                  json_object_get_string(group_obj));
                         event.status = rc =  FAIL_JSON_PARSE ;
                         break ;
                     }
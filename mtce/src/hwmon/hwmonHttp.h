@@ -89,4 +89,11 @@ int  hwmonHttp_load_groups  ( string & hostname, libEvent & event );
 int  
 hwmonHttp_group_sensors( string & hostname, libEvent & event, string & group_uuid, string & sensor_list );
 
+/* Load a sysinv sensor or sensor group record from its json string or
+ * from an already parsed record object of a sysinv list response */
+int  hwmonJson_load_sensor  ( string hostname, string sensor_record, sensor_type & sensor );
+int  hwmonJson_load_sensor  ( string hostname, struct json_object * json_obj, sensor_type & sensor );
+int  hwmonJson_load_group   ( string hostname, string group_record, struct sensor_group_type & group );
+int  hwmonJson_load_group   ( string hostname, struct json_object * json_obj, struct sensor_group_type & group );
+
 #endif /* __INCLUDE_HWMONHTTP_H__ */
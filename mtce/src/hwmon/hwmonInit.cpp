@@ -18,6 +18,17 @@
 #include "hwmonClass.h"    /* for ... get_hwmonHostClass_ptr         */
 #include "hwmonHttp.h"     /* for ... hwmonHttp_server_fini          */
 #include "tokenUtil.h"     /* for ... keystone_config_handler        */
+#include "jsonUtil.h"      /* for ... jsonUtil_doc_parse             */
+#include "hwmonBmc.h"      /* for ... bmc_load_json_sensor           */
+#include "hwmonSensor.h"   /* for ... hwmonSensor_init               */
+#include "hwmonThreads.h"  /* for ... BMC_JSON__SENSORS_LABEL        */
+#include "redfishClient.h" /* for ... redfishClient_command           */
+
+#include <arpa/inet.h>            /* for ... ntohs                   */
+#include <event2/event.h>         /* for ... event_base_new          */
+#include <event2/http.h>          /* for ... evhttp_new              */
+#include <event2/buffer.h>        /* for ... evbuffer_add_printf     */
+#include <event2/keyvalq_struct.h>
 
 /* Process Monitor Control Structure */
 static hwmon_ctrl_type hwmon_ctrl ;
@@ -105,6 +116,16 @@ static int mtc_config_handler ( void * user,
         config_ptr->daemon_log_port = atoi(value);
         ilog("mtclogd port: %d (tx)\n", config_ptr->daemon_log_port );
     }
+    else if (MATCH("agent", "redfish_native_hosts"))
+    {
+        config_ptr->redfish_native_hosts = strdup(value);
+        ilog("Redfish Clnt: %s\n", config_ptr->redfish_native_hosts );
+    }
+    else if (MATCH("agent", "bmc_workers"))
+    {
+        config_ptr->bmc_workers = atoi(value);
+        threadUtil_workers ( config_ptr->bmc_workers );
+    }
 
    return (PASS);
 }
@@ -398,6 +419,8 @@ void daemon_dump_info ( void )
 {
     daemon_dump_membuf_banner ();
 
+    threadUtil_workers_dump ();
+    daemon_reactor_dump ();
     get_hwmonHostClass_ptr()->memDumpAllState ();
 
     daemon_dump_membuf (); /* write mem_logs to log file and clear log list */
@@ -409,9 +432,477 @@ const char * daemon_stream_info ( void )
     return (&MY_DATA[0]);
 }
 
+/*****************************************************************************
+ *
+ * Test Head : JSON parse benchmark
+ *
+ * Builds a sysinv 'isensors' list response and a bmc sensor sample
+ * response, each with 'sensors' records, and loads them 'loops' times
+ * through both the string based utilities, which reparse the response
+ * for every record, and the parse-once document handle. Both must load
+ * the same sensors ; the elapsed time of each is printed.
+ *
+ *****************************************************************************/
+
+static unsigned long _testhead_usecs ( struct timespec & start )
+{
+    struct timespec now ;
+    clock_gettime ( CLOCK_MONOTONIC, &now );
+    return ((now.tv_sec - start.tv_sec) * 1000000 +
+            (now.tv_nsec - start.tv_nsec) / 1000 );
+}
+
+static string _testhead_sysinv_sensors ( int sensors )
+{
+    string json = "{\"" ;
+    json.append(SYSINV_ISENSOR_LABEL);
+    json.append("\": [");
+    for ( int i = 0 ; i < sensors ; i++ )
+    {
+        char record[1024] ;
+        snprintf ( record, sizeof(record),
+            "%s{\"t_critical_upper\": null, \"actions_minor\": \"ignore\", "
+            "\"sensorname\": \"Volt_P%d\", \"links\": [{\"href\": "
+            "\"http://192.168.204.2:6385/v1/isensors/2bc0ac2c-d0f1-4cbe-9eac-%012d\", "
+            "\"rel\": \"self\"}], \"path\": \"/etc/bmc/server_profiles.d/sensor.profile\", "
+            "\"t_major_lower\": null, \"uuid\": \"2bc0ac2c-d0f1-4cbe-9eac-%012d\", "
+            "\"t_minor_upper\": null, \"capabilities\": {}, \"actions_critical\": \"alarm\", "
+            "\"state\": \"enabled\", \"sensorgroup_uuid\": \"8da729d7-168c-4f81-9616-d420b9e4d1e6\", "
+            "\"t_major_upper\": null, \"actions_major\": \"log\", \"status\": \"offline\", "
+            "\"suppress\": \"False\", \"sensortype\": \"voltage\", \"t_critical_lower\": null, "
+            "\"t_minor_lower\": null, \"unit_rate\": null, \"unit_modifier\": null, "
+            "\"host_uuid\": \"44a462f0-56d2-47c7-a3e6-30f60df54e6c\", \"unit_base\": null, "
+            "\"algorithm\": \"debounce-1.v1\", \"datatype\": \"discrete\", "
+            "\"audit_interval\": 300}",
+            i ? ", " : "", i, i, i );
+        json.append(record);
+    }
+    json.append("]}");
+    return (json);
+}
+
+static string _testhead_bmc_samples ( int samples )
+{
+    string json = "{\"" ;
+    json.append(BMC_JSON__SENSORS_LABEL);
+    json.append("\":[");
+    for ( int i = 0 ; i < samples ; i++ )
+    {
+        char record[256] ;
+        snprintf ( record, sizeof(record),
+            "%s{\"n\":\"Volt_P%d\",\"v\":\"12.%d\",\"u\":\"Volts\",\"s\":\"ok\","
+            "\"lnr\":\"na\",\"lcr\":\"10.2\",\"lnc\":\"na\","
+            "\"unr\":\"na\",\"ucr\":\"13.8\",\"unc\":\"na\"}",
+            i ? "," : "", i, i%10 );
+        json.append(record);
+    }
+    json.append("]}");
+    return (json);
+}
+
+static int _testhead_json_parse ( int sensors, int loops )
+{
+    int rc = PASS ;
+    string hostname = "testhost" ;
+    string inv_json = _testhead_sysinv_sensors ( sensors );
+    string bmc_json = _testhead_bmc_samples ( sensors );
+    vector<string> names_reparse ;
+    vector<string> names_once ;
+    struct timespec start ;
+    sensor_type sensor ;
+    sensor_data_type sample ;
+
+    /* string based ; every record reparses the response */
+    clock_gettime ( CLOCK_MONOTONIC, &start );
+    for ( int l = 0 ; l < loops ; l++ )
+    {
+        list<string> record_list ;
+        jsonUtil_get_list ( (char*)inv_json.data(), SYSINV_ISENSOR_LABEL, record_list );
+        for ( list<string>::iterator it = record_list.begin() ; it != record_list.end() ; ++it )
+        {
+            hwmonSensor_init ( hostname, &sensor );
+            if ( hwmonJson_load_sensor ( hostname, *it, sensor ) == PASS && l == 0 )
+                names_reparse.push_back ( sensor.sensorname );
+        }
+        int samples = 0 ;
+        jsonUtil_array_elements ( (char*)bmc_json.data(), BMC_JSON__SENSORS_LABEL, samples );
+        for ( int i = 0 ; i < samples ; i++ )
+        {
+            string record ;
+            jsonUtil_get_array_idx ( (char*)bmc_json.data(), BMC_JSON__SENSORS_LABEL, i, record );
+            if ( bmc_load_json_sensor ( hostname, sample, record ) == PASS && l == 0 )
+                names_reparse.push_back ( sample.name );
+        }
+    }
+    unsigned long reparse_usecs = _testhead_usecs ( start );
+
+    /* parse-once document handle */
+    clock_gettime ( CLOCK_MONOTONIC, &start );
+    for ( int l = 0 ; l < loops ; l++ )
+    {
+        jsonUtil_doc_type doc ;
+        int records = 0 ;
+        jsonUtil_doc_parse ( doc, inv_json.data() );
+        struct json_object * array_obj = jsonUtil_get_array ( doc.root, SYSINV_ISENSOR_LABEL, records );
+        for ( int i = 0 ; i < records ; i++ )
+        {
+            hwmonSensor_init ( hostname, &sensor );
+            if ( hwmonJson_load_sensor ( hostname, jsonUtil_get_array_obj ( array_obj, i ), sensor ) == PASS && l == 0 )
+                names_once.push_back ( sensor.sensorname );
+        }
+        jsonUtil_doc_parse ( doc, bmc_json.data() );
+        array_obj = jsonUtil_get_array ( doc.root, BMC_JSON__SENSORS_LABEL, records );
+        for ( int i = 0 ; i < records ; i++ )
+        {
+            if ( bmc_load_json_sensor ( hostname, sample, jsonUtil_get_array_obj ( array_obj, i )) == PASS && l == 0 )
+                names_once.push_back ( sample.name );
+        }
+    }
+    unsigned long once_usecs = _testhead_usecs ( start );
+
+    if (( names_once.size() != (size_t)(sensors*2) ) || ( names_once != names_reparse ))
+        rc = FAIL ;
+
+    printf ("| json load %3d sensors x%d : reparse %7lu usec : parse-once %6lu usec | ",
+             sensors, loops, reparse_usecs, once_usecs );
+    return (rc);
+}
+
+/*****************************************************************************
+ *
+ * Test Head : Sensor sample handoff benchmark
+ *
+ * Fills a bmc thread sample list with 'sensors' samples and hands it to
+ * the parent 'loops' times ; first as a json string that the thread
+ * builds and the parent parses back, then as the sample list itself.
+ * Both must load the same samples ; the elapsed time of each is printed.
+ *
+ *****************************************************************************/
+
+static bool _testhead_sample_equal ( sensor_data_type & a, sensor_data_type & b )
+{
+    return (( a.name == b.name ) && ( a.value == b.value ) &&
+            ( a.unit == b.unit ) && ( a.status == b.status ) &&
+            ( a.lnr == b.lnr ) && ( a.lcr == b.lcr ) && ( a.lnc == b.lnc ) &&
+            ( a.unc == b.unc ) && ( a.ucr == b.ucr ) && ( a.unr == b.unr ));
+}
+
+static int _testhead_sample_handoff ( int sensors, int loops )
+{
+    int rc = PASS ;
+    string hostname = "testhost" ;
+    bmc_sample_type * sample_list = new bmc_sample_type[MAX_HOST_SENSORS] ;
+    sensor_data_type * json_samples = new sensor_data_type[MAX_HOST_SENSORS] ;
+    sensor_data_type * list_samples = new sensor_data_type[MAX_HOST_SENSORS] ;
+    struct timespec start ;
+
+    memset ( sample_list, 0, sizeof(bmc_sample_type)*MAX_HOST_SENSORS );
+    for ( int i = 0 ; i < sensors ; i++ )
+    {
+        bmc_sample_type * ptr = &sample_list[i] ;
+        snprintf ( ptr->name,   IPMITOOL_MAX_FIELD_LEN, "Volt_P%d", i );
+        snprintf ( ptr->value,  IPMITOOL_MAX_FIELD_LEN, "12.%d", i%10 );
+        snprintf ( ptr->unit,   IPMITOOL_MAX_FIELD_LEN, "Volts" );
+        snprintf ( ptr->status, IPMITOOL_MAX_FIELD_LEN, "ok" );
+        snprintf ( ptr->lnr,    IPMITOOL_MAX_FIELD_LEN, "na" );
+        snprintf ( ptr->lcr,    IPMITOOL_MAX_FIELD_LEN, "10.2" );
+        snprintf ( ptr->lnc,    IPMITOOL_MAX_FIELD_LEN, "na" );
+        snprintf ( ptr->unc,    IPMITOOL_MAX_FIELD_LEN, "na" );
+        snprintf ( ptr->ucr,    IPMITOOL_MAX_FIELD_LEN, "13.8" );
+        snprintf ( ptr->unr,    IPMITOOL_MAX_FIELD_LEN, "na" );
+    }
+
+    /* json round trip ; thread serializes, parent parses it back */
+    clock_gettime ( CLOCK_MONOTONIC, &start );
+    for ( int l = 0 ; l < loops ; l++ )
+    {
+        string json = "{\"" ;
+        json.append(BMC_JSON__SENSORS_LABEL);
+        json.append("\":[");
+        for ( int i = 0 ; i < sensors ; )
+        {
+            bmc_sample_to_json ( sample_list[i], json );
+            if ( ++i < sensors )
+                json.append (",");
+        }
+        json.append ("]}");
+
+        jsonUtil_doc_type doc ;
+        int records = 0 ;
+        jsonUtil_doc_parse ( doc, json.data() );
+        struct json_object * array_obj = jsonUtil_get_array ( doc.root, BMC_JSON__SENSORS_LABEL, records );
+        for ( int i = 0 ; i < records ; i++ )
+            bmc_load_json_sensor ( hostname, json_samples[i], jsonUtil_get_array_obj ( array_obj, i ));
+    }
+    unsigned long json_usecs = _testhead_usecs ( start );
+
+    /* sample list handoff */
+    clock_gettime ( CLOCK_MONOTONIC, &start );
+    for ( int l = 0 ; l < loops ; l++ )
+    {
+        for ( int i = 0 ; i < sensors ; i++ )
+            bmc_load_sample ( hostname, list_samples[i], sample_list[i] );
+    }
+    unsigned long list_usecs = _testhead_usecs ( start );
+
+    for ( int i = 0 ; i < sensors ; i++ )
+        if ( _testhead_sample_equal ( json_samples[i], list_samples[i] ) == false )
+            rc = FAIL ;
+
+    printf ("| handoff %3d samples x%d : json %11lu usec : sample list %5lu usec | ",
+             sensors, loops, json_usecs, list_usecs );
+
+    delete [] sample_list ;
+    delete [] json_samples ;
+    delete [] list_samples ;
+    return (rc);
+}
+
+/*****************************************************************************
+ *
+ * Test Head : Redfish client session handling
+ *
+ * Runs the in-process redfish client against a stub Redfish server on
+ * the loopback interface. The stub counts session logins and accepts
+ * only the token of the latest login, or basic auth when no token is
+ * presented, so each case can check how the client authenticated.
+ *
+ *****************************************************************************/
+
+typedef struct
+{
+    pthread_mutex_t mutex ;
+    bool   stop           ; /* tells the stub server thread to exit      */
+    int    login_status   ; /* http status returned to a session login   */
+    string token          ; /* the currently valid session token         */
+    int    logins         ; /* session logins accepted                   */
+    int    login_attempts ; /* session logins received                   */
+    int    token_requests ; /* requests accepted with the session token  */
+    int    basic_requests ; /* requests accepted with basic auth         */
+    int    rejected       ; /* requests answered with 401                */
+} redfish_stub_type ;
+
+static redfish_stub_type _stub ;
+
+static void _stub_reply ( struct evhttp_request * req, int status )
+{
+    struct evbuffer * buf = evbuffer_new ();
+    evhttp_add_header ( evhttp_request_get_output_headers ( req ),
+                        "Content-Type", "application/json" );
+    evbuffer_add_printf ( buf, "%s", ( status < 300 ) ? "{\"Id\":\"1\"}" : "{}" );
+    evhttp_send_reply ( req, status, ( status < 300 ) ? "OK" : "Error", buf );
+    evbuffer_free ( buf );
+}
+
+static void _stub_request ( struct evhttp_request * req, void * arg )
+{
+    UNUSED(arg);
+    struct evkeyvalq * hdrs = evhttp_request_get_input_headers ( req );
+    const char * token = evhttp_find_header ( hdrs, REDFISH_HEADER__AUTH_TOKEN );
+    const char * basic = evhttp_find_header ( hdrs, "Authorization" );
+    string path = evhttp_request_get_uri ( req );
+
+    pthread_mutex_lock ( &_stub.mutex );
+    if (( evhttp_request_get_command ( req ) == EVHTTP_REQ_POST ) &&
+        ( path == REDFISH_PATH__SESSIONS ))
+    {
+        _stub.login_attempts++ ;
+        if ( _stub.login_status == 201 )
+        {
+            _stub.logins++ ;
+            _stub.token = "token-" + itos(_stub.logins) ;
+            struct evkeyvalq * out = evhttp_request_get_output_headers ( req );
+            evhttp_add_header ( out, REDFISH_HEADER__AUTH_TOKEN, _stub.token.c_str());
+            evhttp_add_header ( out, "Location", (path + "/" + itos(_stub.logins)).c_str());
+        }
+        _stub_reply ( req, _stub.login_status );
+    }
+    else if ( evhttp_request_get_command ( req ) == EVHTTP_REQ_DELETE )
+    {
+        _stub.token.clear();
+        _stub_reply ( req, 200 );
+    }
+    else if (( token ) && ( !_stub.token.empty() ) && ( _stub.token == token ))
+    {
+        _stub.token_requests++ ;
+        _stub_reply ( req, 200 );
+    }
+    else if (( token == NULL ) && ( basic ))
+    {
+        _stub.basic_requests++ ;
+        _stub_reply ( req, 200 );
+    }
+    else
+    {
+        _stub.rejected++ ;
+        _stub_reply ( req, 401 );
+    }
+    pthread_mutex_unlock ( &_stub.mutex );
+}
+
+/* the stub's event base can't be broken from the test thread ; poll */
+static void _stub_poll ( evutil_socket_t fd, short events, void * arg )
+{
+    UNUSED(fd); UNUSED(events);
+    pthread_mutex_lock ( &_stub.mutex );
+    if ( _stub.stop )
+        event_base_loopbreak ( (struct event_base *)arg );
+    pthread_mutex_unlock ( &_stub.mutex );
+}
+
+static void * _stub_thread ( void * arg )
+{
+    event_base_dispatch ( (struct event_base *)arg );
+    return (NULL);
+}
+
+static redfish_stub_type _stub_counts ( void )
+{
+    pthread_mutex_lock ( &_stub.mutex );
+    redfish_stub_type counts = _stub ;
+    pthread_mutex_unlock ( &_stub.mutex );
+    return (counts);
+}
+
+static void _stub_set ( int login_status, bool expire )
+{
+    pthread_mutex_lock ( &_stub.mutex );
+    _stub.login_status = login_status ;
+    if ( expire )
+        _stub.token.clear();
+    pthread_mutex_unlock ( &_stub.mutex );
+}
+
+static int _stub_get ( string & bm_ip )
+{
+    string response ;
+    string command = REDFISHTOOL_RAW_GET_CMD ;
+    command.append ( "/redfish/v1/Systems/1" );
+    return ( redfishClient_command ( "testhost", bm_ip, "admin", "secret", command, response ));
+}
+
+#define TESTHEAD_CHECK(cond,desc) \
+{ \
+    printf ("| redfish stub : %-52s| ", desc ); \
+    if ( cond ) { PASSED ; } else { FAILED ; rc = FAIL ; } \
+}
+
+static int _testhead_redfish_session ( void )
+{
+    int rc = PASS ;
+    struct event_base * base = event_base_new ();
+    struct evhttp     * http = base ? evhttp_new ( base ) : NULL ;
+    struct evhttp_bound_socket * handle = http ?
+    evhttp_bind_socket_with_handle ( http, "127.0.0.1", 0 ) : NULL ;
+    struct event * poll_event = handle ?
+    event_new ( base, -1, EV_PERSIST, _stub_poll, base ) : NULL ;
+    if ( poll_event == NULL )
+    {
+        printf ("| redfish stub : failed to start stub server%25s| ", "" );
+        FAILED ;
+        if ( http ) evhttp_free ( http );
+        if ( base ) event_base_free ( base );
+        return (FAIL);
+    }
+    struct timeval tick = { 0, 100000 };
+    event_add ( poll_event, &tick );
+    evhttp_set_gencb ( http, _stub_request, NULL );
+
+    struct sockaddr_in addr ;
+    socklen_t len = sizeof(addr);
+    getsockname ( evhttp_bound_socket_get_fd ( handle ), (struct sockaddr *)&addr, &len );
+    string bm_ip = "http://127.0.0.1:" + itos(ntohs(addr.sin_port)) ;
+
+    pthread_mutex_init ( &_stub.mutex, NULL );
+    _stub.stop = false ;
+    _stub.login_status = 201 ;
+
+    pthread_t server ;
+    pthread_create ( &server, NULL, _stub_thread, base );
+
+    /* one login is reused by every request */
+    int rc1 = _stub_get ( bm_ip );
+    int rc2 = _stub_get ( bm_ip );
+    int rc3 = _stub_get ( bm_ip );
+    redfish_stub_type counts = _stub_counts ();
+    TESTHEAD_CHECK (( rc1 == PASS ) && ( rc2 == PASS ) && ( rc3 == PASS ) &&
+                    ( counts.logins == 1 ) && ( counts.token_requests == 3 ),
+                    "session login reused over 3 requests" );
+
+    /* the BMC drops the session ; as it does when it expires */
+    _stub_set ( 201, true );
+    rc1 = _stub_get ( bm_ip );
+    counts = _stub_counts ();
+    TESTHEAD_CHECK (( rc1 == PASS ) && ( counts.logins == 2 ) && ( counts.rejected == 1 ),
+                    "expired session replaced by a new login" );
+
+    /* a server error login is retried ; not switched to basic auth */
+    redfishClient_close ( "testhost" );
+    _stub_set ( 500, true );
+    rc1 = _stub_get ( bm_ip );
+    _stub_set ( 201, false );
+    rc2 = _stub_get ( bm_ip );
+    counts = _stub_counts ();
+    TESTHEAD_CHECK (( rc1 != PASS ) && ( rc2 == PASS ) && ( counts.logins == 3 ) &&
+                    ( counts.basic_requests == 0 ),
+                    "failed login retried on the next request" );
+
+    /* no session service ; basic auth without further login attempts */
+    redfishClient_close ( "testhost" );
+    _stub_set ( 405, true );
+    int basic = _stub_counts().basic_requests ;
+    rc1 = _stub_get ( bm_ip );
+    int attempts = _stub_counts().login_attempts ;
+    rc2 = _stub_get ( bm_ip );
+    counts = _stub_counts ();
+    TESTHEAD_CHECK (( rc1 == PASS ) && ( rc2 == PASS ) && ( counts.basic_requests == basic+2 ) &&
+                    ( counts.login_attempts == attempts ),
+                    "refused login falls back to basic auth" );
+
+    redfishClient_close ( "testhost" );
+    pthread_mutex_lock ( &_stub.mutex );
+    _stub.stop = true ;
+    pthread_mutex_unlock ( &_stub.mutex );
+    pthread_join ( server, NULL );
+
+    event_free ( poll_event );
+    evhttp_free ( http );
+    event_base_free ( base );
+    return (rc);
+}
+
 /** Teat Head Entry */
 int daemon_run_testhead ( void )
 {
-    ilog ("Empty test head.\n");
-    return (PASS);
+    int rc = PASS ;
+    int sensors[] = { 50, 250 } ;
+
+    printf  ("\n\n");
+    printf  (TESTHEAD_BAR);
+    printf  ("| Hardware Monitor Test Head - Sensor Data Benchmarks\n");
+    printf  (TESTHEAD_BAR);
+    for ( int i = 0 ; i < 2 ; i++ )
+    {
+        if ( _testhead_json_parse ( sensors[i], 10 ) )
+        {
+            FAILED ;
+            rc = FAIL ;
+        }
+        else
+            PASSED ;
+    }
+    for ( int i = 0 ; i < 2 ; i++ )
+    {
+        if ( _testhead_sample_handoff ( sensors[i], 100 ) )
+        {
+            FAILED ;
+            rc = FAIL ;
+        }
+        else
+            PASSED ;
+    }
+    if ( _testhead_redfish_session () != PASS )
+        rc = FAIL ;
+    printf  (TESTHEAD_BAR);
+    return (rc);
 }
@@ -387,6 +387,8 @@ int hwmonHostClass::bmc_delete_sensor_model ( struct hwmonHostClass::hwmon_host
         }
     }
 
+    host_ptr->sensor_index_stale = true ;
+
     if (( host_ptr->sensors == 0 ) && ( host_ptr->groups == 0 ))
     {
         plog ("%s sensor model deleted\n", host_ptr->hostname.c_str() );
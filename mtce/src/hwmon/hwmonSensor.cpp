@@ -715,6 +715,7 @@ int hwmonHostClass::hwmon_load_sensors ( struct hwmonHostClass::hwmon_host * hos
     {
         ilog ("%s reloading sensors list\n", host_ptr->hostname.c_str());
         host_ptr->sensors = 0 ;
+        host_ptr->sensor_index_stale = true ;
         rc = hwmonHttp_load_sensors ( host_ptr->hostname, host_ptr->event );
     }
 
@@ -2149,6 +2150,7 @@ int hwmonHostClass::bmc_create_sensors ( struct hwmonHostClass::hwmon_host * hos
     int rc = PASS ;
     int sensor_errors = 0 ;
     host_ptr->sensors = 0 ;
+    host_ptr->sensor_index_stale = true ;
 
     for ( int s = 0 ; s < host_ptr->samples ; ++s )
     {
@@ -36,22 +36,17 @@ using namespace std;
 #include "hwmonThreads.h"    /* for ... BMC_THREAD_CMD__READ_SENSORS */
 #include "hwmonBmc.h"        /* for ... MAX_IPMITOOL_PARSE_ERRORS         */
 #include "hwmonClass.h"      /* for ... thread_extra_info_type            */
-#include "nodeUtil.h"        /* for ... fork_execv                        */
+#include "nodeUtil.h"        /* for ... spawn_execv                       */
+#include "redfishClient.h"   /* for ... redfishClient_command             */
 
 
-/* One instance per thread. Uses the memory allocated for the stack.
+/* One instance per thread. Points at the MAX_HOST_SENSORS sample list
+ * the parent handed this thread in thread_extra_info.sample_list.
  *
- * Although thread_local variables are not on the stack, they still
- * consume memory that’s tied to the thread’s overall resources,
- * and that memory often comes from the same per-thread allocation
- * that includes the stack ; refer to TLS (Thread-Local Storage).
- * The TLS area is often allocated adjacent to or within the thread's
- * stack mapping. A large thread_local variable increases the TLS
- * memory requirement, and if it exceeds the reserved space or
- * overlaps with the stack space, the OS may fail to allocate the
- * thread with a errno "Resource temporarily unavailable".
- * This allocation required the per thread stack to be increased. */
-thread_local bmc_sample_type _sample_list[MAX_HOST_SENSORS];
+ * The samples are parsed straight into that list and the parent takes
+ * it over when the thread is done, so they no longer need to be
+ * serialized into a json string and parsed back by the parent. */
+thread_local bmc_sample_type * _sample_list = NULL ;
 
 // #define WANT_SAMPLE_LIST_DEBUG
 #ifdef WANT_SAMPLE_LIST_DEBUG
@@ -110,58 +105,6 @@ static void _command_not_supported ( thread_info_type * info_ptr )
 }
 
 
-static void _add_json_sensor_tuple ( bmc_sample_type * ptr, string & response )
-{
-    response.append ("{\"n\":\"");
-    response.append (ptr->name);
-    response.append ("\",\"v\":\"");
-    response.append (ptr->value);
-    response.append ("\",\"u\":\"");
-    response.append (ptr->unit);
-    response.append ("\",\"s\":\"");
-    response.append (ptr->status);
-    response.append ("\"");
-
-    /* Include the threshold value of each below if not 'na' */
-    if ( strcmp (ptr->lnr,"na" ))
-    {
-        response.append (",\"lnr\":\"");
-        response.append (ptr->lnr);
-        response.append ("\"");
-    }
-    if ( strcmp (ptr->lcr,"na" ))
-    {
-        response.append (",\"lcr\":\"");
-        response.append (ptr->lcr);
-        response.append ("\"");
-    }
-    if ( strcmp (ptr->lnc,"na" ))
-    {
-        response.append (",\"lnc\":\"");
-        response.append (ptr->lnc);
-        response.append ("\"");
-    }
-    if ( strcmp (ptr->unc,"na" ))
-    {
-        response.append (",\"unc\":\"");
-        response.append (ptr->unc);
-        response.append ("\"");
-    }
-    if ( strcmp (ptr->ucr,"na" ))
-    {
-        response.append (",\"ucr\":\"");
-        response.append (ptr->ucr);
-        response.append ("\"");
-    }
-    if ( strcmp (ptr->unr,"na" ))
-    {
-        response.append (",\"unr\":\"");
-        response.append (ptr->unr);
-        response.append ("\"");
-    }
-    response.append("}");
-}
-
 /*****************************************************************************
  *
  * Name        : _parse_sensor_data
@@ -169,12 +112,20 @@ static void _add_json_sensor_tuple ( bmc_sample_type * ptr, string & response )
  * Description: Create a sensor data json string using pertinent data in the
  *              control structure data and of course the _sample_list.
  *
+ *              The parent loads the samples from the _sample_list itself,
+ *              so the json string is only created for debug logging when
+ *              bmgmt debug lane 8 is enabled.
+ *
  *****************************************************************************/
 
 static void _parse_sensor_data ( thread_info_type * info_ptr )
 {
     if ( info_ptr && info_ptr->extra_info_ptr )
     {
+        info_ptr->data.clear();
+        if ( !(daemon_get_cfg_ptr()->debug_bmgmt&8) )
+            return ;
+
         /*
          *   Get local copies rather than continuously use
          *   the pointer in the parse process ; just safer
@@ -209,7 +160,7 @@ static void _parse_sensor_data ( thread_info_type * info_ptr )
 
         for ( int i = 0 ; i < samples ; )
         {
-            _add_json_sensor_tuple ( &_sample_list[i], info_ptr->data ) ;
+            bmc_sample_to_json ( _sample_list[i], info_ptr->data ) ;
             if ( ++i < samples )
                 info_ptr->data.append (",");
         }
@@ -374,7 +325,13 @@ void * hwmonThread_ipmitool ( void * arg )
 
     /* the number of sensors are learned */
     extra_ptr->samples = samples = 0 ;
-    MEMSET_ZERO (_sample_list);
+    if (( _sample_list = extra_ptr->sample_list ) == NULL )
+    {
+        info_ptr->status_string = "null sample list pointer" ;
+        info_ptr->status = FAIL_NULL_POINTER ;
+        goto ipmitool_thread_done ;
+    }
+    memset ( _sample_list, 0, sizeof(bmc_sample_type)*MAX_HOST_SENSORS );
     switch ( info_ptr->command )
     {
         case BMC_THREAD_CMD__POWER_STATUS:
@@ -406,7 +363,7 @@ void * hwmonThread_ipmitool ( void * arg )
                         info_ptr->log_prefix,
                         info_ptr->password_file.c_str());
 
-            /*************** Create the output filename ***************/
+            /******* Create the fault insertion output filename ********/
             string datafile =
             bmcUtil_create_data_fn (info_ptr->hostname,
                                     BMC_POWER_STATUS_FILE_SUFFIX,
@@ -429,12 +386,15 @@ void * hwmonThread_ipmitool ( void * arg )
             if ( daemon_is_file_present ( MTC_CMD_FIT__POWER_STATUS ))
             {
                 slog ("%s FIT IPMITOOL_POWER_STATUS_CMD\n", info_ptr->hostname.c_str());
+                info_ptr->data = daemon_read_file (datafile.data()) ;
                 rc = PASS ;
             }
             else
             {
-                /* Make the request */
-                rc = fork_execv ( info_ptr->hostname, request, datafile ) ;
+                /* Make the request ; output is captured in memory */
+                rc = spawn_execv ( info_ptr->hostname, request, "",
+                                   &info_ptr->data,
+                                   DEFAULT_SYSTEM_REQUEST_TIMEOUT_SECS ) ;
             }
 
             unlink(info_ptr->password_file.data());
@@ -447,38 +407,19 @@ void * hwmonThread_ipmitool ( void * arg )
                 info_ptr->status_string.append(request);
                 info_ptr->status = FAIL_SYSTEM_CALL ;
             }
+            else if ( info_ptr->data.empty() )
+            {
+                info_ptr->status_string = "command did not produce output" ;
+                info_ptr->status = FAIL_FILE_ACCESS ;
+            }
             else
             {
-                bool datafile_present = false ;
-
-                /* look for the output data file */
-                for ( int i = 0 ; i < 10 ; i++ )
-                {
-                    pthread_signal_handler ( info_ptr );
-                    if ( daemon_is_file_present ( datafile.data() ))
-                    {
-                        datafile_present = true ;
-                        break ;
-                    }
-                    info_ptr->progress++ ;
-                    sleep (1);
-                }
-
-                if ( datafile_present )
-                {
-                    info_ptr->data = daemon_read_file (datafile.data()) ;
-                    dlog_t ("%s data:%s\n",
-                                info_ptr->hostname.c_str(),
-                                info_ptr->data.data());
+                dlog_t ("%s data:%s\n",
+                            info_ptr->hostname.c_str(),
+                            info_ptr->data.data());
 
-                    info_ptr->status_string = "pass" ;
-                    info_ptr->status = PASS ;
-                }
-                else
-                {
-                    info_ptr->status_string = "command did not produce output file ; timeout" ;
-                    info_ptr->status = FAIL_FILE_ACCESS ;
-                }
+                info_ptr->status_string = "pass" ;
+                info_ptr->status = PASS ;
             }
             break ;
         }
@@ -513,7 +454,7 @@ void * hwmonThread_ipmitool ( void * arg )
                         info_ptr->log_prefix,
                         info_ptr->password_file.c_str());
 
-            /*************** Create the output filename ***************/
+            /******* Create the debug and fault insertion filename ******/
             string sensor_datafile =
             bmcUtil_create_data_fn (info_ptr->hostname,
                                     BMC_SENSOR_OUTPUT_FILE_SUFFIX,
@@ -534,6 +475,8 @@ void * hwmonThread_ipmitool ( void * arg )
                   info_ptr->log_prefix,
                   sensor_query_request.c_str());
 
+            /* sensor query output is captured here rather than in the datafile */
+            string sensor_data ;
 
             /****************************************************************
              *
@@ -550,11 +493,13 @@ void * hwmonThread_ipmitool ( void * arg )
                 ilog_t ("%s bypass sensor data read ; %s FIT file is present",
                             info_ptr->hostname.c_str(),
                             MTC_CMD_FIT__SENSOR_DATA);
+                sensor_data = daemon_read_file ( sensor_datafile.data() );
                 rc = PASS ;
             }
 #ifdef WANT_FIT_TESTING
             else if ( daemon_want_fit ( FIT_CODE__HWMON__AVOID_SENSOR_QUERY, info_ptr->hostname ))
             {
+                sensor_data = daemon_read_file ( sensor_datafile.data() );
                 rc = PASS ; // ilog ("%s FIT Avoiding Sensor Query\n", info_ptr->hostname.c_str());
             }
             else if ( daemon_want_fit ( FIT_CODE__AVOID_N_FAIL_BMC_REQUEST, info_ptr->hostname ))
@@ -564,9 +509,9 @@ void * hwmonThread_ipmitool ( void * arg )
 #endif
             else
             {
-                /* remove the last query */
-                // daemon_remove_file ( sensor_datafile.data() ) ;
-                rc = fork_execv ( info_ptr->hostname, sensor_query_request, sensor_datafile ) ;
+                rc = spawn_execv ( info_ptr->hostname, sensor_query_request, "",
+                                   &sensor_data,
+                                   DEFAULT_SYSTEM_REQUEST_TIMEOUT_SECS ) ;
             }
 
 #ifdef WANT_FIT_TESTING
@@ -595,8 +540,14 @@ void * hwmonThread_ipmitool ( void * arg )
             * ... to save ther current sensor read file with a dated extension
             *     so that a read history is maintained for debug purposes. */
             if(daemon_get_cfg_ptr()->debug_bmgmt&8)
+            {
                 if ( daemon_is_file_present (WANT_DATED_IPMI_SENSOR_DATA_FILES))
+                {
+                    daemon_remove_file ( sensor_datafile.data() );
+                    daemon_log ( sensor_datafile.data(), sensor_data.data() );
                     daemon_copy_file(info_ptr->hostname, sensor_datafile.data());
+                }
+            }
 
             /* check for system call error case */
             if ( rc != PASS )
@@ -607,7 +558,10 @@ void * hwmonThread_ipmitool ( void * arg )
             }
             else
             {
-                FILE * _fp = fopen ( sensor_datafile.data(), "r" );
+                /* reuse the line parser over the captured output */
+                FILE * _fp = NULL ;
+                if ( ! sensor_data.empty() )
+                    _fp = fmemopen ( (void*)sensor_data.data(), sensor_data.length(), "r" );
                 if ( _fp )
                 {
                     char buffer [IPMITOOL_MAX_LINE_LEN];
@@ -795,9 +749,9 @@ void * hwmonThread_ipmitool ( void * arg )
                 } /* fopen */
                 else
                 {
-                    info_ptr->status = FAIL_FILE_ACCESS ;
-                    info_ptr->status_string = "failed to open sensor data file: ";
-                    info_ptr->status_string.append(sensor_datafile);
+                    info_ptr->status = FAIL_NO_DATA ;
+                    info_ptr->status_string = "no sensor data from: ";
+                    info_ptr->status_string.append(sensor_query_request);
                  }
             } /* end else handling of successful system command */
             break ;
@@ -843,7 +797,8 @@ ipmitool_thread_done:
     info_ptr->progress++ ;
     info_ptr->runcount++ ;
     info_ptr->id = 0     ;
-    pthread_exit (&info_ptr->status );
+
+    /* return rather than pthread_exit so a pool worker can be reused */
     return NULL ;
 }
 
@@ -887,8 +842,8 @@ static void _set_default_unit_type_for_sensor( thread_info_type * info_ptr,
  *
  * Name        : _parse_redfish_sensor_data
  * Purpose     : Parse redfish command response
- * Description : Parse json string and store sensor data to  _sample_list.
- * Parameters  : json_str_ptr  - the json string read from the file of command response.
+ * Description : Parse json object and store sensor data to  _sample_list.
+ * Parameters  : root_obj      - the parsed json object of the command response file.
                  info_ptr      - thread info
                  label         - json key, like "Voltages", "PowerControl"
                  reading_label - json key, like "ReadingVolts", "PowerConsumedWatts"
@@ -904,7 +859,7 @@ static void _set_default_unit_type_for_sensor( thread_info_type * info_ptr,
     if ( !strcmp (temp_str.data(),"none" ))   temp_str = "na" ;    \
     strcpy( _sample_list[samples].para , temp_str.c_str() );
 
-static int _parse_redfish_sensor_data( char * json_str_ptr, thread_info_type * info_ptr,
+static int _parse_redfish_sensor_data( struct json_object * root_obj, thread_info_type * info_ptr,
                                        string label, const char * reading_label, int & samples )
 {
     int rc = PASS ;
@@ -914,39 +869,27 @@ static int _parse_redfish_sensor_data( char * json_str_ptr, thread_info_type * i
      * Gracefully handle a missing sensor group label.
      * Return failure, that is ignored, if its not there.
      *
-     * Calling jsonUtil_get_list directly results in noisy json error logs.
      * If a server is not providing a canned group then so be it.
      *
-     *************************************************************************
-     *
-     * Start by objectifying the output data followed by getting that
-     * sensor group key value */
-    struct json_object *json_obj = json_tokener_parse(json_str_ptr);
-    if ( !json_obj )
+     *************************************************************************/
+    if ( !root_obj )
         return (FAIL_JSON_PARSE);
-    string value = jsonUtil_get_key_value_string ( json_obj, label.data());
-    json_object_put(json_obj);
-    if (( value.empty() || value == NONE ))
+
+    int sensors = 0 ;
+    struct json_object * sensors_obj = jsonUtil_get_array ( root_obj, label.data(), sensors );
+    if ( !sensors_obj )
         return (FAIL_NO_DATA);
 
-    std::list<string> sensor_list ;
-    sensor_list.clear();
-    rc = jsonUtil_get_list(json_str_ptr, label, sensor_list);
-    if ( rc == PASS )
     {
-        string status_str;
         string temp_str;
-        std::list<string>::iterator iter_curr_ptr ;
 
         // Required for special case handling of the Power Supply Redundancy Sensor
         bool is_power_supply_redundancy_sensor = false ;
         int  redundancy_count = 0 ;
 
-        for ( iter_curr_ptr  = sensor_list.begin();
-              iter_curr_ptr != sensor_list.end() ;
-            ++iter_curr_ptr )
+        for ( int i = 0 ; i < sensors ; i++ )
         {
-            json_obj = json_tokener_parse((char*)iter_curr_ptr->data());
+            struct json_object * json_obj = jsonUtil_get_array_obj ( sensors_obj, i );
             if ( !json_obj )
             {
                 elog_t ("%s no or invalid sensor record\n", info_ptr->hostname.c_str());
@@ -1012,11 +955,10 @@ static int _parse_redfish_sensor_data( char * json_str_ptr, thread_info_type * i
             }
 
             /* Parse and store status to _sample_list[samples].status */
-            status_str = jsonUtil_get_key_value_string ( json_obj, "Status" );
-            if ( strcmp (status_str.data(),"none" ))
+            struct json_object * json_status_obj = jsonUtil_get_key_object ( json_obj, "Status" );
+            if ( json_status_obj )
             {
-                struct json_object *json_status_obj = json_tokener_parse((char*)status_str.data());
-                if ( json_status_obj )
+                if ( json_object_is_type ( json_status_obj, json_type_object ))
                 {
                     string state = jsonUtil_get_key_value_string ( json_status_obj, "State" );
                     string health = jsonUtil_get_key_value_string ( json_status_obj, "Health" );
@@ -1081,7 +1023,10 @@ static int _parse_redfish_sensor_data( char * json_str_ptr, thread_info_type * i
                     {
                         strcpy(_sample_list[samples].status, "na");
                     }
-                    json_object_put(json_status_obj);
+                }
+                else
+                {
+                    strcpy(_sample_list[samples].status, "na");
                 }
             }
             else
@@ -1089,8 +1034,6 @@ static int _parse_redfish_sensor_data( char * json_str_ptr, thread_info_type * i
                 strcpy(_sample_list[samples].status, "na");
             }
 
-            if (json_obj) json_object_put(json_obj);
-
             samples++ ;
             if ( samples >= MAX_HOST_SENSORS )
             {
@@ -1243,6 +1186,63 @@ static bool _wait_for_command_output( thread_info_type * info_ptr, string & data
     return false ;
 }
 
+/*****************************************************************************
+ *
+ * Name        : _parse_redfish_sensor_group
+ * Description : Parse a power or thermal sensor group response
+ * Parameters  : info_ptr              - thread info
+                 sensor_group          - power & thermal group
+                 json_str_ptr          - the group's json response
+                 samples               - sensor data index for _sample_list array.
+ * Returns     : PASS if the response parsed
+ *
+ *****************************************************************************/
+
+static int _parse_redfish_sensor_group( thread_info_type * info_ptr,
+                                        int                sensor_group,
+                                        const char *       json_str_ptr,
+                                        int &              samples )
+{
+    /* Parse the response once for all of this group's sensor labels */
+    jsonUtil_doc_type doc ;
+    if ( jsonUtil_doc_parse ( doc, json_str_ptr ) != PASS )
+    {
+        elog_t ("%s failed to parse sensor data\n",
+                    info_ptr->hostname.c_str());
+        return FAIL_JSON_PARSE ;
+    }
+
+    switch (sensor_group)
+    {
+        case BMC_SENSOR_POWER_GROUP:
+        {
+            _parse_redfish_sensor_data( doc.root, info_ptr, REDFISH_SENSOR_LABEL_VOLT,
+                                    REDFISH_SENSOR_LABEL_VOLT_READING, samples);
+            _parse_redfish_sensor_data( doc.root, info_ptr, REDFISH_SENSOR_LABEL_POWER_REDUNDANCY,
+                                    REDFISH_SENSOR_LABEL_REDUNDANCY_READING, samples);
+            _parse_redfish_sensor_data( doc.root, info_ptr, REDFISH_SENSOR_LABEL_POWER_SUPPLY,
+                                    REDFISH_SENSOR_LABEL_POWER_SUPPLY_READING, samples);
+            _parse_redfish_sensor_data( doc.root, info_ptr, REDFISH_SENSOR_LABEL_POWER_CTRL,
+                                    REDFISH_SENSOR_LABEL_POWER_CTRL_READING, samples);
+            return PASS;
+        }
+        case BMC_SENSOR_THERMAL_GROUP:
+        {
+            _parse_redfish_sensor_data( doc.root, info_ptr, REDFISH_SENSOR_LABEL_TEMP,
+                                    REDFISH_SENSOR_LABEL_TEMP_READING, samples);
+            _parse_redfish_sensor_data( doc.root, info_ptr, REDFISH_SENSOR_LABEL_FANS,
+                                    REDFISH_SENSOR_LABEL_FANS_READING, samples);
+            return PASS;
+        }
+        default:
+        {
+            elog_t ("%s unsupported command failure\n",
+                        info_ptr->hostname.c_str());
+        }
+    }
+    return FAIL ;
+}
+
 /*****************************************************************************
  *
  * Name        : _parse_redfish_sensor_data_output_file
@@ -1292,34 +1292,7 @@ static int _parse_redfish_sensor_data_output_file( thread_info_type * info_ptr,
             if ( daemon_is_file_present (WANT_DATED_REDFISH_SENSOR_DATA_FILES))
                  daemon_copy_file(info_ptr->hostname, datafile.data());
 
-        switch (sensor_group)
-        {
-            case BMC_SENSOR_POWER_GROUP:
-            {
-                _parse_redfish_sensor_data( buffer, info_ptr, REDFISH_SENSOR_LABEL_VOLT,
-                                        REDFISH_SENSOR_LABEL_VOLT_READING, samples);
-                _parse_redfish_sensor_data( buffer, info_ptr, REDFISH_SENSOR_LABEL_POWER_REDUNDANCY,
-                                        REDFISH_SENSOR_LABEL_REDUNDANCY_READING, samples);
-                _parse_redfish_sensor_data( buffer, info_ptr, REDFISH_SENSOR_LABEL_POWER_SUPPLY,
-                                        REDFISH_SENSOR_LABEL_POWER_SUPPLY_READING, samples);
-                _parse_redfish_sensor_data( buffer, info_ptr, REDFISH_SENSOR_LABEL_POWER_CTRL,
-                                        REDFISH_SENSOR_LABEL_POWER_CTRL_READING, samples);
-                return PASS;
-            }
-            case BMC_SENSOR_THERMAL_GROUP:
-            {
-                _parse_redfish_sensor_data( buffer, info_ptr, REDFISH_SENSOR_LABEL_TEMP,
-                                        REDFISH_SENSOR_LABEL_TEMP_READING, samples);
-                _parse_redfish_sensor_data( buffer, info_ptr, REDFISH_SENSOR_LABEL_FANS,
-                                        REDFISH_SENSOR_LABEL_FANS_READING, samples);
-                return PASS;
-            }
-            default:
-            {
-                elog_t ("%s unsupported command failure\n",
-                            info_ptr->hostname.c_str());
-            }
-        }
+        return ( _parse_redfish_sensor_group ( info_ptr, sensor_group, buffer, samples ));
     }
     else
     {
@@ -1331,6 +1304,69 @@ static int _parse_redfish_sensor_data_output_file( thread_info_type * info_ptr,
     return FAIL ;
 }
 
+/*****************************************************************************
+ *
+ * Name        : _redfishClient_send_request
+ * Description : Execute a redfishtool command with the in-process client
+ * Parameters  : info_ptr              - thread info
+                 file_suffix           - datafile suffix ; for the FIT bypass
+                 redfish_cmd_str       - redfish command string
+                 response              - the response body
+ * Returns     : PASS if the command succeeded.
+ *
+ *****************************************************************************/
+
+static int _redfishClient_send_request( thread_info_type * info_ptr,
+                                        const char * file_suffix,
+                                        const char * redfish_cmd_str,
+                                        string & response )
+{
+    thread_extra_info_type * extra_ptr = (thread_extra_info_type*)info_ptr->extra_info_ptr ;
+
+    info_ptr->status_string = "" ;
+    info_ptr->status = PASS ;
+
+    if ( extra_ptr == NULL )
+    {
+        info_ptr->status = FAIL_NULL_POINTER ;
+        info_ptr->status_string = "null extra info pointer" ;
+        return FAIL ;
+    }
+
+    if (( info_ptr->command == BMC_THREAD_CMD__READ_SENSORS ) &&
+        ( daemon_is_file_present ( MTC_CMD_FIT__SENSOR_DATA )))
+    {
+        string datafile = bmcUtil_create_data_fn (info_ptr->hostname, file_suffix, BMC_PROTOCOL__REDFISHTOOL ) ;
+        if ( daemon_is_file_present ( datafile.data()))
+        {
+            ilog_t ("%s bypass sensor data read ; %s FIT file is present",
+                        info_ptr->hostname.c_str(),
+                        MTC_CMD_FIT__SENSOR_DATA);
+            response = daemon_read_file ( datafile.data() );
+            return PASS ;
+        }
+    }
+
+    blog1_t ("%s redfish client '%s'", info_ptr->hostname.c_str(), redfish_cmd_str );
+    int rc = redfishClient_command ( info_ptr->hostname,
+                                     extra_ptr->bm_ip,
+                                     extra_ptr->bm_un,
+                                     extra_ptr->bm_pw,
+                                     redfish_cmd_str,
+                                     response );
+    info_ptr->progress++ ;
+    if ( rc != PASS )
+    {
+        elog_t ("%s redfish client '%s' failed (rc:%d) %s\n",
+                    info_ptr->hostname.c_str(),
+                    redfish_cmd_str,
+                    rc, response.c_str());
+        info_ptr->status = FAIL_SYSTEM_CALL ;
+        info_ptr->status_string = response ;
+    }
+    return (rc);
+}
+
 /*****************************************************************************
  *
  * Name        : hwmonThread_redfish
@@ -1342,6 +1378,7 @@ static int _parse_redfish_sensor_data_output_file( thread_info_type * info_ptr,
 void * hwmonThread_redfish ( void * arg )
 {
     int samples ;
+    bool native = false ;
 
     thread_info_type       * info_ptr  ;
     thread_extra_info_type * extra_ptr ;
@@ -1376,39 +1413,81 @@ void * hwmonThread_redfish ( void * arg )
 
     /* the number of sensors learned */
     extra_ptr->samples = samples = 0 ;
-    MEMSET_ZERO (_sample_list);
+    if (( _sample_list = extra_ptr->sample_list ) == NULL )
+    {
+        info_ptr->status_string = "null sample list pointer" ;
+        info_ptr->status = FAIL_NULL_POINTER ;
+        goto redfishtool_thread_done ;
+    }
+    memset ( _sample_list, 0, sizeof(bmc_sample_type)*MAX_HOST_SENSORS );
+
+    /* use the in-process redfish client rather than redfishtool */
+    native = redfishClient_selected ( info_ptr->hostname );
 
     switch ( info_ptr->command )
     {
         case BMC_THREAD_CMD__READ_SENSORS:
         {
-            blog2_t ("%s read power sensors \n", info_ptr->log_prefix);
-            if ( _redfishUtil_send_request( info_ptr, datafile,
-                                            BMC_POWER_SENSOR_FILE_SUFFIX,
-                                            REDFISHTOOL_READ_POWER_SENSORS_CMD ) == PASS )
+            if ( native )
             {
-                /* look for the output data file */
-                if( _wait_for_command_output(info_ptr, datafile) )
+                string response ;
+
+                blog2_t ("%s read power sensors \n", info_ptr->log_prefix);
+                if ( _redfishClient_send_request( info_ptr,
+                                                  BMC_POWER_SENSOR_FILE_SUFFIX,
+                                                  REDFISHTOOL_READ_POWER_SENSORS_CMD,
+                                                  response ) == PASS )
                 {
-                    _parse_redfish_sensor_data_output_file( info_ptr, BMC_SENSOR_POWER_GROUP,
-                                                            datafile, samples );
+                    _parse_redfish_sensor_group( info_ptr, BMC_SENSOR_POWER_GROUP,
+                                                 response.data(), samples );
                 }
                 else
                 {
+                    /* keep the request failure status ; as the redfishtool
+                     * path does when its power output does not arrive */
                     break ;
                 }
-            }
 
-            blog2_t ("%s read thermal sensors \n", info_ptr->log_prefix);
-            if (_redfishUtil_send_request( info_ptr, datafile,
-                                           BMC_THERMAL_SENSOR_FILE_SUFFIX,
-                                           REDFISHTOOL_READ_THERMAL_SENSORS_CMD ) == PASS )
+                blog2_t ("%s read thermal sensors \n", info_ptr->log_prefix);
+                if ( _redfishClient_send_request( info_ptr,
+                                                  BMC_THERMAL_SENSOR_FILE_SUFFIX,
+                                                  REDFISHTOOL_READ_THERMAL_SENSORS_CMD,
+                                                  response ) == PASS )
+                {
+                    _parse_redfish_sensor_group( info_ptr, BMC_SENSOR_THERMAL_GROUP,
+                                                 response.data(), samples );
+                }
+            }
+            else
             {
-                /* look for the output data file */
-                if( _wait_for_command_output(info_ptr, datafile) )
+                blog2_t ("%s read power sensors \n", info_ptr->log_prefix);
+                if ( _redfishUtil_send_request( info_ptr, datafile,
+                                                BMC_POWER_SENSOR_FILE_SUFFIX,
+                                                REDFISHTOOL_READ_POWER_SENSORS_CMD ) == PASS )
+                {
+                    /* look for the output data file */
+                    if( _wait_for_command_output(info_ptr, datafile) )
+                    {
+                        _parse_redfish_sensor_data_output_file( info_ptr, BMC_SENSOR_POWER_GROUP,
+                                                                datafile, samples );
+                    }
+                    else
+                    {
+                        break ;
+                    }
+                }
+
+                blog2_t ("%s read thermal sensors \n", info_ptr->log_prefix);
+                if (_redfishUtil_send_request( info_ptr, datafile,
+                                               BMC_THERMAL_SENSOR_FILE_SUFFIX,
+                                               REDFISHTOOL_READ_THERMAL_SENSORS_CMD ) == PASS )
                 {
-                    _parse_redfish_sensor_data_output_file( info_ptr, BMC_SENSOR_THERMAL_GROUP,
-                                                            datafile, samples );
+                    /* look for the output data file */
+                    if( _wait_for_command_output(info_ptr, datafile) )
+                    {
+                        _parse_redfish_sensor_data_output_file( info_ptr, BMC_SENSOR_THERMAL_GROUP,
+                                                                datafile, samples );
+                    }
                 }
             }
 
@@ -1427,23 +1506,34 @@ void * hwmonThread_redfish ( void * arg )
         }
         case BMC_THREAD_CMD__POWER_STATUS:
         {
+            string json_bmc_info = "" ;
+
             blog2_t ("%s read power state\n", info_ptr->log_prefix);
-            if ( _redfishUtil_send_request( info_ptr, datafile,
-                                            BMC_POWER_STATUS_FILE_SUFFIX,
-                                            REDFISHTOOL_BMC_INFO_CMD ) != PASS )
+            if ( native )
             {
-                info_ptr->status_string = "failed to send request" ;
-                info_ptr->status = FAIL_OPERATION ;
-                goto redfishtool_thread_done ;
+                if ( _redfishClient_send_request( info_ptr,
+                                                  BMC_POWER_STATUS_FILE_SUFFIX,
+                                                  REDFISHTOOL_BMC_INFO_CMD,
+                                                  json_bmc_info ) != PASS )
+                {
+                    goto redfishtool_thread_done ;
+                }
             }
-            /* look for the output data file */
-            if( _wait_for_command_output(info_ptr, datafile) )
+            else
             {
-               /* need to add one of the following 2 strings
-                * to info_ptr->data
-                *     - Chassis Power is on
-                *     - Chassis Power is off
-                */
+                if ( _redfishUtil_send_request( info_ptr, datafile,
+                                                BMC_POWER_STATUS_FILE_SUFFIX,
+                                                REDFISHTOOL_BMC_INFO_CMD ) != PASS )
+                {
+                    info_ptr->status_string = "failed to send request" ;
+                    info_ptr->status = FAIL_OPERATION ;
+                    goto redfishtool_thread_done ;
+                }
+                /* look for the output data file */
+                if( ! _wait_for_command_output(info_ptr, datafile) )
+                {
+                    break ;
+                }
                 if ( datafile.empty() )
                 {
                     info_ptr->status_string = "bmc info filename empty" ;
@@ -1452,41 +1542,47 @@ void * hwmonThread_redfish ( void * arg )
                 }
 
                 /* read the output data */
-                string json_bmc_info = daemon_read_file (datafile.data());
-                if ( json_bmc_info.empty() )
-                {
-                    info_ptr->status_string = "bmc info file empty" ;
-                    info_ptr->status = FAIL_STRING_EMPTY ;
-                    goto redfishtool_thread_done ;
-                }
+                json_bmc_info = daemon_read_file (datafile.data());
+            }
 
-                /* parse the output data */
-                struct json_object *json_obj =
-                    json_tokener_parse((char*)json_bmc_info.data());
-                if ( !json_obj )
-                {
-                    info_ptr->status_string = "bmc info data parse error" ;
-                    info_ptr->status = FAIL_JSON_PARSE ;
-                    goto redfishtool_thread_done ;
-                }
+           /* need to add one of the following 2 strings
+            * to info_ptr->data
+            *     - Chassis Power is on
+            *     - Chassis Power is off
+            */
+            if ( json_bmc_info.empty() )
+            {
+                info_ptr->status_string = "bmc info file empty" ;
+                info_ptr->status = FAIL_STRING_EMPTY ;
+                goto redfishtool_thread_done ;
+            }
 
-                /* load the power state */
-                string power_state = tolowercase(
-                jsonUtil_get_key_value_string( json_obj, REDFISH_LABEL__POWER_STATE));
-                if ( power_state == "on" )
-                {
-                    info_ptr->data = "Chassis Power is on" ;
-                }
-                else
-                {
-                    info_ptr->data = "Chassis Power is off" ;
-                }
-                info_ptr->status_string = "pass" ;
-                info_ptr->status = PASS ;
-                ilog_t ("%s %s", info_ptr->hostname.c_str(),
-                                 info_ptr->data.c_str());
-                json_object_put( json_obj );
+            /* parse the output data */
+            struct json_object *json_obj =
+                json_tokener_parse((char*)json_bmc_info.data());
+            if ( !json_obj )
+            {
+                info_ptr->status_string = "bmc info data parse error" ;
+                info_ptr->status = FAIL_JSON_PARSE ;
+                goto redfishtool_thread_done ;
             }
+
+            /* load the power state */
+            string power_state = tolowercase(
+            jsonUtil_get_key_value_string( json_obj, REDFISH_LABEL__POWER_STATE));
+            if ( power_state == "on" )
+            {
+                info_ptr->data = "Chassis Power is on" ;
+            }
+            else
+            {
+                info_ptr->data = "Chassis Power is off" ;
+            }
+            info_ptr->status_string = "pass" ;
+            info_ptr->status = PASS ;
+            ilog_t ("%s %s", info_ptr->hostname.c_str(),
+                             info_ptr->data.c_str());
+            json_object_put( json_obj );
             break ;
         }
         default:
@@ -1521,7 +1617,6 @@ redfishtool_thread_done:
     info_ptr->progress++ ;
     info_ptr->runcount++ ;
     info_ptr->id = 0     ;
-    pthread_exit (&info_ptr->status );
     return NULL ;
 }
 
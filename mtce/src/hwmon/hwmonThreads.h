@@ -189,6 +189,11 @@ typedef struct
     string bm_un ;
     string bm_pw ;
 
+    /* MAX_HOST_SENSORS sample list the thread parses sensor readings
+     * into. It belongs to the thread while it runs. When the read is
+     * done hwmond swaps it with its own list and loads the samples
+     * straight from it ; see bmc_load_sensor_samples. */
+    bmc_sample_type * sample_list ;
     int    samples ;
 } thread_extra_info_type ;
 
@@ -682,12 +682,22 @@ void lmon_query_all_links( void )
  *
  */
 
-void daemon_service_run ( void )
+/* Main loop reactor handler for the netlink socket */
+static void _reactor_netlink ( int fd, void * ctx )
 {
-    fd_set readfds;
-    struct timeval waitd;
-    std::list<int> socks;
+    UNUSED(fd); UNUSED(ctx);
+    dlog ("netlink socket fired\n");
+    service_interface_events ();
+}
 
+static void _reactor_wheel ( int fd, void * ctx )
+{
+    UNUSED(fd); UNUSED(ctx);
+    mtcTimer_wheel_service ();
+}
+
+void daemon_service_run ( void )
+{
     lmon_ctrl.ioctl_socket = 0 ;
     lmon_ctrl.netlink_socket = 0 ;
     memset (&lmon_ctrl.mtclogd, 0, sizeof(lmon_ctrl.mtclogd));
@@ -713,31 +723,29 @@ void daemon_service_run ( void )
 
     lmon_learn_interfaces ( lmon_ctrl.ioctl_socket );
 
+    /* Run this daemon's timers off the timer wheel rather than
+     * with a posix timer and signal per timer */
+    mtcTimer_wheel_init ();
+
     int audit_secs = daemon_get_cfg_ptr()->audit_period ;
     ilog ("started %d second link state self correcting audit", audit_secs );
     mtcTimer_start ( lmon_ctrl.audit_timer, lmonTimer_handler, audit_secs );
 
-    socks.clear();
-    socks.push_front (lmon_ctrl.netlink_socket);
-    socks.sort();
+    if (( daemon_reactor_init () != PASS ) ||
+        ( daemon_reactor_add ( lmon_ctrl.netlink_socket, _reactor_netlink ) != PASS ))
+    {
+        elog ("failed to register netlink socket with reactor ; exiting ...\n");
+        daemon_exit ();
+    }
+    if ( mtcTimer_wheel_enabled () )
+        daemon_reactor_add ( mtcTimer_wheel_fd(), _reactor_wheel );
 
     ilog ("waiting on netlink events ...");
 
     for (;;)
     {
-        /* Accomodate for hup reconfig */
-        FD_ZERO(&readfds);
-        FD_SET(lmon_ctrl.netlink_socket, &readfds);
-        waitd.tv_sec  = 0;
-        waitd.tv_usec = SOCKET_WAIT ;
-
         /* This is used as a delay up to select timeout ; SOCKET_WAIT */
-        select( socks.back()+1, &readfds, NULL, NULL, &waitd);
-        if (FD_ISSET(lmon_ctrl.netlink_socket, &readfds))
-        {
-            dlog ("netlink socket fired\n");
-            service_interface_events ();
-        }
+        daemon_reactor_run ( SOCKET_WAIT/1000 );
 
         if ( lmon_ctrl.audit_timer.ring == true )
         {
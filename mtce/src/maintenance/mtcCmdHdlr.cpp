@@ -871,6 +871,7 @@ int nodeLinkClass::cmd_handler ( struct nodeLinkClass::node * node_ptr )
                 hostname_inventory.remove ( node_ptr->hostname );
                 node_ptr->hostname = name ;
                 hostname_inventory.push_back ( node_ptr->hostname );
+                index_node ( node_ptr );
 
                 /* update the timer hostname */
                 node_ptr->mtcTimer.hostname = name ;
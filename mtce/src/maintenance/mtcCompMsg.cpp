@@ -31,6 +31,7 @@
 #include <errno.h>
 #include <list>        /* for ... list of conf file names */
 #include <unistd.h>    /* for ... sync                    */
+#include <signal.h>    /* for ... kill                    */
 
 using namespace std;
 
@@ -901,6 +902,158 @@ int mtce_send_event ( mtc_socket_type * sock_ptr, unsigned int cmd , const char
     return rc ;
 }
 
+/****************************************************************************
+ *
+ * Name       : mtcAlive flag files
+ *
+ * Description: create_mtcAlive_msg reports the presence of these flag
+ *              files in every mtcAlive it builds, on every interface.
+ *              They are registered with the daemon file watch service
+ *              so that daemon_is_file_present answers them from memory.
+ *
+ ****************************************************************************/
+
+typedef enum
+{
+    MTCALIVE_FLAG__CONFIG_COMPLETE,
+    MTCALIVE_FLAG__CONFIG_FAIL,
+    MTCALIVE_FLAG__CONFIG_PASS,
+    MTCALIVE_FLAG__NODE_LOCKED,
+    MTCALIVE_FLAG__GOENABLED_MAIN_PASS,
+    MTCALIVE_FLAG__PATCHING_IN_PROG,
+    MTCALIVE_FLAG__NODE_IS_PATCHED,
+    MTCALIVE_FLAG__CONFIG_COMPLETE_WORKER,
+    MTCALIVE_FLAG__GOENABLED_SUBF_PASS,
+    MTCALIVE_FLAG__GOENABLED_SUBF_FAIL,
+    MTCALIVE_FLAG__SMGMT_DEGRADED,
+    MTCALIVE_FLAG__SMGMT_UNHEALTHY,
+    MTCALIVE_FLAG__LAST
+} mtcAlive_flag_enum ;
+
+static const char * _flag_file [MTCALIVE_FLAG__LAST] =
+{
+    CONFIG_COMPLETE_FILE,
+    CONFIG_FAIL_FILE,
+    CONFIG_PASS_FILE,
+    NODE_LOCKED_FILE,
+    GOENABLED_MAIN_PASS,
+    PATCHING_IN_PROG_FILE,
+    NODE_IS_PATCHED_FILE,
+    CONFIG_COMPLETE_WORKER,
+    GOENABLED_SUBF_PASS,
+    GOENABLED_SUBF_FAIL,
+    SMGMT_DEGRADED_FILE,
+    SMGMT_UNHEALTHY_FILE,
+};
+
+void mtcAlive_flags_init ( void )
+{
+    int watched = 0 ;
+    for ( int i = 0 ; i < MTCALIVE_FLAG__LAST ; i++ )
+        if ( daemon_watch_file ( _flag_file[i] ) == PASS )
+            watched++ ;
+    ilog ("mtcAlive flag files watched: %d of %d", watched, MTCALIVE_FLAG__LAST );
+}
+
+static bool _flag_present ( mtcAlive_flag_enum flag )
+{
+    return ( daemon_is_file_present ( _flag_file[flag] ));
+}
+
+
+/****************************************************************************
+ *
+ * Name       : mtcAlive_luks_audit
+ *
+ * Description: Probe the LUKS vault status every luks_audit_period secs.
+ *
+ *              The probe runs in the background and its last result is
+ *              what create_mtcAlive_msg reports ; the vault is assumed ok
+ *              until the first probe completes. A probe that has not
+ *              completed in LUKS_PROBE_TIMEOUT secs is killed and leaves
+ *              the last result as is.
+ *
+ *              Called from the mtcClient main loop. The probe is normally
+ *              reaped here but may also be reaped by the SIGCHLD handler
+ *              while scripts are running ; see mtcAlive_luks_reaped.
+ *
+ ****************************************************************************/
+
+static pid_t  _luks_pid    = 0 ;
+static bool   _luks_failed = false ;
+static time_t _luks_start  = 0 ;
+static time_t _luks_next   = 0 ;
+
+static void _luks_result ( int status )
+{
+    bool failed = !( WIFEXITED(status) && ( WEXITSTATUS(status) == 0 ));
+    if ( failed != _luks_failed )
+    {
+        if ( failed )
+        {
+            wlog ("LUKS vault status failed (status:0x%x)", status );
+        }
+        else
+        {
+            ilog ("LUKS vault status ok");
+        }
+        _luks_failed = failed ;
+    }
+    _luks_pid = 0 ;
+}
+
+bool mtcAlive_luks_reaped ( pid_t pid, int status )
+{
+    if (( pid <= 0 ) || ( pid != _luks_pid ))
+        return (false);
+    _luks_result ( status );
+    return (true);
+}
+
+void mtcAlive_luks_audit ( void )
+{
+    struct timespec ts ;
+    clock_gettime ( CLOCK_MONOTONIC, &ts );
+
+    if ( _luks_pid )
+    {
+        int status = 0 ;
+        pid_t pid = waitpid ( _luks_pid, &status, WNOHANG );
+        if ( pid == _luks_pid )
+        {
+            _luks_result ( status );
+        }
+        else if (( pid < 0 ) && ( errno == ECHILD ))
+        {
+            /* reaped elsewhere without being handed over */
+            _luks_pid = 0 ;
+        }
+        else if ( ts.tv_sec - _luks_start >= LUKS_PROBE_TIMEOUT )
+        {
+            wlog ("LUKS vault status probe timeout ; killing pid %d", _luks_pid );
+            kill ( _luks_pid, SIGKILL );
+            while (( waitpid ( _luks_pid, &status, 0 ) < 0 ) && ( errno == EINTR )) ;
+            _luks_pid = 0 ;
+        }
+        return ;
+    }
+
+    if ( ts.tv_sec < _luks_next )
+        return ;
+
+    int period = daemon_get_cfg_ptr()->luks_audit_period ;
+    if ( period <= 0 )
+        period = LUKS_AUDIT_PERIOD_DEFAULT ;
+    _luks_next  = ts.tv_sec + period ;
+    _luks_start = ts.tv_sec ;
+
+    if ( spawn_nowait ( get_hostname(), LUKS_VAULT_STATUS_CMD, _luks_pid ) != PASS )
+    {
+        /* same outcome system() had when the command could not run */
+        _luks_result ( -1 );
+    }
+}
+
 /****************************************************************************
  *
  * Name       : create_mtcAlive_msg
@@ -946,40 +1099,42 @@ int create_mtcAlive_msg ( ctrl_type * ctrl_ptr, mtc_message_type & msg, int cmd,
     msg.parm[MTC_PARM_UPTIME_IDX] = ts.tv_sec ;
 
     /* Insert the host health - TO BE OBSOLTETED */
-    msg.parm[MTC_PARM_HEALTH_IDX] = get_node_health( get_hostname() ) ;
+    msg.parm[MTC_PARM_HEALTH_IDX] =
+        set_node_health ( get_hostname(),
+                          _flag_present ( MTCALIVE_FLAG__CONFIG_PASS ),
+                          _flag_present ( MTCALIVE_FLAG__CONFIG_FAIL ));
 
     /* Insert the mtce flags */
     msg.parm[MTC_PARM_FLAGS_IDX] = 0 ;
 
-    //Check if LUKS FS manager service is active
-    int exitstatus = system("cryptsetup status luks_encrypted_vault");
-    if ( 0 != exitstatus )
+    /* result of the last LUKS vault status probe ; see mtcAlive_luks_audit */
+    if ( _luks_failed )
         msg.parm[MTC_PARM_FLAGS_IDX] |= MTC_FLAG__LUKS_VOL_FAILED ;
-    if ( daemon_is_file_present ( CONFIG_COMPLETE_FILE ) )
+    if ( _flag_present ( MTCALIVE_FLAG__CONFIG_COMPLETE ) )
         msg.parm[MTC_PARM_FLAGS_IDX] |= MTC_FLAG__I_AM_CONFIGURED ;
-    if ( daemon_is_file_present ( CONFIG_FAIL_FILE ) )
+    if ( _flag_present ( MTCALIVE_FLAG__CONFIG_FAIL ) )
         msg.parm[MTC_PARM_FLAGS_IDX] |= MTC_FLAG__I_AM_NOT_HEALTHY ;
-    if ( daemon_is_file_present ( CONFIG_PASS_FILE ) )
+    if ( _flag_present ( MTCALIVE_FLAG__CONFIG_PASS ) )
         msg.parm[MTC_PARM_FLAGS_IDX] |= MTC_FLAG__I_AM_HEALTHY ;
-    if ( daemon_is_file_present ( NODE_LOCKED_FILE ) )
+    if ( _flag_present ( MTCALIVE_FLAG__NODE_LOCKED ) )
         msg.parm[MTC_PARM_FLAGS_IDX] |= MTC_FLAG__I_AM_LOCKED ;
-    if ( daemon_is_file_present ( GOENABLED_MAIN_PASS ) )
+    if ( _flag_present ( MTCALIVE_FLAG__GOENABLED_MAIN_PASS ) )
         msg.parm[MTC_PARM_FLAGS_IDX] |= MTC_FLAG__MAIN_GOENABLED ;
-    if ( daemon_is_file_present ( PATCHING_IN_PROG_FILE ) )
+    if ( _flag_present ( MTCALIVE_FLAG__PATCHING_IN_PROG ) )
         msg.parm[MTC_PARM_FLAGS_IDX] |= MTC_FLAG__PATCHING ;
-    if ( daemon_is_file_present ( NODE_IS_PATCHED_FILE ) )
+    if ( _flag_present ( MTCALIVE_FLAG__NODE_IS_PATCHED ) )
         msg.parm[MTC_PARM_FLAGS_IDX] |= MTC_FLAG__PATCHED ;
 
     /* manage the worker subfunction flag */
     if ( is_subfunction_worker () == true )
     {
-        if ( daemon_is_file_present ( CONFIG_COMPLETE_WORKER ) )
+        if ( _flag_present ( MTCALIVE_FLAG__CONFIG_COMPLETE_WORKER ) )
         {
             msg.parm[MTC_PARM_FLAGS_IDX] |= MTC_FLAG__SUBF_CONFIGURED ;
 
             /* Only set the go enabled subfunction flag if the pass file only exists */
-            if (( daemon_is_file_present ( GOENABLED_SUBF_PASS ) == true ) &&
-                ( daemon_is_file_present ( GOENABLED_SUBF_FAIL ) == false ))
+            if (( _flag_present ( MTCALIVE_FLAG__GOENABLED_SUBF_PASS ) == true ) &&
+                ( _flag_present ( MTCALIVE_FLAG__GOENABLED_SUBF_FAIL ) == false ))
             {
                 msg.parm[MTC_PARM_FLAGS_IDX] |= MTC_FLAG__SUBF_GOENABLED ;
             }
@@ -1018,10 +1173,10 @@ int create_mtcAlive_msg ( ctrl_type * ctrl_ptr, mtc_message_type & msg, int cmd,
         dlog3 ("worker start host services failed ; rc:%d", ctrl_ptr->worker_hostservices_result );
     }
 
-    if ( daemon_is_file_present ( SMGMT_DEGRADED_FILE ) )
+    if ( _flag_present ( MTCALIVE_FLAG__SMGMT_DEGRADED ) )
         msg.parm[MTC_PARM_FLAGS_IDX] |= MTC_FLAG__SM_DEGRADED ;
 
-    if ( daemon_is_file_present ( SMGMT_UNHEALTHY_FILE ) )
+    if ( _flag_present ( MTCALIVE_FLAG__SMGMT_UNHEALTHY ) )
     {
         /* debounce 6 mtcAlive messages = ~25-30 second debounce */
         #define MAX_SM_UNHEALTHY_DEBOUNCE (6)
@@ -202,20 +202,22 @@ int mtc_service_inbox ( nodeLinkClass   *  obj_ptr,
 
     zero_unused_msg_buf (msg, bytes);
 
+    /* lookup the sender by the binary source address the socket
+     * resolved on receive ; no string conversion needed */
+    msgClassSock * rx_sock_ptr = NULL ;
     if ( iface == CLSTR_INTERFACE )
-    {
-        hostaddr = sock_ptr->mtc_agent_clstr_rx_socket->get_src_str();
-        hostname = obj_ptr->get_hostname ( hostaddr ) ;
-    }
+        rx_sock_ptr = sock_ptr->mtc_agent_clstr_rx_socket ;
     else if ( iface == MGMNT_INTERFACE )
-    {
-        hostaddr = sock_ptr->mtc_agent_mgmt_rx_socket->get_src_str();
-        hostname = obj_ptr->get_hostname ( hostaddr ) ;
-    }
+        rx_sock_ptr = sock_ptr->mtc_agent_mgmt_rx_socket ;
+    if ( rx_sock_ptr )
+        hostname = obj_ptr->get_hostname ( rx_sock_ptr->get_src_key() ) ;
 
     /* lookup failed if hostname remains empty. */
     if ( hostname.empty() )
     {
+        if ( rx_sock_ptr )
+            hostaddr = rx_sock_ptr->get_src_str();
+
         /* try and learn the cluster ip from a mtcAlive message. */
         if (( msg.cmd == MTC_MSG_MTCALIVE ) &&
             (( rc = jsonUtil_get_key_val ( &msg.buf[0], "hostname", hostname )) == PASS ))
@@ -241,6 +243,9 @@ int mtc_service_inbox ( nodeLinkClass   *  obj_ptr,
 
     print_mtc_message ( hostname, MTC_CMD_RX, msg, iface_name_ptr, false );
 
+    /* run the sender through the fsm on the next pass */
+    obj_ptr->fsm_wake ( hostname );
+
     /* handle messages that are not mtc_message_type
      * but rather are simply a json string */
     if ( msg.hdr[0] == '{' )
@@ -268,6 +273,7 @@ int mtc_service_inbox ( nodeLinkClass   *  obj_ptr,
                 }
                 else
                 {
+                    obj_ptr->fsm_wake ( hostname );
                     obj_ptr->collectd_notify_handler ( hostname,
                                                        resource,
                                                        state );
@@ -470,6 +476,7 @@ int mtc_service_inbox ( nodeLinkClass   *  obj_ptr,
         int rc1 = FAIL ;
         if ( ( rc = jsonUtil_get_key_val(&msg.buf[0], MTC_JSON_INV_NAME, hostname )) == PASS )
         {
+            obj_ptr->fsm_wake ( hostname );
             if ( ( rc1 = jsonUtil_get_key_val(&msg.buf[0], MTC_JSON_SERVICE, service )) == PASS )
             {
                 if (( msg.cmd == MTC_DEGRADE_RAISE )        ||
@@ -1144,12 +1151,12 @@ int service_events ( nodeLinkClass * obj_ptr, mtc_socket_type * sock_ptr )
         return (RETRY) ;
     }
 
-    string hostaddr = sock_ptr->mtc_event_rx_sock->get_src_str();
-    string hostname = obj_ptr->get_hostname ( hostaddr ) ;
+    string hostname = obj_ptr->get_hostname ( sock_ptr->mtc_event_rx_sock->get_src_key() ) ;
     if ( hostname.empty() )
     {
         wlog ("%s ignoring service event from unknown host (%s)",
-                obj_ptr->my_hostname.c_str(), hostaddr.c_str());
+                obj_ptr->my_hostname.c_str(),
+                sock_ptr->mtc_event_rx_sock->get_src_str());
         return (FAIL_UNKNOWN_HOSTNAME);
     }
     if (( hostname != obj_ptr->my_hostname ) &&
@@ -1193,6 +1200,9 @@ int service_events ( nodeLinkClass * obj_ptr, mtc_socket_type * sock_ptr )
         }
     }
 
+    /* run the host the event is for through the fsm on the next pass */
+    obj_ptr->fsm_wake ( hostname );
+
     /* print the ready event log */
     if (( msg.cmd != MTC_EVENT_HEARTBEAT_READY ) && ( !hostname.empty () ))
     {
@@ -135,6 +135,7 @@ int mtcHttpUtil_event_init ( libEvent * ptr ,
     /* Result Info */
     ptr->callback    = nullptr ;
     ptr->done        = false ;
+    ptr->keep_alive  = false ;
     ptr->status      = FAIL;
     ptr->exec_time_msec = 0 ;
     ptr->http_status = 0   ;
@@ -170,6 +171,11 @@ void mtcHttpUtil_init ( void )
 
 void mtcHttpUtil_free_conn ( libEvent & event )
 {
+    if ( httpUtil_pool_owns ( event ) )
+    {
+        httpUtil_pool_release ( event );
+        return ;
+    }
     if ( event.conn )
     {
         hlog2 ("%s Free Connection (%p)\n", event.log_prefix.c_str(), event.conn );
@@ -192,6 +198,13 @@ void mtcHttpUtil_free_conn ( libEvent & event )
 
 void mtcHttpUtil_free_base ( libEvent & event )
 {
+    /* The shared pool base is never freed */
+    if ( httpUtil_pool_owns ( event ) )
+    {
+        httpUtil_free_base ( event );
+        return ;
+    }
+
     /* Free the base */
     if ( event.base )
     {
@@ -422,6 +435,7 @@ int mtcHttpUtil_status ( libEvent & event )
         return (FAIL_UNKNOWN_HOSTNAME);
     }
     event.status = event.http_status = evhttp_request_get_response_code (event.req);
+    event.keep_alive = httpUtil_keep_alive ( event.req );
     switch (event.status)
     {
         case HTTP_OK:
@@ -520,20 +534,15 @@ int mtcHttpUtil_api_request ( libEvent & event )
     {
         slog ("%s http base memory leak avoidance (%p)\n",
                   event.log_prefix.c_str(), event.base );
+        if ( httpUtil_pool_owns ( event ) )
+        {
+            /* abandoned request ; don't keep its connection */
+            event.active = false ;
+            event.status = FAIL ;
+            mtcHttpUtil_free_conn ( event );
+        }
         // event_base_free(event.base);
-    }
-
-    /* Allocate the base */
-    event.base = event_base_new();
-    if ( event.base == NULL )
-    {
-        elog ("%s No Memory for Request\n", event.log_prefix.c_str());
-        event.status = FAIL_EVENT_BASE ;
-        return (event.status) ;
-    }
-    else
-    {
-        hlog2 ("%s base:%p object:%p\n", event.log_prefix.c_str(), event.base, &event );
+        event.base = NULL ;
     }
 
     if ( event.request == SYSINV_GET )
@@ -712,12 +721,39 @@ int mtcHttpUtil_api_request ( libEvent & event )
         goto mtcHttpUtil_api_request_done ;
     }
 
-    /* Establish connection */
-    if ( mtcHttpUtil_connect_new ( event ))
+    /* Requests bound to the generic handler find their event by its
+     * address so they can use the shared base and a pooled keep-alive
+     * connection. The others find their event by base so they still
+     * need a base of their own. */
+    if ( handler == &mtcHttpUtil_Handler )
     {
-        event.status = FAIL_CONNECT ;
-        event.conn = NULL ;
-        goto mtcHttpUtil_api_request_done ;
+        if ( httpUtil_pool_acquire ( event ) != PASS )
+        {
+            event.status = FAIL_CONNECT ;
+            event.conn = NULL ;
+            goto mtcHttpUtil_api_request_done ;
+        }
+        hlog2 ("%s base:%p object:%p (pooled)\n", event.log_prefix.c_str(), event.base, &event );
+    }
+    else
+    {
+        /* Allocate the base */
+        event.base = event_base_new();
+        if ( event.base == NULL )
+        {
+            elog ("%s No Memory for Request\n", event.log_prefix.c_str());
+            event.status = FAIL_EVENT_BASE ;
+            return (event.status) ;
+        }
+        hlog2 ("%s base:%p object:%p\n", event.log_prefix.c_str(), event.base, &event );
+
+        /* Establish connection */
+        if ( mtcHttpUtil_connect_new ( event ))
+        {
+            event.status = FAIL_CONNECT ;
+            event.conn = NULL ;
+            goto mtcHttpUtil_api_request_done ;
+        }
     }
 
     /* Create request */
@@ -811,7 +847,7 @@ int mtcHttpUtil_api_request ( libEvent & event )
     }
 
     hdrs.entry[hdr_entry].key   = "Connection" ;
-    hdrs.entry[hdr_entry].value = "close" ;
+    hdrs.entry[hdr_entry].value = httpUtil_pool_owns ( event ) ? "keep-alive" : "close" ;
     hdr_entry++;
     hdrs.entries = hdr_entry ;
 
@@ -836,6 +872,7 @@ int mtcHttpUtil_api_request ( libEvent & event )
 
     gettime   ( event.send_time );
     gettime   ( event.done_time ); /* create a valid done value */
+    event.keep_alive = false ;
 
     jlog ("%s API Address : %s", event.hostname.c_str(), event.token.url.c_str());
     event.status = evhttp_make_request ( event.conn, event.req, event.type, event.token.url.data());
@@ -864,7 +901,15 @@ int mtcHttpUtil_api_request ( libEvent & event )
             hlog ("%s Requested (blocking) (to:%d)\n", event.log_prefix.c_str(), event.timeout);
 
             /* Send the message with timeout */
-            event_base_dispatch(event.base);
+            if ( httpUtil_pool_owns ( event ) )
+            {
+                event.active = true ;
+                httpUtil_pool_wait ( event );
+            }
+            else
+            {
+                event_base_dispatch(event.base);
+            }
 
             goto mtcHttpUtil_api_request_done ;
         }
@@ -951,6 +996,12 @@ int mtcHttpUtil_api_request ( libEvent & event )
                   event.hostname.c_str(), rc);
     }
 
+    /* don't hold on to a pooled connection that failed */
+    if ( httpUtil_pool_owns ( event ) )
+    {
+        mtcHttpUtil_free_conn ( event );
+        mtcHttpUtil_free_base ( event );
+    }
     return (FAIL_MAKE_REQUEST);
 
 mtcHttpUtil_api_request_done:
@@ -246,6 +246,10 @@ void daemon_exit ( void )
     _close_clstr_tx_sockets();
     _close_amon_sock       ();
 
+    daemon_watch_dump      ();
+    daemon_watch_fini      ();
+    daemon_reactor_dump    ();
+
     exit (0) ;
 }
 
@@ -1429,6 +1433,94 @@ int daemon_init ( string iface, string nodetype_str )
     return (rc) ;
 }
 
+/*****************************************************************************
+ *
+ * Main loop reactor handlers and registration ; see daemon_reactor_add
+ *
+ *****************************************************************************/
+
+/* ctx is the interface ; PXEBOOT, MGMNT or CLSTR */
+static void _reactor_command ( int fd, void * ctx )
+{
+    UNUSED(fd);
+    int iface = (int)(long)ctx ;
+    mlog3 ("%s rx socket fired", get_iface_name_str(iface));
+    mtc_service_command ( sock_ptr, iface );
+}
+
+static void _reactor_amon ( int fd, void * ctx )
+{
+    UNUSED(fd); UNUSED(ctx);
+    mlog3 ("Active Monitor Select Fired\n");
+    active_monitor_dispatch ();
+}
+
+static void _reactor_watch ( int fd, void * ctx )
+{
+    UNUSED(fd); UNUSED(ctx);
+    mlog3 ("file watch fired");
+    daemon_watch_handler ();
+}
+
+static void _reactor_wheel ( int fd, void * ctx )
+{
+    UNUSED(fd); UNUSED(ctx);
+    mtcTimer_wheel_service ();
+}
+
+/* the receive fds currently registered with the reactor ; 0 if none */
+static int _reactor_mgmt_fd    = 0 ;
+static int _reactor_clstr_fd   = 0 ;
+static int _reactor_pxeboot_fd = 0 ;
+static int _reactor_amon_fd    = 0 ;
+
+/* Move a registration from the 'registered' fd to 'fd'. Done when the
+ * fd changes or is forced after a socket re-init that may have reused
+ * the same fd number. */
+static void _reactor_slot ( int & registered, int fd, bool force,
+                            daemon_reactor_handler_type handler,
+                            void * ctx = NULL )
+{
+    if (( fd == registered ) && ( force == false ))
+        return ;
+
+    if ( registered > 0 )
+        daemon_reactor_del ( registered );
+    if (( fd > 0 ) && ( daemon_reactor_add ( fd, handler, ctx ) != PASS ))
+        fd = 0 ;
+    registered = fd ;
+}
+
+/* Keep the reactor waiting on the receive sockets that are provisioned
+ * and up. Sockets are (re)created by auto-recovery and interfaces can be
+ * provisioned at any time so this is run every pass ; it only touches
+ * the reactor when one of them has changed. */
+static void _reactor_sync ( bool force )
+{
+    int fd = 0 ;
+    if ( mtc_sock.mtc_client_mgmt_rx_socket && mtc_sock.mtc_client_mgmt_rx_socket->return_status==PASS )
+        fd = mtc_sock.mtc_client_mgmt_rx_socket->getFD();
+    _reactor_slot ( _reactor_mgmt_fd, fd, force, _reactor_command, (void*)(long)MGMNT_INTERFACE );
+
+    fd = 0 ;
+    if (( ctrl.clstr_iface_provisioned == true ) &&
+        ( !ctrl.address_clstr.empty() ) &&
+        ( mtc_sock.mtc_client_clstr_rx_socket ) &&
+        ( mtc_sock.mtc_client_clstr_rx_socket->return_status==PASS ))
+    {
+        fd = mtc_sock.mtc_client_clstr_rx_socket->getFD();
+    }
+    _reactor_slot ( _reactor_clstr_fd, fd, force, _reactor_command, (void*)(long)CLSTR_INTERFACE );
+
+    fd = 0 ;
+    if (( ctrl.pxeboot_iface_provisioned ) && ( mtc_sock.pxeboot_rx_socket > 0 ))
+        fd = mtc_sock.pxeboot_rx_socket ;
+    _reactor_slot ( _reactor_pxeboot_fd, fd, force, _reactor_command, (void*)(long)PXEBOOT_INTERFACE );
+
+    mtc_sock.amon_socket = active_monitor_get_sel_obj ();
+    _reactor_slot ( _reactor_amon_fd, mtc_sock.amon_socket, force, _reactor_amon );
+}
+
 int select_log_count = 0 ;
 void daemon_service_run ( void )
 {
@@ -1488,6 +1580,10 @@ void daemon_service_run ( void )
         daemon_remove_file ( NODE_LOCKED_FILE );
     }
 
+    /* Run this daemon's timers off the timer wheel rather than
+     * with a posix timer and signal per timer */
+    mtcTimer_wheel_init ();
+
     /* Start mtcAlive message timer */
     /* Send first mtcAlive ASAP */
     mtcTimer_start ( ctrl.timer, timer_handler, 1 );
@@ -1509,102 +1605,42 @@ void daemon_service_run ( void )
     dlog ("%s running main loop with %d msecs socket timeout\n",
                        &ctrl.hostname[0], (SOCKET_WAIT/1000) );
 
-    std::list<int> socks ;
-
-    /* Run heartbeat service forever or until stop condition */
-    for ( ; ; )
+    if ( daemon_reactor_init () != PASS )
     {
-        /* set the master fd_set */
-        FD_ZERO(&mtc_sock.readfds);
-        socks.clear();
-
-        if ( mtc_sock.mtc_client_mgmt_rx_socket && mtc_sock.mtc_client_mgmt_rx_socket->return_status==PASS )
-        {
-            socks.push_front (mtc_sock.mtc_client_mgmt_rx_socket->getFD());
-            FD_SET(mtc_sock.mtc_client_mgmt_rx_socket->getFD(), &mtc_sock.readfds);
-        }
-
-        if (( ctrl.clstr_iface_provisioned == true ) &&
-            ( mtc_sock.mtc_client_clstr_rx_socket ) &&
-            ( mtc_sock.mtc_client_clstr_rx_socket->return_status==PASS ))
-        {
-            socks.push_front (mtc_sock.mtc_client_clstr_rx_socket->getFD());
-            FD_SET(mtc_sock.mtc_client_clstr_rx_socket->getFD(), &mtc_sock.readfds);
-        }
-
-        if (( ctrl.pxeboot_iface_provisioned ) &&
-            ( mtc_sock.pxeboot_rx_socket ))
-        {
-            socks.push_front (mtc_sock.pxeboot_rx_socket);
-            FD_SET(mtc_sock.pxeboot_rx_socket, &mtc_sock.readfds);
-        }
-
-        mtc_sock.amon_socket = active_monitor_get_sel_obj ();
-        if ( mtc_sock.amon_socket )
-        {
-            socks.push_front (mtc_sock.amon_socket);
-            FD_SET(mtc_sock.amon_socket,          &mtc_sock.readfds);
-        }
-
-        /* Initialize the timeval struct to wait for 50 mSec */
-        mtc_sock.waitd.tv_sec  = 0;
-        mtc_sock.waitd.tv_usec = SOCKET_WAIT;
+        elog ("Failed to create main loop reactor\n");
+        daemon_exit ();
+    }
+    if ( mtcTimer_wheel_enabled () )
+        daemon_reactor_add ( mtcTimer_wheel_fd(), _reactor_wheel );
 
-        /* Call select() and wait only up to SOCKET_WAIT */
-        socks.sort();
-        rc = select( socks.back()+1,
-                    &mtc_sock.readfds, NULL, NULL,
-                    &mtc_sock.waitd);
+    /* set after a socket re-init to force the receive sockets to be
+     * re-registered with the reactor */
+    bool reactor_resync = true ;
 
-        /* If the select time out expired then  */
-        if (( rc < 0 ) || ( rc == 0 ))
-        {
-            /* Check to see if the select call failed. */
-            /* ... but filter Interrupt signal         */
-            if (( rc < 0 ) && ( errno != EINTR ))
-            {
-                elog ("Select Failed (rc:%d) %s \n", errno, strerror(errno));
-            }
-        }
-        else
-        {
-
-            // Is there a Pxeboot network message present ?
-            if (( ctrl.pxeboot_iface_provisioned ) &&
-                ( mtc_sock.pxeboot_rx_socket )     &&
-                ( FD_ISSET(mtc_sock.pxeboot_rx_socket, &mtc_sock.readfds)))
-            {
-                mlog3 ("pxeboot rx socket fired");
-                mtc_service_command ( sock_ptr, PXEBOOT_INTERFACE );
-            }
+    /* answer the flag files polled below and in every mtcAlive from
+     * memory rather than stat'ing them on each check */
+    if ( daemon_watch_init () == PASS )
+    {
+        mtcAlive_flags_init ();
+        daemon_watch_file ( NODE_RESET_FILE );
+        daemon_watch_file ( GOENABLED_MAIN_READY );
+        daemon_watch_file ( GOENABLED_SUBF_READY );
+        daemon_watch_file ( GOENABLED_MAIN_FAIL );
+        daemon_watch_file ( RESET_PEER_NOW );
+        daemon_watch_file ( MTC_CMD_FIT__DIR );
+        daemon_reactor_add ( daemon_watch_fd (), _reactor_watch );
+    }
 
-            // Is there a Mgmt network message present ?
-            if ((mtc_sock.mtc_client_mgmt_rx_socket &&
-                 mtc_sock.mtc_client_mgmt_rx_socket->return_status==PASS) &&
-                 FD_ISSET(mtc_sock.mtc_client_mgmt_rx_socket->getFD(), &mtc_sock.readfds))
-            {
-                mlog3 ("mgmt rx socket fired");
-                mtc_service_command ( sock_ptr, MGMNT_INTERFACE );
-            }
+    /* Run heartbeat service forever or until stop condition */
+    for ( ; ; )
+    {
+        _reactor_sync ( reactor_resync );
+        reactor_resync = false ;
 
-            // Is there a cluster host network message present ?
-            if (( ctrl.clstr_iface_provisioned == true ) &&
-                ( !ctrl.address_clstr.empty() ) &&
-                ( mtc_sock.mtc_client_clstr_rx_socket ) &&
-                ( mtc_sock.mtc_client_clstr_rx_socket->return_status==PASS) &&
-                ( FD_ISSET(mtc_sock.mtc_client_clstr_rx_socket->getFD(), &mtc_sock.readfds)))
-            {
-                mlog3 ("clstr rx socket fired");
-                mtc_service_command ( sock_ptr, CLSTR_INTERFACE );
-            }
+        /* Wait only up to SOCKET_WAIT for and dispatch the ready fds */
+        daemon_reactor_run ( SOCKET_WAIT/1000 );
 
-            // Is there a active monitor request pesent
-            if ( FD_ISSET(mtc_sock.amon_socket, &mtc_sock.readfds))
-            {
-                mlog3 ("Active Monitor Select Fired\n");
-                active_monitor_dispatch ();
-            }
-        }
+        mtcAlive_luks_audit ();
 
         if (( ctrl.active_script_set == GOENABLED_MAIN_SCRIPTS ) ||
             ( ctrl.active_script_set == GOENABLED_SUBF_SCRIPTS ))
@@ -1803,6 +1839,8 @@ void daemon_service_run ( void )
 
             if ( socket_reinit )
             {
+                reactor_resync = true ;
+
                 if (( ctrl.pxeboot_iface_provisioned ) &&
                     (( mtc_sock.pxeboot_tx_socket <= 0 ) ||
                      ( mtc_sock.pxeboot_rx_socket <= 0 )))
@@ -2438,6 +2476,13 @@ void daemon_sigchld_hdlr ( void )
 
     while ( 0 < ( tpid = waitpid ( -1, &status, WNOHANG | WUNTRACED )))
     {
+        /* the periodic LUKS vault probe may be reaped here too */
+        if ( mtcAlive_luks_reaped ( tpid, status ) == true )
+        {
+            found = true ;
+            continue ;
+        }
+
         /* loop over all the scripts and get the child execution status */
         for ( int i = 0 ; i < scripts_ptr->scripts ; i++ )
         {
@@ -177,4 +177,13 @@ int run_hostservices_scripts ( unsigned int cmd );
 void load_mtcInfo_msg ( mtc_message_type & msg );
 void load_pxebootInfo_msg ( mtc_message_type & msg );
 
+/* mtcAlive flag file watch and LUKS vault probe ; see mtcCompMsg.cpp */
+#define LUKS_VAULT_STATUS_CMD     ((const char *)"/usr/sbin/cryptsetup status luks_encrypted_vault")
+#define LUKS_AUDIT_PERIOD_DEFAULT (30) /* secs ; mtc.conf luks_audit_period */
+#define LUKS_PROBE_TIMEOUT        (30) /* secs before a probe is killed     */
+
+void mtcAlive_flags_init    ( void );
+void mtcAlive_luks_audit    ( void );
+bool mtcAlive_luks_reaped   ( pid_t pid, int status );
+
 #endif // __INCLUDE_MTCNODECOMP_HH__
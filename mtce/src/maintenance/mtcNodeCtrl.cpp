@@ -478,6 +478,16 @@ static int mtc_config_handler ( void * user,
         config_ptr->pod_drain_timeout = atoi(value);
         ilog ("Pod Drain   : %d secs", config_ptr->pod_drain_timeout );
     }
+    else if (MATCH("agent", "redfish_native_hosts"))
+    {
+        config_ptr->redfish_native_hosts = strdup(value);
+        ilog ("Redfish Clnt: %s", config_ptr->redfish_native_hosts );
+    }
+    else if (MATCH("agent", "bmc_workers"))
+    {
+        config_ptr->bmc_workers = atoi(value);
+        threadUtil_workers ( config_ptr->bmc_workers );
+    }
     else if (MATCH("timeouts", "failsafe_shutdown_delay"))
     {
         config_ptr->failsafe_shutdown_delay = atoi(value);
@@ -1428,10 +1438,82 @@ int _self_provision ( void )
     return(rc);
 }
 
+/* Returns true if the host is settled with nothing in progress ; it then
+ * only needs to be run when a timer, message or request wakes it or
+ * when its next bmc ping is due. */
+bool nodeLinkClass::fsm_idle ( struct nodeLinkClass::node * node_ptr,
+                               unsigned long long & wake_time )
+{
+    wake_time = 0 ;
+
+    if (( node_ptr->adminAction  != MTC_ADMIN_ACTION__NONE )   ||
+        ( node_ptr->configAction != MTC_CONFIG_ACTION__NONE )  ||
+        ( node_ptr->clear_task   == true )                     ||
+        ( node_ptr->offlineStage != MTC_OFFLINE__IDLE )        ||
+        ( node_ptr->libEvent_work_fifo.size() )                ||
+        ( node_ptr->libEvent_done_fifo.size() )                ||
+        ( node_ptr->mtcCmd_work_fifo.size() )                  ||
+        ( node_ptr->mtcCmd_done_fifo.size() )                  ||
+        ( thread_idle ( node_ptr->bmc_thread_ctrl ) == false ) ||
+        (( this->delayed_swact_required ) &&
+         ( node_ptr->hostname == this->my_hostname )))
+    {
+        return (false);
+    }
+
+    /* any state other than these is a transition in progress */
+    if ((( node_ptr->adminState  != MTC_ADMIN_STATE__UNLOCKED ) ||
+         ( node_ptr->operState   != MTC_OPER_STATE__ENABLED )   ||
+         (( node_ptr->availStatus != MTC_AVAIL_STATUS__AVAILABLE ) &&
+          ( node_ptr->availStatus != MTC_AVAIL_STATUS__DEGRADED ))) &&
+        (( node_ptr->adminState  != MTC_ADMIN_STATE__LOCKED )   ||
+         ( node_ptr->operState   != MTC_OPER_STATE__DISABLED )  ||
+         (( node_ptr->availStatus != MTC_AVAIL_STATUS__OFFLINE ) &&
+          ( node_ptr->availStatus != MTC_AVAIL_STATUS__ONLINE )  &&
+          ( node_ptr->availStatus != MTC_AVAIL_STATUS__OFFDUTY ) &&
+          ( node_ptr->availStatus != MTC_AVAIL_STATUS__POWERED_OFF ))))
+    {
+        return (false);
+    }
+
+    if ( node_ptr->bmc_provisioned )
+    {
+        /* the bm password is fetched once ping is ok */
+        if (( node_ptr->bm_ping_info.ok ) && ( node_ptr->bm_pw.empty() ))
+            return (false);
+
+        switch ( node_ptr->bm_ping_info.stage )
+        {
+            case PINGUTIL_MONITOR_STAGE__IDLE:
+                break ;
+            /* a host in ping WAIT or RECV is idle until the stage
+             * deadline, which is its wake time. A request queued in
+             * SEND is sent by the pingUtil_service call on this same
+             * loop pass so its reply is in by the RECV deadline. */
+            case PINGUTIL_MONITOR_STAGE__WAIT:
+            case PINGUTIL_MONITOR_STAGE__RECV:
+                wake_time = node_ptr->bm_ping_info.deadline ;
+                break ;
+            default:
+                return (false);
+        }
+    }
+    return (true);
+}
+
+void nodeLinkClass::fsm_dump ( void )
+{
+    ilog ("FSM Runs    : passes:%llu sweeps:%llu host runs:%llu ; runnable:%zu timed:%zu\n",
+              fsm_passes, fsm_sweeps, fsm_runs, fsm_runq.size(), fsm_timers.size());
+}
+
 static int sm_unhealthy_log_throttle = 0 ;
 #define SM_UNHEALTHY_LOG_THROTTLE (100)
 
-/* Main FSM Loop */
+/* Main FSM Loop
+ *
+ * Runs the hosts on the run queue and those whose timed wake-up is due,
+ * or every host on a periodic or requested sweep ; see fsm_wake. */
 void nodeLinkClass::fsm ( void )
 {
     if ( head )
@@ -1455,8 +1537,49 @@ void nodeLinkClass::fsm ( void )
         if ( sm_unhealthy_log_throttle )
             sm_unhealthy_log_throttle = 0 ;
 
-        for ( node_ptr = head ; node_ptr != NULL ; node_ptr = node_ptr->next )
+        /* Build this pass's batch. Hosts in it stay marked queued
+         * until they are run so they are only added once. */
+        unsigned long long now = gettime_monotonic_nsec ();
+        fsm_passes++ ;
+        fsm_batch.clear();
+        if (( fsm_sweep_now == true ) || ( now >= fsm_sweep_time ))
         {
+            fsm_sweep_now  = false ;
+            fsm_sweep_time = now + ((unsigned long long)MTC_FSM_SWEEP_MSECS*1000000) ;
+            fsm_sweeps++ ;
+            fsm_runq.clear();
+            for ( node_ptr = head ; node_ptr != NULL ; node_ptr = node_ptr->next )
+            {
+                node_ptr->fsm_queued = true ;
+                fsm_batch.push_back ( node_ptr );
+            }
+        }
+        else
+        {
+            fsm_batch.swap ( fsm_runq );
+            while (( fsm_timers.size() ) && ( fsm_timers.begin()->first <= now ))
+            {
+                node_ptr = fsm_timers.begin()->second ;
+                fsm_timer_set ( node_ptr, 0 );
+                if ( node_ptr->fsm_queued == false )
+                {
+                    node_ptr->fsm_queued = true ;
+                    fsm_batch.push_back ( node_ptr );
+                }
+            }
+        }
+
+        for ( unsigned int i = 0 ; i < fsm_batch.size() ; i++ )
+        {
+            /* null if the host was deleted after the batch was built */
+            node_ptr = fsm_batch[i] ;
+            if ( node_ptr == NULL )
+                continue ;
+
+            /* wake-ups from here on put it back on the run queue */
+            node_ptr->fsm_queued = false ;
+            fsm_runs++ ;
+
             string hn = node_ptr->hostname ;
             rc = fsm ( node_ptr ) ;
             if ( rc )
@@ -1466,26 +1589,182 @@ void nodeLinkClass::fsm ( void )
             if ( this->host_deleted == true )
             {
                 this->host_deleted = false ;
+
+                /* run what is left of the batch on the next pass */
+                for ( unsigned int j = i ; j < fsm_batch.size() ; j++ )
+                {
+                    if ( fsm_batch[j] )
+                    {
+                        fsm_batch[j]->fsm_queued = false ;
+                        fsm_wake ( fsm_batch[j] );
+                    }
+                }
+                fsm_batch.clear();
                 return ;
             }
 
+            /* keep running it while it has work in progress */
+            unsigned long long wake_time = 0 ;
+            if ( fsm_idle ( node_ptr, wake_time ) == false )
+                fsm_wake ( node_ptr );
+            fsm_timer_set ( node_ptr, wake_time );
+
             daemon_signal_hdlr ();
             mtcHttpSvr_look ( mtce_event );
         }
+        fsm_batch.clear();
         mtcInv.mtcInfo_handler();
     }
 }
+// Used to track mtcAgent incoming messaging rate
+#define LOOP_TIMER_PERIOD_SECS    (60)
+#define MSGS_PER_SEC_THRESHOLD    (20)
+#define MSGS_CNT_IDX_INBOX        (0)
+#define MSGS_CNT_IDX_EVENT        (1)
+#define MSGS_CNT_IDX_PMOND        (2)
+#define MSGS_CNT_IDX_HTTP         (3)
+#define MSGS_CNT_IDX_NETLINK      (4)
+#define MSGS_CNT_IDX_INOTIFY      (5)
+#define MSGS_CNT_IDX_MAX          (6)
+static unsigned int messages_tally[MSGS_CNT_IDX_MAX] = {0,0,0,0,0,0} ;
+
+/*****************************************************************************
+ *
+ * Main loop reactor handlers.
+ *
+ * Each of the mtcAgent's receive file descriptors is registered once with
+ * daemon_reactor_add and its handler is called by daemon_reactor_run when
+ * it is readable.
+ *
+ *****************************************************************************/
+
+static void _reactor_wheel ( int fd, void * ctx )
+{
+    UNUSED(fd); UNUSED(ctx);
+    mtcTimer_wheel_service ();
+}
+
+static void _reactor_http ( int fd, void * ctx )
+{
+    UNUSED(fd); UNUSED(ctx);
+    mlog3 ("http socket fired");
+    messages_tally[MSGS_CNT_IDX_HTTP]++ ;
+    mtcHttpSvr_look ( mtce_event );
+    mlog3 ("http handling done");
+}
+
+static void _reactor_netlink ( int fd, void * ctx )
+{
+    UNUSED(ctx);
+    mlog3 ("netlink socket fired");
+    messages_tally[MSGS_CNT_IDX_NETLINK]++ ;
+    int rc = mtcInv.service_netlink_events ( fd, mtc_sock.ioctl_sock );
+    if ( rc != PASS )
+    {
+        elog ("service_netlink_events failed (rc:%d)\n", rc );
+    }
+    /* a link change can affect any host */
+    mtcInv.fsm_wake_all ();
+    mlog3 ("netlink handling done");
+}
+
+static void _reactor_events ( int fd, void * ctx )
+{
+    UNUSED(fd); UNUSED(ctx);
+    mlog3 ("events socket fired");
+    messages_tally[MSGS_CNT_IDX_EVENT]++ ;
+    int rc = service_events ( &mtcInv, &mtc_sock );
+    if ( rc != PASS )
+    {
+        elog ("service_events failed (rc:%d)\n", rc );
+    }
+    mlog3 ("events handling done");
+}
+
+/* ctx is the interface ; PXEBOOT, MGMNT or CLSTR */
+static void _reactor_inbox ( int fd, void * ctx )
+{
+    UNUSED(fd);
+    int iface = (int)(long)ctx ;
+    const char * iface_name = get_iface_name_str ( iface );
+    int cnt = 0 ;
+
+    /* Service up to MAX_RX_MSG_BATCH of messages at once */
+    mlog3 ("%s network socket fired", iface_name );
+    for ( ; cnt < MAX_RX_MSG_BATCH ; cnt++ )
+    {
+        mlog3 ("... service inbox ; message %d", cnt+1);
+        int rc = mtc_service_inbox ( &mtcInv, &mtc_sock, iface ) ;
+        if ( rc == RETRY )
+        {
+            mlog3 ("... service inbox done");
+            break ;
+        }
+        messages_tally[MSGS_CNT_IDX_INBOX]++ ;
+        if ( rc > RETRY )
+        {
+            if ( iface == CLSTR_INTERFACE )
+            {
+                mlog ("mtc_service_inbox failed (rc:%d) (%s)\n", rc, iface_name );
+            }
+            else
+            {
+                wlog ("mtc_service_inbox failed (rc:%d) (%s)", rc, iface_name );
+            }
+            break ;
+        }
+        else
+        {
+            mlog3 ("......more messages to service");
+        }
+    }
+    if ( cnt > (MAX_RX_MSG_BATCH/2) )
+    {
+        ilog ("serviced %d messages in one batch (%s)", cnt, iface_name );
+    }
+    mlog3 ("%s network message handling done", iface_name );
+}
+
+static void _reactor_shadow ( int fd, void * ctx )
+{
+    UNUSED(ctx);
+    mlog3 ("inotify socket fired");
+    messages_tally[MSGS_CNT_IDX_INOTIFY]++ ;
+    int rc = get_inotify_events ( fd, (IN_MODIFY | IN_CREATE | IN_IGNORED) );
+    if ( rc )
+    {
+        ilog ("Shadow file has changed (%x)\n", rc );
+        if ( mtcInv.manage_shadow_change ( mtcInv.my_hostname ) != PASS )
+        {
+            elog ("failed to manage shadow file change notification (%d)\n", rc );
+        }
+        if ( rc & IN_IGNORED )
+        {
+            daemon_reactor_del ( mtcInv.inotify_shadow_file_fd );
+            set_inotify_close ( mtcInv.inotify_shadow_file_fd, mtcInv.inotify_shadow_file_wd );
+            set_inotify_watch_file ( SHADOW_FILE,
+                 mtcInv.inotify_shadow_file_fd ,
+                 mtcInv.inotify_shadow_file_wd );
+            if ( mtcInv.inotify_shadow_file_fd )
+                daemon_reactor_add ( mtcInv.inotify_shadow_file_fd, _reactor_shadow );
+            wlog ("Reselecting on %s change (Select:%d)\n", SHADOW_FILE, mtcInv.inotify_shadow_file_fd );
+        }
+    }
+    mlog3 ("inotify event handling done");
+}
+
 void daemon_service_run ( void )
 {
     int rc ;
 
-    /* socket descriptor list */
-    std::list<int> socks ;
-
     /* Set the mode */
     mtcInv_ptr->maintenance = true ;
     mtcInv_ptr->heartbeat   = false ;
 
+    /* Run this daemon's timers off the timer wheel rather than
+     * with a posix timer and signal per timer */
+    mtcTimer_wheel_init ();
+
     if (( mtc_sock.ioctl_sock = open_ioctl_socket ( )) <= 0 )
     {
         elog ("Failed to create ioctl socket");
@@ -1648,35 +1927,47 @@ void daemon_service_run ( void )
     send_hbs_command ( mtcInv.my_hostname, MTC_CMD_ADD_HOST );
     send_hbs_command ( mtcInv.my_hostname, MTC_CMD_START_HOST );
 
-    socks.clear();
+    /* Register the receive file descriptors with the reactor once ;
+     * the main loop then just waits on and dispatches them */
+    if ( daemon_reactor_init () != PASS )
+    {
+        elog ("Failed to create main loop reactor");
+        daemon_exit ();
+    }
 
     // service_events
-    socks.push_front (mtc_sock.mtc_event_rx_sock->getFD());
+    daemon_reactor_add ( mtc_sock.mtc_event_rx_sock->getFD(), _reactor_events );
 
     if ( mtcInv.pxeboot_network_provisioned )
     {
         // mtc_service_inbox - receive sockets from Pxeboot, Mgmt and Clstr network
-        if ( mtc_sock.pxeboot_rx_socket )
+        if ( mtc_sock.pxeboot_rx_socket > 0 )
         {
-            socks.push_front (mtc_sock.pxeboot_rx_socket);
+            daemon_reactor_add ( mtc_sock.pxeboot_rx_socket, _reactor_inbox,
+                                 (void*)(long)PXEBOOT_INTERFACE );
         }
     }
-    socks.push_front (mtc_sock.mtc_agent_mgmt_rx_socket->getFD());
-    if ( mtcInv.clstr_network_provisioned == true )
+    daemon_reactor_add ( mtc_sock.mtc_agent_mgmt_rx_socket->getFD(), _reactor_inbox,
+                         (void*)(long)MGMNT_INTERFACE );
+    if (( mtcInv.clstr_network_provisioned == true ) &&
+        ( mtc_sock.mtc_agent_clstr_rx_socket != NULL ))
     {
-        socks.push_front (mtc_sock.mtc_agent_clstr_rx_socket->getFD());
+        daemon_reactor_add ( mtc_sock.mtc_agent_clstr_rx_socket->getFD(), _reactor_inbox,
+                             (void*)(long)CLSTR_INTERFACE );
     }
 
-    socks.push_front (mtc_sock.netlink_sock);
+    if ( mtc_sock.netlink_sock )
+        daemon_reactor_add ( mtc_sock.netlink_sock, _reactor_netlink );
 
     if ( mtce_event.fd )
-        socks.push_front( mtce_event.fd ) ;
+        daemon_reactor_add ( mtce_event.fd, _reactor_http );
 
     /* Avoid selecting on file descriptors that are 0 */
     if ( mtcInv.inotify_shadow_file_fd )
-        socks.push_front (mtcInv.inotify_shadow_file_fd);
+        daemon_reactor_add ( mtcInv.inotify_shadow_file_fd, _reactor_shadow );
 
-    socks.sort();
+    if ( mtcTimer_wheel_enabled () )
+        daemon_reactor_add ( mtcTimer_wheel_fd(), _reactor_wheel );
 
     mtcInv.print_node_info();
 
@@ -1735,17 +2026,6 @@ void daemon_service_run ( void )
      * where it had commanded the hbsAgent to heartbeat at a reduced rate. */
     send_hbs_command ( mtcInv.my_hostname, MTC_RECOVER_HBS );
 
-    // Used to track mtcAgent incoming messaging rate
-    #define LOOP_TIMER_PERIOD_SECS    (60)
-    #define MSGS_PER_SEC_THRESHOLD    (20)
-    #define MSGS_CNT_IDX_INBOX        (0)
-    #define MSGS_CNT_IDX_EVENT        (1)
-    #define MSGS_CNT_IDX_PMOND        (2)
-    #define MSGS_CNT_IDX_HTTP         (3)
-    #define MSGS_CNT_IDX_NETLINK      (4)
-    #define MSGS_CNT_IDX_INOTIFY      (5)
-    #define MSGS_CNT_IDX_MAX          (6)
-    static unsigned int messages_tally[MSGS_CNT_IDX_MAX] = {0,0,0,0,0,0} ;
     static float messages_total = 0 ;
     mtcTimer_init ( mtcInv.mtcTimer_loop, mtcInv.my_hostname, "loop timer" );
 
@@ -1814,212 +2094,14 @@ void daemon_service_run ( void )
 
         mtcInv.fsm ( );
 
-        /* Initialize the master fd_set */
-        FD_ZERO(&mtc_sock.readfds);
-        FD_SET(mtc_sock.mtc_event_rx_sock->getFD(), &mtc_sock.readfds);
-        FD_SET(mtc_sock.mtc_agent_mgmt_rx_socket->getFD(), &mtc_sock.readfds);
-        if ( mtcInv.clstr_network_provisioned == true )
-        {
-            FD_SET(mtc_sock.mtc_agent_clstr_rx_socket->getFD(),&mtc_sock.readfds);
-        }
-        if ( mtcInv.pxeboot_network_provisioned == true )
-        {
-            // Listen to the pxeboot rx socket if it is setup
-            if ( mtc_sock.pxeboot_rx_socket > 0 )
-            {
-                FD_SET(mtc_sock.pxeboot_rx_socket, &mtc_sock.readfds);
-            }
-        }
-        if ( mtce_event.fd )
-        {
-            FD_SET(mtce_event.fd, &mtc_sock.readfds);
-        }
-        if ( mtcInv.inotify_shadow_file_fd )
-        {
-            FD_SET(mtcInv.inotify_shadow_file_fd, &mtc_sock.readfds);
-        }
-        if ( mtc_sock.netlink_sock )
-        {
-            FD_SET(mtc_sock.netlink_sock, &mtc_sock.readfds);
-        }
+        /* send the bmc pings queued by this fsm pass */
+        pingUtil_service ();
 
-        /* Initialize the timeval struct  */
-        mtc_sock.waitd.tv_sec = 0;
+        /* Wait up to the select timeout for and dispatch the ready fds */
         if ( mtcInv.system_type == SYSTEM_TYPE__NORMAL )
-            mtc_sock.waitd.tv_usec = MTCAGENT_SELECT_TIMEOUT ;
+            daemon_reactor_run ( MTCAGENT_SELECT_TIMEOUT/1000 );
         else
-            mtc_sock.waitd.tv_usec = MTCAGENT_AIO_SELECT_TIMEOUT ;
-
-        /* This is used as a delay up to select_timeout */
-        rc = select( socks.back()+1, &mtc_sock.readfds, NULL, NULL, &mtc_sock.waitd);
-
-        /* If the select time out expired then  */
-        if (( rc < 0 ) || ( rc == 0 ))
-        {
-            /* Check to see if the select call failed. */
-            /* ... but filter Interrupt signal         */
-            if (( rc < 0 ) && ( errno != EINTR ))
-            {
-                elog ( "Select Failed (rc:%d) %s \n", errno, strerror(errno));
-            }
-        }
-        else
-        {
-            if ( FD_ISSET( mtce_event.fd , &mtc_sock.readfds))
-            {
-                mlog3 ("http socket fired");
-                messages_tally[MSGS_CNT_IDX_HTTP]++ ;
-                mtcHttpSvr_look ( mtce_event );
-                mlog3 ("http handling done");
-            }
-            if (FD_ISSET(mtc_sock.netlink_sock, &mtc_sock.readfds))
-            {
-                mlog3 ("netlink socket fired");
-                messages_tally[MSGS_CNT_IDX_NETLINK]++ ;
-                if ( mtcInv.service_netlink_events ( mtc_sock.netlink_sock, mtc_sock.ioctl_sock ) != PASS )
-                {
-                    elog ("service_netlink_events failed (rc:%d)\n", rc );
-                }
-                mlog3 ("netlink handling done");
-            }
-
-            if (FD_ISSET(mtc_sock.mtc_event_rx_sock->getFD(), &mtc_sock.readfds))
-            {
-                mlog3 ("events socket fired");
-                messages_tally[MSGS_CNT_IDX_EVENT]++ ;
-                if ( (rc = service_events ( &mtcInv, &mtc_sock )) != PASS )
-                {
-                    elog ("service_events failed (rc:%d)\n", rc );
-                }
-                mlog3 ("events handling done");
-            }
-
-            if (( mtcInv.pxeboot_network_provisioned == true ) &&
-                ( mtc_sock.pxeboot_rx_socket && FD_ISSET(mtc_sock.pxeboot_rx_socket, &mtc_sock.readfds)))
-            {
-                int cnt = 0 ;
-                /* Service up to MAX_RX_MSG_BATCH of messages at once */
-                mlog3 ("pxeboot network socket fired");
-                for ( ; cnt < MAX_RX_MSG_BATCH ; cnt++ )
-                {
-                    mlog3 ("... service inbox ; message %d", cnt+1);
-                    rc =  mtc_service_inbox ( &mtcInv, &mtc_sock , PXEBOOT_INTERFACE) ;
-                    if ( rc == RETRY )
-                    {
-                        mlog3 ("... service inbox done");
-                        break ;
-                    }
-                    messages_tally[MSGS_CNT_IDX_INBOX]++ ;
-                    if ( rc > RETRY )
-                    {
-                        wlog ("mtc_service_inbox failed (rc:%d) (pxeboot)", rc );
-                        break ;
-                    }
-                    else
-                    {
-                       mlog3 ("......more messages to service");
-                    }
-                }
-                if ( cnt > (MAX_RX_MSG_BATCH/2) )
-                {
-                    ilog ("serviced %d messages in one batch (pxeboot)", cnt );
-                }
-                mlog3 ("pxeboot network message handling done");
-            }
-
-            if ( FD_ISSET(mtc_sock.mtc_agent_mgmt_rx_socket->getFD(), &mtc_sock.readfds))
-            {
-                int cnt = 0 ;
-                /* Service up to MAX_RX_MSG_BATCH of messages at once */
-                mlog3 ("mgmt network socket fired");
-                for ( ; cnt < MAX_RX_MSG_BATCH ; cnt++ )
-                {
-                    mlog3 ("... service inbox ; message %d", cnt+1);
-                    rc =  mtc_service_inbox ( &mtcInv, &mtc_sock , MGMNT_INTERFACE) ;
-                    if ( rc == RETRY )
-                    {
-                        mlog3 ("... service inbox done");
-                        break ;
-                    }
-                    messages_tally[MSGS_CNT_IDX_INBOX]++ ;
-                    if ( rc > RETRY )
-                    {
-                        wlog ("mtc_service_inbox failed (rc:%d) (Mgmnt)", rc );
-                        break ;
-                    }
-                    else
-                    {
-                        mlog3 ("......more messages to service");
-                    }
-                }
-                if ( cnt > (MAX_RX_MSG_BATCH/2) )
-                {
-                    ilog ("serviced %d messages in one batch (Mgmnt)", cnt );
-                }
-                mlog3 ("mgmt network message handling done");
-            }
-
-            if (( mtcInv.clstr_network_provisioned == true ) &&
-                ( mtc_sock.mtc_agent_clstr_rx_socket != NULL ) &&
-                ( FD_ISSET(mtc_sock.mtc_agent_clstr_rx_socket->getFD(), &mtc_sock.readfds)))
-            {
-                int cnt = 0 ;
-                /* Service up to MAX_RX_MSG_BATCH of messages at once */
-                mlog3 ("clstr network socket fired");
-                for ( ; cnt < MAX_RX_MSG_BATCH ; cnt++ )
-                {
-                    mlog3 ("... service inbox ; message %d", cnt+1);
-
-                    rc =  mtc_service_inbox ( &mtcInv, &mtc_sock, CLSTR_INTERFACE ) ;
-                    if ( rc == RETRY )
-                    {
-                        mlog3 ("... service inbox done");
-                        break ;
-                    }
-                    messages_tally[MSGS_CNT_IDX_INBOX]++ ;
-                    if ( rc > RETRY )
-                    {
-                        mlog ("mtc_service_inbox failed (rc:%d) (Clstr)\n", rc );
-                        break ;
-                    }
-                    else
-                    {
-                        mlog3 ("......more messages to service");
-                    }
-                }
-                if ( cnt > (MAX_RX_MSG_BATCH/2) )
-                {
-                   ilog ("serviced %d messages in one batch (Clstr)", cnt );
-                }
-                mlog3 ("mgmt network message handling done");
-            }
-            if (FD_ISSET(mtcInv.inotify_shadow_file_fd, &mtc_sock.readfds))
-            {
-                mlog3 ("inotify socket fired");
-                messages_tally[MSGS_CNT_IDX_INOTIFY]++ ;
-                rc = get_inotify_events ( mtcInv.inotify_shadow_file_fd, (IN_MODIFY | IN_CREATE | IN_IGNORED) );
-                if ( rc )
-                {
-                    ilog ("Shadow file has changed (%x)\n", rc );
-                    if ( mtcInv.manage_shadow_change ( mtcInv.my_hostname ) != PASS )
-                    {
-                        elog ("failed to manage shadow file change notification (%d)\n", rc );
-                    }
-                    if ( rc & IN_IGNORED )
-                    {
-                        socks.remove(mtcInv.inotify_shadow_file_fd);
-                        set_inotify_close ( mtcInv.inotify_shadow_file_fd, mtcInv.inotify_shadow_file_wd );
-                        set_inotify_watch_file ( SHADOW_FILE,
-                             mtcInv.inotify_shadow_file_fd ,
-                             mtcInv.inotify_shadow_file_wd );
-                        socks.push_back (mtcInv.inotify_shadow_file_fd);
-                        socks.sort();
-                        wlog ("Reselecting on %s change (Select:%d)\n", SHADOW_FILE, mtcInv.inotify_shadow_file_fd );
-                    }
-                }
-                mlog3 ("inotify event handling done");
-            }
-        }
+            daemon_reactor_run ( MTCAGENT_AIO_SELECT_TIMEOUT/1000 );
 
         daemon_signal_hdlr ();
 
@@ -2045,6 +2127,9 @@ void daemon_dump_info ( void )
     daemon_dump_membuf_banner ();
 
     mtcTimer_mem_log ();
+    threadUtil_workers_dump ();
+    daemon_reactor_dump ();
+    mtcInv.fsm_dump ();
     mtcInv.print_node_info ();
     daemon_dump_membuf (); /* write mem_logs to log file and clear log list */
 
@@ -2078,10 +2163,67 @@ const char * daemon_stream_info ( void )
 
 extern int mtcJsonInv_testhead ( void );
 
+/* Tests the fsm_idle invariant that a host whose bmc ping is in the
+ * RECV stage can be parked until the stage deadline. Its request is
+ * sent and the reply routed by the pingUtil_service call made on every
+ * main loop pass, so the reply must already be there when the host runs
+ * again at the deadline. */
+static int _testhead_ping_recv ( void )
+{
+    int rc = PASS ;
+    ping_info_type ping_info ;
+    string hostname = "testhost" ;
+
+    printf ("| Ping Monitor : parked in RECV completes without a retry            | ");
+    if ( pingUtil_init ( hostname, ping_info, "127.0.0.1" ) != PASS )
+    {
+        FAILED ;
+        return (FAIL);
+    }
+
+    ping_info.stage = PINGUTIL_MONITOR_STAGE__SEND ;
+    pingUtil_acc_monitor ( ping_info );
+    if ( ping_info.stage != PINGUTIL_MONITOR_STAGE__RECV )
+    {
+        rc = FAIL ;
+    }
+    else
+    {
+        /* main loop passes while the host is parked */
+        while ( gettime_monotonic_nsec () < ping_info.deadline )
+        {
+            pingUtil_service ();
+            usleep (10000);
+        }
+
+        /* the reply must be in before the host runs again */
+        bool received = ping_info.received ;
+        pingUtil_acc_monitor ( ping_info );
+        if (( received == false ) ||
+            ( ping_info.stage != PINGUTIL_MONITOR_STAGE__WAIT ) ||
+            ( ping_info.ok    != true ) ||
+            ( ping_info.recv_retries != 0 ))
+        {
+            rc = FAIL ;
+        }
+    }
+    if ( rc == PASS ) { PASSED ; } else { FAILED ; }
+    pingUtil_fini ( ping_info );
+    return (rc);
+}
+
 /** Teat Head Entry */
 int daemon_run_testhead ( void )
 {
     int rc    = PASS;
+
+    printf  ("\n\n");
+    printf  (TESTHEAD_BAR);
+    printf  ("| Maintenance Agent Test Head\n");
+    printf  (TESTHEAD_BAR);
+    if ( _testhead_ping_recv () != PASS )
+        rc = FAIL ;
+    printf  (TESTHEAD_BAR);
     return (rc);
 }
 
@@ -104,175 +104,149 @@ int nodeLinkClass::calc_reset_prog_timeout ( struct nodeLinkClass::node * node_p
 
 void mtcTimer_handler ( int sig, siginfo_t *si, void *uc);
 
-/* Looks up the timer ID and asserts the corresponding node's ringer */
-void nodeLinkClass::timer_handler ( int sig, siginfo_t *si, void *uc)
+/* Rings the timer if it is one of this node's timers ; returns true if it was */
+bool nodeLinkClass::timer_handler_node ( struct nodeLinkClass::node * node_ptr,
+                                         struct mtc_timer * fired )
 {
-    struct nodeLinkClass::node * node_ptr ;
-
-    /* sival_ptr points directly to the mtc_timer struct that fired.
-     * This avoids relying on tid values for identification
-     * (tid can be 0 in glibc 2.36+) and avoids needing unique
-     * RT signals per timer. */
-    struct mtc_timer * fired = (struct mtc_timer *)si->si_value.sival_ptr ;
-
-    /* Avoid compiler errors/warnings for parms we must
-     * have but currently do nothing with */
-    sig=sig ; uc = uc ;
-
-    if ( fired == NULL )
+    if ( fired == &node_ptr->offline_timer )
     {
-        // tlog ("Called with a NULL Timer pointer\n");
-        return ;
+        mtcTimer_stop_int_safe ( node_ptr->offline_timer );
+        node_ptr->offline_timer.ring = true ;
+        return (true);
     }
-
-    /* Search per-host timers */
-    for ( node_ptr = head ; node_ptr != NULL ; node_ptr = node_ptr->next )
+    if ( fired == &node_ptr->online_timer )
     {
-        if ( fired == &node_ptr->offline_timer )
-        {
-            mtcTimer_stop_int_safe ( node_ptr->offline_timer );
-            node_ptr->offline_timer.ring = true ;
-            return ;
-        }
-        if ( fired == &node_ptr->online_timer )
-        {
-            mtcTimer_stop_int_safe ( node_ptr->online_timer );
-            node_ptr->online_timer.ring = true ;
-            return ;
-        }
-        if ( fired == &node_ptr->mtcAlive_timer )
-        {
-            mtcTimer_stop_int_safe ( node_ptr->mtcAlive_timer );
-            node_ptr->mtcAlive_timer.ring = true ;
-            return ;
-        }
-        if ( fired == &node_ptr->mtcCmd_timer )
-        {
-            mtcTimer_stop_int_safe ( node_ptr->mtcCmd_timer );
-            node_ptr->mtcCmd_timer.ring = true ;
-            return ;
-        }
-        if ( fired == &node_ptr->insvTestTimer )
-        {
-            mtcTimer_stop_int_safe ( node_ptr->insvTestTimer );
-            node_ptr->insvTestTimer.ring = true ;
-            return ;
-        }
-        if ( fired == &node_ptr->oosTestTimer )
-        {
-            mtcTimer_stop_int_safe ( node_ptr->oosTestTimer );
-            node_ptr->oosTestTimer.ring = true ;
-            return ;
-        }
-        if ( fired == &node_ptr->mtcSwact_timer )
-        {
-            mtcTimer_stop_int_safe ( node_ptr->mtcSwact_timer );
-            node_ptr->mtcSwact_timer.ring = true ;
-            return ;
-        }
-        if ( fired == &node_ptr->http_timer )
-        {
-            mtcTimer_stop_int_safe ( node_ptr->http_timer );
-            node_ptr->http_timer.ring = true ;
-            if ( node_ptr->http_timer.mutex == true )
-                node_ptr->http_timer.error = true ;
-            return ;
-        }
-        if ( fired == &node_ptr->mtcTimer )
-        {
-            mtcTimer_stop_int_safe ( node_ptr->mtcTimer );
-            node_ptr->mtcTimer.ring = true ;
-            return ;
-        }
-        if ( fired == &node_ptr->mtcConfig_timer )
-        {
-            mtcTimer_stop_int_safe ( node_ptr->mtcConfig_timer );
-            node_ptr->mtcConfig_timer.ring = true ;
-            return ;
-        }
-        if ( fired == &node_ptr->bmc_thread_ctrl.timer )
-        {
-            mtcTimer_stop_int_safe ( node_ptr->bmc_thread_ctrl.timer );
-            node_ptr->bmc_thread_ctrl.timer.ring = true ;
-            return ;
-        }
-        if ( fired == &node_ptr->bm_ping_info.timer )
-        {
-            mtcTimer_stop_int_safe ( node_ptr->bm_ping_info.timer );
-            node_ptr->bm_ping_info.timer.ring = true ;
-            return ;
-        }
-        if ( fired == &node_ptr->bm_timer )
-        {
-            mtcTimer_stop_int_safe ( node_ptr->bm_timer );
-            node_ptr->bm_timer.ring = true ;
-            return ;
-        }
-        if ( fired == &node_ptr->bmc_access_timer )
-        {
-            mtcTimer_stop_int_safe ( node_ptr->bmc_access_timer );
-            node_ptr->bmc_access_timer.ring = true ;
-            return ;
-        }
-        if ( fired == &node_ptr->bmc_audit_timer )
-        {
-            mtcTimer_stop_int_safe ( node_ptr->bmc_audit_timer );
-            node_ptr->bmc_audit_timer.ring = true ;
-            return ;
-        }
-        if ( fired == &node_ptr->host_services_timer )
-        {
-            mtcTimer_stop_int_safe ( node_ptr->host_services_timer );
-            node_ptr->host_services_timer.ring = true ;
-            return ;
-        }
-        if ( fired == &node_ptr->hwmon_powercycle.recovery_timer )
-        {
-            if ( node_ptr->hwmon_powercycle.attempts )
-            {
-                tlog ("%s powercycle monitor completed successfully after attempt %d\n",
-                          node_ptr->hostname.c_str(),
-                          node_ptr->hwmon_powercycle.attempts);
-            }
-            recovery_ctrl_init ( node_ptr->hwmon_powercycle );
-            if (( node_ptr->adminAction == MTC_ADMIN_ACTION__NONE ) &&
-                ( node_ptr->availStatus != MTC_AVAIL_STATUS__POWERED_OFF ))
-            {
-               node_ptr->clear_task = true ;
-            }
-            mtcTimer_stop_int_safe ( node_ptr->hwmon_powercycle.recovery_timer );
-            node_ptr->hwmon_powercycle.recovery_timer.ring = true ;
-            return ;
-        }
-        if ( fired == &node_ptr->hwmon_powercycle.control_timer )
-        {
-            mtcTimer_stop_int_safe ( node_ptr->hwmon_powercycle.control_timer );
-            node_ptr->hwmon_powercycle.control_timer.ring = true ;
-            return ;
-        }
-        if ( fired == &node_ptr->hwmon_reset.recovery_timer )
+        mtcTimer_stop_int_safe ( node_ptr->online_timer );
+        node_ptr->online_timer.ring = true ;
+        return (true);
+    }
+    if ( fired == &node_ptr->mtcAlive_timer )
+    {
+        mtcTimer_stop_int_safe ( node_ptr->mtcAlive_timer );
+        node_ptr->mtcAlive_timer.ring = true ;
+        return (true);
+    }
+    if ( fired == &node_ptr->mtcCmd_timer )
+    {
+        mtcTimer_stop_int_safe ( node_ptr->mtcCmd_timer );
+        node_ptr->mtcCmd_timer.ring = true ;
+        return (true);
+    }
+    if ( fired == &node_ptr->insvTestTimer )
+    {
+        mtcTimer_stop_int_safe ( node_ptr->insvTestTimer );
+        node_ptr->insvTestTimer.ring = true ;
+        return (true);
+    }
+    if ( fired == &node_ptr->oosTestTimer )
+    {
+        mtcTimer_stop_int_safe ( node_ptr->oosTestTimer );
+        node_ptr->oosTestTimer.ring = true ;
+        return (true);
+    }
+    if ( fired == &node_ptr->mtcSwact_timer )
+    {
+        mtcTimer_stop_int_safe ( node_ptr->mtcSwact_timer );
+        node_ptr->mtcSwact_timer.ring = true ;
+        return (true);
+    }
+    if ( fired == &node_ptr->http_timer )
+    {
+        mtcTimer_stop_int_safe ( node_ptr->http_timer );
+        node_ptr->http_timer.ring = true ;
+        if ( node_ptr->http_timer.mutex == true )
+            node_ptr->http_timer.error = true ;
+        return (true);
+    }
+    if ( fired == &node_ptr->mtcTimer )
+    {
+        mtcTimer_stop_int_safe ( node_ptr->mtcTimer );
+        node_ptr->mtcTimer.ring = true ;
+        return (true);
+    }
+    if ( fired == &node_ptr->mtcConfig_timer )
+    {
+        mtcTimer_stop_int_safe ( node_ptr->mtcConfig_timer );
+        node_ptr->mtcConfig_timer.ring = true ;
+        return (true);
+    }
+    if ( fired == &node_ptr->bmc_thread_ctrl.timer )
+    {
+        mtcTimer_stop_int_safe ( node_ptr->bmc_thread_ctrl.timer );
+        node_ptr->bmc_thread_ctrl.timer.ring = true ;
+        return (true);
+    }
+    if ( fired == &node_ptr->bm_timer )
+    {
+        mtcTimer_stop_int_safe ( node_ptr->bm_timer );
+        node_ptr->bm_timer.ring = true ;
+        return (true);
+    }
+    if ( fired == &node_ptr->bmc_access_timer )
+    {
+        mtcTimer_stop_int_safe ( node_ptr->bmc_access_timer );
+        node_ptr->bmc_access_timer.ring = true ;
+        return (true);
+    }
+    if ( fired == &node_ptr->bmc_audit_timer )
+    {
+        mtcTimer_stop_int_safe ( node_ptr->bmc_audit_timer );
+        node_ptr->bmc_audit_timer.ring = true ;
+        return (true);
+    }
+    if ( fired == &node_ptr->host_services_timer )
+    {
+        mtcTimer_stop_int_safe ( node_ptr->host_services_timer );
+        node_ptr->host_services_timer.ring = true ;
+        return (true);
+    }
+    if ( fired == &node_ptr->hwmon_powercycle.recovery_timer )
+    {
+        if ( node_ptr->hwmon_powercycle.attempts )
         {
-            tlog ("%s clearing hwmon reset holdoff timer\n",
-                      node_ptr->hostname.c_str());
-            recovery_ctrl_init ( node_ptr->hwmon_reset );
-            mtcTimer_stop_int_safe ( node_ptr->hwmon_reset.recovery_timer );
-            node_ptr->hwmon_reset.recovery_timer.ring = true ;
-            return ;
+            tlog ("%s powercycle monitor completed successfully after attempt %d\n",
+                      node_ptr->hostname.c_str(),
+                      node_ptr->hwmon_powercycle.attempts);
         }
-        if ( fired == &node_ptr->hwmon_reset.control_timer )
+        recovery_ctrl_init ( node_ptr->hwmon_powercycle );
+        if (( node_ptr->adminAction == MTC_ADMIN_ACTION__NONE ) &&
+            ( node_ptr->availStatus != MTC_AVAIL_STATUS__POWERED_OFF ))
         {
-            tlog ("%s ringing hwmon reset control timer\n",
-                      node_ptr->hostname.c_str());
-            mtcTimer_stop_int_safe ( node_ptr->hwmon_reset.control_timer );
-            node_ptr->hwmon_reset.control_timer.ring = true ;
-            return ;
+           node_ptr->clear_task = true ;
         }
-
-        if ( node_ptr->next == NULL )
-            break ;
+        mtcTimer_stop_int_safe ( node_ptr->hwmon_powercycle.recovery_timer );
+        node_ptr->hwmon_powercycle.recovery_timer.ring = true ;
+        return (true);
+    }
+    if ( fired == &node_ptr->hwmon_powercycle.control_timer )
+    {
+        mtcTimer_stop_int_safe ( node_ptr->hwmon_powercycle.control_timer );
+        node_ptr->hwmon_powercycle.control_timer.ring = true ;
+        return (true);
+    }
+    if ( fired == &node_ptr->hwmon_reset.recovery_timer )
+    {
+        tlog ("%s clearing hwmon reset holdoff timer\n",
+                  node_ptr->hostname.c_str());
+        recovery_ctrl_init ( node_ptr->hwmon_reset );
+        mtcTimer_stop_int_safe ( node_ptr->hwmon_reset.recovery_timer );
+        node_ptr->hwmon_reset.recovery_timer.ring = true ;
+        return (true);
+    }
+    if ( fired == &node_ptr->hwmon_reset.control_timer )
+    {
+        tlog ("%s ringing hwmon reset control timer\n",
+                  node_ptr->hostname.c_str());
+        mtcTimer_stop_int_safe ( node_ptr->hwmon_reset.control_timer );
+        node_ptr->hwmon_reset.control_timer.ring = true ;
+        return (true);
     }
+    return (false);
+}
 
-    /* Check global (non-per-host) timers */
+/* Rings the timer if it is one of the global (non-per-host) timers */
+bool nodeLinkClass::timer_handler_global ( struct mtc_timer * fired )
+{
 
     /* Dead Office Recovery Mode Timer */
     if ( fired == &mtcTimer_dor )
@@ -280,7 +254,7 @@ void nodeLinkClass::timer_handler ( int sig, siginfo_t *si, void *uc)
         mtcTimer_stop_int_safe ( mtcTimer_dor );
         mtcTimer_dor.ring = true ;
         this->dor_mode_active_log_throttle = 0 ;
-        return ;
+        return (true);
     }
 
     /* Multi-Node Failure Avoidance Timer */
@@ -288,7 +262,7 @@ void nodeLinkClass::timer_handler ( int sig, siginfo_t *si, void *uc)
     {
         mtcTimer_stop_int_safe ( mtcTimer_mnfa );
         mtcTimer_mnfa.ring = true ;
-        return ;
+        return (true);
     }
 
     /* base mtc timer */
@@ -296,7 +270,7 @@ void nodeLinkClass::timer_handler ( int sig, siginfo_t *si, void *uc)
     {
         mtcTimer_stop_int_safe ( mtcTimer );
         mtcTimer.ring = true ;
-        return ;
+        return (true);
     }
 
     /* uptime refresh timer */
@@ -343,7 +317,7 @@ void nodeLinkClass::timer_handler ( int sig, siginfo_t *si, void *uc)
                 }
             }
         }
-        return ;
+        return (true);
     }
 
     /* keystone token refresh timer */
@@ -351,7 +325,7 @@ void nodeLinkClass::timer_handler ( int sig, siginfo_t *si, void *uc)
     {
         mtcTimer_stop_int_safe ( mtcTimer_token );
         mtcTimer_token.ring = true ;
-        return ;
+        return (true);
     }
 
 #ifdef WANT_FIT_TESTING
@@ -362,7 +336,7 @@ void nodeLinkClass::timer_handler ( int sig, siginfo_t *si, void *uc)
         mtcTimer_fit.ring = true ;
         if ( daemon_want_fit ( FIT_CODE__CORRUPT_TOKEN, mtcTimer_fit.hostname, "random"))
             tokenUtil_fail_token ();
-        return ;
+        return (true);
     }
 #endif
 
@@ -371,9 +345,72 @@ void nodeLinkClass::timer_handler ( int sig, siginfo_t *si, void *uc)
     {
         mtcTimer_stop_int_safe ( mtcTimer_loop );
         mtcTimer_loop.ring = true ;
+        return (true);
+    }
+    return (false);
+}
+
+/* Looks up the timer ID and asserts the corresponding node's ringer */
+void nodeLinkClass::timer_handler ( int sig, siginfo_t *si, void *uc)
+{
+    struct nodeLinkClass::node * node_ptr ;
+
+    /* sival_ptr points directly to the mtc_timer struct that fired.
+     * This avoids relying on tid values for identification
+     * (tid can be 0 in glibc 2.36+) and avoids needing unique
+     * RT signals per timer. */
+    struct mtc_timer * fired = (struct mtc_timer *)si->si_value.sival_ptr ;
+
+    /* Avoid compiler errors/warnings for parms we must
+     * have but currently do nothing with */
+    sig=sig ; uc = uc ;
+
+    if ( fired == NULL )
+    {
+        // tlog ("Called with a NULL Timer pointer\n");
+        return ;
+    }
+
+    /* Timer wheel timers are dispatched at base level rather than from
+     * a signal so the owning node can be found through the node index
+     * rather than by searching every timer of every node. */
+    if ( fired->wheel == true )
+    {
+        node_ptr = getNode ( fired->hostname );
+        if (( node_ptr ) && ( timer_handler_node ( node_ptr, fired ) == true ))
+        {
+            /* run the host the timer belongs to on the next fsm pass */
+            fsm_wake ( node_ptr );
+            return ;
+        }
+    }
+
+    /* The dor, mnfa and base timers are acted on from any host's fsm
+     * and the search below may be run from signal context ; in those
+     * cases just request a sweep of all hosts */
+    if ( timer_handler_global ( fired ) == true )
+    {
+        if (( fired == &mtcTimer_dor ) || ( fired == &mtcTimer_mnfa ) ||
+            ( fired == &mtcTimer ))
+        {
+            fsm_sweep_now = true ;
+        }
         return ;
     }
 
+    /* Search per-host timers */
+    for ( node_ptr = head ; node_ptr != NULL ; node_ptr = node_ptr->next )
+    {
+        if ( timer_handler_node ( node_ptr, fired ) == true )
+        {
+            fsm_sweep_now = true ;
+            return ;
+        }
+
+        if ( node_ptr->next == NULL )
+            break ;
+    }
+
     /* Unknown timer - log and ignore */
     mtcTimer_stop_tid_int_safe ( &fired->tid );
 }
@@ -2948,6 +2985,7 @@ int nodeLinkClass::disable_handler  ( struct nodeLinkClass::node * node_ptr )
                 node_ptr->cmd.cmd   = MTC_OPER__RESET_PROGRESSION ;
                 node_ptr->cmd.parm1 = 2 ; /* 2 retries */
                 node_ptr->mtcCmd_work_fifo.push_back(node_ptr->cmd);
+                fsm_wake ( node_ptr );
 
                 int timeout = ((MTC_RESET_PROG_TIMEOUT*(node_ptr->cmd.parm1+1))*2) ;
                 mtcTimer_start ( node_ptr->mtcTimer, mtcTimer_handler, timeout ) ;
@@ -37,6 +37,7 @@ using namespace std;
 #include "threadUtil.h"
 #include "mtcThreads.h"    /* for ... IPMITOOL_THREAD_CMD__RESET ...   */
 #include "bmcUtil.h"       /* for ... mtce-common bmc utility header   */
+#include "redfishClient.h" /* for ... redfishClient_command            */
 
 /**************************************************************************
  *
@@ -83,7 +84,6 @@ void * mtcThread_bmc ( void * arg )
     {
         info_ptr->progress++ ;
         info_ptr->runcount++ ;
-        pthread_exit (&info_ptr->status );
         return NULL ;
     }
 #endif
@@ -242,6 +242,49 @@ void * mtcThread_bmc ( void * arg )
             }
             goto bmc_thread_done ;
         }
+        else if (( info_ptr->proto == BMC_PROTOCOL__REDFISHTOOL ) &&
+                 ( redfishClient_selected ( info_ptr->hostname )))
+        {
+            /* In-process redfish client ; no password file or forked
+             * redfishtool and the response is returned in memory. */
+            blog1_t ("%s redfish client '%s'", info_ptr->hostname.c_str(), command.c_str());
+
+            rc = redfishClient_command ( info_ptr->hostname,
+                                         extra_ptr->bm_ip,
+                                         extra_ptr->bm_un,
+                                         extra_ptr->bm_pw,
+                                         command,
+                                         response );
+            info_ptr->progress++ ;
+            if ( rc != PASS )
+            {
+                /* the root query is expected to fail during learning */
+                if ( info_ptr->command != BMC_THREAD_CMD__BMC_QUERY )
+                {
+                    elog_t ("%s redfish client '%s' failed (rc:%d) %s\n",
+                                info_ptr->hostname.c_str(),
+                                command.c_str(),
+                                rc, response.c_str());
+                }
+                info_ptr->status_string = response ;
+                info_ptr->status = FAIL_SYSTEM_CALL ;
+            }
+            else if ( info_ptr->command == BMC_THREAD_CMD__BMC_INFO )
+            {
+                /* the bmc info consumers read the response from a file */
+                datafile = bmcUtil_create_data_fn ( info_ptr->hostname,
+                                                    suffix,
+                                                    BMC_PROTOCOL__REDFISHTOOL );
+                daemon_remove_file ( datafile.data() );
+                daemon_log ( datafile.data(), response.data() );
+                info_ptr->data = datafile ;
+            }
+            else
+            {
+                info_ptr->data = response ;
+            }
+            goto bmc_thread_done ;
+        }
         else if ( info_ptr->proto == BMC_PROTOCOL__REDFISHTOOL )
         {
             dlog_t ("%s '%s' command\n", info_ptr->log_prefix, command.c_str());
@@ -656,6 +699,7 @@ bmc_thread_done:
 
     info_ptr->progress++ ;
     info_ptr->runcount++ ;
-    pthread_exit (&info_ptr->status );
+
+    /* return rather than pthread_exit so a pool worker can be reused */
     return NULL ;
 }
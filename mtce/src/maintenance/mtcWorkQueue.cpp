@@ -19,6 +19,7 @@
   *
   *    _get_work_state_str
   *    _get_event_log_prefix_string
+  *    _get_update_rank
   *
   *
   */
@@ -30,6 +31,7 @@ using namespace std;
 #include "mtcNodeHdlrs.h"   /* for ... mtcTimer_handl                  */
 #include "nodeUtil.h"       /* for ... common Node Utilities           */
 #include "tokenUtil.h"      /* for ... token utilities                 */
+#include "jsonUtil.h"       /* for ... jsonUtil_patch_merge            */
 
 #define QUEUE_OVERLOAD (100)
 #define VERBOSE_ENQUEUE_LOG_THRESHOLD (4)
@@ -53,8 +55,32 @@ string _get_work_state_str ( httpStages_enum state )
 }
 
 
+/* Rank the sysinv update operations that may be coalesced.
+ *
+ * A coalesced request is handled as the highest ranked operation it
+ * carries so that the state operations still get their admin, oper and
+ * avail response validation. Returns -1 for operations that must never
+ * be coalesced. */
+static int _get_update_rank ( string & operation )
+{
+    if ( !operation.compare(SYSINV_OPER__FORCE_STATES))  return (5);
+    if ( !operation.compare(SYSINV_OPER__UPDATE_STATES)) return (4);
+    if ( !operation.compare(SYSINV_OPER__UPDATE_STATE))  return (4);
+    if ( !operation.compare(SYSINV_OPER__UPDATE_VALUE))  return (3);
+    if ( !operation.compare(SYSINV_OPER__FORCE_TASK))    return (2);
+    if ( !operation.compare(SYSINV_OPER__UPDATE_TASK))   return (1);
+    if ( !operation.compare(SYSINV_OPER__UPDATE_UPTIME)) return (0);
+    return (-1);
+}
+
 void nodeLinkClass::workQueue_dump ( struct nodeLinkClass::node * node_ptr )
 {
+    if ( node_ptr->oper_coalesced )
+    {
+        syslog ( LOG_INFO, "%s work queue coalesced %d sysinv update requests\n",
+                           node_ptr->hostname.c_str(),
+                           node_ptr->oper_coalesced );
+    }
     if ( node_ptr->libEvent_work_fifo.size() )
     {
         syslog ( LOG_INFO, "\n");
@@ -147,6 +173,15 @@ void nodeLinkClass::doneQueue_dump_all ( void )
  *              (to avoid repeated recreation) and then copies that
  *              event to the work queue.
  *
+ *              A sysinv update (PATCH) for a host whose last queued
+ *              request is a not yet transmitted sysinv update for the
+ *              same uuid is coalesced into that queued request rather
+ *              than added behind it. Only the tail of the queue is
+ *              considered so requests never pass one another ; within
+ *              the merged json-patch document the last writer wins per
+ *              path. The caller's event takes on the sequence number of
+ *              the merged request so done queue lookups still work.
+ *
  * @param event is a reference to the callers libEvent.
  * @return an integer with value of PASS.
  *
@@ -181,6 +216,45 @@ int nodeLinkClass::workQueue_enqueue ( libEvent & event )
         event.log_prefix.append (" ");
         event.log_prefix.append (event.service) ;
     }
+
+    if (( size ) && ( event.request == SYSINV_UPDATE ))
+    {
+        libEvent & tail = node_ptr->libEvent_work_fifo.back();
+        int new_rank = _get_update_rank ( event.operation );
+        int old_rank = _get_update_rank ( tail.operation );
+        if (( tail.request == SYSINV_UPDATE ) &&
+            ( tail.state   == HTTP__TRANSMIT ) &&
+            ( tail.uuid    == event.uuid ) &&
+            ( tail.ip      == event.ip ) &&
+            ( tail.port    == event.port ) &&
+            ( new_rank >= 0 ) && ( old_rank >= 0 ) &&
+            ( jsonUtil_patch_merge ( tail.payload, event.payload ) == PASS ))
+        {
+            if ( new_rank >= old_rank )
+            {
+                tail.operation   = event.operation   ;
+                tail.information = event.information ;
+            }
+            if ( event.timeout > tail.timeout )
+                tail.timeout = event.timeout ;
+            if ( event.max_retries > tail.max_retries )
+                tail.max_retries = event.max_retries ;
+            tail.noncritical = ( tail.noncritical && event.noncritical );
+
+            event.sequence = tail.sequence ;
+            sprintf ( &seq_str[0], "%d", event.sequence );
+            event.log_prefix.append (" seq:");
+            event.log_prefix.append (seq_str) ;
+
+            node_ptr->oper_coalesced++ ;
+            dlog ("%s coalesced '%s' ; %d total\n",
+                      event.log_prefix.c_str(),
+                      event.information.c_str(),
+                      node_ptr->oper_coalesced );
+            return (PASS);
+        }
+    }
+
     event.sequence = node_ptr->oper_sequence++ ;
     sprintf ( &seq_str[0], "%d", event.sequence );
     event.log_prefix.append (" seq:");
@@ -188,6 +262,7 @@ int nodeLinkClass::workQueue_enqueue ( libEvent & event )
 
     /* add the event to this host's work fifo */
     node_ptr->libEvent_work_fifo.push_back(event);
+    fsm_wake ( node_ptr );
 
     /* Log the number of enqueued requests for this host
      * if the number exceeds VERBOSE_ENQUEUE_LOG_THRESHOLD.
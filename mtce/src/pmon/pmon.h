@@ -90,6 +90,8 @@
 #include <sys/wait.h>      /* for ... waitpid                 */
 #include <time.h>          /* for ... time                    */
 #include <sys/prctl.h>     /* for program control header      */
+#include <sys/epoll.h>     /* for ... pidfd exit event set    */
+#include <sys/syscall.h>   /* for ... pidfd_open              */
 #include <sys/types.h>     /*                                 */
 #include <sys/socket.h>    /* for ... socket                  */
 #include <linux/un.h>      /* for ... domain socket type      */
@@ -194,6 +196,26 @@ enum
 #define MON_STOPPED 0x20
 #define MON_CONTINUED 0x40
 
+/* Stock kernels without the PR_DO_NOTIFY_TASK_STATE patch can report
+ * the exit of an arbitrary process through a pidfd (linux 5.3+) that
+ * becomes readable when that process exits. Older glibc headers may
+ * not define the syscall number ; it is the same on all architectures. */
+#ifndef SYS_pidfd_open
+#define SYS_pidfd_open 434
+#endif
+
+/* Process exit event method ; pmond.conf [config] event_method */
+typedef enum
+{
+    PMON_EVENT_METHOD__AUTO    = 0, /**< prctl, then pidfd, then polling   */
+    PMON_EVENT_METHOD__PRCTL   = 1, /**< PR_DO_NOTIFY_TASK_STATE signal    */
+    PMON_EVENT_METHOD__PIDFD   = 2, /**< pidfd readable on process exit    */
+    PMON_EVENT_METHOD__POLLING = 3, /**< pidfile and kill 0 audit          */
+} pmon_event_method_enum ;
+
+pmon_event_method_enum get_event_method     ( const char * method_str );
+const char *           get_event_method_str ( pmon_event_method_enum method );
+
 typedef enum
 {
    PMOND_RECOVERY_METHOD__SYSVINIT = 0,
@@ -228,6 +250,10 @@ typedef struct
     struct sigaction prev ; /**< Action handler that was replaced  */
                             /**< This is put back on the exit      */
     bool   event_mode     ; /**< true=event mode ; false=polling   */
+    pmon_event_method_enum event_method ; /**< configured event method */
+    pmon_event_method_enum event_active ; /**< event method in use     */
+    int    event_fd       ; /**< epoll set of process pidfds       */
+    int    child_fd       ; /**< epoll set of child script pidfds  */
     int    fd             ; /**< inotify file descriptor           */
     int    wd             ; /**< inotify watch descriptor          */
 
@@ -453,6 +479,7 @@ typedef struct
     EFmAlarmSeverityT alarm_severity ;
     bool          restart      ;
     bool          registered   ; /**< true if pid is registered with kernel  */
+             int  pidfd        ; /**< exit event pidfd ; 0 if not open       */
     bool          failed       ;
     bool          ignore       ; /**< ignore this process ; debug purposes   */
     bool          stopped      ; /**< process was stopped by command         */
@@ -467,6 +494,8 @@ typedef struct
     unsigned int  stage_cnt    ; /**< general stage specific count           */
     unsigned int  failed_cnt   ; /**< number of times process has failed     */
              int  child_pid    ; /**< Restart scriptm chile process ID (obs) */
+             int  child_pidfd  ; /**< exit event pidfd of the child ; or 0   */
+             int  child_pidfd_pid ; /**< child the child_pidfd was opened for */
              int  pid          ; /**< The PID of the this process            */
              int  sev          ; /**< Translated severity code; MAJ,MIN,CRIT */
              int status        ; /**< exit status                            */
@@ -522,6 +551,13 @@ typedef struct
     statusStage_enum status_stage   ; /**< Status Monitor FSM Stage Control  */
 
     bool status_monitoring          ; /**< true if status monitoring         */
+
+    /* status command latency in msecs ; reported in the dump info */
+    unsigned int status_checks      ; /**< completed status commands         */
+    unsigned int status_timeouts    ; /**< status commands that timed out    */
+    unsigned int status_msecs       ; /**< last status command latency       */
+    unsigned int status_msecs_max   ; /**< max status command latency        */
+    unsigned long long status_msecs_total ; /**< for the average latency    */
     bool status_failed              ;
     bool was_failed                 ; /**< indicates the process was in the failed state */
 
@@ -601,6 +637,8 @@ int  open_process_socket  ( process_config_type * ptr );
 void manage_process_failure ( process_config_type * ptr );
 int  register_process       ( process_config_type * ptr );
 int  unregister_process     ( process_config_type * ptr );
+void pmon_event_handler     ( void );
+void pmon_child_handler     ( void );
 int  respawn_process        ( process_config_type * ptr );
 int  get_process_pid        ( process_config_type * ptr );
 bool process_running        ( process_config_type * ptr );
@@ -969,6 +969,22 @@ int pmon_status_handler ( process_config_type * ptr )
                 mtcTimer_reset( ptr->pt_ptr);
                 ptr->pt_ptr->ring = false;
 
+                if (( ptr->sigchld_rxed ) && ( ptr->child_pid ))
+                {
+                    unsigned int msecs = (unsigned int)((ptr->time_delta.secs*1000) +
+                                                         ptr->time_delta.msecs) ;
+                    ptr->status_checks++ ;
+                    ptr->status_msecs        = msecs ;
+                    ptr->status_msecs_total += msecs ;
+                    if ( msecs > ptr->status_msecs_max )
+                        ptr->status_msecs_max = msecs ;
+                    dlog ("%s status command took %u msecs\n", ptr->process, msecs );
+                }
+                else if ( ptr->child_pid )
+                {
+                    ptr->status_timeouts++ ;
+                }
+
                 if (( !ptr->sigchld_rxed ) || ( !ptr->child_pid ) || (ptr->status != PASS))
                 {
                     if ( ptr->child_pid == 0 )
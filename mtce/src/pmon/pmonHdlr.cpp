@@ -86,11 +86,13 @@ void mem_log_ctrl ( pmon_ctrl_type * ptr )
 {
     #define MAX_LEN 500
     char str[MAX_LEN] ;
-    snprintf (&str[0], MAX_LEN, "%s %s %s Pulse Rate:%d msecs\n",
+    snprintf (&str[0], MAX_LEN, "%s %s %s Pulse Rate:%d msecs Event Method:%s (%s)\n",
                &ptr->my_hostname[0],
                ptr->my_address.c_str(),
                ptr->my_macaddr.c_str(),
-               ptr->pulse_period );
+               ptr->pulse_period,
+               get_event_method_str(ptr->event_active),
+               get_event_method_str(ptr->event_method));
     mem_log(str);
 }
 
@@ -128,6 +130,20 @@ void mem_log_pstate ( process_config_type * ptr )
     mem_log(str);
 }
 
+/* Log process specific status monitor latency */
+void mem_log_sstate ( process_config_type * ptr )
+{
+    #define MAX_LEN 500
+    char str[MAX_LEN] ;
+    snprintf (&str[0], MAX_LEN, "  Status : Checks:%u  Timeouts:%u  Latency msecs - Last:%u  Avg:%llu  Max:%u\n",
+               ptr->status_checks,
+               ptr->status_timeouts,
+               ptr->status_msecs,
+               ptr->status_checks ? ptr->status_msecs_total/ptr->status_checks : 0,
+               ptr->status_msecs_max );
+    mem_log(str);
+}
+
 /* Log process specific active monitor controls */
 void mem_log_aconfig ( process_config_type * ptr )
 {
@@ -176,6 +192,10 @@ void daemon_dump_info ( void )
             mem_log ('\n');
             mem_log_process ( ptr );
             mem_log_pstate  ( ptr );
+            if ( ptr->status_monitoring )
+            {
+                mem_log_sstate ( ptr );
+            }
             if ( ptr->active_monitoring )
             {
                 mem_log_aconfig ( ptr );
@@ -184,6 +204,8 @@ void daemon_dump_info ( void )
         }
         daemon_dump_membuf();
     }
+    daemon_watch_dump ();
+    daemon_reactor_dump ();
 }
 
 /*******************************************************************
@@ -237,6 +259,197 @@ int signal_hdlr_init ( int sig_num )
     return (rc) ;
 }
 
+/***************************************************************************
+ *
+ * Process exit event method support.
+ *
+ * The prctl method needs the 'notification of death of arbitrary process'
+ * kernel patch. On stock kernels the pidfd method is used instead ; a
+ * pidfd is opened for each registered process and added to an epoll set
+ * that pmon_service selects on. The pidfd becomes readable as soon as
+ * the process exits. Polling is the last resort.
+ *
+ ***************************************************************************/
+
+static const char * _event_method_str[] =
+{
+    "auto",
+    "prctl",
+    "pidfd",
+    "polling",
+};
+
+const char * get_event_method_str ( pmon_event_method_enum method )
+{
+    if (( method >= PMON_EVENT_METHOD__AUTO ) &&
+        ( method <= PMON_EVENT_METHOD__POLLING ))
+    {
+        return ( _event_method_str[method] );
+    }
+    return ( "unknown" );
+}
+
+pmon_event_method_enum get_event_method ( const char * method_str )
+{
+    for ( int i = PMON_EVENT_METHOD__AUTO ; i <= PMON_EVENT_METHOD__POLLING ; i++ )
+    {
+        if ( !strcmp ( method_str, _event_method_str[i] ) )
+        {
+            return ( (pmon_event_method_enum)i );
+        }
+    }
+    wlog ("unsupported event method '%s' ; using '%s'\n",
+           method_str, _event_method_str[PMON_EVENT_METHOD__AUTO]);
+    return ( PMON_EVENT_METHOD__AUTO );
+}
+
+/* Remembers that the kernel rejected prctl registration
+ * so that auto mode goes straight to pidfd on config reload */
+static bool _prctl_unsupported = false ;
+
+/* Select the event method at the start of a process config load */
+static void _event_method_init ( void )
+{
+    pmon_event_method_enum method = _pmon_ctrl_ptr->event_method ;
+    if ( method == PMON_EVENT_METHOD__AUTO )
+    {
+        method = _prctl_unsupported ? PMON_EVENT_METHOD__PIDFD
+                                    : PMON_EVENT_METHOD__PRCTL ;
+    }
+    if (( method == PMON_EVENT_METHOD__PIDFD ) && ( _pmon_ctrl_ptr->event_fd == 0 ))
+    {
+        method = PMON_EVENT_METHOD__POLLING ;
+    }
+    _pmon_ctrl_ptr->event_active = method ;
+    _pmon_ctrl_ptr->event_mode   = ( method != PMON_EVENT_METHOD__POLLING ) ;
+}
+
+/* The active event method is not supported by this kernel.
+ * Auto mode steps down from prctl to pidfd ; otherwise poll. */
+static void _event_method_fallback ( process_config_type * ptr )
+{
+    if ( _pmon_ctrl_ptr->event_active == PMON_EVENT_METHOD__PRCTL )
+    {
+        _prctl_unsupported = true ;
+    }
+    if (( _pmon_ctrl_ptr->event_active == PMON_EVENT_METHOD__PRCTL ) &&
+        ( _pmon_ctrl_ptr->event_method == PMON_EVENT_METHOD__AUTO ) &&
+        ( _pmon_ctrl_ptr->event_fd ))
+    {
+        _pmon_ctrl_ptr->event_active = PMON_EVENT_METHOD__PIDFD ;
+        wlog ( "%s Switching to pidfd event mode\n", ptr->process);
+    }
+    else
+    {
+        _pmon_ctrl_ptr->event_active = PMON_EVENT_METHOD__POLLING ;
+        _pmon_ctrl_ptr->event_mode   = false ;
+        wlog ( "%s Switching to Polling mode\n", ptr->process);
+    }
+}
+
+static void _pidfd_close ( process_config_type * ptr )
+{
+    if ( ptr->pidfd )
+    {
+        /* closing the pidfd also removes it from the event set */
+        close ( ptr->pidfd );
+        ptr->pidfd = 0 ;
+    }
+}
+
+/* Open a pidfd for this process and add it to the event set */
+static int _pidfd_register ( process_config_type * ptr, int pid )
+{
+    struct epoll_event event ;
+
+    _pidfd_close ( ptr );
+
+    int fd = (int)syscall ( SYS_pidfd_open, pid, 0 );
+    if ( fd < 0 )
+    {
+        int err = errno ;
+        elog ("%s failed to open pidfd for pid:%d (%d:%s)\n",
+                  ptr->process, pid, err, strerror(err));
+        if (( err == ENOSYS ) || ( err == EPERM ))
+        {
+            _event_method_fallback ( ptr );
+        }
+        else
+        {
+            /* ESRCH ; the process is already gone */
+            ptr->failed = true ;
+        }
+        return (FAIL);
+    }
+
+    memset ( &event, 0, sizeof(event));
+    event.events   = EPOLLIN ;
+    event.data.ptr = ptr ;
+    if ( epoll_ctl ( _pmon_ctrl_ptr->event_fd, EPOLL_CTL_ADD, fd, &event ) )
+    {
+        elog ("%s failed to add pidfd for pid:%d (%d:%s)\n",
+                  ptr->process, pid, errno, strerror(errno));
+        close ( fd );
+        ptr->failed = true ;
+        return (FAIL);
+    }
+    ptr->pidfd = fd ;
+    return (PASS);
+}
+
+/* Stop tracking this process's status, start or respawn child */
+static void _child_untrack ( process_config_type * ptr )
+{
+    if ( ptr->child_pidfd )
+    {
+        close ( ptr->child_pidfd );
+        ptr->child_pidfd     = 0 ;
+        ptr->child_pidfd_pid = 0 ;
+    }
+}
+
+/* Track the exit of a just forked child through a pidfd in the child
+ * event set. The event carries the process_config index so the child
+ * is reaped from the select loop without searching the process list.
+ * Children that cannot be tracked are still reaped by the SIGCHLD
+ * handler. */
+static void _child_track ( process_config_type * ptr )
+{
+    struct epoll_event event ;
+    long index = ptr - &process_config[0] ;
+
+    if (( _pmon_ctrl_ptr->child_fd == 0 ) ||
+        ( index < 0 ) || ( index >= MAX_PROCESSES ))
+    {
+        return ;
+    }
+
+    /* a previous child that has not been reaped yet is
+     * left for the SIGCHLD handler */
+    _child_untrack ( ptr );
+
+    int fd = (int)syscall ( SYS_pidfd_open, ptr->child_pid, 0 );
+    if ( fd < 0 )
+    {
+        dlog ("%s child %d not tracked (%d:%s)\n",
+                  ptr->process, ptr->child_pid, errno, strerror(errno));
+        return ;
+    }
+
+    memset ( &event, 0, sizeof(event));
+    event.events   = EPOLLIN ;
+    event.data.u32 = (uint32_t)index ;
+    if ( epoll_ctl ( _pmon_ctrl_ptr->child_fd, EPOLL_CTL_ADD, fd, &event ) )
+    {
+        dlog ("%s child %d not tracked (%d:%s)\n",
+                  ptr->process, ptr->child_pid, errno, strerror(errno));
+        close ( fd );
+        return ;
+    }
+    ptr->child_pidfd     = fd ;
+    ptr->child_pidfd_pid = ptr->child_pid ;
+}
+
 /*
  * Init the handler
  *    - Must support re-init that might occur over a SIGHUP
@@ -260,6 +473,35 @@ int pmon_hdlr_init ( pmon_ctrl_type * ctrl_ptr )
     _pmon_ctrl_ptr->fd = 0 ;
     _pmon_ctrl_ptr->wd = 0 ;
 
+    /* Create the pidfd exit event set once ; the service loop
+     * selects on it regardless of the configured event method */
+    if ( _pmon_ctrl_ptr->event_fd == 0 )
+    {
+        int fd = epoll_create1 ( EPOLL_CLOEXEC );
+        if ( fd < 0 )
+        {
+            wlog ("failed to create pidfd event set (%d:%s)\n",
+                   errno, strerror(errno));
+        }
+        else
+        {
+            _pmon_ctrl_ptr->event_fd = fd ;
+        }
+    }
+    if ( _pmon_ctrl_ptr->child_fd == 0 )
+    {
+        int fd = epoll_create1 ( EPOLL_CLOEXEC );
+        if ( fd < 0 )
+        {
+            wlog ("failed to create child event set (%d:%s)\n",
+                   errno, strerror(errno));
+        }
+        else
+        {
+            _pmon_ctrl_ptr->child_fd = fd ;
+        }
+    }
+
     return (rc) ;
 }
 
@@ -271,10 +513,24 @@ void pmon_hdlr_fini ( pmon_ctrl_type * ctrl_ptr )
     {
         /* Close any active monitoring sockets */
         close_process_socket ( &process_config[i] );
+        _pidfd_close         ( &process_config[i] );
+        _child_untrack       ( &process_config[i] );
+    }
+
+    if ( ctrl_ptr->event_fd )
+    {
+        close ( ctrl_ptr->event_fd );
+        ctrl_ptr->event_fd = 0 ;
+    }
+    if ( ctrl_ptr->child_fd )
+    {
+        close ( ctrl_ptr->child_fd );
+        ctrl_ptr->child_fd = 0 ;
     }
 
     /* Turn off inotify */
     set_inotify_close ( ctrl_ptr->fd, ctrl_ptr->wd );
+    daemon_watch_fini ();
 }
 
 void manage_process_failure ( process_config_type * ptr )
@@ -375,14 +631,16 @@ void load_processes ( void )
     {
         mtcTimer_reset ( process_config[i].pt_ptr );
         close_process_socket ( &process_config[i] );
+        _pidfd_close ( &process_config[i] );
+        _child_untrack ( &process_config[i] );
     }
 
 
     /* init the process config memory */
     init_process_config_memory ();
 
-    /* Default to event mode */
-    _pmon_ctrl_ptr->event_mode = true ;
+    /* Default to event mode with the configured method */
+    _event_method_init ();
 
     /* Start with zero processes */
     _pmon_ctrl_ptr->processes = 0 ;
@@ -423,6 +681,11 @@ void load_processes ( void )
     {
         process_config[i].restart= false;
         process_config[i].failed = false;
+
+        /* answer the pidfile checks of every audit from memory */
+        if ( process_config[i].pidfile )
+            daemon_watch_file ( process_config[i].pidfile );
+
         if ( process_config[i].status_monitoring )
         {
            process_config[i].status_stage = STATUS_STAGE__BEGIN ;
@@ -1068,7 +1331,13 @@ void _get_events ( void )
 int unregister_process ( process_config_type * ptr )
 {
     dlog1 ("%s pid %d\n", ptr->process, ptr->pid );
-    if ( ptr->pid )
+    if ( ptr->pidfd )
+    {
+        ilog ("%s Unregister (%d)\n", ptr->process, ptr->pid );
+        _pidfd_close ( ptr );
+    }
+    else if (( ptr->pid ) &&
+             ( _pmon_ctrl_ptr->event_active == PMON_EVENT_METHOD__PRCTL ))
     {
         struct task_state_notify_info info ;
         info.pid    = ptr->pid ;
@@ -1103,24 +1372,37 @@ int register_process ( process_config_type * ptr )
         ptr->restart= false ;
         if (( _pmon_ctrl_ptr->event_mode ) && ( !ptr->ignore ))
         {
-            struct task_state_notify_info info ;
-            info.pid    = pid ;
-            info.sig    = PMON_RT_SIGNAL ;
-            info.events = PMON_EVENT_FLAGS;
-            if ( prctl (PR_DO_NOTIFY_TASK_STATE, &info ) )
+            int rc = PASS ;
+            if ( _pmon_ctrl_ptr->event_active == PMON_EVENT_METHOD__PRCTL )
             {
-                elog ("%s failed to register pid:%d (%d:%s)\n", ptr->process, pid, errno, strerror(errno));
-                if ( errno == EINVAL )
-                {
-                    _pmon_ctrl_ptr->event_mode = false ;
-                    wlog ( "%s Switching to Polling mode\n", ptr->process);
-                }
-                else
+                struct task_state_notify_info info ;
+                info.pid    = pid ;
+                info.sig    = PMON_RT_SIGNAL ;
+                info.events = PMON_EVENT_FLAGS;
+                if ( prctl (PR_DO_NOTIFY_TASK_STATE, &info ) )
                 {
-                    ptr->failed = true ;
+                    int err = errno ;
+                    elog ("%s failed to register pid:%d (%d:%s)\n", ptr->process, pid, err, strerror(err));
+                    if ( err == EINVAL )
+                    {
+                        _event_method_fallback ( ptr );
+                    }
+                    else
+                    {
+                        ptr->failed = true ;
+                    }
+                    rc = FAIL ;
                 }
             }
-            else
+
+            /* Don't 'else' ; prctl may have fallen back to pidfd */
+            if (( _pmon_ctrl_ptr->event_mode ) &&
+                ( _pmon_ctrl_ptr->event_active == PMON_EVENT_METHOD__PIDFD ))
+            {
+                rc = _pidfd_register ( ptr, pid );
+            }
+
+            if (( rc == PASS ) && ( _pmon_ctrl_ptr->event_mode ))
             {
                 ilog ("%s Registered (%d)\n", ptr->process , pid );
                 ptr->failed = false ;
@@ -1290,6 +1572,7 @@ int respawn_process ( process_config_type * ptr )
     }
 
     gettime ( ptr->time_start );
+    _child_track ( ptr );
 
     ilog ("%s Spawn      (%d)\n", ptr->process, ptr->child_pid );
 
@@ -1346,6 +1629,7 @@ int execute_start_command(process_config_type * ptr)
     }
 
     gettime ( ptr->time_start );
+    _child_track ( ptr );
 
     return (PASS);
 }
@@ -1399,10 +1683,138 @@ int execute_status_command (process_config_type * ptr)
     }
 
     gettime ( ptr->time_start );
+    _child_track ( ptr );
 
     return (PASS);
 }
 
+/* Record the exit status of a reaped status, start or respawn child */
+static void _child_exit_status ( process_config_type * ptr, pid_t tpid, int status )
+{
+    UNUSED(tpid);
+
+    ptr->sigchld_rxed = true ;
+
+    if (WIFEXITED(status))
+    {
+        if ( ptr->status_monitoring == false )
+        {
+          #ifdef DEBIAN_BULLSEYE
+            dlog ("%s spawn script exited properly (%d)\n", ptr->process, tpid );
+          #endif
+          /* DEBIAN_TRIXIE */
+          /* Defer logging to main loop */
+        }
+        else
+        {
+           /* with status mode we do not need to wait for a timeout since we got a response */
+           /* force a ring                                                                  */
+           ptr->pt_ptr->ring = true;
+        }
+
+        gettime   ( ptr->time_stop );
+        timedelta ( ptr->time_start,
+                    ptr->time_stop,
+                    ptr->time_delta );
+
+        /* DEBIAN_BULLSEYE only print log if there is an error */
+        /* DEBIAN_TRIXIE only print log if there is an error */
+        ptr->status = WEXITSTATUS(status) ;
+
+#ifdef DEBIAN_BULLSEYE
+        if ( ptr->status )
+        {
+            if ( ptr->status_monitoring == false )
+            {
+                ilog ("%s spawn failed (rc:%d:%x) (%ld.%03ld secs)\n",
+                       ptr->process,
+                       ptr->status,
+                       ptr->status,
+                       ptr->time_delta.secs,
+                       ptr->time_delta.msecs/1000);
+            }
+        }
+        else
+        {
+            if ( ptr->status_monitoring == false )
+            {
+                /* only print this log if the spawn time took longer than 1 second */
+                if ( ptr->time_delta.secs )
+                {
+                    ilog ("%s spawned in %ld.%03ld secs\n",
+                              ptr->process,
+                              ptr->time_delta.secs,
+                              ptr->time_delta.msecs/1000);
+                }
+            }
+        }
+#endif
+
+    }
+    else if (WIFSIGNALED(status))
+    {
+        ptr->status = FAIL ;
+        #ifdef DEBIAN_BULLSEYE
+            wlog ("%s test uncaught signal\n", ptr->process);
+        #endif
+        /* DEBIAN_TRIXIE */
+        /* Defer logging to main loop */
+
+    }
+    else if (WIFSTOPPED(status))
+    {
+        ptr->status = FAIL ;
+        #ifdef DEBIAN_BULLSEYE
+            wlog ("%s test stopped.\n", ptr->process );
+        #endif
+        /* DEBIAN_TRIXIE */
+        /* Defer logging to main loop */
+    }
+}
+
+/*****************************************************************************
+ *
+ * Name       : pmon_child_handler
+ *
+ * Description: Reap the status, start and respawn children whose pidfd
+ *              in the child event set reports that they have exited.
+ *
+ * Called from the main loop select and ahead of the SIGCHLD reaper.
+ * A child that the SIGCHLD reaper got to first is simply untracked.
+ *
+ *****************************************************************************/
+void pmon_child_handler ( void )
+{
+    struct epoll_event events[MAX_PROCESSES] ;
+
+    if ( _pmon_ctrl_ptr->child_fd == 0 )
+        return ;
+
+    int count = epoll_wait ( _pmon_ctrl_ptr->child_fd, &events[0], MAX_PROCESSES, 0 );
+    for ( int i = 0 ; i < count ; i++ )
+    {
+        if ( events[i].data.u32 >= MAX_PROCESSES )
+            continue ;
+
+        process_config_type * ptr = &process_config[events[i].data.u32] ;
+        pid_t pid = ptr->child_pidfd_pid ;
+        int status = 0 ;
+
+        _child_untrack ( ptr );
+        if (( pid > 0 ) && ( waitpid ( pid, &status, WNOHANG | WUNTRACED ) == pid ))
+        {
+            if ( pid == ptr->child_pid )
+            {
+                _child_exit_status ( ptr, pid, status );
+            }
+            else
+            {
+                dlog ("%s reaped previous child (%d)\n", ptr->process, pid );
+            }
+        }
+    }
+}
+
 void daemon_sigchld_hdlr ( void )
 {
     pid_t tpid = 0 ;
@@ -1416,88 +1828,17 @@ void daemon_sigchld_hdlr ( void )
     * NO logging (dlog/ilog/wlog), NO malloc/free, NO mutex locks.
     * Trixie's glibc/Python 3.13/OpenSSL 3.0 will deadlock otherwise.
     * Just reap children and set flags - logging happens in main loop. */
+
+    /* Reap the pidfd tracked children first so that the search
+     * below only runs for children that could not be tracked */
+    pmon_child_handler ();
+
     while ( 0 < ( tpid = waitpid ( -1, &status, WNOHANG | WUNTRACED )))
     {
         process_config_type * process_ptr = find_parent_process ( tpid ) ;
         if ( process_ptr )
         {
-            process_ptr->sigchld_rxed = true ;
-
-            if (WIFEXITED(status))
-            {
-                if ( process_ptr->status_monitoring == false )
-                {
-                  #ifdef DEBIAN_BULLSEYE
-                    dlog ("%s spawn script exited properly (%d)\n", process_ptr->process, tpid );
-                  #endif
-                  /* DEBIAN_TRIXIE */
-                  /* Defer logging to main loop */
-                }
-                else
-                {
-                   /* with status mode we do not need to wait for a timeout since we got a response */
-                   /* force a ring                                                                  */
-                   process_ptr->pt_ptr->ring = true;
-                }
-
-                gettime   ( process_ptr->time_stop );
-                timedelta ( process_ptr->time_start,
-                            process_ptr->time_stop,
-                            process_ptr->time_delta );
-
-                /* DEBIAN_BULLSEYE only print log if there is an error */
-                /* DEBIAN_TRIXIE only print log if there is an error */
-                process_ptr->status = WEXITSTATUS(status) ;
-
-#ifdef DEBIAN_BULLSEYE
-                if ( process_ptr->status )
-                {
-                    if ( process_ptr->status_monitoring == false )
-                    {
-                        ilog ("%s spawn failed (rc:%d:%x) (%ld.%03ld secs)\n",
-                               process_ptr->process,
-                               process_ptr->status,
-                               process_ptr->status,
-                               process_ptr->time_delta.secs,
-                               process_ptr->time_delta.msecs/1000);
-                    }
-                }
-                else
-                {
-                    if ( process_ptr->status_monitoring == false )
-                    {
-                        /* only print this log if the spawn time took longer than 1 second */
-                        if ( process_ptr->time_delta.secs )
-                        {
-                            ilog ("%s spawned in %ld.%03ld secs\n",
-                                      process_ptr->process,
-                                      process_ptr->time_delta.secs,
-                                      process_ptr->time_delta.msecs/1000);
-                        }
-                    }
-                }
-#endif
-
-            }
-            else if (WIFSIGNALED(status))
-            {
-                process_ptr->status = FAIL ;
-                #ifdef DEBIAN_BULLSEYE
-                    wlog ("%s test uncaught signal\n", process_ptr->process);
-                #endif
-                /* DEBIAN_TRIXIE */
-                /* Defer logging to main loop */
-
-            }
-            else if (WIFSTOPPED(status))
-            {
-                process_ptr->status = FAIL ;
-                #ifdef DEBIAN_BULLSEYE
-                    wlog ("%s test stopped.\n", process_ptr->process );
-                #endif
-                /* DEBIAN_TRIXIE */
-                /* Defer logging to main loop */
-            }
+            _child_exit_status ( process_ptr, tpid, status );
         }
         else
         {
@@ -1717,6 +2058,43 @@ void _process_death_hdlr ( int sig_num, siginfo_t * info_ptr, void * context_ptr
     }
 }
 
+/*****************************************************************************
+ *
+ * Name       : pmon_event_handler
+ *
+ * Description: Service the pidfd event set from the main loop select.
+ *
+ * Each ready pidfd belongs to a registered process that has exited.
+ * The pidfd is closed and, like the kernel signal handler above, the
+ * process failure is handed to the fsm for recovery.
+ *
+ *****************************************************************************/
+void pmon_event_handler ( void )
+{
+    struct epoll_event events[MAX_PROCESSES] ;
+
+    int count = epoll_wait ( _pmon_ctrl_ptr->event_fd, &events[0], MAX_PROCESSES, 0 );
+    if (( count < 0 ) && ( errno != EINTR ))
+    {
+        wlog ("pidfd event wait failed (%d:%s)\n", errno, strerror(errno));
+        _pmon_ctrl_ptr->run_audit = true ;
+        return ;
+    }
+    for ( int i = 0 ; i < count ; i++ )
+    {
+        process_config_type * ptr = (process_config_type*)events[i].data.ptr ;
+        if ( ptr == NULL )
+            continue ;
+
+        dlog ("%s exit event (pid:%d)\n", ptr->process, ptr->pid );
+        _pidfd_close ( ptr );
+        if ( ptr->failed != true )
+        {
+            manage_process_failure ( ptr );
+        }
+    }
+}
+
 /***************************************************************************
  *
  * Name       : alarmed_process_audit
@@ -1835,14 +2213,47 @@ void alarmed_process_audit ( void )
 }
 
 
+/* Main loop reactor handlers ; see daemon_reactor_add */
+static void _reactor_cmd ( int fd, void * ctx )
+{
+    UNUSED(fd); UNUSED(ctx);
+    pmon_service_inbox ();
+}
+
+static void _reactor_amon ( int fd, void * ctx )
+{
+    UNUSED(fd); UNUSED(ctx);
+    amon_service_inbox ( _pmon_ctrl_ptr->processes );
+}
+
+static void _reactor_watch ( int fd, void * ctx )
+{
+    UNUSED(fd); UNUSED(ctx);
+    daemon_watch_handler ();
+}
+
+static void _reactor_event ( int fd, void * ctx )
+{
+    UNUSED(fd); UNUSED(ctx);
+    pmon_event_handler ();
+}
+
+static void _reactor_child ( int fd, void * ctx )
+{
+    UNUSED(fd); UNUSED(ctx);
+    pmon_child_handler ();
+}
+
+static void _reactor_wheel ( int fd, void * ctx )
+{
+    UNUSED(fd); UNUSED(ctx);
+    mtcTimer_wheel_service ();
+}
+
 void pmon_service ( pmon_ctrl_type * ctrl_ptr )
 {
-    std::list<int> socks ;
-    struct timeval waitd;
-    fd_set readfds;
     int  select_fail_count = 0 ;
     int  flush_thld        = 0 ;
-    int  rc                = PASS ;
     int  shutdown_log_throttle = 0;
 
     /* iNotify stuff */
@@ -1862,6 +2273,18 @@ void pmon_service ( pmon_ctrl_type * ctrl_ptr )
     ilog ("Starting to monitor processes\n");
     pmon_send_hostwd ( );
 
+    /* Run this daemon's timers off the timer wheel rather than
+     * with a posix timer and signal per timer */
+    mtcTimer_wheel_init ();
+
+    /* Watch the flag and pid files polled by the audits ;
+     * load_processes adds each process's pidfile */
+    if ( daemon_watch_init () == PASS )
+    {
+        daemon_watch_file ( NODE_RESET_FILE );
+        daemon_watch_file ( PATCHING_IN_PROG_FILE );
+    }
+
     /* Load and register generic processes - not subfunction processes */
     load_processes ();
 
@@ -1869,11 +2292,24 @@ void pmon_service ( pmon_ctrl_type * ctrl_ptr )
     if ( set_inotify_watch ( CONFIG_DIR, ctrl_ptr->fd, ctrl_ptr->wd ) )
         inotify_fault = true ;
 
-    socks.clear();
-    socks.push_front (sock_ptr->cmd_sock->getFD());
-    socks.push_front (sock_ptr->event_sock->getFD());
-    socks.push_front (sock_ptr->amon_sock);
-    socks.sort();
+    /* Register the receive file descriptors with the reactor once */
+    if ( daemon_reactor_init () != PASS )
+    {
+        elog ("Failed to create main loop reactor\n");
+        daemon_exit ();
+    }
+    if ( sock_ptr->cmd_sock->getFD() )
+        daemon_reactor_add ( sock_ptr->cmd_sock->getFD(), _reactor_cmd );
+    if ( sock_ptr->amon_sock )
+        daemon_reactor_add ( sock_ptr->amon_sock, _reactor_amon );
+    if ( daemon_watch_fd () >= 0 )
+        daemon_reactor_add ( daemon_watch_fd (), _reactor_watch );
+    if ( ctrl_ptr->event_fd )
+        daemon_reactor_add ( ctrl_ptr->event_fd, _reactor_event );
+    if ( ctrl_ptr->child_fd )
+        daemon_reactor_add ( ctrl_ptr->child_fd, _reactor_child );
+    if ( mtcTimer_wheel_enabled () )
+        daemon_reactor_add ( mtcTimer_wheel_fd(), _reactor_wheel );
 
     ilog ("Starting 'Audit' timer (%d secs)\n", audit_period );
     mtcTimer_start ( pmonTimer_audit, pmon_timer_handler, audit_period );
@@ -1899,49 +2335,12 @@ void pmon_service ( pmon_ctrl_type * ctrl_ptr )
 
         daemon_signal_hdlr ();
 
-        /* Initialize the master fd_set */
-        FD_ZERO(&readfds);
-        if ( sock_ptr->cmd_sock->getFD() )
+        /* Wait up to select_timeout for and dispatch the ready fds */
+        if ( daemon_reactor_run ( (select_timeout+999)/1000 ) < 0 )
         {
-            FD_SET(sock_ptr->cmd_sock->getFD(), &readfds);
-        }
-        if ( sock_ptr->event_sock->getFD() )
-        {
-            FD_SET(sock_ptr->event_sock->getFD(), &readfds);
-        }
-        if ( sock_ptr->amon_sock )
-        {
-            FD_SET(sock_ptr->amon_sock, &readfds);
-        }
-
-        waitd.tv_sec  = 0;
-        waitd.tv_usec = select_timeout ;
-
-        /* This is used as a delay up to select_timeout */
-        rc = select( socks.back()+1, &readfds, NULL, NULL, &waitd);
-        /* If the select time out expired then  */
-        if (( rc < 0 ) || ( rc == 0 ))
-        {
-            /* Check to see if the select call failed. */
-            /* ... but filter Interrupt signal         */
-            if (( rc < 0 ) && ( errno != EINTR ))
-            {
-                wlog_throttled ( select_fail_count, 20,
-                                 "Socket Select Failed (rc:%d) %s \n",
-                                 errno, strerror(errno));
-            }
-        }
-        else
-        {
-            if ( FD_ISSET(sock_ptr->cmd_sock->getFD(), &readfds))
-            {
-                pmon_service_inbox ();
-            }
-
-            if (FD_ISSET(sock_ptr->amon_sock, &readfds))
-            {
-                amon_service_inbox  ( _pmon_ctrl_ptr->processes );
-            }
+            wlog_throttled ( select_fail_count, 20,
+                             "Socket Select Failed (rc:%d) %s \n",
+                             errno, strerror(errno));
         }
 
         if (pmonTimer_pulse.ring == true )
@@ -82,6 +82,10 @@ static int pmon_config_handler ( void * user,
         config_ptr->hostwd_update_period = atoi(value);
         config_ptr->mask |= CONFIG_HOSTWD_PERIOD ;
     }
+    else if (MATCH("config", "event_method"))
+    {
+        pmon_ctrl.event_method = get_event_method ( value );
+    }
     else if (MATCH("timeouts", "start_delay"))
     {
         config_ptr->start_delay = atoi(value);
@@ -331,6 +335,7 @@ int daemon_configure ( void )
     /* Log the startup settings */
     ilog("Interface   : %s\n", pmon_config.mgmnt_iface );
     ilog("Event Port  : %d\n", pmon_config.pmon_event_port );
+    ilog("Event Method: %s\n", get_event_method_str(pmon_ctrl.event_method));
 
     get_iface_macaddr  ( pmon_config.mgmnt_iface,  pmon_ctrl.my_macaddr );
     get_iface_address  ( pmon_config.mgmnt_iface,  pmon_ctrl.my_address, true );
@@ -444,6 +449,10 @@ int daemon_init ( string iface, string nodetype_str )
     pmon_ctrl.pulse_period = PMON_MAX_AUDIT_PERIOD ;
     pmon_ctrl.processes    = 0  ;
     pmon_ctrl.system_type  = daemon_system_type ();
+    pmon_ctrl.event_method = PMON_EVENT_METHOD__AUTO ;
+    pmon_ctrl.event_active = PMON_EVENT_METHOD__AUTO ;
+    pmon_ctrl.event_fd     = 0  ;
+    pmon_ctrl.child_fd     = 0  ;
 
     /* sets in pmonHdlr.cpp */
     pmon_set_ctrl_ptr ( &pmon_ctrl );
@@ -0,0 +1,143 @@
+#!/bin/bash
+
+#
+# Copyright (c) 2026 Wind River Systems, Inc.
+#
+# SPDX-License-Identifier: Apache-2.0
+#
+#
+###########################################################################
+#
+# This is a pmon test script that is not packaged into the load.
+# It measures process failure detection latency.
+#
+# A dummy systemd service is created and put under pmond passive
+# monitoring. The dummy is then killed repeatedly and the time from
+# the kill to the pmond '<process> failed (<pid>)' log is reported.
+#
+# Run it once for each pmond.conf 'event_method' to compare them.
+#
+# Usage: pmon-event-latency.sh [iterations]
+#
+# Example:
+#
+# controller-0:~# /home/sysadmin/pmon-event-latency.sh 5
+#
+# pmond event method: pidfd
+# pmon-latency-dummy kill 1 pid 123456 detected in     3 msecs
+# ...
+# pmon-latency-dummy 5 kills ; min 2 avg 3 max 5 msecs
+#
+############################################################################
+
+PROCESS="pmon-latency-dummy"
+PIDFILE="/var/run/${PROCESS}.pid"
+CONFFILE="/etc/pmon.d/${PROCESS}.conf"
+UNITFILE="/etc/systemd/system/${PROCESS}.service"
+LOGFILE="/var/log/pmond.log"
+
+ITERATIONS=${1:-10}
+TIMEOUT_SECS=60
+
+# Linux Standard Base (LSB) Error Codes
+GENERIC_ERROR=1
+
+trap cleanup EXIT
+
+function cleanup {
+    rm -f ${CONFFILE}
+    systemctl stop ${PROCESS} 2>/dev/null
+    rm -f ${UNITFILE} ${PIDFILE}
+    systemctl daemon-reload
+}
+
+# wait for a log matching $1 to appear after line $2 of the pmond log
+# and print the number of msecs waited.
+function wait_for_log {
+    local start=$(date +%s%N)
+    local now=${start}
+    local limit=$((start + TIMEOUT_SECS*1000000000))
+    while [ ${now} -lt ${limit} ] ; do
+        tail -n +$(($2+1)) ${LOGFILE} | grep -q -- "$1"
+        if [ $? -eq 0 ] ; then
+            echo $(( ($(date +%s%N) - start) / 1000000 ))
+            return 0
+        fi
+        sleep 0.001
+        now=$(date +%s%N)
+    done
+    return 1
+}
+
+function log_lines {
+    wc -l < ${LOGFILE}
+}
+
+cat > ${UNITFILE} << EOF
+[Unit]
+Description=pmond event latency test dummy
+
+[Service]
+Type=simple
+ExecStart=/bin/sh -c 'echo \$\$ > ${PIDFILE} ; exec sleep infinity'
+ExecStopPost=/bin/rm -f ${PIDFILE}
+EOF
+
+cat > ${CONFFILE} << EOF
+[process]
+process  = ${PROCESS}
+service  = ${PROCESS}
+pidfile  = ${PIDFILE}
+style    = lsb
+severity = minor
+restarts = 3
+interval = 1
+debounce = 1
+startuptime = 1
+mode = passive
+EOF
+
+systemctl daemon-reload
+line=$(log_lines)
+systemctl start ${PROCESS}
+
+# pmond reloads its config when /etc/pmon.d changes
+if ! wait_for_log "${PROCESS} Registered" ${line} > /dev/null ; then
+    echo "${PROCESS} was not registered by pmond"
+    exit ${GENERIC_ERROR}
+fi
+
+method=$(grep "Event Method:" ${LOGFILE} | tail -1 | sed 's/.*Event Method: *//')
+echo "pmond event method: ${method:-unknown}"
+
+total=0
+min=0
+max=0
+for ((i = 1 ; i <= ITERATIONS ; i++)) ; do
+    pid=$(head -1 ${PIDFILE})
+    line=$(log_lines)
+    kill -9 ${pid}
+    msecs=$(wait_for_log "${PROCESS} failed (${pid})" ${line})
+    if [ $? -ne 0 ] ; then
+        echo "${PROCESS} kill ${i} pid ${pid} not detected in ${TIMEOUT_SECS} secs"
+        exit ${GENERIC_ERROR}
+    fi
+    printf "%s kill %d pid %d detected in %5d msecs\n" "${PROCESS}" ${i} ${pid} ${msecs}
+
+    total=$((total + msecs))
+    if [ ${i} -eq 1 -o ${msecs} -lt ${min} ] ; then
+        min=${msecs}
+    fi
+    if [ ${msecs} -gt ${max} ] ; then
+        max=${msecs}
+    fi
+
+    # wait for recovery and re-registration of the new pid
+    if ! wait_for_log "${PROCESS} Registered" ${line} > /dev/null ; then
+        echo "${PROCESS} was not recovered by pmond"
+        exit ${GENERIC_ERROR}
+    fi
+done
+
+echo "${PROCESS} ${ITERATIONS} kills ; min ${min} avg $((total / ITERATIONS)) max ${max} msecs"
+exit 0